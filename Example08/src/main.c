@@ -65,7 +65,15 @@ static GLuint g_numberIndicesSphere;
 GLUSboolean init(GLUSvoid) {
   GLUSshape cube;
 
-  GLUStgaimage image;
+  // Positive and negative x, y and z, which is the order of the cube map targets.
+  const GLUSchar *filenames[6] = {
+      RESOURCE_PATH PATH_SEPERATOR "cm_pos_x.tga", RESOURCE_PATH PATH_SEPERATOR "cm_neg_x.tga",
+      RESOURCE_PATH PATH_SEPERATOR "cm_pos_y.tga", RESOURCE_PATH PATH_SEPERATOR "cm_neg_y.tga",
+      RESOURCE_PATH PATH_SEPERATOR "cm_pos_z.tga", RESOURCE_PATH PATH_SEPERATOR "cm_neg_z.tga"};
+
+  GLUSimagebatch batch;
+
+  GLint i;
 
   GLUStextfile vertexSource;
   GLUStextfile fragmentSource;
@@ -100,35 +108,17 @@ GLUSboolean init(GLUSvoid) {
   glGenTextures(1, &g_cubemapTexture);
   glBindTexture(GL_TEXTURE_CUBE_MAP, g_cubemapTexture);
 
-  glusImageLoadTga(RESOURCE_PATH PATH_SEPERATOR "cm_pos_x.tga", &image);
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, image.format, image.width, image.height, 0, image.format,
-               GL_UNSIGNED_BYTE, image.data);
-  glusImageDestroyTga(&image);
-
-  glusImageLoadTga(RESOURCE_PATH PATH_SEPERATOR "cm_neg_x.tga", &image);
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0, image.format, image.width, image.height, 0, image.format,
-               GL_UNSIGNED_BYTE, image.data);
-  glusImageDestroyTga(&image);
-
-  glusImageLoadTga(RESOURCE_PATH PATH_SEPERATOR "cm_pos_y.tga", &image);
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 0, image.format, image.width, image.height, 0, image.format,
-               GL_UNSIGNED_BYTE, image.data);
-  glusImageDestroyTga(&image);
-
-  glusImageLoadTga(RESOURCE_PATH PATH_SEPERATOR "cm_neg_y.tga", &image);
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 0, image.format, image.width, image.height, 0, image.format,
-               GL_UNSIGNED_BYTE, image.data);
-  glusImageDestroyTga(&image);
-
-  glusImageLoadTga(RESOURCE_PATH PATH_SEPERATOR "cm_pos_z.tga", &image);
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 0, image.format, image.width, image.height, 0, image.format,
-               GL_UNSIGNED_BYTE, image.data);
-  glusImageDestroyTga(&image);
-
-  glusImageLoadTga(RESOURCE_PATH PATH_SEPERATOR "cm_neg_z.tga", &image);
-  glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 0, image.format, image.width, image.height, 0, image.format,
-               GL_UNSIGNED_BYTE, image.data);
-  glusImageDestroyTga(&image);
+  // The six sides are loaded in parallel into one allocation. A side, which could not be loaded, is empty.
+  glusImageLoadBatch(&batch, filenames, 6, 0);
+
+  if (batch.loaded) {
+    for (i = 0; i < 6; i++) {
+      glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, batch.tgaimages[i].format, batch.tgaimages[i].width,
+                   batch.tgaimages[i].height, 0, batch.tgaimages[i].format, GL_UNSIGNED_BYTE, batch.tgaimages[i].data);
+    }
+  }
+
+  glusImageDestroyBatch(&batch);
 
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
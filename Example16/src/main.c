@@ -110,6 +110,8 @@ GLUSboolean init(GLUSvoid) {
 
   GLUSshape wavefrontObj;
 
+  GLUSwavefrontoptions options;
+
   glusFileLoadText(RESOURCE_PATH PATH_SEPERATOR "Example16" PATH_SEPERATOR "shader" PATH_SEPERATOR "phong.vert.glsl",
                    &vertexSource);
   glusFileLoadText(RESOURCE_PATH PATH_SEPERATOR "Example16" PATH_SEPERATOR "shader" PATH_SEPERATOR "phong.frag.glsl",
@@ -144,8 +146,11 @@ GLUSboolean init(GLUSvoid) {
 
   //
 
-  // Use a helper function to load an wavefront object file.
-  glusShapeLoadWavefront(RESOURCE_PATH PATH_SEPERATOR "monkey.obj", &wavefrontObj);
+  // Use a helper function to load an wavefront object file. The shader only needs vertices and normals.
+  glusWavefrontInitOptions(&options);
+  options.attributes = GLUS_ATTRIBUTE_NORMALS;
+
+  glusShapeLoadWavefrontWithOptions(RESOURCE_PATH PATH_SEPERATOR "monkey.obj", &wavefrontObj, &options);
 
   g_numberVertices = wavefrontObj.numberVertices;
 
@@ -136,7 +136,12 @@ GLUSboolean init(GLUSvoid) {
   GLUSshape wavefront;
 
   // 6 sides of diffuse and specular; all roughness levels of specular.
-  GLUShdrimage image[6 * NUMBER_ROUGHNESS + 6];
+  GLchar filenames[6 * NUMBER_ROUGHNESS + 6][300];
+  const GLchar *filenamePointers[6 * NUMBER_ROUGHNESS + 6];
+
+  // All images are loaded in parallel into one allocation.
+  GLUSimagebatch batch;
+  GLUShdrimage *image;
 
   // The look up table (LUT) is stored in a raw binary file.
   GLUSbinaryfile rawimage;
@@ -146,7 +151,7 @@ GLUSboolean init(GLUSvoid) {
 
   GLchar buffer[27] = "doge2/doge2_POS_X_00_s.hdr";
 
-  GLint i, k, m;
+  GLint i, k, m, index;
 
   //
 
@@ -308,35 +313,49 @@ GLUSboolean init(GLUSvoid) {
             break;
         }
 
-        printf("Loading '%s' ...", buffer);
+        index = i * NUMBER_ROUGHNESS * 6 + k * 6 + m;
 
-        char path_name[300] = RESOURCE_PATH;
-        strncpy(&path_name[strlen(RESOURCE_PATH)], buffer, 27);
-        path_name[strlen(RESOURCE_PATH) + 27 + 1] = 0;
+        strcpy(filenames[index], RESOURCE_PATH);
+        strcat(filenames[index], buffer);
 
-        if (!glusImageLoadHdr(path_name, &image[i * NUMBER_ROUGHNESS * 6 + k * 6 + m])) {
-          printf(" error!\n");
-          continue;
-        }
+        filenamePointers[index] = filenames[index];
+      }
+    }
+  }
+
+  printf("Loading %d images ...", 6 * NUMBER_ROUGHNESS + 6);
 
-        printf(" done.\n");
+  if (!glusImageLoadBatchPacked(&batch, filenamePointers, 6 * NUMBER_ROUGHNESS + 6, 0, GLUS_HALF_FLOAT)) {
+    printf(" error!\n");
+
+    if (!batch.loaded) {
+      return GLUS_FALSE;
+    }
+
+    for (i = 0; i < 6 * NUMBER_ROUGHNESS + 6; i++) {
+      if (!batch.loaded[i]) {
+        printf("Could not load '%s'\n", filenames[i]);
       }
     }
+  } else {
+    printf(" done.\n");
   }
 
+  image = batch.hdrimages;
+
   glGenTextures(1, &g_texture[0]);
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, g_texture[0]);
 
-  glTexImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 0, GL_RGB32F, image[0].width, image[0].height, 6 * NUMBER_ROUGHNESS, 0,
-               GL_RGB, GL_FLOAT, 0);
+  glTexImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 0, GL_RGB16F, image[0].width, image[0].height, 6 * NUMBER_ROUGHNESS, 0,
+               GL_RGB, GL_HALF_FLOAT, 0);
 
   glusLogPrintError(GLUS_LOG_INFO, "glTexImage3D()");
 
   for (i = 0; i < NUMBER_ROUGHNESS; i++) {
     for (k = 0; k < 6; k++) {
       glTexSubImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 0, 0, 0, 6 * i + k, image[i * 6 + k].width, image[i * 6 + k].height, 1,
-                      image[i * 6 + k].format, GL_FLOAT, image[i * 6 + k].data);
+                      image[i * 6 + k].format, image[i * 6 + k].type, image[i * 6 + k].data);
 
       glusLogPrintError(GLUS_LOG_INFO, "glTexSubImage3D() %d %d", i, k);
     }
@@ -356,9 +375,10 @@ GLUSboolean init(GLUSvoid) {
   glBindTexture(GL_TEXTURE_CUBE_MAP, g_texture[1]);
 
   for (i = 0; i < 6; i++) {
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, image[i + 6 * NUMBER_ROUGHNESS].format,
+    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F,
                  image[i + 6 * NUMBER_ROUGHNESS].width, image[i + 6 * NUMBER_ROUGHNESS].height, 0,
-                 image[i + 6 * NUMBER_ROUGHNESS].format, GL_FLOAT, image[i + 6 * NUMBER_ROUGHNESS].data);
+                 image[i + 6 * NUMBER_ROUGHNESS].format, image[i + 6 * NUMBER_ROUGHNESS].type,
+                 image[i + 6 * NUMBER_ROUGHNESS].data);
 
     glusLogPrintError(GLUS_LOG_INFO, "glTexImage2D() %d", i);
   }
@@ -398,17 +418,7 @@ GLUSboolean init(GLUSvoid) {
 
   //
 
-  for (i = 0; i < 2; i++) {
-    for (k = 0; k < NUMBER_ROUGHNESS; k++) {
-      if (i == 1 && k > 0) {
-        continue;
-      }
-
-      for (m = 0; m < 6; m++) {
-        glusImageDestroyHdr(&image[i * NUMBER_ROUGHNESS * 6 + k * 6 + m]);
-      }
-    }
-  }
+  glusImageDestroyBatch(&batch);
 
   //
 
@@ -111,6 +111,8 @@ GLUSboolean init(GLUSvoid) {
   GLUSgroupList *groupWalker;
   GLUSmaterialList *materialWalker;
 
+  GLUSwavefrontoptions options;
+
   glusFileLoadText(RESOURCE_PATH PATH_SEPERATOR "Example43" PATH_SEPERATOR "shader" PATH_SEPERATOR
                                                 "phong_textured.vert.glsl",
                    &vertexSource);
@@ -150,10 +152,13 @@ GLUSboolean init(GLUSvoid) {
   g_texCoordLocation = glGetAttribLocation(g_program.program, "a_texCoord");
 
   //
-  // Use a helper function to load the wavefront object file.
+  // Use a helper function to load the wavefront object file. Tangents and bitangents are not used by the shader.
   //
 
-  glusWavefrontLoadScene(RESOURCE_PATH PATH_SEPERATOR "three_objects.obj", &g_scene);
+  glusWavefrontInitOptions(&options);
+  options.attributes = GLUS_ATTRIBUTE_NORMALS | GLUS_ATTRIBUTE_TEXCOORDS;
+
+  glusWavefrontLoadSceneWithOptions(RESOURCE_PATH PATH_SEPERATOR "three_objects.obj", &g_scene, &options);
 
   objectWalker = g_scene.objectList;
   while (objectWalker) {
@@ -0,0 +1,53 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_BENCHMARK_H_
+#define GLUS_BENCHMARK_H_
+
+#include "GL/glus.h"
+
+#include <stdio.h>
+
+/**
+ * The fastest of this number of runs is reported.
+ */
+#define GLUS_BENCHMARK_RUNS 10
+
+/**
+ * Gets the wall clock time. Without OpenMP, the processor time is used, which
+ * is the same for one thread.
+ *
+ * @return The time in seconds.
+ */
+double glusBenchmarkGetTime(void);
+
+/**
+ * Gets the number of processors, which are used by OpenMP.
+ *
+ * @return The number of processors, 1 without OpenMP.
+ */
+GLUSint glusBenchmarkGetNumberProcessors(void);
+
+/**
+ * Sets the number of threads of the following parallel regions.
+ *
+ * @param numberThreads The number of threads. Ignored without OpenMP.
+ */
+GLUSvoid glusBenchmarkSetNumberThreads(GLUSint numberThreads);
+
+#endif /* GLUS_BENCHMARK_H_ */
@@ -0,0 +1,330 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares glusShapeCreateAdjacencyIndicesf() with the previous builder,
+// which scanned all triangles for every edge. Spheres and tori of growing size
+// are measured. The previous builder is quadratic, so it is only run up to
+// GLUS_BENCHMARK_PREVIOUS_TRIANGLES triangles. Both results are compared byte
+// by byte.
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_POINT_TOLERANCE 0.001f
+
+#define GLUS_BENCHMARK_PREVIOUS_TRIANGLES 40000
+
+#define GLUS_BENCHMARK_SIZES 6
+
+static GLUSboolean glusBenchmarkFindIndexByIndicesf(GLUSuint *adjacentIndex,
+                                                    GLUSuint triangleFirstIndex,
+                                                    GLUSuint edge,
+                                                    const GLUSshape *shape) {
+  GLUSuint i, k, m;
+
+  GLUSuint equalIndices;
+
+  GLUSuint edgeIndices[2];
+
+  for (i = 0; i < shape->numberIndices / 3; i++) {
+    // Skip same triangle
+    if (triangleFirstIndex == i * 3) {
+      continue;
+    }
+
+    equalIndices = 0;
+
+    for (k = 0; k < 3; k++) {
+      for (m = 0 + edge; m < 2 + edge; m++) {
+        if (shape->indices[triangleFirstIndex + (m % 3)] ==
+            shape->indices[i * 3 + k]) {
+          equalIndices++;
+
+          edgeIndices[m - edge] = shape->indices[i * 3 + k];
+
+          break;
+        }
+      }
+    }
+
+    if (equalIndices == 2) {
+      for (k = 0; k < 3; k++) {
+        if (shape->indices[i * 3 + k] != edgeIndices[0] &&
+            shape->indices[i * 3 + k] != edgeIndices[1]) {
+          *adjacentIndex = shape->indices[i * 3 + k];
+
+          break;
+        }
+      }
+
+      return GLUS_TRUE;
+    }
+  }
+
+  return GLUS_FALSE;
+}
+
+static GLUSboolean glusBenchmarkEqualPointsf(const GLUSfloat *point0,
+                                             const GLUSfloat *point1) {
+  GLUSint i;
+
+  for (i = 0; i < 3; i++) {
+    if (point0[i] < point1[i] - GLUS_BENCHMARK_POINT_TOLERANCE ||
+        point0[i] > point1[i] + GLUS_BENCHMARK_POINT_TOLERANCE) {
+      return GLUS_FALSE;
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusBenchmarkFindIndexByVerticesf(GLUSuint *adjacentIndex,
+                                                     GLUSuint triangleIndex,
+                                                     GLUSuint edge,
+                                                     const GLUSshape *shape) {
+  GLUSuint i, k, m;
+
+  GLUSuint equalVertices, walkerIndex, searchIndex;
+
+  GLUSuint edgeIndices[2];
+
+  for (i = 0; i < shape->numberIndices / 3; i++) {
+    // Skip same triangle
+    if (triangleIndex == i * 3) {
+      continue;
+    }
+
+    equalVertices = 0;
+
+    for (k = 0; k < 3; k++) {
+      walkerIndex = shape->indices[i * 3 + k];
+
+      for (m = 0 + edge; m < 2 + edge; m++) {
+        searchIndex = shape->indices[triangleIndex + (m % 3)];
+
+        if (glusBenchmarkEqualPointsf(&shape->vertices[4 * searchIndex],
+                                      &shape->vertices[4 * walkerIndex])) {
+          equalVertices++;
+
+          edgeIndices[m - edge] = walkerIndex;
+
+          break;
+        }
+      }
+    }
+
+    if (equalVertices == 2) {
+      for (k = 0; k < 3; k++) {
+        if (shape->indices[i * 3 + k] != edgeIndices[0] &&
+            shape->indices[i * 3 + k] != edgeIndices[1]) {
+          *adjacentIndex = shape->indices[i * 3 + k];
+
+          break;
+        }
+      }
+
+      return GLUS_TRUE;
+    }
+  }
+
+  return GLUS_FALSE;
+}
+
+// The previous builder. The shape is copied like in the library, so both
+// measure the same work around the search.
+static GLUSboolean
+glusBenchmarkCreateAdjacencyPreviousf(GLUSshape *adjacencyShape,
+                                      const GLUSshape *sourceShape) {
+  GLUSuint i;
+
+  GLUSuint numberIndices = sourceShape->numberIndices * 2;
+
+  GLUSuint adjacentIndex, edge;
+
+  if (!glusShapeCopyf(adjacencyShape, sourceShape)) {
+    return GLUS_FALSE;
+  }
+
+  adjacencyShape->numberIndices = numberIndices;
+
+  glusMemoryFree(adjacencyShape->indices);
+  adjacencyShape->indices =
+      (GLUSindex *)glusMemoryMalloc(numberIndices * sizeof(GLUSindex));
+
+  adjacencyShape->mode = GLUS_TRIANGLES_ADJACENCY;
+
+  if (!adjacencyShape->indices) {
+    glusShapeDestroyf(adjacencyShape);
+
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < sourceShape->numberIndices / 3; i++) {
+    adjacencyShape->indices[6 * i + 0] = sourceShape->indices[3 * i + 0];
+    adjacencyShape->indices[6 * i + 1] = sourceShape->indices[3 * i + 0];
+    adjacencyShape->indices[6 * i + 2] = sourceShape->indices[3 * i + 1];
+    adjacencyShape->indices[6 * i + 3] = sourceShape->indices[3 * i + 1];
+    adjacencyShape->indices[6 * i + 4] = sourceShape->indices[3 * i + 2];
+    adjacencyShape->indices[6 * i + 5] = sourceShape->indices[3 * i + 2];
+
+    if (sourceShape->indices[i * 3 + 0] == sourceShape->indices[i * 3 + 1] ||
+        sourceShape->indices[i * 3 + 0] == sourceShape->indices[i * 3 + 2] ||
+        sourceShape->indices[i * 3 + 1] == sourceShape->indices[i * 3 + 2]) {
+      continue;
+    }
+
+    for (edge = 0; edge < 3; edge++) {
+      adjacentIndex = 0;
+
+      if (glusBenchmarkFindIndexByIndicesf(&adjacentIndex, 3 * i, edge,
+                                           sourceShape) ||
+          glusBenchmarkFindIndexByVerticesf(&adjacentIndex, 3 * i, edge,
+                                            sourceShape)) {
+        adjacencyShape->indices[6 * i + edge * 2 + 1] = adjacentIndex;
+      }
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+// Builds the adjacency indices several times and returns the fastest time or
+// a negative value, if building failed. The shape of the last run is kept.
+static double glusBenchmarkMeasure(GLUSshape *adjacencyShape,
+                                   const GLUSshape *shape,
+                                   GLUSboolean previous, GLUSint numberRuns) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  for (i = 0; i < numberRuns; i++) {
+    double startTime;
+    double time;
+
+    GLUSboolean result;
+
+    if (i > 0) {
+      glusShapeDestroyf(adjacencyShape);
+    }
+
+    startTime = glusBenchmarkGetTime();
+
+    if (previous) {
+      result = glusBenchmarkCreateAdjacencyPreviousf(adjacencyShape, shape);
+    } else {
+      result = glusShapeCreateAdjacencyIndicesf(adjacencyShape, shape);
+    }
+
+    time = glusBenchmarkGetTime() - startTime;
+
+    if (!result) {
+      return -1.0;
+    }
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkShape(const GLUSchar *name,
+                                   const GLUSshape *shape) {
+  GLUSshape previousShape;
+  GLUSshape adjacencyShape;
+
+  GLUSuint numberTriangles = shape->numberIndices / 3;
+
+  double previousTime = -1.0;
+  double time;
+
+  time = glusBenchmarkMeasure(&adjacencyShape, shape, GLUS_FALSE,
+                              GLUS_BENCHMARK_RUNS);
+
+  if (time < 0.0) {
+    printf("%s: Could not create adjacency indices.\n", name);
+
+    return;
+  }
+
+  if (numberTriangles > GLUS_BENCHMARK_PREVIOUS_TRIANGLES) {
+    printf("%s: %u triangles: hashed %.2f ms\n", name, numberTriangles,
+           time * 1000.0);
+
+    glusShapeDestroyf(&adjacencyShape);
+
+    return;
+  }
+
+  // The previous builder takes long, so it is run once.
+  previousTime = glusBenchmarkMeasure(&previousShape, shape, GLUS_TRUE, 1);
+
+  if (previousTime < 0.0) {
+    printf("%s: Could not create previous adjacency indices.\n", name);
+
+    glusShapeDestroyf(&adjacencyShape);
+
+    return;
+  }
+
+  printf("%s: %u triangles: scanning %.2f ms, hashed %.2f ms, speedup %.1f, "
+         "%s\n",
+         name, numberTriangles, previousTime * 1000.0, time * 1000.0,
+         time > 0.0 ? previousTime / time : 0.0,
+         memcmp(previousShape.indices, adjacencyShape.indices,
+                adjacencyShape.numberIndices * sizeof(GLUSindex)) == 0
+             ? "identical"
+             : "DIFFERENT");
+
+  glusShapeDestroyf(&previousShape);
+  glusShapeDestroyf(&adjacencyShape);
+}
+
+int main(void) {
+  const GLUSuint numberSlices[GLUS_BENCHMARK_SIZES] = {16,  32,  64,
+                                                       128, 256, 512};
+
+  GLUSchar name[64];
+
+  GLUSshape shape;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_SIZES; i++) {
+    // Sphere poles and seams have separate vertices at the same position, so
+    // the vertex comparison is needed there.
+    if (glusShapeCreateSpheref(&shape, 1.0f, numberSlices[i])) {
+      sprintf(name, "Sphere %u", numberSlices[i]);
+
+      glusBenchmarkShape(name, &shape);
+
+      glusShapeDestroyf(&shape);
+    }
+
+    if (glusShapeCreateTorusf(&shape, 0.5f, 1.0f, numberSlices[i],
+                              numberSlices[i])) {
+      sprintf(name, "Torus %u", numberSlices[i]);
+
+      glusBenchmarkShape(name, &shape);
+
+      glusShapeDestroyf(&shape);
+    }
+  }
+
+  return 0;
+}
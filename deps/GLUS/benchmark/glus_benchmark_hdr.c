@@ -0,0 +1,601 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares glusImageLoadHdr() with the previous loader, which read the file
+// byte by byte and converted every pixel with powf(). A 2048x1024 image is
+// written run length encoded and uncompressed as two temporary files into the
+// current directory. Radiance files can be passed as arguments:
+//
+// glus_benchmark_hdr doge2.hdr
+//
+// Throughput is in Mpixels/s and the floats are compared byte by byte. The
+// half float and RGB9E5 loads are only measured.
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_WIDTH 2048
+#define GLUS_BENCHMARK_HEIGHT 1024
+
+#define GLUS_BENCHMARK_RLE_FILE "glus_benchmark_rle.hdr"
+#define GLUS_BENCHMARK_FLAT_FILE "glus_benchmark_flat.hdr"
+
+#define GLUS_BENCHMARK_TYPES 3
+
+static const GLUSenum g_types[GLUS_BENCHMARK_TYPES] = {
+    GLUS_FLOAT, GLUS_HALF_FLOAT, GLUS_UNSIGNED_INT_5_9_9_9_REV};
+
+static const GLUSchar *g_typeNames[GLUS_BENCHMARK_TYPES] = {"float", "half",
+                                                            "rgb9e5"};
+
+extern GLUSboolean _glusFileCheckRead(FILE *f, size_t actualRead,
+                                      size_t expectedRead);
+
+// The previous conversion of one RGBE pixel.
+static GLUSvoid glusBenchmarkConvertRGBEPrevious(GLUSfloat *rgb,
+                                                 const GLUSubyte *rgbe) {
+  GLUSfloat exponent = (GLUSfloat)(rgbe[3] - 128);
+
+  rgb[0] = (GLUSfloat)rgbe[0] / 256.0f * powf(2.0f, exponent);
+  rgb[1] = (GLUSfloat)rgbe[1] / 256.0f * powf(2.0f, exponent);
+  rgb[2] = (GLUSfloat)rgbe[2] / 256.0f * powf(2.0f, exponent);
+}
+
+// The previous decoding of a new RLE scanline, which read every byte with
+// fread().
+static GLUSint glusBenchmarkDecodeNewRLEPrevious(FILE *file,
+                                                 GLUSubyte *scanline,
+                                                 GLUSint width) {
+  GLUSint channel, x, scanLength, maxScanLength;
+  GLUSubyte code, channelValue;
+  size_t elementsRead;
+
+  maxScanLength = 0;
+
+  for (channel = 0; channel < 4; channel++) {
+    x = 0;
+
+    scanLength = 0;
+
+    while (x < width) {
+      elementsRead = fread(&code, 1, 1, file);
+
+      if (!_glusFileCheckRead(file, elementsRead, 1)) {
+        return -1;
+      }
+
+      if (code > 128) {
+        code &= 127;
+
+        scanLength += code;
+
+        if (scanLength > width) {
+          glusFileClose(file);
+
+          return -1;
+        }
+
+        elementsRead = fread(&channelValue, 1, 1, file);
+
+        if (!_glusFileCheckRead(file, elementsRead, 1)) {
+          return -1;
+        }
+
+        while (code--) {
+          scanline[x++ * 4 + channel] = channelValue;
+        }
+      } else {
+        scanLength += code;
+
+        if (scanLength > width) {
+          glusFileClose(file);
+
+          return -1;
+        }
+
+        while (code--) {
+          elementsRead = fread(&channelValue, 1, 1, file);
+
+          if (!_glusFileCheckRead(file, elementsRead, 1)) {
+            return -1;
+          }
+
+          scanline[x++ * 4 + channel] = channelValue;
+        }
+      }
+    }
+
+    if (scanLength > maxScanLength) {
+      maxScanLength = scanLength;
+    }
+  }
+
+  return maxScanLength;
+}
+
+// Stores a pixel of the previous loader.
+static GLUSvoid glusBenchmarkStorePrevious(GLUShdrimage *hdrimage,
+                                          const GLUSfloat rgb[3], GLUSint x,
+                                          GLUSint y) {
+  GLUSint index = (hdrimage->width * y + x) * 3;
+
+  hdrimage->data[index + 0] = rgb[0];
+  hdrimage->data[index + 1] = rgb[1];
+  hdrimage->data[index + 2] = rgb[2];
+}
+
+// The previous loader. Only the cleanup on errors is shortened.
+static GLUSboolean glusBenchmarkLoadHdrPrevious(const GLUSchar *filename,
+                                                GLUShdrimage *hdrimage) {
+  FILE *file;
+
+  GLUSchar buffer[256];
+  GLUSchar currentChar, oldChar;
+
+  GLUSint width, height, x, y, repeat, factor, i;
+
+  GLUSubyte *scanline;
+  GLUSubyte rgbe[4];
+  GLUSubyte prevRgbe[4];
+
+  GLUSfloat rgb[3];
+
+  size_t elementsRead;
+
+  hdrimage->width = 0;
+  hdrimage->height = 0;
+  hdrimage->depth = 0;
+  hdrimage->data = 0;
+
+  file = glusFileOpen(filename, "rb");
+
+  if (!file) {
+    return GLUS_FALSE;
+  }
+
+  elementsRead = fread(buffer, 10, 1, file);
+
+  if (!_glusFileCheckRead(file, elementsRead, 1)) {
+    return GLUS_FALSE;
+  }
+
+  if (strncmp(buffer, "#?RADIANCE", 10) || fseek(file, 1, SEEK_CUR)) {
+    glusFileClose(file);
+
+    return GLUS_FALSE;
+  }
+
+  currentChar = 0;
+  while (GLUS_TRUE) {
+    oldChar = currentChar;
+
+    elementsRead = fread(&currentChar, 1, 1, file);
+
+    if (!_glusFileCheckRead(file, elementsRead, 1)) {
+      return GLUS_FALSE;
+    }
+
+    if (currentChar == '\n' && oldChar == '\n') {
+      break;
+    }
+  }
+
+  i = 0;
+  while (GLUS_TRUE) {
+    elementsRead = fread(&currentChar, 1, 1, file);
+
+    if (!_glusFileCheckRead(file, elementsRead, 1)) {
+      return GLUS_FALSE;
+    }
+
+    buffer[i++] = currentChar;
+
+    if (currentChar == '\n') {
+      break;
+    }
+  }
+
+  if (!sscanf(buffer, "-Y %d +X %d", &height, &width)) {
+    glusFileClose(file);
+
+    return GLUS_FALSE;
+  }
+
+  hdrimage->width = (GLUSushort)width;
+  hdrimage->height = (GLUSushort)height;
+  hdrimage->depth = 1;
+  hdrimage->format = GLUS_RGB;
+  hdrimage->type = GLUS_FLOAT;
+
+  hdrimage->data =
+      (GLUSfloat *)glusMemoryMalloc(width * height * 3 * sizeof(GLUSfloat));
+
+  scanline = (GLUSubyte *)glusMemoryMalloc(width * 4 * sizeof(GLUSubyte));
+
+  if (!hdrimage->data || !scanline) {
+    glusMemoryFree(scanline);
+
+    glusFileClose(file);
+
+    glusImageDestroyHdr(hdrimage);
+
+    return GLUS_FALSE;
+  }
+
+  prevRgbe[0] = 0;
+  prevRgbe[1] = 0;
+  prevRgbe[2] = 0;
+  prevRgbe[3] = 0;
+
+  factor = 1;
+  x = 0;
+  y = height - 1;
+  while (y >= 0) {
+    elementsRead = fread(buffer, 4, 1, file);
+
+    if (!_glusFileCheckRead(file, elementsRead, 1)) {
+      glusMemoryFree(scanline);
+
+      glusImageDestroyHdr(hdrimage);
+
+      return GLUS_FALSE;
+    }
+
+    repeat = 0;
+
+    if (width < 32768 && buffer[0] == 2 && buffer[1] == 2 &&
+        buffer[2] == ((width >> 8) & 0xFF) && buffer[3] == (width & 0xFF)) {
+      GLUSint scanlinePixels =
+          glusBenchmarkDecodeNewRLEPrevious(file, scanline, width);
+
+      if (scanlinePixels < 0) {
+        glusMemoryFree(scanline);
+
+        glusImageDestroyHdr(hdrimage);
+
+        return GLUS_FALSE;
+      }
+
+      for (i = 0; i < scanlinePixels; i++) {
+        if (y < 0) {
+          glusMemoryFree(scanline);
+
+          glusFileClose(file);
+
+          glusImageDestroyHdr(hdrimage);
+
+          return GLUS_FALSE;
+        }
+
+        glusBenchmarkConvertRGBEPrevious(rgb, &scanline[i * 4]);
+
+        glusBenchmarkStorePrevious(hdrimage, rgb, x, y);
+
+        x++;
+        if (x >= width) {
+          y--;
+          x = 0;
+        }
+      }
+
+      factor = 1;
+
+      memcpy(prevRgbe, &scanline[(scanlinePixels - 1) * 4], 4);
+
+      continue;
+    } else if (buffer[0] == 1 && buffer[1] == 1 && buffer[2] == 1) {
+      repeat = buffer[3] * factor;
+
+      memcpy(rgbe, prevRgbe, 4);
+
+      factor *= 256;
+    } else {
+      repeat = 1;
+
+      memcpy(rgbe, buffer, 4);
+
+      factor = 1;
+    }
+
+    glusBenchmarkConvertRGBEPrevious(rgb, rgbe);
+
+    while (repeat) {
+      if (y < 0) {
+        glusMemoryFree(scanline);
+
+        glusFileClose(file);
+
+        glusImageDestroyHdr(hdrimage);
+
+        return GLUS_FALSE;
+      }
+
+      glusBenchmarkStorePrevious(hdrimage, rgb, x, y);
+
+      x++;
+      if (x >= width) {
+        y--;
+        x = 0;
+      }
+
+      repeat--;
+    }
+
+    memcpy(prevRgbe, rgbe, 4);
+  }
+
+  glusMemoryFree(scanline);
+
+  glusFileClose(file);
+
+  return GLUS_TRUE;
+}
+
+// Writes one channel of a scanline in the new RLE format. Three or more equal
+// values are stored as a run.
+static GLUSboolean glusBenchmarkWriteChannel(FILE *file,
+                                             const GLUSubyte *scanline,
+                                             GLUSint width) {
+  GLUSubyte buffer[129];
+
+  GLUSint x = 0;
+  GLUSint length, runLength;
+
+  while (x < width) {
+    length = 0;
+
+    while (x + length < width && length < 128) {
+      runLength = 1;
+
+      while (x + length + runLength < width && runLength < 127 &&
+             scanline[(x + length + runLength) * 4] ==
+                 scanline[(x + length) * 4]) {
+        runLength++;
+      }
+
+      if (runLength >= 3) {
+        break;
+      }
+
+      buffer[1 + length] = scanline[(x + length) * 4];
+
+      length++;
+    }
+
+    if (length > 0) {
+      buffer[0] = (GLUSubyte)length;
+
+      if (fwrite(buffer, 1, length + 1, file) != (size_t)(length + 1)) {
+        return GLUS_FALSE;
+      }
+
+      x += length;
+
+      continue;
+    }
+
+    buffer[0] = (GLUSubyte)(128 + runLength);
+    buffer[1] = scanline[x * 4];
+
+    if (fwrite(buffer, 1, 2, file) != 2) {
+      return GLUS_FALSE;
+    }
+
+    x += runLength;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Writes the RGBE pixels, either run length encoded or uncompressed.
+static GLUSboolean glusBenchmarkWriteHdr(const GLUSchar *filename,
+                                         const GLUSubyte *rgbe,
+                                         GLUSboolean rle) {
+  FILE *file = glusFileOpen(filename, "wb");
+
+  GLUSubyte code[4] = {2, 2, GLUS_BENCHMARK_WIDTH >> 8,
+                       GLUS_BENCHMARK_WIDTH & 0xFF};
+
+  GLUSboolean result = GLUS_TRUE;
+
+  GLUSint y, channel;
+
+  if (!file) {
+    return GLUS_FALSE;
+  }
+
+  if (fprintf(file,
+              "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y %d +X %d\n",
+              GLUS_BENCHMARK_HEIGHT, GLUS_BENCHMARK_WIDTH) < 0) {
+    result = GLUS_FALSE;
+  }
+
+  for (y = 0; y < GLUS_BENCHMARK_HEIGHT && result; y++) {
+    const GLUSubyte *scanline = &rgbe[y * GLUS_BENCHMARK_WIDTH * 4];
+
+    if (!rle) {
+      result = fwrite(scanline, 4, GLUS_BENCHMARK_WIDTH, file) ==
+               GLUS_BENCHMARK_WIDTH;
+
+      continue;
+    }
+
+    result = fwrite(code, 1, 4, file) == 4;
+
+    for (channel = 0; channel < 4 && result; channel++) {
+      result = glusBenchmarkWriteChannel(file, &scanline[channel],
+                                         GLUS_BENCHMARK_WIDTH);
+    }
+  }
+
+  glusFileClose(file);
+
+  return result;
+}
+
+// Runs the loader several times and returns the fastest time. The last image
+// is kept.
+static double glusBenchmarkMeasure(GLUSboolean previous, GLUSenum type,
+                                   const GLUSchar *filename,
+                                   GLUShdrimage *hdrimage) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double time;
+
+    GLUSboolean result;
+
+    if (i > 0) {
+      glusImageDestroyHdr(hdrimage);
+    }
+
+    time = glusBenchmarkGetTime();
+
+    result = previous ? glusBenchmarkLoadHdrPrevious(filename, hdrimage)
+                      : glusImageLoadHdrPacked(filename, hdrimage, type);
+
+    time = glusBenchmarkGetTime() - time;
+
+    if (!result) {
+      return -1.0;
+    }
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkFile(const GLUSchar *filename) {
+  GLUShdrimage previousImage;
+  GLUShdrimage image;
+
+  double previousTime;
+  double time;
+
+  double numberPixels;
+
+  GLUSint i;
+
+  previousTime =
+      glusBenchmarkMeasure(GLUS_TRUE, GLUS_FLOAT, filename, &previousImage);
+
+  if (previousTime <= 0.0) {
+    printf("%s: Could not load file with the previous loader.\n", filename);
+
+    return;
+  }
+
+  numberPixels = (double)previousImage.width * previousImage.height;
+
+  printf("%s: %dx%d, previous %.0f Mpixels/s\n", filename, previousImage.width,
+         previousImage.height, numberPixels / previousTime / 1000000.0);
+
+  for (i = 0; i < GLUS_BENCHMARK_TYPES; i++) {
+    time = glusBenchmarkMeasure(GLUS_FALSE, g_types[i], filename, &image);
+
+    if (time <= 0.0) {
+      printf("  %s: Could not load file.\n", g_typeNames[i]);
+
+      continue;
+    }
+
+    printf("  %s: %.0f Mpixels/s, %.1fx", g_typeNames[i],
+           numberPixels / time / 1000000.0, previousTime / time);
+
+    if (g_types[i] == GLUS_FLOAT) {
+      printf(", %s",
+             image.width == previousImage.width &&
+                     image.height == previousImage.height &&
+                     memcmp(image.data, previousImage.data,
+                            (size_t)image.width * image.height * 3 *
+                                sizeof(GLUSfloat)) == 0
+                 ? "identical"
+                 : "DIFFERENT");
+    }
+
+    printf("\n");
+
+    glusImageDestroyHdr(&image);
+  }
+
+  glusImageDestroyHdr(&previousImage);
+}
+
+int main(int argc, char *argv[]) {
+  GLUSubyte *rgbe;
+
+  GLUSuint random = 12345;
+
+  GLUSint x, y, i;
+
+  rgbe = (GLUSubyte *)glusMemoryMalloc(
+      (size_t)GLUS_BENCHMARK_WIDTH * GLUS_BENCHMARK_HEIGHT * 4);
+
+  if (!rgbe) {
+    printf("Could not allocate memory.\n");
+
+    return 1;
+  }
+
+  // Smooth tiles, which compress well, alternate with noisy tiles. The
+  // exponents cover bright and dark values.
+  for (y = 0; y < GLUS_BENCHMARK_HEIGHT; y++) {
+    for (x = 0; x < GLUS_BENCHMARK_WIDTH; x++) {
+      GLUSubyte *pixel = &rgbe[(y * GLUS_BENCHMARK_WIDTH + x) * 4];
+
+      GLUSint tile = x / 64 + y / 64;
+
+      random = random * 1664525 + 1013904223;
+
+      if (tile % 2) {
+        pixel[0] = (GLUSubyte)(128 + (random >> 25));
+        pixel[1] = (GLUSubyte)(random >> 16);
+        pixel[2] = (GLUSubyte)(random >> 8);
+      } else {
+        pixel[0] = (GLUSubyte)(128 + tile % 128);
+        pixel[1] = (GLUSubyte)(64 + x / 32 % 64);
+        pixel[2] = 32;
+      }
+
+      pixel[3] = (GLUSubyte)(112 + tile % 32);
+    }
+  }
+
+  if (!glusBenchmarkWriteHdr(GLUS_BENCHMARK_RLE_FILE, rgbe, GLUS_TRUE) ||
+      !glusBenchmarkWriteHdr(GLUS_BENCHMARK_FLAT_FILE, rgbe, GLUS_FALSE)) {
+    printf("Could not write files.\n");
+  } else {
+    glusBenchmarkFile(GLUS_BENCHMARK_RLE_FILE);
+    glusBenchmarkFile(GLUS_BENCHMARK_FLAT_FILE);
+  }
+
+  remove(GLUS_BENCHMARK_RLE_FILE);
+  remove(GLUS_BENCHMARK_FLAT_FILE);
+
+  glusMemoryFree(rgbe);
+
+  for (i = 1; i < argc; i++) {
+    glusBenchmarkFile(argv[i]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,306 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures how many triangles glusMeshletCullf() rejects per millisecond on
+// the CPU. The meshlets are culled from views around the mesh at different
+// distances, so both the frustum and the normal cone test reject meshlets.
+// Every triangle of a culled meshlet is checked to be back facing or outside
+// of the frustum. A torus is always measured, wavefront files can be passed
+// as arguments:
+//
+// glus_benchmark_meshlet elephant.obj venusm.obj
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_VIEWS 200
+
+#define GLUS_BENCHMARK_MAX_VERTICES 64
+#define GLUS_BENCHMARK_MAX_TRIANGLES 124
+
+#define GLUS_BENCHMARK_CACHE_SIZE 16
+
+// Calculates a sphere around all meshlets, which is used to place the views.
+static GLUSvoid glusBenchmarkGetBounds(GLUSfloat center[4], GLUSfloat *radius,
+                                       const GLUSmeshlet *meshlets,
+                                       GLUSuint numberMeshlets) {
+  GLUSuint i, k;
+
+  center[0] = 0.0f;
+  center[1] = 0.0f;
+  center[2] = 0.0f;
+  center[3] = 1.0f;
+
+  for (i = 0; i < numberMeshlets; i++) {
+    for (k = 0; k < 3; k++) {
+      center[k] += meshlets[i].center[k] / (GLUSfloat)numberMeshlets;
+    }
+  }
+
+  *radius = 0.0f;
+
+  for (i = 0; i < numberMeshlets; i++) {
+    GLUSfloat direction[3];
+
+    GLUSfloat distance;
+
+    glusVector3SubtractVector3f(direction, meshlets[i].center, center);
+
+    distance = glusVector3Lengthf(direction) + meshlets[i].radius;
+
+    if (distance > *radius) {
+      *radius = distance;
+    }
+  }
+}
+
+// Places the eye on a spiral around the mesh. Every fourth view is close to
+// the mesh and looks beside its center, so large parts of it are outside of
+// the frustum.
+static GLUSvoid glusBenchmarkGetView(GLUSfloat viewProjectionMatrix[16],
+                                     GLUSfloat eye[4], GLUSint view,
+                                     const GLUSfloat center[4],
+                                     GLUSfloat radius) {
+  GLUSfloat projectionMatrix[16];
+  GLUSfloat viewMatrix[16];
+
+  GLUSfloat height =
+      1.8f * (GLUSfloat)view / (GLUSfloat)GLUS_BENCHMARK_VIEWS - 0.9f;
+  GLUSfloat angle = 2.4f * (GLUSfloat)view;
+  GLUSfloat distance = radius * (view % 4 == 0 ? 1.2f : 3.0f);
+  GLUSfloat offset = radius * (view % 4 == 0 ? 0.5f : 0.0f);
+  GLUSfloat planar = sqrtf(1.0f - height * height);
+
+  eye[0] = center[0] + distance * planar * cosf(angle);
+  eye[1] = center[1] + distance * height;
+  eye[2] = center[2] + distance * planar * sinf(angle);
+  eye[3] = 1.0f;
+
+  glusMatrix4x4Perspectivef(projectionMatrix, 40.0f, 1.5f, 0.01f * radius,
+                            10.0f * radius);
+
+  glusMatrix4x4LookAtf(viewMatrix, eye[0], eye[1], eye[2],
+                       center[0] - offset * sinf(angle), center[1],
+                       center[2] + offset * cosf(angle), 0.0f, 1.0f, 0.0f);
+
+  glusMatrix4x4Multiplyf(viewProjectionMatrix, projectionMatrix, viewMatrix);
+}
+
+// Checks, that the triangle is back facing or that all its vertices are
+// outside of one clip plane.
+static GLUSboolean
+glusBenchmarkIsCulled(const GLUSshape *shape, const GLUSindex *triangle,
+                      const GLUSfloat viewProjectionMatrix[16],
+                      const GLUSfloat eye[4]) {
+  GLUSfloat clip[3][4];
+
+  GLUSfloat edge0[3];
+  GLUSfloat edge1[3];
+  GLUSfloat normal[3];
+  GLUSfloat direction[3];
+
+  const GLUSfloat *point0 = &shape->vertices[4 * triangle[0]];
+  const GLUSfloat *point1 = &shape->vertices[4 * triangle[1]];
+  const GLUSfloat *point2 = &shape->vertices[4 * triangle[2]];
+
+  GLUSint i, k;
+
+  glusVector3SubtractVector3f(edge0, point1, point0);
+  glusVector3SubtractVector3f(edge1, point2, point0);
+  glusVector3Crossf(normal, edge0, edge1);
+  glusVector3SubtractVector3f(direction, point0, eye);
+
+  // Small tolerance for triangles, which are seen from the side.
+  if (glusVector3Dotf(normal, direction) >=
+      -0.0001f * glusVector3Lengthf(normal) * glusVector3Lengthf(direction)) {
+    return GLUS_TRUE;
+  }
+
+  for (i = 0; i < 3; i++) {
+    glusMatrix4x4MultiplyPoint4f(clip[i], viewProjectionMatrix,
+                                 &shape->vertices[4 * triangle[i]]);
+  }
+
+  for (k = 0; k < 3; k++) {
+    if ((clip[0][k] < -clip[0][3] && clip[1][k] < -clip[1][3] &&
+         clip[2][k] < -clip[2][3]) ||
+        (clip[0][k] > clip[0][3] && clip[1][k] > clip[1][3] &&
+         clip[2][k] > clip[2][3])) {
+      return GLUS_TRUE;
+    }
+  }
+
+  return GLUS_FALSE;
+}
+
+static GLUSvoid glusBenchmarkShape(const GLUSchar *name, GLUSshape *shape) {
+  GLUSmeshlet *meshlets;
+
+  GLUSuint numberMeshlets;
+
+  GLUSuint *visibleMeshlets;
+
+  GLUSubyte *visible;
+
+  GLUSfloat center[4];
+  GLUSfloat radius;
+
+  double buildTime;
+  double cullTime = 0.0;
+
+  double numberTriangles = 0.0;
+  double numberRejected = 0.0;
+
+  GLUSuint numberWrong = 0;
+
+  GLUSuint i, k;
+
+  GLUSint view, run;
+
+  buildTime = glusBenchmarkGetTime();
+
+  if (!glusShapeOptimizeVertexCachef(shape, GLUS_BENCHMARK_CACHE_SIZE) ||
+      !glusShapeCreateMeshletsf(&meshlets, &numberMeshlets, shape,
+                                GLUS_BENCHMARK_MAX_VERTICES,
+                                GLUS_BENCHMARK_MAX_TRIANGLES)) {
+    printf("%s: Could not create meshlets.\n", name);
+
+    return;
+  }
+
+  buildTime = glusBenchmarkGetTime() - buildTime;
+
+  visibleMeshlets =
+      (GLUSuint *)glusMemoryMalloc(numberMeshlets * sizeof(GLUSuint));
+  visible = (GLUSubyte *)glusMemoryMalloc(numberMeshlets * sizeof(GLUSubyte));
+
+  if (!visibleMeshlets || !visible) {
+    printf("%s: Could not allocate memory.\n", name);
+
+    glusMemoryFree(visibleMeshlets);
+    glusMemoryFree(visible);
+
+    glusMeshletDestroyf(meshlets);
+
+    return;
+  }
+
+  glusBenchmarkGetBounds(center, &radius, meshlets, numberMeshlets);
+
+  for (view = 0; view < GLUS_BENCHMARK_VIEWS; view++) {
+    GLUSfloat viewProjectionMatrix[16];
+    GLUSfloat eye[4];
+
+    GLUSuint numberVisible = 0;
+
+    double bestTime = -1.0;
+
+    glusBenchmarkGetView(viewProjectionMatrix, eye, view, center, radius);
+
+    for (run = 0; run < GLUS_BENCHMARK_RUNS; run++) {
+      double time = glusBenchmarkGetTime();
+
+      numberVisible = glusMeshletCullf(visibleMeshlets, meshlets,
+                                       numberMeshlets, viewProjectionMatrix,
+                                       eye);
+
+      time = glusBenchmarkGetTime() - time;
+
+      if (bestTime < 0.0 || time < bestTime) {
+        bestTime = time;
+      }
+    }
+
+    cullTime += bestTime;
+
+    memset(visible, 0, numberMeshlets * sizeof(GLUSubyte));
+
+    for (i = 0; i < numberVisible; i++) {
+      visible[visibleMeshlets[i]] = GLUS_TRUE;
+    }
+
+    for (i = 0; i < numberMeshlets; i++) {
+      numberTriangles += meshlets[i].numberIndices / 3;
+
+      if (visible[i]) {
+        continue;
+      }
+
+      numberRejected += meshlets[i].numberIndices / 3;
+
+      for (k = 0; k < meshlets[i].numberIndices; k += 3) {
+        if (!glusBenchmarkIsCulled(
+                shape, &shape->indices[meshlets[i].firstIndex + k],
+                viewProjectionMatrix, eye)) {
+          numberWrong++;
+        }
+      }
+    }
+  }
+
+  printf("%s: %u triangles, %u meshlets, built in %.1f ms\n", name,
+         shape->numberIndices / 3, numberMeshlets, buildTime * 1000.0);
+  printf("  %.3f ms per cull, %.1f%% of triangles rejected, %.0f triangles "
+         "rejected per ms, %s\n",
+         cullTime * 1000.0 / GLUS_BENCHMARK_VIEWS,
+         numberTriangles > 0.0 ? 100.0 * numberRejected / numberTriangles : 0.0,
+         cullTime > 0.0 ? numberRejected / (cullTime * 1000.0) : 0.0,
+         numberWrong == 0 ? "conservative" : "VISIBLE TRIANGLES CULLED");
+
+  glusMemoryFree(visibleMeshlets);
+  glusMemoryFree(visible);
+
+  glusMeshletDestroyf(meshlets);
+}
+
+int main(int argc, char *argv[]) {
+  GLUSwavefrontoptions options;
+
+  GLUSshape shape;
+
+  GLUSint i;
+
+  if (glusShapeCreateTorusf(&shape, 0.5f, 1.0f, 700, 700)) {
+    glusBenchmarkShape("Torus", &shape);
+
+    glusShapeDestroyf(&shape);
+  }
+
+  // Triangles are grouped over shared vertices, so the files are loaded
+  // indexed and welded by position.
+  glusWavefrontInitOptions(&options);
+
+  options.indexed = GLUS_TRUE;
+
+  for (i = 1; i < argc; i++) {
+    if (!glusShapeLoadWavefrontWithOptions(argv[i], &shape, &options)) {
+      printf("%s: Could not load file.\n", argv[i]);
+
+      continue;
+    }
+
+    if (glusShapeWeldf(&shape, 0.0f, 0, 0.0f)) {
+      glusBenchmarkShape(argv[i], &shape);
+    } else {
+      printf("%s: Could not weld shape.\n", argv[i]);
+    }
+
+    glusShapeDestroyf(&shape);
+  }
+
+  return 0;
+}
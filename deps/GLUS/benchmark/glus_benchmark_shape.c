@@ -0,0 +1,510 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures the round shape generators across slice counts. Every call creates
+// and destroys a shape, so the time includes the allocations. Sphere and torus
+// are compared with the previous generators, which called sinf and cosf and
+// built a quaternion for every vertex. The largest difference of all
+// attributes is printed, the indices have to be identical.
+
+#include "glus_benchmark.h"
+
+// The largest size stays below the index limit of the torus and the cone.
+#define GLUS_BENCHMARK_SIZES 4
+
+// Enough calls per run, so small shapes are measured above the timer
+// resolution.
+#define GLUS_BENCHMARK_VERTICES_PER_RUN 4000000
+
+typedef GLUSboolean (*GLUSbenchmarkcreate)(GLUSshape *shape,
+                                           GLUSuint numberSlices);
+
+static GLUSvoid glusBenchmarkInitf(GLUSshape *shape) {
+  memset(shape, 0, sizeof(GLUSshape));
+
+  shape->mode = GLUS_TRIANGLES;
+}
+
+static GLUSboolean glusBenchmarkCheckf(GLUSshape *shape) {
+  return shape->vertices && shape->normals && shape->tangents &&
+         shape->texCoords && shape->indices;
+}
+
+static GLUSboolean glusBenchmarkFinalizef(GLUSshape *shape) {
+  GLUSuint i;
+
+  // vertex, normal, tangent, bitangent, texCoords
+  GLUSuint stride = 4 + 3 + 3 + 3 + 2;
+
+  // Add bitangents
+  shape->bitangents = (GLUSfloat *)glusMemoryMalloc(3 * shape->numberVertices *
+                                                    sizeof(GLUSfloat));
+
+  if (!shape->bitangents) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    glusVector3Crossf(&(shape->bitangents[i * 3]), &(shape->normals[i * 3]),
+                      &(shape->tangents[i * 3]));
+  }
+
+  shape->allAttributes = (GLUSfloat *)glusMemoryMalloc(
+      stride * shape->numberVertices * sizeof(GLUSfloat));
+
+  if (!shape->allAttributes) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    shape->allAttributes[i * stride + 0] = shape->vertices[i * 4 + 0];
+    shape->allAttributes[i * stride + 1] = shape->vertices[i * 4 + 1];
+    shape->allAttributes[i * stride + 2] = shape->vertices[i * 4 + 2];
+    shape->allAttributes[i * stride + 3] = shape->vertices[i * 4 + 3];
+
+    shape->allAttributes[i * stride + 4] = shape->normals[i * 3 + 0];
+    shape->allAttributes[i * stride + 5] = shape->normals[i * 3 + 1];
+    shape->allAttributes[i * stride + 6] = shape->normals[i * 3 + 2];
+
+    shape->allAttributes[i * stride + 7] = shape->tangents[i * 3 + 0];
+    shape->allAttributes[i * stride + 8] = shape->tangents[i * 3 + 1];
+    shape->allAttributes[i * stride + 9] = shape->tangents[i * 3 + 2];
+
+    shape->allAttributes[i * stride + 10] = shape->bitangents[i * 3 + 0];
+    shape->allAttributes[i * stride + 11] = shape->bitangents[i * 3 + 1];
+    shape->allAttributes[i * stride + 12] = shape->bitangents[i * 3 + 2];
+
+    shape->allAttributes[i * stride + 13] = shape->texCoords[i * 2 + 0];
+    shape->allAttributes[i * stride + 14] = shape->texCoords[i * 2 + 1];
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusBenchmarkAllocatef(GLUSshape *shape,
+                                          GLUSuint numberVertices,
+                                          GLUSuint numberIndices) {
+  glusBenchmarkInitf(shape);
+
+  shape->numberVertices = numberVertices;
+  shape->numberIndices = numberIndices;
+
+  shape->vertices =
+      (GLUSfloat *)glusMemoryMalloc(4 * numberVertices * sizeof(GLUSfloat));
+  shape->normals =
+      (GLUSfloat *)glusMemoryMalloc(3 * numberVertices * sizeof(GLUSfloat));
+  shape->tangents =
+      (GLUSfloat *)glusMemoryMalloc(3 * numberVertices * sizeof(GLUSfloat));
+  shape->texCoords =
+      (GLUSfloat *)glusMemoryMalloc(2 * numberVertices * sizeof(GLUSfloat));
+  shape->indices =
+      (GLUSindex *)glusMemoryMalloc(numberIndices * sizeof(GLUSindex));
+
+  if (!glusBenchmarkCheckf(shape)) {
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  return GLUS_TRUE;
+}
+
+// The previous sphere generator.
+static GLUSboolean glusBenchmarkCreateSpherePreviousf(GLUSshape *shape,
+                                                      GLUSuint numberSlices) {
+  GLUSuint i, j;
+
+  GLUSfloat radius = 1.0f;
+
+  GLUSuint numberParallels = numberSlices / 2;
+  GLUSuint numberVertices = (numberParallels + 1) * (numberSlices + 1);
+  GLUSuint numberIndices = numberParallels * numberSlices * 6;
+
+  GLUSfloat angleStep = (2.0f * GLUS_PI) / ((GLUSfloat)numberSlices);
+
+  GLUSuint indexIndices;
+
+  // used later to help us calculating tangents vectors
+  GLUSfloat helpVector[3] = {1.0f, 0.0f, 0.0f};
+  GLUSfloat helpQuaternion[4];
+  GLUSfloat helpMatrix[16];
+
+  if (numberSlices < 3 || numberVertices > GLUS_MAX_VERTICES ||
+      numberIndices > GLUS_MAX_INDICES) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusBenchmarkAllocatef(shape, numberVertices, numberIndices)) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < numberParallels + 1; i++) {
+    for (j = 0; j < numberSlices + 1; j++) {
+      GLUSuint vertexIndex = (i * (numberSlices + 1) + j) * 4;
+      GLUSuint normalIndex = (i * (numberSlices + 1) + j) * 3;
+      GLUSuint tangentIndex = (i * (numberSlices + 1) + j) * 3;
+      GLUSuint texCoordsIndex = (i * (numberSlices + 1) + j) * 2;
+
+      shape->vertices[vertexIndex + 0] = radius *
+                                         sinf(angleStep * (GLUSfloat)i) *
+                                         sinf(angleStep * (GLUSfloat)j);
+      shape->vertices[vertexIndex + 1] =
+          radius * cosf(angleStep * (GLUSfloat)i);
+      shape->vertices[vertexIndex + 2] = radius *
+                                         sinf(angleStep * (GLUSfloat)i) *
+                                         cosf(angleStep * (GLUSfloat)j);
+      shape->vertices[vertexIndex + 3] = 1.0f;
+
+      shape->normals[normalIndex + 0] =
+          shape->vertices[vertexIndex + 0] / radius;
+      shape->normals[normalIndex + 1] =
+          shape->vertices[vertexIndex + 1] / radius;
+      shape->normals[normalIndex + 2] =
+          shape->vertices[vertexIndex + 2] / radius;
+
+      shape->texCoords[texCoordsIndex + 0] =
+          (GLUSfloat)j / (GLUSfloat)numberSlices;
+      shape->texCoords[texCoordsIndex + 1] =
+          1.0f - (GLUSfloat)i / (GLUSfloat)numberParallels;
+
+      // use quaternion to get the tangent vector
+      glusQuaternionRotateRyf(helpQuaternion,
+                              360.0f * shape->texCoords[texCoordsIndex + 0]);
+      glusQuaternionGetMatrix4x4f(helpMatrix, helpQuaternion);
+
+      glusMatrix4x4MultiplyVector3f(&shape->tangents[tangentIndex], helpMatrix,
+                                    helpVector);
+    }
+  }
+
+  indexIndices = 0;
+  for (i = 0; i < numberParallels; i++) {
+    for (j = 0; j < numberSlices; j++) {
+      shape->indices[indexIndices++] = i * (numberSlices + 1) + j;
+      shape->indices[indexIndices++] = (i + 1) * (numberSlices + 1) + j;
+      shape->indices[indexIndices++] = (i + 1) * (numberSlices + 1) + (j + 1);
+
+      shape->indices[indexIndices++] = i * (numberSlices + 1) + j;
+      shape->indices[indexIndices++] = (i + 1) * (numberSlices + 1) + (j + 1);
+      shape->indices[indexIndices++] = i * (numberSlices + 1) + (j + 1);
+    }
+  }
+
+  if (!glusBenchmarkFinalizef(shape)) {
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  return GLUS_TRUE;
+}
+
+// The previous torus generator, which accumulated s and t.
+static GLUSboolean glusBenchmarkCreateTorusPreviousf(GLUSshape *shape,
+                                                     GLUSuint numberSlices) {
+  GLUSfloat innerRadius = 0.5f;
+  GLUSfloat outerRadius = 1.0f;
+
+  GLUSuint numberStacks = numberSlices;
+
+  GLUSfloat s = 0;
+  GLUSfloat t = 0;
+
+  GLUSfloat sIncr;
+  GLUSfloat tIncr;
+
+  GLUSfloat cos2PIs, sin2PIs, cos2PIt, sin2PIt;
+
+  GLUSuint numberVertices;
+  GLUSuint numberIndices;
+
+  GLUSfloat helpVector[3] = {0.0f, 1.0f, 0.0f};
+  GLUSfloat helpQuaternion[4];
+  GLUSfloat helpMatrix[16];
+
+  GLUSuint indexVertices, indexIndices, indexNormals, indexTangents,
+      indexTexCoords;
+
+  GLUSuint sideCount, faceCount;
+
+  GLUSuint v0, v1, v2, v3;
+
+  GLUSfloat torusRadius = (outerRadius - innerRadius) / 2.0f;
+  GLUSfloat centerRadius = outerRadius - torusRadius;
+
+  numberVertices = (numberStacks + 1) * (numberSlices + 1);
+  numberIndices = numberStacks * numberSlices * 2 * 3;
+
+  if (numberSlices < 3 || numberStacks < 3 ||
+      numberVertices > GLUS_MAX_VERTICES || numberIndices > GLUS_MAX_INDICES) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusBenchmarkAllocatef(shape, numberVertices, numberIndices)) {
+    return GLUS_FALSE;
+  }
+
+  sIncr = 1.0f / (GLUSfloat)numberSlices;
+  tIncr = 1.0f / (GLUSfloat)numberStacks;
+
+  for (sideCount = 0; sideCount <= numberSlices; ++sideCount, s += sIncr) {
+    cos2PIs = (GLUSfloat)cosf(2.0f * GLUS_PI * s);
+    sin2PIs = (GLUSfloat)sinf(2.0f * GLUS_PI * s);
+
+    t = 0.0f;
+    for (faceCount = 0; faceCount <= numberStacks; ++faceCount, t += tIncr) {
+      cos2PIt = (GLUSfloat)cosf(2.0f * GLUS_PI * t);
+      sin2PIt = (GLUSfloat)sinf(2.0f * GLUS_PI * t);
+
+      indexVertices = ((sideCount * (numberStacks + 1)) + faceCount) * 4;
+      shape->vertices[indexVertices + 0] =
+          (centerRadius + torusRadius * cos2PIt) * cos2PIs;
+      shape->vertices[indexVertices + 1] =
+          (centerRadius + torusRadius * cos2PIt) * sin2PIs;
+      shape->vertices[indexVertices + 2] = torusRadius * sin2PIt;
+      shape->vertices[indexVertices + 3] = 1.0f;
+
+      indexNormals = ((sideCount * (numberStacks + 1)) + faceCount) * 3;
+      shape->normals[indexNormals + 0] = cos2PIs * cos2PIt;
+      shape->normals[indexNormals + 1] = sin2PIs * cos2PIt;
+      shape->normals[indexNormals + 2] = sin2PIt;
+
+      indexTexCoords = ((sideCount * (numberStacks + 1)) + faceCount) * 2;
+      shape->texCoords[indexTexCoords + 0] = s;
+      shape->texCoords[indexTexCoords + 1] = t;
+
+      // use quaternion to get the tangent vector
+      glusQuaternionRotateRzf(helpQuaternion, 360.0f * s);
+      glusQuaternionGetMatrix4x4f(helpMatrix, helpQuaternion);
+
+      indexTangents = ((sideCount * (numberStacks + 1)) + faceCount) * 3;
+
+      glusMatrix4x4MultiplyVector3f(&shape->tangents[indexTangents], helpMatrix,
+                                    helpVector);
+    }
+  }
+
+  indexIndices = 0;
+  for (sideCount = 0; sideCount < numberSlices; ++sideCount) {
+    for (faceCount = 0; faceCount < numberStacks; ++faceCount) {
+      v0 = ((sideCount * (numberStacks + 1)) + faceCount);
+      v1 = (((sideCount + 1) * (numberStacks + 1)) + faceCount);
+      v2 = (((sideCount + 1) * (numberStacks + 1)) + (faceCount + 1));
+      v3 = ((sideCount * (numberStacks + 1)) + (faceCount + 1));
+
+      shape->indices[indexIndices++] = v0;
+      shape->indices[indexIndices++] = v1;
+      shape->indices[indexIndices++] = v2;
+
+      shape->indices[indexIndices++] = v0;
+      shape->indices[indexIndices++] = v2;
+      shape->indices[indexIndices++] = v3;
+    }
+  }
+
+  if (!glusBenchmarkFinalizef(shape)) {
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusBenchmarkCreateSpheref(GLUSshape *shape,
+                                              GLUSuint numberSlices) {
+  return glusShapeCreateSpheref(shape, 1.0f, numberSlices);
+}
+
+static GLUSboolean glusBenchmarkCreateDomef(GLUSshape *shape,
+                                            GLUSuint numberSlices) {
+  return glusShapeCreateDomef(shape, 1.0f, numberSlices);
+}
+
+static GLUSboolean glusBenchmarkCreateTorusf(GLUSshape *shape,
+                                             GLUSuint numberSlices) {
+  return glusShapeCreateTorusf(shape, 0.5f, 1.0f, numberSlices, numberSlices);
+}
+
+static GLUSboolean glusBenchmarkCreateCylinderf(GLUSshape *shape,
+                                                GLUSuint numberSlices) {
+  return glusShapeCreateCylinderf(shape, 1.0f, 1.0f, numberSlices);
+}
+
+static GLUSboolean glusBenchmarkCreateConef(GLUSshape *shape,
+                                            GLUSuint numberSlices) {
+  return glusShapeCreateConef(shape, 1.0f, 1.0f, numberSlices, numberSlices);
+}
+
+static GLUSboolean glusBenchmarkCreateDiscf(GLUSshape *shape,
+                                            GLUSuint numberSlices) {
+  return glusShapeCreateDiscf(shape, 1.0f, numberSlices);
+}
+
+// Creates and destroys the shape several times and returns the fastest mean
+// time per call or a negative value, if creation failed.
+static double glusBenchmarkMeasure(GLUSbenchmarkcreate create,
+                                   GLUSuint numberSlices,
+                                   GLUSuint numberCalls) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  GLUSuint k;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime = glusBenchmarkGetTime();
+
+    double time;
+
+    for (k = 0; k < numberCalls; k++) {
+      GLUSshape shape;
+
+      if (!create(&shape, numberSlices)) {
+        return -1.0;
+      }
+
+      glusShapeDestroyf(&shape);
+    }
+
+    time = (glusBenchmarkGetTime() - startTime) / (double)numberCalls;
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSfloat glusBenchmarkGetDifference(const GLUSfloat *array0,
+                                            const GLUSfloat *array1,
+                                            GLUSuint numberElements) {
+  GLUSfloat difference = 0.0f;
+
+  GLUSuint i;
+
+  for (i = 0; i < numberElements; i++) {
+    GLUSfloat current = fabsf(array0[i] - array1[i]);
+
+    if (current > difference) {
+      difference = current;
+    }
+  }
+
+  return difference;
+}
+
+// Prints the largest difference of all attributes and whether the indices
+// are identical.
+static GLUSvoid glusBenchmarkCompare(GLUSbenchmarkcreate previousCreate,
+                                     GLUSbenchmarkcreate create,
+                                     GLUSuint numberSlices) {
+  GLUSshape previousShape;
+  GLUSshape shape;
+
+  GLUSfloat difference;
+
+  if (!previousCreate(&previousShape, numberSlices)) {
+    return;
+  }
+
+  if (!create(&shape, numberSlices)) {
+    glusShapeDestroyf(&previousShape);
+
+    return;
+  }
+
+  if (previousShape.numberVertices != shape.numberVertices ||
+      previousShape.numberIndices != shape.numberIndices) {
+    printf("    DIFFERENT sizes\n");
+  } else {
+    difference = glusBenchmarkGetDifference(
+        previousShape.allAttributes, shape.allAttributes,
+        (4 + 3 + 3 + 3 + 2) * shape.numberVertices);
+
+    printf("    largest difference %.1e, indices %s\n", difference,
+           memcmp(previousShape.indices, shape.indices,
+                  shape.numberIndices * sizeof(GLUSindex)) == 0
+               ? "identical"
+               : "DIFFERENT");
+  }
+
+  glusShapeDestroyf(&previousShape);
+  glusShapeDestroyf(&shape);
+}
+
+static GLUSvoid glusBenchmarkGenerator(const GLUSchar *name,
+                                       GLUSbenchmarkcreate previousCreate,
+                                       GLUSbenchmarkcreate create) {
+  const GLUSuint numberSlices[GLUS_BENCHMARK_SIZES] = {16, 64, 256, 700};
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_SIZES; i++) {
+    GLUSuint numberCalls =
+        GLUS_BENCHMARK_VERTICES_PER_RUN / (numberSlices[i] * numberSlices[i]) +
+        1;
+
+    double previousTime = -1.0;
+    double time;
+
+    time = glusBenchmarkMeasure(create, numberSlices[i], numberCalls);
+
+    if (time < 0.0) {
+      printf("%s %u: Could not create shape.\n", name, numberSlices[i]);
+
+      continue;
+    }
+
+    if (!previousCreate) {
+      printf("%s %u: %.1f us\n", name, numberSlices[i], time * 1000000.0);
+
+      continue;
+    }
+
+    previousTime =
+        glusBenchmarkMeasure(previousCreate, numberSlices[i], numberCalls);
+
+    if (previousTime < 0.0) {
+      printf("%s %u: Could not create previous shape.\n", name,
+             numberSlices[i]);
+
+      continue;
+    }
+
+    printf("%s %u: previous %.1f us, tables %.1f us, speedup %.2f\n", name,
+           numberSlices[i], previousTime * 1000000.0, time * 1000000.0,
+           time > 0.0 ? previousTime / time : 0.0);
+
+    glusBenchmarkCompare(previousCreate, create, numberSlices[i]);
+  }
+}
+
+int main(void) {
+  glusBenchmarkGenerator("Sphere", glusBenchmarkCreateSpherePreviousf,
+                         glusBenchmarkCreateSpheref);
+  glusBenchmarkGenerator("Torus", glusBenchmarkCreateTorusPreviousf,
+                         glusBenchmarkCreateTorusf);
+  glusBenchmarkGenerator("Dome", 0, glusBenchmarkCreateDomef);
+  glusBenchmarkGenerator("Cylinder", 0, glusBenchmarkCreateCylinderf);
+  glusBenchmarkGenerator("Cone", 0, glusBenchmarkCreateConef);
+  glusBenchmarkGenerator("Disc", 0, glusBenchmarkCreateDiscf);
+
+  return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures glusShapeCalculateTangentBitangentf() with one thread and with all
+// processors. A sphere and a torus are always measured, wavefront files can be
+// passed as arguments, e.g. the dragon and venus models:
+//
+// glus_benchmark_tangent dragon.obj venusm.obj
+
+#include "glus_benchmark.h"
+
+// Projects the positions onto the xy plane, so a model without texture
+// coordinates still has a tangent space. The absolute x mirrors the texture
+// coordinates, so both handednesses are calculated.
+static GLUSboolean glusBenchmarkCreateTexCoords(GLUSshape *shape) {
+  GLUSuint i;
+
+  if (shape->texCoords) {
+    return GLUS_TRUE;
+  }
+
+  shape->texCoords = (GLUSfloat *)glusMemoryMalloc(2 * shape->numberVertices *
+                                                   sizeof(GLUSfloat));
+
+  if (!shape->texCoords) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    shape->texCoords[2 * i] = fabsf(shape->vertices[4 * i]);
+    shape->texCoords[2 * i + 1] = shape->vertices[4 * i + 1];
+  }
+
+  return GLUS_TRUE;
+}
+
+static double glusBenchmarkMeasure(GLUSshape *shape, GLUSint numberThreads) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  glusBenchmarkSetNumberThreads(numberThreads);
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime = glusBenchmarkGetTime();
+
+    double time;
+
+    if (!glusShapeCalculateTangentBitangentf(shape)) {
+      return -1.0;
+    }
+
+    time = glusBenchmarkGetTime() - startTime;
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkShape(const GLUSchar *name, GLUSshape *shape) {
+  GLUSint numberThreads = glusBenchmarkGetNumberProcessors();
+
+  double singleTime;
+  double parallelTime;
+
+  if (!glusBenchmarkCreateTexCoords(shape)) {
+    printf("%s: Could not create texture coordinates.\n", name);
+
+    return;
+  }
+
+  singleTime = glusBenchmarkMeasure(shape, 1);
+  parallelTime = glusBenchmarkMeasure(shape, numberThreads);
+
+  if (singleTime < 0.0 || parallelTime < 0.0) {
+    printf("%s: Could not calculate tangents.\n", name);
+
+    return;
+  }
+
+  printf("%s: %u vertices, %u indices: 1 thread %.2f ms, %d threads %.2f ms, "
+         "speedup %.2f\n",
+         name, shape->numberVertices, shape->numberIndices,
+         singleTime * 1000.0, numberThreads, parallelTime * 1000.0,
+         parallelTime > 0.0 ? singleTime / parallelTime : 0.0);
+}
+
+int main(int argc, char *argv[]) {
+  GLUSwavefrontoptions options;
+
+  GLUSshape shape;
+
+  GLUSint i;
+
+  if (glusShapeCreateSpheref(&shape, 1.0f, 1024)) {
+    glusBenchmarkShape("Sphere", &shape);
+
+    glusShapeDestroyf(&shape);
+  }
+
+  if (glusShapeCreateTorusf(&shape, 0.5f, 1.0f, 700, 700)) {
+    glusBenchmarkShape("Torus", &shape);
+
+    glusShapeDestroyf(&shape);
+  }
+
+  // Indexed, so vertices are shared between triangles like in the shapes.
+  glusWavefrontInitOptions(&options);
+
+  options.indexed = GLUS_TRUE;
+
+  for (i = 1; i < argc; i++) {
+    if (!glusShapeLoadWavefrontWithOptions(argv[i], &shape, &options)) {
+      printf("%s: Could not load file.\n", argv[i]);
+
+      continue;
+    }
+
+    glusBenchmarkShape(argv[i], &shape);
+
+    glusShapeDestroyf(&shape);
+  }
+
+  return 0;
+}
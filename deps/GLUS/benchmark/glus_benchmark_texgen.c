@@ -0,0 +1,255 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures the texture coordinate generation in vertices per second on tori
+// of growing size. The previous loops, the current functions and the buffer
+// variants are run with one thread and with all processors. Every result is
+// compared byte by byte with the previous loop. The current kernel is only
+// vectorized from -O3 on, e.g. with CMAKE_BUILD_TYPE=Release.
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_SIZES 4
+
+// Enough calls per run, so small shapes are measured above the timer
+// resolution.
+#define GLUS_BENCHMARK_VERTICES_PER_RUN 4000000
+
+#define GLUS_BENCHMARK_VARIANTS 6
+
+#define GLUS_BENCHMARK_S_SIZE_X 0.5f
+#define GLUS_BENCHMARK_S_SIZE_Z 0.25f
+#define GLUS_BENCHMARK_T_SIZE_Y 0.5f
+#define GLUS_BENCHMARK_T_SIZE_Z -0.25f
+#define GLUS_BENCHMARK_S_OFFSET 0.5f
+#define GLUS_BENCHMARK_T_OFFSET 0.5f
+
+static const GLUSfloat g_sPlane[4] = {0.6f, 0.0f, 0.8f, 0.1f};
+static const GLUSfloat g_tPlane[4] = {0.0f, 0.8f, -0.6f, -0.2f};
+
+static const GLUSchar *g_variantNames[GLUS_BENCHMARK_VARIANTS] = {
+    "axes previous",   "axes",   "axes buffer",
+    "planes previous", "planes", "planes buffer"};
+
+// The previous axes generation, which reallocated the texture coordinates.
+static GLUSboolean glusBenchmarkTexGenByAxesPreviousf(
+    GLUSshape *shape, const GLUSfloat sSizeX, const GLUSfloat sSizeZ,
+    const GLUSfloat tSizeY, const GLUSfloat tSizeZ, const GLUSfloat sOffset,
+    const GLUSfloat tOffset) {
+  GLUSuint i;
+
+  glusMemoryFree(shape->texCoords);
+
+  shape->texCoords = (GLUSfloat *)glusMemoryMalloc(2 * shape->numberVertices *
+                                                   sizeof(GLUSfloat));
+
+  if (!shape->texCoords) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    shape->texCoords[2 * i + 0] = shape->vertices[4 * i + 0] * sSizeX +
+                                  shape->vertices[4 * i + 2] * sSizeZ + sOffset;
+    shape->texCoords[2 * i + 1] = shape->vertices[4 * i + 1] * tSizeY +
+                                  shape->vertices[4 * i + 2] * tSizeZ + tOffset;
+  }
+
+  return GLUS_TRUE;
+}
+
+// The previous planes generation, which called glusPlaneDistancePoint4f().
+static GLUSboolean glusBenchmarkTexGenByPlanesPreviousf(
+    GLUSshape *shape, const GLUSfloat sPlane[4], const GLUSfloat tPlane[4],
+    const float sSize, const float tSize, const float sOffset,
+    const float tOffset) {
+  GLUSuint i;
+
+  glusMemoryFree(shape->texCoords);
+
+  shape->texCoords = (GLUSfloat *)glusMemoryMalloc(2 * shape->numberVertices *
+                                                   sizeof(GLUSfloat));
+
+  if (!shape->texCoords) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    shape->texCoords[2 * i + 0] =
+        glusPlaneDistancePoint4f(sPlane, &shape->vertices[4 * i]) * sSize +
+        sOffset;
+    shape->texCoords[2 * i + 1] =
+        glusPlaneDistancePoint4f(tPlane, &shape->vertices[4 * i]) * tSize +
+        tOffset;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Runs one variant. The buffer variants write into the given buffer, all
+// others into the texture coordinates of the shape.
+static GLUSboolean glusBenchmarkTexGen(GLUSint variant, GLUSshape *shape,
+                                       GLUSfloat *buffer) {
+  switch (variant) {
+  case 0:
+    return glusBenchmarkTexGenByAxesPreviousf(
+        shape, GLUS_BENCHMARK_S_SIZE_X, GLUS_BENCHMARK_S_SIZE_Z,
+        GLUS_BENCHMARK_T_SIZE_Y, GLUS_BENCHMARK_T_SIZE_Z,
+        GLUS_BENCHMARK_S_OFFSET, GLUS_BENCHMARK_T_OFFSET);
+  case 1:
+    return glusShapeTexGenByAxesf(
+        shape, GLUS_BENCHMARK_S_SIZE_X, GLUS_BENCHMARK_S_SIZE_Z,
+        GLUS_BENCHMARK_T_SIZE_Y, GLUS_BENCHMARK_T_SIZE_Z,
+        GLUS_BENCHMARK_S_OFFSET, GLUS_BENCHMARK_T_OFFSET);
+  case 2:
+    return glusShapeTexGenByAxesToBufferf(
+        buffer, shape, GLUS_BENCHMARK_S_SIZE_X, GLUS_BENCHMARK_S_SIZE_Z,
+        GLUS_BENCHMARK_T_SIZE_Y, GLUS_BENCHMARK_T_SIZE_Z,
+        GLUS_BENCHMARK_S_OFFSET, GLUS_BENCHMARK_T_OFFSET);
+  case 3:
+    return glusBenchmarkTexGenByPlanesPreviousf(
+        shape, g_sPlane, g_tPlane, 2.0f, 2.0f, GLUS_BENCHMARK_S_OFFSET,
+        GLUS_BENCHMARK_T_OFFSET);
+  case 4:
+    return glusShapeTexGenByPlanesf(shape, g_sPlane, g_tPlane, 2.0f, 2.0f,
+                                    GLUS_BENCHMARK_S_OFFSET,
+                                    GLUS_BENCHMARK_T_OFFSET);
+  case 5:
+    return glusShapeTexGenByPlanesToBufferf(
+        buffer, shape, g_sPlane, g_tPlane, 2.0f, 2.0f, GLUS_BENCHMARK_S_OFFSET,
+        GLUS_BENCHMARK_T_OFFSET);
+  }
+
+  return GLUS_FALSE;
+}
+
+// Runs the variant several times and returns the fastest time per call or a
+// negative value, if the generation failed.
+static double glusBenchmarkMeasure(GLUSint variant, GLUSshape *shape,
+                                   GLUSfloat *buffer, GLUSuint numberCalls) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  GLUSuint k;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime = glusBenchmarkGetTime();
+
+    double time;
+
+    for (k = 0; k < numberCalls; k++) {
+      if (!glusBenchmarkTexGen(variant, shape, buffer)) {
+        return -1.0;
+      }
+    }
+
+    time = (glusBenchmarkGetTime() - startTime) / (double)numberCalls;
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkShape(GLUSshape *shape) {
+  GLUSint numberProcessors = glusBenchmarkGetNumberProcessors();
+
+  GLUSuint numberCalls =
+      GLUS_BENCHMARK_VERTICES_PER_RUN / shape->numberVertices + 1;
+
+  size_t size = 2 * shape->numberVertices * sizeof(GLUSfloat);
+
+  GLUSfloat *buffer;
+  GLUSfloat *previous;
+
+  GLUSint variant;
+
+  buffer = (GLUSfloat *)glusMemoryMalloc(size);
+  previous = (GLUSfloat *)glusMemoryMalloc(size);
+
+  if (!buffer || !previous) {
+    printf("Could not allocate memory.\n");
+
+    glusMemoryFree(buffer);
+    glusMemoryFree(previous);
+
+    return;
+  }
+
+  printf("Torus with %u vertices:\n", shape->numberVertices);
+
+  for (variant = 0; variant < GLUS_BENCHMARK_VARIANTS; variant++) {
+    const GLUSfloat *result;
+
+    double singleTime;
+    double parallelTime;
+
+    glusBenchmarkSetNumberThreads(1);
+
+    singleTime = glusBenchmarkMeasure(variant, shape, buffer, numberCalls);
+
+    glusBenchmarkSetNumberThreads(numberProcessors);
+
+    parallelTime = glusBenchmarkMeasure(variant, shape, buffer, numberCalls);
+
+    if (singleTime <= 0.0 || parallelTime <= 0.0) {
+      printf("  %s: Could not generate texture coordinates.\n",
+             g_variantNames[variant]);
+
+      continue;
+    }
+
+    result = variant % 3 == 2 ? buffer : shape->texCoords;
+
+    // Every third variant is a previous loop, which is the reference.
+    if (variant % 3 == 0) {
+      memcpy(previous, result, size);
+    }
+
+    printf("  %s: 1 thread %.0f Mvertices/s, %d threads %.0f Mvertices/s, "
+           "%s\n",
+           g_variantNames[variant],
+           shape->numberVertices / singleTime / 1000000.0, numberProcessors,
+           shape->numberVertices / parallelTime / 1000000.0,
+           memcmp(previous, result, size) == 0 ? "identical" : "DIFFERENT");
+  }
+
+  glusMemoryFree(buffer);
+  glusMemoryFree(previous);
+}
+
+int main(void) {
+  const GLUSuint numberSlices[GLUS_BENCHMARK_SIZES] = {64, 128, 256, 700};
+
+  GLUSshape shape;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_SIZES; i++) {
+    if (glusShapeCreateTorusf(&shape, 0.5f, 1.0f, numberSlices[i],
+                              numberSlices[i])) {
+      glusBenchmarkShape(&shape);
+
+      glusShapeDestroyf(&shape);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,656 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the TGA kernels with the previous per-channel loops on a random
+// 4096x2048 image. glusImageConvertTga() is run for all pairs of formats and
+// glusImageToPremultiplyTga() on the RGBA image. The color channel swap is
+// measured through glusImageSaveTga(), which writes two temporary files into
+// the current directory. Throughput is in MB/s of source data and every
+// result is compared byte by byte.
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_WIDTH 4096
+#define GLUS_BENCHMARK_HEIGHT 2048
+
+#define GLUS_BENCHMARK_FORMATS 5
+
+#define GLUS_BENCHMARK_PREVIOUS_FILE "glus_benchmark_previous.tga"
+#define GLUS_BENCHMARK_CURRENT_FILE "glus_benchmark_current.tga"
+
+typedef GLUSboolean (*GLUSbenchmarkconvert)(GLUStgaimage *targetImage,
+                                            const GLUStgaimage *sourceImage,
+                                            GLUSenum targetFormat);
+
+static const GLUSenum g_formats[GLUS_BENCHMARK_FORMATS] = {
+    GLUS_RED, GLUS_ALPHA, GLUS_LUMINANCE, GLUS_RGB, GLUS_RGBA};
+
+static const GLUSchar *g_formatNames[GLUS_BENCHMARK_FORMATS] = {
+    "red", "alpha", "lum", "rgb", "rgba"};
+
+extern GLUSboolean _glusFileCheckWrite(FILE *f, size_t actualWrite,
+                                       size_t expectedWrite);
+
+static GLUSint glusBenchmarkGetNumberChannels(GLUSenum format) {
+  if (format == GLUS_RGB) {
+    return 3;
+  } else if (format == GLUS_RGBA) {
+    return 4;
+  }
+
+  return 1;
+}
+
+// The previous in place swap of the red and blue channels.
+static GLUSvoid glusBenchmarkSwapColorChannelPrevious(GLUSint width,
+                                                      GLUSint height,
+                                                      GLUSenum format,
+                                                      GLUSubyte *data) {
+  GLUSint i;
+  GLUSubyte temp;
+  GLUSint bytesPerPixel = 3;
+
+  if (!data) {
+    return;
+  }
+
+  if (format == GLUS_RGBA) {
+    bytesPerPixel = 4;
+  }
+
+  // swap the R and B values to get RGB since the bitmap color format is in BGR
+  for (i = 0; i < width * height * bytesPerPixel; i += bytesPerPixel) {
+    temp = data[i];
+    data[i] = data[i + 2];
+    data[i + 2] = temp;
+  }
+}
+
+// The previous save, which copied the image and swapped the copy in place,
+// also for 8 bit images.
+static GLUSboolean glusBenchmarkSaveTgaPrevious(const GLUSchar *filename,
+                                                const GLUStgaimage *tgaimage) {
+  FILE *file;
+  GLUSubyte buffer[12];
+  GLUSubyte bitsPerPixel;
+  size_t elementsWritten;
+  GLUSubyte *data;
+
+  file = glusFileOpen(filename, "wb");
+
+  if (!file) {
+    return GLUS_FALSE;
+  }
+
+  switch (tgaimage->format) {
+  case GLUS_ALPHA:
+  case GLUS_RED:
+  case GLUS_LUMINANCE:
+    bitsPerPixel = 8;
+    break;
+  case GLUS_RGB:
+    bitsPerPixel = 24;
+    break;
+  case GLUS_RGBA:
+    bitsPerPixel = 32;
+    break;
+  default:
+    glusFileClose(file);
+    return GLUS_FALSE;
+  }
+
+  if (bitsPerPixel == 8) {
+    buffer[2] = 3;
+  } else {
+    buffer[2] = 2;
+  }
+
+  // TGA header
+  buffer[0] = 0;
+  buffer[1] = 0;
+
+  buffer[3] = 0;
+  buffer[4] = 0;
+  buffer[5] = 0;
+  buffer[6] = 0;
+  buffer[7] = 0;
+  buffer[8] = 0;
+  buffer[9] = 0;
+  buffer[10] = 0;
+  buffer[11] = 0;
+
+  elementsWritten = fwrite(buffer, 1, 12, file);
+
+  if (!_glusFileCheckWrite(file, elementsWritten, 12)) {
+    return GLUS_FALSE;
+  }
+
+  elementsWritten = fwrite(&tgaimage->width, sizeof(tgaimage->width), 1, file);
+
+  if (!_glusFileCheckWrite(file, elementsWritten, 1)) {
+    return GLUS_FALSE;
+  }
+
+  elementsWritten =
+      fwrite(&tgaimage->height, sizeof(tgaimage->height), 1, file);
+
+  if (!_glusFileCheckWrite(file, elementsWritten, 1)) {
+    return GLUS_FALSE;
+  }
+
+  elementsWritten = fwrite(&bitsPerPixel, sizeof(bitsPerPixel), 1, file);
+
+  if (!_glusFileCheckWrite(file, elementsWritten, 1)) {
+    return GLUS_FALSE;
+  }
+
+  buffer[0] = 0;
+
+  elementsWritten = fwrite(buffer, 1, 1, file);
+
+  if (!_glusFileCheckWrite(file, elementsWritten, 1)) {
+    return GLUS_FALSE;
+  }
+
+  data =
+      glusMemoryMalloc(tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+
+  if (!data) {
+    glusFileClose(file);
+
+    return GLUS_FALSE;
+  }
+
+  memcpy(data, tgaimage->data,
+         tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+
+  if (bitsPerPixel >= 24) {
+    glusBenchmarkSwapColorChannelPrevious(tgaimage->width, tgaimage->height,
+                                          tgaimage->format, data);
+  }
+
+  elementsWritten = fwrite(
+      data, 1, tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
+
+  glusMemoryFree(data);
+
+  if (!_glusFileCheckWrite(file, elementsWritten,
+                           tgaimage->width * tgaimage->height * bitsPerPixel /
+                               8)) {
+    return GLUS_FALSE;
+  }
+
+  glusFileClose(file);
+
+  return GLUS_TRUE;
+}
+
+// The previous conversion, which branched on the formats for every pixel.
+// To keep the copy short, the source address is taken once per pixel.
+// Luminance to red is clamped to 255 like in the library. The previous code
+// clamped to 1.0, which was a bug.
+static GLUSboolean glusBenchmarkConvertTgaPrevious(
+    GLUStgaimage *targetImage, const GLUStgaimage *sourceImage,
+    const GLUSenum targetFormat) {
+  GLUSint targetNumberChannels =
+      glusBenchmarkGetNumberChannels(targetFormat);
+  GLUSint sourceNumberChannels =
+      glusBenchmarkGetNumberChannels(sourceImage->format);
+  GLUSint x, y, z, c;
+
+  GLUSubyte channels[4] = {0, 0, 0, 255};
+
+  GLUSfloat toLuminace[3] = {0.299f, 0.587f, 0.114f};
+
+  targetImage->data = (GLUSubyte *)glusMemoryMalloc(
+      targetNumberChannels * sourceImage->width * sourceImage->height *
+      sourceImage->depth * sizeof(GLUSubyte));
+
+  if (!targetImage->data) {
+    return GLUS_FALSE;
+  }
+  targetImage->width = sourceImage->width;
+  targetImage->height = sourceImage->height;
+  targetImage->depth = sourceImage->depth;
+  targetImage->format = targetFormat;
+
+  for (z = 0; z < targetImage->depth; z++) {
+    for (y = 0; y < targetImage->height; y++) {
+      for (x = 0; x < targetImage->width; x++) {
+        const GLUSubyte *source =
+            &sourceImage->data[sourceNumberChannels * z * sourceImage->height *
+                                   sourceImage->width +
+                               sourceNumberChannels * y * sourceImage->width +
+                               sourceNumberChannels * x];
+
+        if (sourceImage->format == GLUS_RED) {
+          if (targetImage->format == GLUS_RED ||
+              targetImage->format == GLUS_RGB ||
+              targetImage->format == GLUS_RGBA) {
+            channels[0] = source[0];
+
+            if (targetImage->format == GLUS_RGB ||
+                targetImage->format == GLUS_RGBA) {
+              channels[1] = 0;
+              channels[2] = 0;
+
+              if (targetImage->format == GLUS_RGBA) {
+                channels[3] = 255;
+              }
+            }
+          } else if (targetImage->format == GLUS_ALPHA) {
+            channels[0] = 255;
+          } else if (targetImage->format == GLUS_LUMINANCE) {
+            channels[0] = source[0] * toLuminace[0];
+          }
+        } else if (sourceImage->format == GLUS_ALPHA) {
+          if (targetImage->format == GLUS_LUMINANCE ||
+              targetImage->format == GLUS_RED ||
+              targetImage->format == GLUS_RGB ||
+              targetImage->format == GLUS_RGBA) {
+            channels[0] = 0;
+
+            if (targetImage->format == GLUS_RGB ||
+                targetImage->format == GLUS_RGBA) {
+              channels[1] = 0;
+              channels[2] = 0;
+
+              if (targetImage->format == GLUS_RGBA) {
+                channels[3] = source[0];
+              }
+            }
+          } else if (targetImage->format == GLUS_ALPHA) {
+            channels[0] = source[0];
+          }
+        } else if (sourceImage->format == GLUS_LUMINANCE) {
+          if (targetImage->format == GLUS_RED) {
+            channels[0] =
+                glusMathClampf(source[0] / toLuminace[0], 0.0f, 255.0f);
+          } else if (targetImage->format == GLUS_RGB ||
+                     targetImage->format == GLUS_RGBA) {
+            channels[0] = source[0];
+            channels[1] = channels[0];
+            channels[2] = channels[0];
+
+            if (targetImage->format == GLUS_RGBA) {
+              channels[3] = 255;
+            }
+          } else if (targetImage->format == GLUS_ALPHA) {
+            channels[0] = 255;
+          } else if (targetImage->format == GLUS_LUMINANCE) {
+            channels[0] = source[0];
+          }
+        }
+        if (sourceImage->format == GLUS_RGB ||
+            sourceImage->format == GLUS_RGBA) {
+          if (targetImage->format == GLUS_RED) {
+            channels[0] = source[0];
+          } else if (targetImage->format == GLUS_ALPHA) {
+            if (sourceImage->format == GLUS_RGB) {
+              channels[0] = 255;
+            } else if (sourceImage->format == GLUS_RGBA) {
+              channels[0] = source[3];
+            }
+          } else if (targetImage->format == GLUS_LUMINANCE) {
+            channels[0] = 0.0f;
+
+            for (c = 0; c < 3; c++) {
+              channels[0] += source[c] * toLuminace[c];
+            }
+          } else if (targetImage->format == GLUS_RGB ||
+                     targetImage->format == GLUS_RGBA) {
+            for (c = 0; c < 3; c++) {
+              channels[c] = source[c];
+            }
+
+            if (targetImage->format == GLUS_RGBA) {
+              if (sourceImage->format == GLUS_RGBA) {
+                channels[3] = source[3];
+              } else {
+                channels[3] = 255;
+              }
+            }
+          }
+        }
+
+        for (c = 0; c < targetNumberChannels; c++) {
+          targetImage->data[targetNumberChannels * z * targetImage->height *
+                                targetImage->width +
+                            targetNumberChannels * y * targetImage->width +
+                            targetNumberChannels * x + c] = channels[c];
+        }
+      }
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+// The previous premultiply in float math. The alpha channel is copied like in
+// the library. The previous code never wrote it, which was a bug.
+static GLUSboolean
+glusBenchmarkToPremultiplyTgaPrevious(GLUStgaimage *targetImage,
+                                      const GLUStgaimage *sourceImage,
+                                      GLUSenum targetFormat) {
+  GLUSint x, y, z, c;
+
+  GLUSfloat alpha;
+  GLUSfloat channel;
+
+  (void)targetFormat;
+
+  targetImage->data = (GLUSubyte *)glusMemoryMalloc(
+      4 * sourceImage->width * sourceImage->height * sourceImage->depth *
+      sizeof(GLUSubyte));
+
+  if (!targetImage->data) {
+    return GLUS_FALSE;
+  }
+  targetImage->width = sourceImage->width;
+  targetImage->height = sourceImage->height;
+  targetImage->depth = sourceImage->depth;
+  targetImage->format = sourceImage->format;
+
+  for (z = 0; z < targetImage->depth; z++) {
+    for (y = 0; y < targetImage->height; y++) {
+      for (x = 0; x < targetImage->width; x++) {
+        GLUSint pixel = 4 * z * targetImage->height * targetImage->width +
+                        4 * y * targetImage->width + 4 * x;
+
+        alpha = (GLUSfloat)sourceImage->data[pixel + 3] / 255.0f;
+
+        for (c = 0; c < 3; c++) {
+          channel = (GLUSfloat)sourceImage->data[pixel + c] / 255.0f;
+
+          targetImage->data[pixel + c] =
+              (GLUSubyte)glusMathClampf(channel * alpha * 255.0f, 0.0f, 255.0f);
+        }
+
+        targetImage->data[pixel + 3] = sourceImage->data[pixel + 3];
+      }
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean
+glusBenchmarkToPremultiplyTga(GLUStgaimage *targetImage,
+                              const GLUStgaimage *sourceImage,
+                              GLUSenum targetFormat) {
+  (void)targetFormat;
+
+  return glusImageToPremultiplyTga(targetImage, sourceImage);
+}
+
+// Runs the conversion several times and returns the fastest time or a
+// negative value, if the conversion failed. The image of the last run is kept.
+static double glusBenchmarkMeasure(GLUSbenchmarkconvert convert,
+                                   GLUStgaimage *targetImage,
+                                   const GLUStgaimage *sourceImage,
+                                   GLUSenum targetFormat) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime;
+    double time;
+
+    GLUSboolean result;
+
+    if (i > 0) {
+      glusImageDestroyTga(targetImage);
+    }
+
+    startTime = glusBenchmarkGetTime();
+
+    result = convert(targetImage, sourceImage, targetFormat);
+
+    time = glusBenchmarkGetTime() - startTime;
+
+    if (!result) {
+      return -1.0;
+    }
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkConvert(const GLUSchar *name,
+                                     GLUSbenchmarkconvert previousConvert,
+                                     GLUSbenchmarkconvert convert,
+                                     const GLUStgaimage *sourceImage,
+                                     GLUSenum targetFormat) {
+  GLUStgaimage previousImage;
+  GLUStgaimage image;
+
+  double megabytes = (double)sourceImage->width * sourceImage->height *
+                     glusBenchmarkGetNumberChannels(sourceImage->format) /
+                     1000000.0;
+
+  double previousTime;
+  double time;
+
+  previousTime = glusBenchmarkMeasure(previousConvert, &previousImage,
+                                      sourceImage, targetFormat);
+
+  if (previousTime < 0.0) {
+    printf("%s: Could not convert image.\n", name);
+
+    return;
+  }
+
+  time = glusBenchmarkMeasure(convert, &image, sourceImage, targetFormat);
+
+  if (time < 0.0) {
+    printf("%s: Could not convert image.\n", name);
+
+    glusImageDestroyTga(&previousImage);
+
+    return;
+  }
+
+  printf("%-14s %6.0f -> %6.0f MB/s, %s\n", name, megabytes / previousTime,
+         megabytes / time,
+         memcmp(previousImage.data, image.data,
+                (size_t)image.width * image.height *
+                    glusBenchmarkGetNumberChannels(image.format)) == 0
+             ? "identical"
+             : "DIFFERENT");
+
+  glusImageDestroyTga(&previousImage);
+  glusImageDestroyTga(&image);
+}
+
+// Reads a whole file, which has to be freed afterwards.
+static GLUSubyte *glusBenchmarkReadFile(const GLUSchar *filename,
+                                        size_t *size) {
+  FILE *file = glusFileOpen(filename, "rb");
+
+  GLUSubyte *data;
+
+  long length;
+
+  if (!file) {
+    return 0;
+  }
+
+  fseek(file, 0, SEEK_END);
+  length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  data = (GLUSubyte *)glusMemoryMalloc(length > 0 ? (size_t)length : 1);
+
+  if (!data || length < 0 ||
+      fread(data, 1, (size_t)length, file) != (size_t)length) {
+    glusMemoryFree(data);
+
+    glusFileClose(file);
+
+    return 0;
+  }
+
+  glusFileClose(file);
+
+  *size = (size_t)length;
+
+  return data;
+}
+
+// Saves the image several times and returns the fastest time or a negative
+// value, if saving failed.
+static double glusBenchmarkMeasureSave(GLUSboolean previous,
+                                       const GLUSchar *filename,
+                                       const GLUStgaimage *image) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime = glusBenchmarkGetTime();
+
+    double time;
+
+    GLUSboolean result;
+
+    if (previous) {
+      result = glusBenchmarkSaveTgaPrevious(filename, image);
+    } else {
+      result = glusImageSaveTga(filename, image);
+    }
+
+    time = glusBenchmarkGetTime() - startTime;
+
+    if (!result) {
+      return -1.0;
+    }
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkSave(const GLUSchar *name,
+                                  const GLUStgaimage *image) {
+  GLUSubyte *previousData;
+  GLUSubyte *data;
+
+  size_t previousSize = 0;
+  size_t size = 0;
+
+  double megabytes = (double)image->width * image->height *
+                     glusBenchmarkGetNumberChannels(image->format) /
+                     1000000.0;
+
+  double previousTime;
+  double time;
+
+  previousTime =
+      glusBenchmarkMeasureSave(GLUS_TRUE, GLUS_BENCHMARK_PREVIOUS_FILE, image);
+  time = glusBenchmarkMeasureSave(GLUS_FALSE, GLUS_BENCHMARK_CURRENT_FILE,
+                                  image);
+
+  if (previousTime < 0.0 || time < 0.0) {
+    printf("%s: Could not save image.\n", name);
+
+    return;
+  }
+
+  previousData =
+      glusBenchmarkReadFile(GLUS_BENCHMARK_PREVIOUS_FILE, &previousSize);
+  data = glusBenchmarkReadFile(GLUS_BENCHMARK_CURRENT_FILE, &size);
+
+  printf("%-14s %6.0f -> %6.0f MB/s, %s\n", name, megabytes / previousTime,
+         megabytes / time,
+         previousData && data && previousSize == size &&
+                 memcmp(previousData, data, size) == 0
+             ? "identical"
+             : "DIFFERENT");
+
+  glusMemoryFree(previousData);
+  glusMemoryFree(data);
+
+  remove(GLUS_BENCHMARK_PREVIOUS_FILE);
+  remove(GLUS_BENCHMARK_CURRENT_FILE);
+}
+
+int main(void) {
+  GLUStgaimage images[GLUS_BENCHMARK_FORMATS];
+
+  GLUSchar name[32];
+
+  GLUSuint random = 12345;
+
+  size_t i, size;
+
+  GLUSint source, target;
+
+  printf("%dx%d image, previous -> current\n", GLUS_BENCHMARK_WIDTH,
+         GLUS_BENCHMARK_HEIGHT);
+
+  for (source = 0; source < GLUS_BENCHMARK_FORMATS; source++) {
+    if (!glusImageCreateTga(&images[source], GLUS_BENCHMARK_WIDTH,
+                            GLUS_BENCHMARK_HEIGHT, 1, g_formats[source])) {
+      printf("Could not create image.\n");
+
+      return 1;
+    }
+
+    size = (size_t)GLUS_BENCHMARK_WIDTH * GLUS_BENCHMARK_HEIGHT *
+           glusBenchmarkGetNumberChannels(g_formats[source]);
+
+    for (i = 0; i < size; i++) {
+      random = random * 1664525 + 1013904223;
+
+      images[source].data[i] = (GLUSubyte)(random >> 24);
+    }
+  }
+
+  for (source = 0; source < GLUS_BENCHMARK_FORMATS; source++) {
+    for (target = 0; target < GLUS_BENCHMARK_FORMATS; target++) {
+      sprintf(name, "%s -> %s", g_formatNames[source], g_formatNames[target]);
+
+      glusBenchmarkConvert(name, glusBenchmarkConvertTgaPrevious,
+                           glusImageConvertTga, &images[source],
+                           g_formats[target]);
+    }
+  }
+
+  glusBenchmarkConvert("rgba premult", glusBenchmarkToPremultiplyTgaPrevious,
+                       glusBenchmarkToPremultiplyTga, &images[4], GLUS_RGBA);
+
+  for (source = 0; source < GLUS_BENCHMARK_FORMATS; source++) {
+    sprintf(name, "save %s", g_formatNames[source]);
+
+    glusBenchmarkSave(name, &images[source]);
+  }
+
+  for (source = 0; source < GLUS_BENCHMARK_FORMATS; source++) {
+    glusImageDestroyTga(&images[source]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,427 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the startup time of glusShapeLoadWavefront() with the previous
+// parser, which read every line with fgets() and parsed it with sscanf() and
+// strtok(). Both results are compared byte by byte. Pass the wavefront files
+// as arguments, e.g. the models of res/:
+//
+// glus_benchmark_wavefront ../res/*.obj
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_BUFFERSIZE 1024
+
+/**
+ * Growing array of floats for the previous parser.
+ */
+typedef struct _GLUSbenchmarkarray {
+  GLUSfloat *data;
+
+  GLUSuint number;
+
+  GLUSuint capacity;
+
+} GLUSbenchmarkarray;
+
+// The previous parser used fixed arrays. They are grown here, so large files
+// can be measured as well.
+static GLUSboolean glusBenchmarkReserve(GLUSbenchmarkarray *array,
+                                        GLUSuint number, GLUSuint components) {
+  GLUSfloat *newData;
+
+  GLUSuint newCapacity;
+
+  if (array->number + number <= array->capacity) {
+    return GLUS_TRUE;
+  }
+
+  newCapacity = array->capacity > 0 ? 2 * array->capacity : 1024;
+
+  while (newCapacity < array->number + number) {
+    newCapacity *= 2;
+  }
+
+  newData = (GLUSfloat *)glusMemoryRealloc(
+      array->data, (size_t)newCapacity * components * sizeof(GLUSfloat));
+
+  if (!newData) {
+    return GLUS_FALSE;
+  }
+
+  array->data = newData;
+  array->capacity = newCapacity;
+
+  return GLUS_TRUE;
+}
+
+// Appends a triangle corner. From the fourth corner on, the polygon is split
+// into triangles like the previous parser did.
+static GLUSboolean glusBenchmarkAddCorner(GLUSbenchmarkarray *triangleArray,
+                                          const GLUSbenchmarkarray *array,
+                                          GLUSint index, GLUSuint edgeCount,
+                                          GLUSuint components) {
+  GLUSfloat *data;
+
+  if ((GLUSuint)index >= array->number ||
+      !glusBenchmarkReserve(triangleArray, 3, components)) {
+    return GLUS_FALSE;
+  }
+
+  data = triangleArray->data;
+
+  if (edgeCount < 3) {
+    memcpy(&data[components * triangleArray->number],
+           &array->data[components * index], components * sizeof(GLUSfloat));
+
+    triangleArray->number++;
+  } else {
+    memcpy(&data[components * triangleArray->number],
+           &data[components * (triangleArray->number - edgeCount)],
+           components * sizeof(GLUSfloat));
+    memcpy(&data[components * (triangleArray->number + 1)],
+           &data[components * (triangleArray->number - 1)],
+           components * sizeof(GLUSfloat));
+    memcpy(&data[components * (triangleArray->number + 2)],
+           &array->data[components * index], components * sizeof(GLUSfloat));
+
+    triangleArray->number += 3;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Parses the faces of one line with strtok() and sscanf().
+static GLUSboolean glusBenchmarkParseFace(
+    GLUSchar *buffer, const GLUSbenchmarkarray *vertices,
+    const GLUSbenchmarkarray *normals, const GLUSbenchmarkarray *texCoords,
+    GLUSbenchmarkarray *triangleVertices, GLUSbenchmarkarray *triangleNormals,
+    GLUSbenchmarkarray *triangleTexCoords) {
+  GLUSchar *token;
+
+  GLUSchar *c;
+
+  GLUSint vIndex, vtIndex, vnIndex;
+
+  GLUSuint edgeCount = 0;
+
+  GLUSuint facesEncoding = 0;
+
+  token = strtok(buffer, " \t");
+  token = strtok(0, " \n");
+
+  if (!token) {
+    return GLUS_TRUE;
+  }
+
+  if (strstr(token, "//") != 0) {
+    facesEncoding = 2;
+  } else if (strstr(token, "/") != 0) {
+    c = strstr(token, "/") + 1;
+
+    facesEncoding = strstr(c, "/") == 0 ? 1 : 3;
+  }
+
+  while (token != 0) {
+    vIndex = -1;
+    vtIndex = -1;
+    vnIndex = -1;
+
+    switch (facesEncoding) {
+    case 0:
+      sscanf(token, "%d", &vIndex);
+      break;
+    case 1:
+      sscanf(token, "%d/%d", &vIndex, &vtIndex);
+      break;
+    case 2:
+      sscanf(token, "%d//%d", &vIndex, &vnIndex);
+      break;
+    case 3:
+      sscanf(token, "%d/%d/%d", &vIndex, &vtIndex, &vnIndex);
+      break;
+    }
+
+    vIndex--;
+    vtIndex--;
+    vnIndex--;
+
+    if (vIndex >= 0 && !glusBenchmarkAddCorner(triangleVertices, vertices,
+                                               vIndex, edgeCount, 4)) {
+      return GLUS_FALSE;
+    }
+    if (vnIndex >= 0 && !glusBenchmarkAddCorner(triangleNormals, normals,
+                                                vnIndex, edgeCount, 3)) {
+      return GLUS_FALSE;
+    }
+    if (vtIndex >= 0 && !glusBenchmarkAddCorner(triangleTexCoords, texCoords,
+                                                vtIndex, edgeCount, 2)) {
+      return GLUS_FALSE;
+    }
+
+    edgeCount++;
+
+    token = strtok(0, " \n");
+  }
+
+  return GLUS_TRUE;
+}
+
+// Moves the triangle corners into the shape, like the previous parser did.
+static GLUSboolean glusBenchmarkCreateShape(
+    GLUSshape *shape, GLUSbenchmarkarray *triangleVertices,
+    GLUSbenchmarkarray *triangleNormals,
+    GLUSbenchmarkarray *triangleTexCoords) {
+  GLUSuint i;
+
+  shape->numberVertices = triangleVertices->number;
+  shape->numberIndices = triangleVertices->number;
+  shape->mode = GLUS_TRIANGLES;
+
+  if (triangleVertices->number > 0) {
+    shape->vertices = triangleVertices->data;
+    triangleVertices->data = 0;
+
+    shape->indices = (GLUSindex *)glusMemoryMalloc(shape->numberIndices *
+                                                   sizeof(GLUSindex));
+
+    if (!shape->indices) {
+      return GLUS_FALSE;
+    }
+
+    for (i = 0; i < shape->numberIndices; i++) {
+      shape->indices[i] = i;
+    }
+  }
+
+  if (triangleNormals->number > 0) {
+    shape->normals = triangleNormals->data;
+    triangleNormals->data = 0;
+  }
+
+  if (triangleTexCoords->number > 0) {
+    shape->texCoords = triangleTexCoords->data;
+    triangleTexCoords->data = 0;
+  }
+
+  glusShapeCalculateTangentBitangentf(shape);
+
+  return GLUS_TRUE;
+}
+
+// The previous parser for shapes. Only the geometry lines are parsed, as
+// shapes have no groups and materials.
+static GLUSboolean glusBenchmarkLoadPrevious(const GLUSchar *filename,
+                                             GLUSshape *shape) {
+  GLUSbenchmarkarray arrays[6];
+
+  GLUSchar buffer[GLUS_BENCHMARK_BUFFERSIZE];
+  GLUSchar identifier[7];
+
+  GLUSfloat x, y, z;
+
+  GLUSboolean result = GLUS_TRUE;
+
+  FILE *f;
+
+  GLUSint i;
+
+  memset(shape, 0, sizeof(GLUSshape));
+  memset(arrays, 0, sizeof(arrays));
+
+  f = glusFileOpen(filename, "r");
+
+  if (!f) {
+    return GLUS_FALSE;
+  }
+
+  while (result && fgets(buffer, GLUS_BENCHMARK_BUFFERSIZE, f)) {
+    if (strncmp(buffer, "vt", 2) == 0) {
+      sscanf(buffer, "%s %f %f", identifier, &x, &y);
+
+      result = glusBenchmarkReserve(&arrays[2], 1, 2);
+
+      if (result) {
+        arrays[2].data[2 * arrays[2].number + 0] = x;
+        arrays[2].data[2 * arrays[2].number + 1] = y;
+
+        arrays[2].number++;
+      }
+    } else if (strncmp(buffer, "vn", 2) == 0) {
+      sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+
+      result = glusBenchmarkReserve(&arrays[1], 1, 3);
+
+      if (result) {
+        arrays[1].data[3 * arrays[1].number + 0] = x;
+        arrays[1].data[3 * arrays[1].number + 1] = y;
+        arrays[1].data[3 * arrays[1].number + 2] = z;
+
+        arrays[1].number++;
+      }
+    } else if (strncmp(buffer, "v", 1) == 0) {
+      sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+
+      result = glusBenchmarkReserve(&arrays[0], 1, 4);
+
+      if (result) {
+        arrays[0].data[4 * arrays[0].number + 0] = x;
+        arrays[0].data[4 * arrays[0].number + 1] = y;
+        arrays[0].data[4 * arrays[0].number + 2] = z;
+        arrays[0].data[4 * arrays[0].number + 3] = 1.0f;
+
+        arrays[0].number++;
+      }
+    } else if (strncmp(buffer, "f", 1) == 0) {
+      result =
+          glusBenchmarkParseFace(buffer, &arrays[0], &arrays[1], &arrays[2],
+                                 &arrays[3], &arrays[4], &arrays[5]);
+    }
+  }
+
+  glusFileClose(f);
+
+  if (result) {
+    result =
+        glusBenchmarkCreateShape(shape, &arrays[3], &arrays[4], &arrays[5]);
+  }
+
+  for (i = 0; i < 6; i++) {
+    glusMemoryFree(arrays[i].data);
+  }
+
+  if (!result) {
+    glusShapeDestroyf(shape);
+  }
+
+  return result;
+}
+
+static GLUSboolean glusBenchmarkCompareArray(const GLUSfloat *array0,
+                                             const GLUSfloat *array1,
+                                             GLUSuint number) {
+  if (!array0 || !array1) {
+    return array0 == array1;
+  }
+
+  return memcmp(array0, array1, number * sizeof(GLUSfloat)) == 0;
+}
+
+static GLUSboolean glusBenchmarkCompareShape(const GLUSshape *shape0,
+                                             const GLUSshape *shape1) {
+  GLUSuint numberVertices = shape0->numberVertices;
+
+  return shape0->numberVertices == shape1->numberVertices &&
+         glusBenchmarkCompareArray(shape0->vertices, shape1->vertices,
+                                   4 * numberVertices) &&
+         glusBenchmarkCompareArray(shape0->normals, shape1->normals,
+                                   3 * numberVertices) &&
+         glusBenchmarkCompareArray(shape0->texCoords, shape1->texCoords,
+                                   2 * numberVertices) &&
+         glusBenchmarkCompareArray(shape0->tangents, shape1->tangents,
+                                   3 * numberVertices);
+}
+
+// Loads the file several times and returns the fastest time or a negative
+// value, if loading failed. The shape of the last run is kept.
+static double glusBenchmarkMeasure(const GLUSchar *filename, GLUSshape *shape,
+                                   GLUSboolean previous) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime;
+    double time;
+
+    GLUSboolean result;
+
+    if (i > 0) {
+      glusShapeDestroyf(shape);
+    }
+
+    startTime = glusBenchmarkGetTime();
+
+    if (previous) {
+      result = glusBenchmarkLoadPrevious(filename, shape);
+    } else {
+      result = glusShapeLoadWavefront(filename, shape);
+    }
+
+    time = glusBenchmarkGetTime() - startTime;
+
+    if (!result) {
+      return -1.0;
+    }
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+int main(int argc, char *argv[]) {
+  GLUSshape previousShape;
+  GLUSshape shape;
+
+  GLUSint i;
+
+  if (argc < 2) {
+    printf("Usage: %s file.obj ...\n", argv[0]);
+
+    return 1;
+  }
+
+  for (i = 1; i < argc; i++) {
+    double previousTime;
+    double time;
+
+    GLUSboolean equal;
+
+    previousTime = glusBenchmarkMeasure(argv[i], &previousShape, GLUS_TRUE);
+    time = glusBenchmarkMeasure(argv[i], &shape, GLUS_FALSE);
+
+    if (previousTime < 0.0 || time < 0.0) {
+      printf("%s: Could not load file.\n", argv[i]);
+
+      if (previousTime >= 0.0) {
+        glusShapeDestroyf(&previousShape);
+      }
+      if (time >= 0.0) {
+        glusShapeDestroyf(&shape);
+      }
+
+      continue;
+    }
+
+    equal = glusBenchmarkCompareShape(&previousShape, &shape);
+
+    printf("%s: %u vertices: fgets and sscanf %.2f ms, in place %.2f ms, "
+           "speedup %.2f, %s\n",
+           argv[i], shape.numberVertices, previousTime * 1000.0, time * 1000.0,
+           time > 0.0 ? previousTime / time : 0.0,
+           equal ? "identical" : "DIFFERENT");
+
+    glusShapeDestroyf(&previousShape);
+    glusShapeDestroyf(&shape);
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures how loading a wavefront file scales with 1, 2, 4 and 8 threads.
+// The file is loaded as a shape with and without indexed vertices, and every
+// result is compared byte by byte with the result of one thread. Pass a large
+// wavefront file as argument:
+//
+// glus_benchmark_wavefront_threads scan.obj
+
+#include "glus_benchmark.h"
+
+#define GLUS_BENCHMARK_THREAD_COUNTS 4
+
+static GLUSboolean glusBenchmarkCompareArray(const GLUSvoid *array0,
+                                             const GLUSvoid *array1,
+                                             size_t size) {
+  if (!array0 || !array1) {
+    return array0 == array1;
+  }
+
+  return memcmp(array0, array1, size) == 0;
+}
+
+static GLUSboolean glusBenchmarkCompareShape(const GLUSshape *shape0,
+                                             const GLUSshape *shape1) {
+  size_t numberVertices = shape0->numberVertices;
+
+  return shape0->numberVertices == shape1->numberVertices &&
+         shape0->numberIndices == shape1->numberIndices &&
+         glusBenchmarkCompareArray(shape0->vertices, shape1->vertices,
+                                   4 * numberVertices * sizeof(GLUSfloat)) &&
+         glusBenchmarkCompareArray(shape0->normals, shape1->normals,
+                                   3 * numberVertices * sizeof(GLUSfloat)) &&
+         glusBenchmarkCompareArray(shape0->texCoords, shape1->texCoords,
+                                   2 * numberVertices * sizeof(GLUSfloat)) &&
+         glusBenchmarkCompareArray(shape0->tangents, shape1->tangents,
+                                   3 * numberVertices * sizeof(GLUSfloat)) &&
+         glusBenchmarkCompareArray(shape0->bitangents, shape1->bitangents,
+                                   3 * numberVertices * sizeof(GLUSfloat)) &&
+         glusBenchmarkCompareArray(
+             shape0->indices, shape1->indices,
+             (size_t)shape0->numberIndices * sizeof(GLUSindex));
+}
+
+// Loads the file several times and returns the fastest time or a negative
+// value, if loading failed. The shape of the last run is kept.
+static double glusBenchmarkMeasure(const GLUSchar *filename, GLUSshape *shape,
+                                   const GLUSwavefrontoptions *options) {
+  double bestTime = -1.0;
+
+  GLUSint i;
+
+  for (i = 0; i < GLUS_BENCHMARK_RUNS; i++) {
+    double startTime;
+    double time;
+
+    GLUSboolean result;
+
+    if (i > 0) {
+      glusShapeDestroyf(shape);
+    }
+
+    startTime = glusBenchmarkGetTime();
+
+    result = glusShapeLoadWavefrontWithOptions(filename, shape, options);
+
+    time = glusBenchmarkGetTime() - startTime;
+
+    if (!result) {
+      return -1.0;
+    }
+
+    if (bestTime < 0.0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+
+  return bestTime;
+}
+
+static GLUSvoid glusBenchmarkScaling(const GLUSchar *filename,
+                                     GLUSboolean indexed) {
+  const GLUSuint numberThreads[GLUS_BENCHMARK_THREAD_COUNTS] = {1, 2, 4, 8};
+
+  GLUSwavefrontoptions options;
+
+  GLUSshape singleShape;
+  GLUSshape shape;
+
+  double singleTime = 0.0;
+
+  GLUSint i;
+
+  glusWavefrontInitOptions(&options);
+
+  options.indexed = indexed;
+
+  for (i = 0; i < GLUS_BENCHMARK_THREAD_COUNTS; i++) {
+    double time;
+
+    options.numberThreads = numberThreads[i];
+
+    time = glusBenchmarkMeasure(filename, i == 0 ? &singleShape : &shape,
+                                &options);
+
+    if (time < 0.0) {
+      printf("%s: Could not load file with %u threads.\n", filename,
+             numberThreads[i]);
+
+      break;
+    }
+
+    if (i == 0) {
+      singleTime = time;
+
+      printf("%s, %s: %u vertices, %u indices\n", filename,
+             indexed ? "indexed" : "not indexed", singleShape.numberVertices,
+             singleShape.numberIndices);
+      printf("  1 thread: %.2f ms\n", time * 1000.0);
+
+      continue;
+    }
+
+    printf("  %u threads: %.2f ms, speedup %.2f, %s\n", numberThreads[i],
+           time * 1000.0, time > 0.0 ? singleTime / time : 0.0,
+           glusBenchmarkCompareShape(&singleShape, &shape) ? "identical"
+                                                           : "DIFFERENT");
+
+    glusShapeDestroyf(&shape);
+  }
+
+  if (i > 0) {
+    glusShapeDestroyf(&singleShape);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  GLUSint i;
+
+  if (argc < 2) {
+    printf("Usage: %s file.obj ...\n", argv[0]);
+
+    return 1;
+  }
+
+  printf("%d processors\n", glusBenchmarkGetNumberProcessors());
+
+  for (i = 1; i < argc; i++) {
+    glusBenchmarkScaling(argv[i], GLUS_FALSE);
+    glusBenchmarkScaling(argv[i], GLUS_TRUE);
+  }
+
+  return 0;
+}
@@ -217,19 +217,56 @@ extern "C" {
 
 #include "../GLUS/glus_shape_texgen.h"
 
+//
+// Shape vertex welding
+//
+
+#include "../GLUS/glus_shape_weld.h"
+
+//
+// Shape index and vertex order optimization
+//
+
+#include "../GLUS/glus_shape_optimize.h"
+
+//
+// Shape levels of detail
+//
+
+#include "../GLUS/glus_shape_lod.h"
+
+//
+// Shape attribute packing
+//
+
+#include "../GLUS/glus_shape_pack.h"
+
+//
+// Tiled grid planes
+//
+
+#include "../GLUS/glus_shape_tile.h"
+
 //
 // Line / geometry functions.
 //
 
 #include "../GLUS/glus_line.h"
+#include "../GLUS/glus_line_batch.h"
 #include "../GLUS/glus_line_wavefront.h"
 
 //
 // Model loading functions.
 //
 
-#include "../GLUS/glus_shape_wavefront.h"
 #include "../GLUS/glus_wavefront.h"
+#include "../GLUS/glus_shape_wavefront.h"
+
+//
+// Meshlets
+//
+
+#include "../GLUS/glus_shape_meshlet.h"
 
 //
 // Logging
@@ -268,6 +305,7 @@ extern "C" {
 #include "../GLUS/glus_image_hdr.h"
 #include "../GLUS/glus_image_pkm.h"
 #include "../GLUS/glus_image_tga.h"
+#include "../GLUS/glus_image_batch.h"
 
 #include "../GLUS/glus_file_binary.h"
 #include "../GLUS/glus_file_text.h"
@@ -49,6 +49,8 @@
 #define GLUS_UNSIGNED_INT 0x1405
 #define GLUS_FLOAT 0x1406
 #define GLUS_DOUBLE 0x140A
+#define GLUS_HALF_FLOAT 0x140B
+#define GLUS_UNSIGNED_INT_5_9_9_9_REV 0x8C3E
 
 #define GLUS_VERSION 0x1F02
 #define GLUS_EXTENSIONS 0x1F03
@@ -24,4 +24,6 @@
 
 #define GLUSindex GLUSuint
 
+#define GLUS_PRIMITIVE_RESTART_INDEX 0xFFFFFFFF
+
 #endif /* GLUS_DEFINE_UINT_H_ */
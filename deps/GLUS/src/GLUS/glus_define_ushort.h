@@ -24,4 +24,6 @@
 
 #define GLUSindex GLUSushort
 
+#define GLUS_PRIMITIVE_RESTART_INDEX 0xFFFF
+
 #endif /* GLUS_DEFINE_USHORT_H_ */
@@ -76,7 +76,8 @@ typedef struct _GLUShdrimage {
   GLUSushort depth;
 
   /**
-   * Pixel data.
+   * Pixel data. If the type is not GLUS_FLOAT, the data has to be read as
+   * GLUSushort respectively GLUSuint values.
    */
   GLUSfloat *data;
 
@@ -85,6 +86,13 @@ typedef struct _GLUShdrimage {
    */
   GLUSenum format;
 
+  /**
+   * Type of the pixel data. GLUS_FLOAT, GLUS_HALF_FLOAT with three half floats
+   * per pixel or GLUS_UNSIGNED_INT_5_9_9_9_REV with one shared exponent per
+   * pixel. Packed types are always GLUS_RGB.
+   */
+  GLUSenum type;
+
 } GLUShdrimage;
 
 /**
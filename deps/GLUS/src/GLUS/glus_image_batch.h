@@ -0,0 +1,113 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_IMAGE_BATCH_H_
+#define GLUS_IMAGE_BATCH_H_
+
+/**
+ * Images, which were loaded together. The data of all images is stored in one
+ * allocation, in the order of the files. So e.g. the six faces of several cube
+ * maps with the same size and format can be uploaded with one call.
+ */
+typedef struct _GLUSimagebatch {
+  /**
+   * Number of images, which is the number of files.
+   */
+  GLUSuint numberImages;
+
+  /**
+   * Per file, GLUS_TRUE, if the image was loaded.
+   */
+  GLUSboolean *loaded;
+
+  /**
+   * Per file, the loaded image. Only the image of the file type is filled, the
+   * other two are empty. Also empty, if loading the file failed. The data of
+   * the images points into the data of the batch, so the images must not be
+   * destroyed.
+   */
+  GLUStgaimage *tgaimages;
+  GLUShdrimage *hdrimages;
+  GLUSpkmimage *pkmimages;
+
+  /**
+   * Per file, the offset in bytes of the image data. The data of every image
+   * starts at a multiple of 16 bytes. If the size of an image is a multiple of
+   * 16 bytes, the following image starts directly after it.
+   */
+  size_t *offsets;
+
+  /**
+   * The data of all images.
+   */
+  GLUSubyte *data;
+
+  /**
+   * The size of the data in bytes.
+   */
+  size_t size;
+
+} GLUSimagebatch;
+
+/**
+ * Loads TGA, HDR and PKM files in parallel into one allocation. The type of a
+ * file is taken from its extension ".tga", ".hdr" or ".pkm". If one file can
+ * not be loaded, the other files are still loaded.
+ *
+ * @param batch 			The structure to fill the images.
+ * @param filenames 		The names of the files to load.
+ * @param numberFilenames 	The number of files.
+ * @param numberThreads 	The number of threads, which load the files. If 0,
+ * the number of processors is used.
+ *
+ * @return GLUS_TRUE, if all files were loaded. Check the loaded status per
+ * file otherwise.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadBatch(
+    GLUSimagebatch *batch, const GLUSchar **filenames,
+    const GLUSuint numberFilenames, const GLUSuint numberThreads);
+
+/**
+ * Loads TGA, HDR and PKM files in parallel into one allocation and stores the
+ * pixels of the HDR images in the given type. See glusImageLoadHdrPacked().
+ *
+ * @param batch 			The structure to fill the images.
+ * @param filenames 		The names of the files to load.
+ * @param numberFilenames 	The number of files.
+ * @param numberThreads 	The number of threads, which load the files. If 0,
+ * the number of processors is used.
+ * @param hdrType 			GLUS_FLOAT, GLUS_HALF_FLOAT or
+ * GLUS_UNSIGNED_INT_5_9_9_9_REV.
+ *
+ * @return GLUS_TRUE, if all files were loaded. Check the loaded status per
+ * file otherwise.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadBatchPacked(
+    GLUSimagebatch *batch, const GLUSchar **filenames,
+    const GLUSuint numberFilenames, const GLUSuint numberThreads,
+    const GLUSenum hdrType);
+
+/**
+ * Destroys the content of a batch structure, including the data of all
+ * images. Has to be called for freeing the resources.
+ *
+ * @param batch The batch structure.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyBatch(GLUSimagebatch *batch);
+
+#endif /* GLUS_IMAGE_BATCH_H_ */
@@ -47,6 +47,46 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage *hdrimage,
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar *filename,
                                                   GLUShdrimage *hdrimage);
 
+/**
+ * Loads a HDR image from memory, e.g. the content of a HDR file or a mapped
+ * file. Uncompressed and RLE compressed scanlines are supported.
+ *
+ * @param buffer   The HDR data.
+ * @param length   The length of the HDR data in bytes.
+ * @param hdrimage The structure to fill the HDR data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemory(
+    const GLUSubyte *buffer, size_t length, GLUShdrimage *hdrimage);
+
+/**
+ * Loads a HDR file and stores the pixels in the given type. Half floats need
+ * half of the memory of floats, the shared exponent format a third.
+ *
+ * @param filename The name of the file to load.
+ * @param hdrimage The structure to fill the HDR data.
+ * @param type     GLUS_FLOAT, GLUS_HALF_FLOAT or GLUS_UNSIGNED_INT_5_9_9_9_REV.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrPacked(
+    const GLUSchar *filename, GLUShdrimage *hdrimage, const GLUSenum type);
+
+/**
+ * Loads a HDR image from memory and stores the pixels in the given type.
+ *
+ * @param buffer   The HDR data.
+ * @param length   The length of the HDR data in bytes.
+ * @param hdrimage The structure to fill the HDR data.
+ * @param type     GLUS_FLOAT, GLUS_HALF_FLOAT or GLUS_UNSIGNED_INT_5_9_9_9_REV.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemoryPacked(
+    const GLUSubyte *buffer, size_t length, GLUShdrimage *hdrimage,
+    const GLUSenum type);
+
 /**
  * Saves a HDR file.
  *
@@ -68,7 +108,7 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyHdr(GLUShdrimage *hdrimage);
 
 /**
  * Samples a RGB color value from a HDR 2D image.
- * Sampling uses a bilinear filter.
+ * Sampling uses a bilinear filter. Packed pixels are unpacked before filtering.
  *
  * @param rgb 		The resulting, sampled RGB color value.
  * @param hdrimage 	The HDR image structure, containing the 2D texel data.
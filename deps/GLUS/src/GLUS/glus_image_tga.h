@@ -47,6 +47,20 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage *tgaimage,
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar *filename,
                                                   GLUStgaimage *tgaimage);
 
+/**
+ * Loads a TGA image from memory, e.g. the content of a TGA file or a mapped
+ * file. Uncompressed, RLE compressed and 8 bit color mapped images are
+ * supported. Colors are returned as RGB(A).
+ *
+ * @param buffer   The TGA data.
+ * @param length   The length of the TGA data in bytes.
+ * @param tgaimage The structure to fill the TGA data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTgaFromMemory(
+    const GLUSubyte *buffer, size_t length, GLUStgaimage *tgaimage);
+
 /**
  * Saves a TGA file.
  *
@@ -0,0 +1,121 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_LINE_BATCH_H_
+#define GLUS_LINE_BATCH_H_
+
+/**
+ * Many lines in one vertex and index buffer, which can be drawn with one call.
+ * Every line is stored as line strips, which are separated by
+ * GLUS_PRIMITIVE_RESTART_INDEX. So primitive restart has to be enabled.
+ */
+typedef struct _GLUSlinebatch {
+  /**
+   * Vertices in homogeneous coordinates.
+   */
+  GLUSfloat *vertices;
+
+  /**
+   * Indices of the line strips.
+   */
+  GLUSindex *indices;
+
+  /**
+   * Number of vertices.
+   */
+  GLUSuint numberVertices;
+
+  /**
+   * Number of indices.
+   */
+  GLUSuint numberIndices;
+
+  /**
+   * First index of every line. A single line can be drawn with this range.
+   */
+  GLUSuint *lineFirstIndices;
+
+  /**
+   * Number of indices of every line. A line made of several strips contains
+   * restart indices.
+   */
+  GLUSuint *lineNumberIndices;
+
+  /**
+   * Number of lines.
+   */
+  GLUSuint numberLines;
+
+  /**
+   * Line render mode, which is always GLUS_LINE_STRIP.
+   */
+  GLUSenum mode;
+
+  /**
+   * Allocated number of vertices, indices and lines.
+   */
+  GLUSuint capacityVertices;
+  GLUSuint capacityIndices;
+  GLUSuint capacityLines;
+
+} GLUSlinebatch;
+
+/**
+ * Initializes an empty line batch.
+ *
+ * @param lineBatch The line batch.
+ *
+ * @return GLUS_TRUE, if initialization succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusLineBatchInitf(GLUSlinebatch *lineBatch);
+
+/**
+ * Appends a line to the batch. Lines and line loops are converted to line
+ * strips, where connected segments are merged.
+ *
+ * @param lineBatch The line batch.
+ * @param line 		The line to append.
+ *
+ * @return GLUS_TRUE, if appending succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusLineBatchAddLinef(GLUSlinebatch *lineBatch,
+                                                       const GLUSline *line);
+
+/**
+ * Appends a polyline to the batch without creating a GLUSline before.
+ *
+ * @param lineBatch 		The line batch.
+ * @param vertices 			The vertices in homogeneous coordinates.
+ * @param numberVertices 	The number of vertices. Has to be at least two.
+ * @param closed 			Set to GLUS_TRUE, if the last vertex should be
+ * connected with the first one.
+ *
+ * @return GLUS_TRUE, if appending succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusLineBatchAddPolylinef(
+    GLUSlinebatch *lineBatch, const GLUSfloat *vertices,
+    const GLUSuint numberVertices, const GLUSboolean closed);
+
+/**
+ * Destroys the line batch by freeing the allocated memory.
+ *
+ * @param lineBatch The line batch.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusLineBatchDestroyf(GLUSlinebatch *lineBatch);
+
+#endif /* GLUS_LINE_BATCH_H_ */
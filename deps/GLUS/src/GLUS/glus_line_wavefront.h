@@ -30,4 +30,17 @@
 GLUSAPI GLUSboolean GLUSAPIENTRY glusLineLoadWavefront(const GLUSchar *filename,
                                                        GLUSline *line);
 
+/**
+ * Loads the lines of a wavefront object file into a line batch. Every line
+ * element becomes one line of the batch. The vertices and lines are appended,
+ * so several files can be loaded into the same batch.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param lineBatch The initialized line batch, which receives the lines.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusLineLoadWavefrontBatch(
+    const GLUSchar *filename, GLUSlinebatch *lineBatch);
+
 #endif /* GLUS_SHAPE_WAVEFRONT_H_ */
@@ -103,4 +103,23 @@ GLUSAPI GLUSfloat GLUSAPIENTRY glusMathLengthf(const GLUSfloat x,
                                                const GLUSfloat y,
                                                const GLUSfloat z);
 
+/**
+ * Converts a value to a half float. The value is rounded to the nearest half
+ * float. Too large values become infinity.
+ *
+ * @param value The value.
+ *
+ * @return The bits of the half float.
+ */
+GLUSAPI GLUSushort GLUSAPIENTRY glusMathFloatToHalff(const GLUSfloat value);
+
+/**
+ * Converts a half float to a value.
+ *
+ * @param half The bits of the half float.
+ *
+ * @return The value.
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusMathHalfToFloatf(const GLUSushort half);
+
 #endif /* GLUS_MATH_H_ */
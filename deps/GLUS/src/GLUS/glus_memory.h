@@ -29,6 +29,19 @@
  */
 GLUSAPI void *GLUSAPIENTRY glusMemoryMalloc(size_t size);
 
+/**
+ * Change the size of a memory block. The content is kept up to the smaller of
+ * the old and the new size.
+ *
+ * @param pointer Pointer to a memory block previously allocated with
+ * glusMemoryMalloc or glusMemoryRealloc. If null, a new block is allocated.
+ * @param size New size of the memory block in bytes.
+ *
+ * @return Returns on success the pointer to the reallocated memory. Otherwise
+ * null is returned and the old memory block is untouched.
+ */
+GLUSAPI void *GLUSAPIENTRY glusMemoryRealloc(void *pointer, size_t size);
+
 /**
  * Deallocate memory block.
  *
@@ -76,6 +76,11 @@ typedef struct _GLUSshape {
    */
   GLUSenum mode;
 
+  /**
+   * The memory mapped cache file, if the arrays are stored in it. Otherwise 0.
+   */
+  GLUSvoid *cache;
+
 } GLUSshape;
 
 /**
@@ -225,7 +230,10 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeCreateConef(
 
 /**
  * Calculates and creates the tangent and bitangent vectors. Uses the previous
- * created memory for the tangents and bitangents.
+ * created memory for the tangents and bitangents. If the shape has normals, the
+ * tangent is made orthogonal to the normal and the bitangent is the cross
+ * product of the normal and the tangent, keeping the handedness of the texture
+ * coordinates.
  *
  * @param shape The structure which will be filled with the calculated vectors.
  *
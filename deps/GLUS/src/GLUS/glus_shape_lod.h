@@ -0,0 +1,51 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_SHAPE_LOD_H_
+#define GLUS_SHAPE_LOD_H_
+
+/**
+ * Creates a chain of simplified levels of detail of a shape. The edges with
+ * the smallest quadric error are collapsed, until the number of triangles of a
+ * level is reached. Every level continues from the previous one.
+ *
+ * The vertices are not moved, so all levels share the vertices of the source
+ * shape. Their normals and texture coordinates are kept. Borders and texture
+ * seams, i.e. vertices at the same position with different attributes, are
+ * only collapsed along themselves.
+ *
+ * The indices of all levels are stored one after another. Each level is
+ * ordered for the vertex cache.
+ *
+ * @param lodShape 		The shape with the vertices and the indices of all
+ * levels.
+ * @param firstIndices 	The first index of every level.
+ * @param numberIndices The number of indices of every level.
+ * @param sourceShape 	The source shape with triangles.
+ * @param ratios 		The ratio of the source triangles for every level,
+ * e.g. 1.0, 0.5, 0.25. Should be descending.
+ * @param numberLevels 	The number of levels.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeCreateLevelsOfDetailf(
+    GLUSshape *lodShape, GLUSuint *firstIndices, GLUSuint *numberIndices,
+    const GLUSshape *sourceShape, const GLUSfloat *ratios,
+    const GLUSuint numberLevels);
+
+#endif /* GLUS_SHAPE_LOD_H_ */
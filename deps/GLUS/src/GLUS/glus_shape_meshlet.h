@@ -0,0 +1,135 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_SHAPE_MESHLET_H_
+#define GLUS_SHAPE_MESHLET_H_
+
+/**
+ * Cluster of neighbouring triangles, which is culled as a whole.
+ */
+typedef struct _GLUSmeshlet {
+  /**
+   * First index of the triangles.
+   */
+  GLUSuint firstIndex;
+
+  /**
+   * Number of indices.
+   */
+  GLUSuint numberIndices;
+
+  /**
+   * Number of different vertices used by the triangles.
+   */
+  GLUSuint numberVertices;
+
+  /**
+   * Center of the bounding sphere.
+   */
+  GLUSfloat center[4];
+
+  /**
+   * Radius of the bounding sphere.
+   */
+  GLUSfloat radius;
+
+  /**
+   * Average normal of the triangles.
+   */
+  GLUSfloat coneAxis[3];
+
+  /**
+   * Sine of the largest angle between the axis and a normal. 1.0, if the
+   * triangles can not be back face culled as a whole.
+   */
+  GLUSfloat coneCutoff;
+
+} GLUSmeshlet;
+
+/**
+ * Splits the triangles of a shape into meshlets. The indices are reordered,
+ * so every meshlet is a range of them. Neighbouring triangles with similar
+ * normals are grouped, which gives tight bounds for culling.
+ *
+ * Triangles are grouped over shared vertices, so a shape without indexed
+ * vertices should be welded before. The order of the triangles is used to
+ * start new meshlets, so it should be optimized before, e.g. with
+ * glusShapeOptimizeVertexCachef.
+ *
+ * @param meshlets 			The created meshlets. Has to be freed with
+ * glusMeshletDestroyf.
+ * @param numberMeshlets 	The number of created meshlets.
+ * @param shape 			The shape with triangles.
+ * @param maxVertices 		The maximum number of vertices per meshlet, e.g.
+ * 64.
+ * @param maxTriangles 		The maximum number of triangles per meshlet, e.g.
+ * 124.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeCreateMeshletsf(
+    GLUSmeshlet **meshlets, GLUSuint *numberMeshlets, GLUSshape *shape,
+    const GLUSuint maxVertices, const GLUSuint maxTriangles);
+
+/**
+ * Splits the triangles of a wavefront object into meshlets. The groups have to
+ * be merged. Every group is split on its own, so a meshlet has one material.
+ * The first indices of the meshlets are into the merged indices.
+ *
+ * @param meshlets 			The created meshlets. Has to be freed with
+ * glusMeshletDestroyf.
+ * @param numberMeshlets 	The number of created meshlets.
+ * @param wavefront 		The wavefront object with merged groups.
+ * @param maxVertices 		The maximum number of vertices per meshlet, e.g.
+ * 64.
+ * @param maxTriangles 		The maximum number of triangles per meshlet, e.g.
+ * 124.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontCreateMeshletsf(
+    GLUSmeshlet **meshlets, GLUSuint *numberMeshlets, GLUSwavefront *wavefront,
+    const GLUSuint maxVertices, const GLUSuint maxTriangles);
+
+/**
+ * Destroys the meshlets by freeing the allocated memory.
+ *
+ * @param meshlets The meshlets, which were created by one of the above
+ * functions.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMeshletDestroyf(GLUSmeshlet *meshlets);
+
+/**
+ * Culls meshlets against the view frustum and by their normal cone.
+ *
+ * @param visibleMeshlets 	The numbers of the visible meshlets. Has to be as
+ * large as the number of meshlets.
+ * @param meshlets 			The meshlets.
+ * @param numberMeshlets 	The number of meshlets.
+ * @param viewProjectionMatrix 	The matrix transforming the vertices of the
+ * meshlets into clip space.
+ * @param eye 				The eye position in the space of the vertices.
+ *
+ * @return The number of visible meshlets.
+ */
+GLUSAPI GLUSuint GLUSAPIENTRY glusMeshletCullf(
+    GLUSuint *visibleMeshlets, const GLUSmeshlet *meshlets,
+    const GLUSuint numberMeshlets, const GLUSfloat viewProjectionMatrix[16],
+    const GLUSfloat eye[4]);
+
+#endif /* GLUS_SHAPE_MESHLET_H_ */
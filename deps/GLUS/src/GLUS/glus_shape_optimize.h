@@ -0,0 +1,78 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_SHAPE_OPTIMIZE_H_
+#define GLUS_SHAPE_OPTIMIZE_H_
+
+/**
+ * Simulates a FIFO post-transform vertex cache for the indices of a shape.
+ *
+ * @param shape 		The shape with triangles.
+ * @param cacheSize 	The number of vertices in the cache.
+ * @param acmr 			The average cache miss ratio, i.e. the transformed
+ * vertices per triangle. Can be 0.
+ * @param atvr 			The average transform to vertex ratio, i.e. the
+ * transformed vertices per used vertex. Can be 0.
+ *
+ * @return GLUS_TRUE, if the analysis succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeAnalyzeVertexCachef(
+    const GLUSshape *shape, const GLUSuint cacheSize, GLUSfloat *acmr,
+    GLUSfloat *atvr);
+
+/**
+ * Reorders the triangles of a shape for the post-transform vertex cache. Uses
+ * the linear time Tipsify algorithm. The vertices are not changed. If the
+ * triangle order of the shape already has a lower or the same average cache
+ * miss ratio, the order is kept.
+ *
+ * @param shape 		The shape with triangles.
+ * @param cacheSize 	The number of vertices in the cache, e.g. 16.
+ *
+ * @return GLUS_TRUE, if the optimization succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY
+glusShapeOptimizeVertexCachef(GLUSshape *shape, const GLUSuint cacheSize);
+
+/**
+ * Reorders clusters of triangles to reduce overdraw. Clusters facing away from
+ * the center are drawn first, as they tend to occlude the others. Should be
+ * called after glusShapeOptimizeVertexCachef.
+ *
+ * @param shape 		The shape with triangles.
+ * @param cacheSize 	The number of vertices in the cache, e.g. 16.
+ * @param threshold 	The allowed increase of the cache miss ratio, e.g.
+ * 1.05. Larger values create smaller clusters.
+ *
+ * @return GLUS_TRUE, if the optimization succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeOptimizeOverdrawf(
+    GLUSshape *shape, const GLUSuint cacheSize, const GLUSfloat threshold);
+
+/**
+ * Reorders the vertices of a shape in the order of their first use by the
+ * indices, so vertex fetches access the memory sequentially. Unused vertices
+ * are moved to the end. Should be called after the triangles are reordered.
+ *
+ * @param shape 	The shape with triangles.
+ *
+ * @return GLUS_TRUE, if the optimization succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeOptimizeVertexFetchf(GLUSshape *shape);
+
+#endif /* GLUS_SHAPE_OPTIMIZE_H_ */
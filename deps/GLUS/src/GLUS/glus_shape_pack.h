@@ -0,0 +1,158 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_SHAPE_PACK_H_
+#define GLUS_SHAPE_PACK_H_
+
+/**
+ * Interleaved, compressed attributes of a shape. The layout of a vertex is:
+ *
+ * Position as four GLUS_HALF_FLOAT or normalized GLUS_UNSIGNED_SHORT values at
+ * offset 0. The position is positionBias + positionScale * value, w is 1.0.
+ *
+ * Normal as two normalized GLUS_SHORT values of the octahedral encoding.
+ *
+ * Tangent as two GLUS_SHORT values of the octahedral encoding. If the lowest
+ * bit of the second value is set, the bitangent is -cross(normal, tangent),
+ * otherwise cross(normal, tangent). So the tangent has to be read as
+ * integers.
+ *
+ * Texture coordinate as two GLUS_HALF_FLOAT values.
+ */
+typedef struct _GLUSpackedshape {
+  /**
+   * The packed attributes of all vertices.
+   */
+  GLUSubyte *attributes;
+
+  /**
+   * Number of vertices.
+   */
+  GLUSuint numberVertices;
+
+  /**
+   * Bytes per vertex.
+   */
+  GLUSuint stride;
+
+  /**
+   * Either GLUS_HALF_FLOAT or GLUS_UNSIGNED_SHORT.
+   */
+  GLUSenum positionType;
+
+  /**
+   * Scale and bias to get the position out of the stored value.
+   */
+  GLUSfloat positionScale[3];
+  GLUSfloat positionBias[3];
+
+  /**
+   * Offsets in bytes of the attributes. 0, if the attribute is not packed.
+   */
+  GLUSuint normalOffset;
+  GLUSuint tangentOffset;
+  GLUSuint texCoordOffset;
+
+  /**
+   * Largest distance between a packed and the original position.
+   */
+  GLUSfloat maxPositionError;
+
+  /**
+   * Largest angles in degrees between a packed and the original normal,
+   * tangent and bitangent.
+   */
+  GLUSfloat maxNormalError;
+  GLUSfloat maxTangentError;
+  GLUSfloat maxBitangentError;
+
+  /**
+   * Largest difference between a packed and the original texture coordinate.
+   */
+  GLUSfloat maxTexCoordError;
+
+} GLUSpackedshape;
+
+/**
+ * Packs a unit vector into two normalized shorts with the octahedral
+ * encoding. The shorts with the smallest error are chosen.
+ *
+ * @param packed 	The packed vector.
+ * @param vector 	The unit vector.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusPackOctahedralf(GLUSshort packed[2],
+                                                  const GLUSfloat vector[3]);
+
+/**
+ * Unpacks a unit vector of the octahedral encoding.
+ *
+ * @param vector 	The unit vector.
+ * @param packed 	The packed vector.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusUnpackOctahedralf(GLUSfloat vector[3],
+                                                    const GLUSshort packed[2]);
+
+/**
+ * Packs the attributes of a shape. The normals, tangents and texture
+ * coordinates are only packed, if requested and available. The indices of the
+ * shape can be used unchanged.
+ *
+ * @param packedShape 	The packed attributes and the errors of the packing.
+ * @param shape 		The source shape.
+ * @param positionType 	GLUS_HALF_FLOAT or GLUS_UNSIGNED_SHORT, which is
+ * normalized in the bounds of the shape.
+ * @param attributes 	Combination of GLUS_ATTRIBUTE_NORMALS,
+ * GLUS_ATTRIBUTE_TANGENTS and GLUS_ATTRIBUTE_TEXCOORDS. Packed tangents
+ * include the direction of the bitangents.
+ *
+ * @return GLUS_TRUE, if packing succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapePackf(GLUSpackedshape *packedShape,
+                                                const GLUSshape *shape,
+                                                const GLUSenum positionType,
+                                                const GLUSbitfield attributes);
+
+/**
+ * Unpacks the attributes of one vertex.
+ *
+ * @param position 		The position. Can be 0.
+ * @param normal 		The normal. Can be 0. Not changed, if not packed.
+ * @param tangent 		The tangent. Can be 0. Not changed, if not packed.
+ * @param bitangent 	The bitangent. Can be 0. Not changed, if no normal or
+ * tangent is packed.
+ * @param texCoord 		The texture coordinate. Can be 0. Not changed, if not
+ * packed.
+ * @param packedShape 	The packed attributes.
+ * @param vertex 		The number of the vertex.
+ *
+ * @return GLUS_TRUE, if the vertex exists.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusPackedShapeUnpackf(
+    GLUSfloat position[4], GLUSfloat normal[3], GLUSfloat tangent[3],
+    GLUSfloat bitangent[3], GLUSfloat texCoord[2],
+    const GLUSpackedshape *packedShape, const GLUSuint vertex);
+
+/**
+ * Destroys the packed attributes by freeing the allocated memory.
+ *
+ * @param packedShape The packed attributes.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY
+glusPackedShapeDestroyf(GLUSpackedshape *packedShape);
+
+#endif /* GLUS_SHAPE_PACK_H_ */
@@ -21,7 +21,7 @@
 
 /**
  * Creates the texture coordinates of a shape. Already existing texture
- * coordinates are deleted.
+ * coordinates are overwritten.
  *
  * @param shape 	The shape, where the texture coordinates are created.
  * @param sSizeX 	Size of the s texture coordinate, considering x axis.
@@ -40,7 +40,7 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeTexGenByAxesf(
 
 /**
  * Creates the texture coordinates of a shape. Already existing texture
- * coordinates are deleted.
+ * coordinates are overwritten.
  *
  * @param shape 	The shape, where the texture coordinates are created.
  * @param sPlane 	The plane for calculating the s coordinate.
@@ -57,4 +57,46 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeTexGenByPlanesf(
     const float sSize, const float tSize, const float sOffset,
     const float tOffset);
 
+/**
+ * Calculates the texture coordinates of a shape like glusShapeTexGenByAxesf,
+ * but stores them into the given buffer. The shape is not changed, so this can
+ * be used e.g. every frame.
+ *
+ * @param texCoords The buffer for two floats per vertex of the shape.
+ * @param shape 	The shape with the vertices.
+ * @param sSizeX 	Size of the s texture coordinate, considering x axis.
+ * @param sSizeZ 	Size of the s texture coordinate, considering z axis.
+ * @param tSizeY 	Size of the t texture coordinate, considering y axis.
+ * @param tSizeZ 	Size of the t texture coordinate, considering z axis.
+ * @param sOffset 	Offset in the s texture coordinate direction.
+ * @param tOffset 	Offset in the t texture coordinate direction.
+ *
+ * @return GLUS_TRUE, if calculation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeTexGenByAxesToBufferf(
+    GLUSfloat *texCoords, const GLUSshape *shape, const GLUSfloat sSizeX,
+    const GLUSfloat sSizeZ, const GLUSfloat tSizeY, const GLUSfloat tSizeZ,
+    const GLUSfloat sOffset, const GLUSfloat tOffset);
+
+/**
+ * Calculates the texture coordinates of a shape like glusShapeTexGenByPlanesf,
+ * but stores them into the given buffer. The shape is not changed, so this can
+ * be used e.g. every frame.
+ *
+ * @param texCoords The buffer for two floats per vertex of the shape.
+ * @param shape 	The shape with the vertices.
+ * @param sPlane 	The plane for calculating the s coordinate.
+ * @param tPlane 	The plane for calculating the t coordinate.
+ * @param sSize 	The size in s direction.
+ * @param tSize 	The size in t direction.
+ * @param sOffset 	The offset in s direction.
+ * @param tOffset 	The offset in t direction.
+ *
+ * @return GLUS_TRUE, if calculation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeTexGenByPlanesToBufferf(
+    GLUSfloat *texCoords, const GLUSshape *shape, const GLUSfloat sPlane[4],
+    const GLUSfloat tPlane[4], const GLUSfloat sSize, const GLUSfloat tSize,
+    const GLUSfloat sOffset, const GLUSfloat tOffset);
+
 #endif /* GLUS_SHAPE_TEXGEN_H_ */
@@ -0,0 +1,126 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_SHAPE_TILE_H_
+#define GLUS_SHAPE_TILE_H_
+
+/**
+ * Restart index of the triangle strips of a tile. Matches the fixed restart
+ * index of unsigned short indices.
+ */
+#define GLUS_TILE_RESTART_INDEX 0xFFFF
+
+/**
+ * Grid plane, which is drawn as several instances of one tile. Only the
+ * vertices of one tile are stored. Every instance is moved by its tile offset,
+ * e.g. given as an instanced attribute.
+ *
+ * The vertex at row r and column c of the grid is the tile vertex plus the
+ * offset of the tile containing it. The normal of all vertices is (0, 0, 1)
+ * and the tangent is (1, 0, 0).
+ */
+typedef struct _GLUStiledgrid {
+  /**
+   * Vertices of the tile as four floats, relative to the lower left corner of
+   * the tile.
+   */
+  GLUSfloat *vertices;
+
+  /**
+   * Texture coordinates of the tile as two floats, relative to the lower left
+   * corner of the tile.
+   */
+  GLUSfloat *texCoords;
+
+  /**
+   * Indices of the tile.
+   */
+  GLUSushort *indices;
+
+  /**
+   * Number of vertices of the tile.
+   */
+  GLUSuint numberVertices;
+
+  /**
+   * Number of indices of the tile.
+   */
+  GLUSuint numberIndices;
+
+  /**
+   * GLUS_TRIANGLES or GLUS_TRIANGLE_STRIP. Strips are separated by
+   * GLUS_TILE_RESTART_INDEX, so primitive restart has to be enabled.
+   */
+  GLUSenum mode;
+
+  /**
+   * Offsets of the tiles as four floats: x, y, s and t. The first tile is the
+   * upper left one, continued row by row.
+   */
+  GLUSfloat *tileOffsets;
+
+  /**
+   * Number of tiles in horizontal and vertical direction.
+   */
+  GLUSuint numberTileColumns;
+  GLUSuint numberTileRows;
+
+  /**
+   * Number of tiles.
+   */
+  GLUSuint numberTiles;
+
+} GLUStiledgrid;
+
+/**
+ * Creates a rectangular grid plane as tiles, which share their vertices and
+ * indices. The grid is the same as the one of
+ * glusShapeCreateRectangularGridPlanef, but its size is not limited by
+ * GLUS_MAX_VERTICES.
+ *
+ * @param tiledGrid 		The data is stored into this structure.
+ * @param horizontalExtend 	The width of the plane, which is centered at the
+ * origin.
+ * @param verticalExtend 	The height of the plane, which is centered at the
+ * origin.
+ * @param rows 				The number of rows of the grid. Has to be a
+ * multiple of tileRows.
+ * @param columns 			The number of columns of the grid. Has to be a
+ * multiple of tileColumns.
+ * @param tileRows 			The number of rows of a tile.
+ * @param tileColumns 		The number of columns of a tile. A tile can have at
+ * most 65535 vertices.
+ * @param triangleStrip 	Set to GLUS_TRUE, if every row of a tile should be a
+ * triangle strip.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeCreateTiledGridPlanef(
+    GLUStiledgrid *tiledGrid, const GLUSfloat horizontalExtend,
+    const GLUSfloat verticalExtend, const GLUSuint rows, const GLUSuint columns,
+    const GLUSuint tileRows, const GLUSuint tileColumns,
+    const GLUSboolean triangleStrip);
+
+/**
+ * Destroys the tiled grid by freeing the allocated memory.
+ *
+ * @param tiledGrid The tiled grid, which contains the data.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusTiledGridDestroyf(GLUStiledgrid *tiledGrid);
+
+#endif /* GLUS_SHAPE_TILE_H_ */
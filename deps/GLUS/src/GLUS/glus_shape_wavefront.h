@@ -30,4 +30,17 @@
 GLUSAPI GLUSboolean GLUSAPIENTRY
 glusShapeLoadWavefront(const GLUSchar *filename, GLUSshape *shape);
 
+/**
+ * Loads a wavefront object file.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param shape The data is stored into this structure.
+ * @param options The loading options. If 0, the default options are used.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY
+glusShapeLoadWavefrontWithOptions(const GLUSchar *filename, GLUSshape *shape,
+                                  const GLUSwavefrontoptions *options);
+
 #endif /* GLUS_SHAPE_WAVEFRONT_H_ */
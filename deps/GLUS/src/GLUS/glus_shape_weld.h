@@ -0,0 +1,48 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_SHAPE_WELD_H_
+#define GLUS_SHAPE_WELD_H_
+
+/**
+ * Merges the vertices of a shape, which are equal within a tolerance, and
+ * remaps the indices. Two vertices are equal, if every position coordinate
+ * differs by at most the tolerance and, for every compared attribute, every
+ * component differs by at most the attribute tolerance.
+ *
+ * The vertices are visited in order. A vertex is merged into the first
+ * earlier vertex, which is equal and has not been merged itself. The merged
+ * vertices keep the order and the attributes of their first vertex. All
+ * attribute arrays of the shape are compacted.
+ *
+ * @param shape 				The shape to weld.
+ * @param tolerance 			The position tolerance. Zero merges only
+ * identical positions.
+ * @param attributes 			The attributes, which have to be equal as
+ * well, as a combination of GLUS_ATTRIBUTE_NORMALS, GLUS_ATTRIBUTE_TEXCOORDS,
+ * GLUS_ATTRIBUTE_TANGENTS and GLUS_ATTRIBUTE_BITANGENTS. Missing attributes
+ * are not compared.
+ * @param attributeTolerance 	The tolerance of the compared attributes.
+ *
+ * @return GLUS_TRUE, if welding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeWeldf(
+    GLUSshape *shape, const GLUSfloat tolerance, const GLUSbitfield attributes,
+    const GLUSfloat attributeTolerance);
+
+#endif /* GLUS_SHAPE_WELD_H_ */
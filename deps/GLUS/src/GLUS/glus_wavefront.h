@@ -19,6 +19,23 @@
 #ifndef GLUS_WAVEFRONT_H_
 #define GLUS_WAVEFRONT_H_
 
+/**
+ * Attributes, which can be created by loading a wavefront file. The vertices
+ * are always created. Tangents and bitangents need texture coordinates.
+ */
+#define GLUS_ATTRIBUTE_NORMALS 0x0001
+#define GLUS_ATTRIBUTE_TEXCOORDS 0x0002
+#define GLUS_ATTRIBUTE_TANGENTS 0x0004
+#define GLUS_ATTRIBUTE_BITANGENTS 0x0008
+#define GLUS_ATTRIBUTE_ALL_ATTRIBUTES 0x0010
+
+/**
+ * The attributes created by default.
+ */
+#define GLUS_ATTRIBUTE_DEFAULT                                                 \
+  (GLUS_ATTRIBUTE_NORMALS | GLUS_ATTRIBUTE_TEXCOORDS |                         \
+   GLUS_ATTRIBUTE_TANGENTS | GLUS_ATTRIBUTE_BITANGENTS)
+
 /**
  * Structure for holding material data.
  */
@@ -216,6 +233,27 @@ typedef struct _GLUSgroupList {
 
 } GLUSgroupList;
 
+/**
+ * Range of the merged indices, which is drawn with one material.
+ */
+typedef struct _GLUSmaterialrange {
+  /**
+   * Pointer to the material. 0, if the groups have no material.
+   */
+  GLUSmaterial *material;
+
+  /**
+   * First index of the range.
+   */
+  GLUSuint firstIndex;
+
+  /**
+   * Number of indices.
+   */
+  GLUSuint numberIndices;
+
+} GLUSmaterialrange;
+
 /**
  * Structure for a complete wavefront object file.
  */
@@ -275,6 +313,18 @@ typedef struct _GLUSwavefront {
    */
   GLUSuint texCoordsVBO;
 
+  /**
+   * All attributes interleaved with the layout vertex, normal, tangent,
+   * bitangent and texture coordinate. Only created, if requested by the
+   * loading options.
+   */
+  GLUSfloat *allAttributes;
+
+  /**
+   * All attributes VBO.
+   */
+  GLUSuint allAttributesVBO;
+
   /**
    * Number of vertices.
    */
@@ -290,6 +340,42 @@ typedef struct _GLUSwavefront {
    */
   GLUSmaterialList *materials;
 
+  /**
+   * If the groups are merged, the indices of all groups. The groups are sorted
+   * by material and their indices point into this array. Otherwise 0.
+   */
+  GLUSindex *indices;
+
+  /**
+   * Merged indices VBO.
+   */
+  GLUSuint indicesVBO;
+
+  /**
+   * VAO of the merged indices.
+   */
+  GLUSuint vao;
+
+  /**
+   * Number of merged indices.
+   */
+  GLUSuint numberIndices;
+
+  /**
+   * If the groups are merged, one range per material. Otherwise 0.
+   */
+  GLUSmaterialrange *ranges;
+
+  /**
+   * Number of ranges.
+   */
+  GLUSuint numberRanges;
+
+  /**
+   * The memory mapped cache file, if all data is stored in it. Otherwise 0.
+   */
+  GLUSvoid *cache;
+
 } GLUSwavefront;
 
 /**
@@ -317,8 +403,111 @@ typedef struct _GLUSscene {
    */
   GLUSobjectList *objectList;
 
+  /**
+   * The memory mapped cache file, if all data is stored in it. Otherwise 0.
+   */
+  GLUSvoid *cache;
+
 } GLUSscene;
 
+/**
+ * Structure for the wavefront loading options.
+ */
+typedef struct _GLUSwavefrontoptions {
+  /**
+   * If GLUS_TRUE, triangle corners with the same vertex, texture coordinate and
+   * normal indices share one vertex. Otherwise, every triangle corner gets its
+   * own vertex.
+   */
+  GLUSboolean indexed;
+
+  /**
+   * Number of threads used for parsing. If 0, one thread per processor is
+   * used. The loaded data does not depend on the number of threads. Without
+   * OpenMP support, the file is always parsed by one thread.
+   */
+  GLUSuint numberThreads;
+
+  /**
+   * If GLUS_TRUE, the groups are sorted by material and their indices are
+   * stored one after another in one array. Then, every material needs only one
+   * draw call with the given range.
+   */
+  GLUSboolean mergeGroups;
+
+  /**
+   * If GLUS_TRUE, the loaded data is stored in a binary cache file next to the
+   * wavefront file, e.g. model.obj.wavefront.glusmesh. As long as the
+   * wavefront and material files do not change, later loads map the cache
+   * file into memory instead of parsing. Data loaded from a cache must not be
+   * freed or reallocated partially, only by the destroy functions. Default is
+   * GLUS_FALSE, as the directory of the wavefront file has to be writable.
+   */
+  GLUSboolean cache;
+
+  /**
+   * The attributes to create as a combination of the GLUS_ATTRIBUTE_* flags.
+   * Attributes, which are not requested, are neither calculated nor kept in
+   * memory. Default is GLUS_ATTRIBUTE_DEFAULT.
+   */
+  GLUSbitfield attributes;
+
+} GLUSwavefrontoptions;
+
+/**
+ * Structure for a batch of triangles, which is passed to the stream function.
+ */
+typedef struct _GLUSwavefrontbatch {
+  /**
+   * Vertices with the layout x, y, z and w. Three vertices per triangle.
+   */
+  const GLUSfloat *vertices;
+
+  /**
+   * Normals with the layout x, y and z. Zero, if a vertex has no normal.
+   */
+  const GLUSfloat *normals;
+
+  /**
+   * Texture coordinates with the layout s and t. Zero, if a vertex has no
+   * texture coordinate.
+   */
+  const GLUSfloat *texCoords;
+
+  /**
+   * Number of vertices, always a multiple of three.
+   */
+  GLUSuint numberVertices;
+
+  /**
+   * Indices of the object, group and material, all triangles of the batch
+   * belong to. Objects and groups are counted in the order of appearance.
+   * Materials are counted by name, so a material used again keeps its index.
+   * -1, if there is none.
+   */
+  GLUSint objectIndex;
+  GLUSint groupIndex;
+  GLUSint materialIndex;
+
+  /**
+   * Names of the object, group and material.
+   */
+  const GLUSchar *objectName;
+  const GLUSchar *groupName;
+  const GLUSchar *materialName;
+
+} GLUSwavefrontbatch;
+
+/**
+ * Initializes the wavefront loading options with the default values. The
+ * default values are the same as used by the loading functions without
+ * options.
+ *
+ * @param options The options to initialize.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY
+glusWavefrontInitOptions(GLUSwavefrontoptions *options);
+
 /**
  * Loads a wavefront object file with groups and materials.
  *
@@ -330,6 +519,19 @@ typedef struct _GLUSscene {
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar *filename,
                                                    GLUSwavefront *wavefront);
 
+/**
+ * Loads a wavefront object file with groups and materials.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param wavefront The data is stored into this structure.
+ * @param options The loading options. If 0, the default options are used.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY
+glusWavefrontLoadWithOptions(const GLUSchar *filename, GLUSwavefront *wavefront,
+                             const GLUSwavefrontoptions *options);
+
 /**
  * Destroys the wavefront structure by freeing the allocated memory. VBOs, VAOs
  * and textures are not freed.
@@ -350,6 +552,19 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront *wavefront);
 GLUSAPI GLUSboolean GLUSAPIENTRY
 glusWavefrontLoadScene(const GLUSchar *filename, GLUSscene *scene);
 
+/**
+ * Loads a wavefront scene file with objects, groups and materials.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param scene The data is stored into this structure.
+ * @param options The loading options. If 0, the default options are used.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY
+glusWavefrontLoadSceneWithOptions(const GLUSchar *filename, GLUSscene *scene,
+                                  const GLUSwavefrontoptions *options);
+
 /**
  * Destroys the wavefront structure by freeing the allocated memory. VBOs, VAOs
  * and textures are not freed.
@@ -359,4 +574,27 @@ glusWavefrontLoadScene(const GLUSchar *filename, GLUSscene *scene);
  */
 GLUSAPI GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene *scene);
 
+/**
+ * Streams the triangles of a wavefront object file in batches to the given
+ * function, without building the whole mesh in memory. The file is read in
+ * blocks, so only the vertices, normals and texture coordinates are kept, as a
+ * face can reference any of them. Material libraries are not loaded.
+ *
+ * The batch and its arrays are only valid during the call of the function.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param numberTriangles Maximum number of triangles per batch. If 0, a
+ * default is used.
+ * @param glusStreamFunc The function receiving the batches. If it does not
+ * return GLUS_TRUE, streaming is stopped.
+ * @param userData Passed to the function.
+ *
+ * @return GLUS_TRUE, if the whole file was streamed.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontStream(
+    const GLUSchar *filename, GLUSuint numberTriangles,
+    GLUSboolean (*glusStreamFunc)(const GLUSwavefrontbatch *batch,
+                                  GLUSvoid *userData),
+    GLUSvoid *userData);
+
 #endif /* GLUS_WAVEFRONT_H_ */
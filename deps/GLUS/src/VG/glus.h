@@ -226,6 +226,7 @@ extern "C" {
 #include "../GLUS/glus_image_hdr.h"
 #include "../GLUS/glus_image_pkm.h"
 #include "../GLUS/glus_image_tga.h"
+#include "../GLUS/glus_image_batch.h"
 
 #include "../GLUS/glus_file_binary.h"
 #include "../GLUS/glus_file_text.h"
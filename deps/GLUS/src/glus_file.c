@@ -18,6 +18,17 @@
 
 #include "GL/glus.h"
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 GLUSboolean _glusFileCheckRead(FILE *f, size_t actualRead,
                                size_t expectedRead) {
   if (!f) {
@@ -50,6 +61,96 @@ GLUSboolean _glusFileCheckWrite(FILE *f, size_t actualWrite,
   return GLUS_TRUE;
 }
 
+// Maps a whole file into memory. The filename is used as is. A copy on write
+// mapping can be changed without changing the file.
+GLUSubyte *_glusFileMap(const GLUSchar *filename, size_t *size,
+                        GLUSboolean copyOnWrite) {
+  GLUSubyte *data;
+
+#if defined(_WIN32)
+  HANDLE file;
+  HANDLE mapping;
+
+  LARGE_INTEGER fileSize;
+
+  file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                     FILE_ATTRIBUTE_NORMAL, 0);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    return 0;
+  }
+
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 ||
+      (GLUSuint64)fileSize.QuadPart > (size_t)-1) {
+    CloseHandle(file);
+
+    return 0;
+  }
+
+  *size = (size_t)fileSize.QuadPart;
+
+  mapping = CreateFileMappingA(file, 0,
+                               copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0,
+                               0, 0);
+
+  CloseHandle(file);
+
+  if (!mapping) {
+    return 0;
+  }
+
+  data = (GLUSubyte *)MapViewOfFile(
+      mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+
+  CloseHandle(mapping);
+
+  return data;
+#else
+  int file;
+
+  struct stat fileStatus;
+
+  file = open(filename, O_RDONLY);
+
+  if (file < 0) {
+    return 0;
+  }
+
+  if (fstat(file, &fileStatus) != 0 || fileStatus.st_size <= 0 ||
+      (GLUSuint64)fileStatus.st_size > (size_t)-1) {
+    close(file);
+
+    return 0;
+  }
+
+  *size = (size_t)fileStatus.st_size;
+
+  data = (GLUSubyte *)mmap(
+      0, *size, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE,
+      file, 0);
+
+  close(file);
+
+  if (data == MAP_FAILED) {
+    return 0;
+  }
+
+  return data;
+#endif
+}
+
+GLUSvoid _glusFileUnmap(GLUSubyte *data, size_t size) {
+  if (!data) {
+    return;
+  }
+
+#if defined(_WIN32)
+  UnmapViewOfFile(data);
+#else
+  munmap(data, size);
+#endif
+}
+
 FILE *GLUSAPIENTRY glusFileOpen(const char *filename, const char *mode) {
   char buffer[GLUS_MAX_FILENAME];
 
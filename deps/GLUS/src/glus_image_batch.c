@@ -0,0 +1,439 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// The data of every image starts at a multiple of this alignment.
+#define GLUS_BATCH_ALIGNMENT 16
+
+#define GLUS_BATCH_NONE 0
+#define GLUS_BATCH_TGA 1
+#define GLUS_BATCH_HDR 2
+#define GLUS_BATCH_PKM 3
+
+extern GLUSubyte *_glusFileMap(const GLUSchar *filename, size_t *size,
+                               GLUSboolean copyOnWrite);
+
+extern GLUSvoid _glusFileUnmap(GLUSubyte *data, size_t size);
+
+extern GLUSboolean _glusImageReadTgaHeader(const GLUSubyte *buffer,
+                                           size_t length,
+                                           GLUStgaimage *tgaimage);
+
+extern GLUSboolean _glusImageDecodeTga(const GLUSubyte *buffer, size_t length,
+                                       GLUStgaimage *tgaimage);
+
+extern GLUSboolean _glusImageReadHdrHeader(const GLUSubyte *buffer,
+                                           size_t length,
+                                           GLUShdrimage *hdrimage);
+
+extern GLUSboolean _glusImageDecodeHdr(const GLUSubyte *buffer, size_t length,
+                                       GLUShdrimage *hdrimage);
+
+extern size_t _glusImageGetHdrPixelSize(GLUSenum type);
+
+extern GLUSboolean _glusImageReadPkmHeader(const GLUSubyte *buffer,
+                                           size_t length,
+                                           GLUSpkmimage *pkmimage);
+
+extern GLUSboolean _glusImageDecodePkm(const GLUSubyte *buffer, size_t length,
+                                       GLUSpkmimage *pkmimage);
+
+/**
+ * Structure for a file, while the batch is loaded.
+ */
+typedef struct _GLUSbatchfile {
+  /**
+   * The mapped file. 0, if the file could not be mapped or the header is
+   * invalid.
+   */
+  GLUSubyte *data;
+
+  /**
+   * The size of the mapped file.
+   */
+  size_t size;
+
+  /**
+   * The type of the file.
+   */
+  GLUSint type;
+
+  /**
+   * The size of the image data in bytes.
+   */
+  size_t imageSize;
+
+} GLUSbatchfile;
+
+static GLUSint glusImageGetBatchType(const GLUSchar *filename) {
+  const GLUSchar *extension;
+
+  GLUSchar buffer[5];
+
+  GLUSint i;
+
+  extension = strrchr(filename, '.');
+
+  if (!extension || strlen(extension) != 4) {
+    return GLUS_BATCH_NONE;
+  }
+
+  for (i = 0; i < 4; i++) {
+    buffer[i] = (GLUSchar)tolower(extension[i]);
+  }
+  buffer[4] = '\0';
+
+  if (strcmp(buffer, ".tga") == 0) {
+    return GLUS_BATCH_TGA;
+  }
+
+  if (strcmp(buffer, ".hdr") == 0) {
+    return GLUS_BATCH_HDR;
+  }
+
+  if (strcmp(buffer, ".pkm") == 0) {
+    return GLUS_BATCH_PKM;
+  }
+
+  return GLUS_BATCH_NONE;
+}
+
+// Maps the file and reads the header of the image, so the size of the image
+// data is known. HDR images are stored in the given type.
+static GLUSvoid glusImageOpenBatchFile(GLUSbatchfile *file,
+                                       const GLUSchar *filename,
+                                       GLUSimagebatch *batch, GLUSuint index,
+                                       GLUSenum hdrType) {
+  GLUSchar buffer[GLUS_MAX_FILENAME];
+
+  GLUSboolean result = GLUS_FALSE;
+
+  file->type = GLUS_BATCH_NONE;
+
+  if (!filename) {
+    return;
+  }
+
+  file->type = glusImageGetBatchType(filename);
+
+  if (file->type == GLUS_BATCH_NONE) {
+    return;
+  }
+
+  if (strlen(GLUS_BASE_DIRECTORY) + strlen(filename) >= GLUS_MAX_FILENAME) {
+    return;
+  }
+
+  strcpy(buffer, GLUS_BASE_DIRECTORY);
+  strcat(buffer, filename);
+
+  file->data = _glusFileMap(buffer, &file->size, GLUS_FALSE);
+
+  if (!file->data) {
+    return;
+  }
+
+  switch (file->type) {
+  case GLUS_BATCH_TGA:
+    result = _glusImageReadTgaHeader(file->data, file->size,
+                                     &batch->tgaimages[index]);
+
+    if (result) {
+      file->imageSize = (size_t)batch->tgaimages[index].width *
+                        batch->tgaimages[index].height;
+
+      if (batch->tgaimages[index].format == GLUS_RGB) {
+        file->imageSize *= 3;
+      } else if (batch->tgaimages[index].format == GLUS_RGBA) {
+        file->imageSize *= 4;
+      }
+    }
+    break;
+  case GLUS_BATCH_HDR:
+    result = _glusImageReadHdrHeader(file->data, file->size,
+                                     &batch->hdrimages[index]);
+
+    if (result) {
+      GLUSuint64 imageSize = (GLUSuint64)batch->hdrimages[index].width *
+                             batch->hdrimages[index].height *
+                             _glusImageGetHdrPixelSize(hdrType);
+
+      batch->hdrimages[index].type = hdrType;
+
+      // A large image does not fit into the address space of a 32 bit target.
+      result = imageSize <= (size_t)-1;
+
+      file->imageSize = (size_t)imageSize;
+    }
+    break;
+  case GLUS_BATCH_PKM:
+    result = _glusImageReadPkmHeader(file->data, file->size,
+                                     &batch->pkmimages[index]);
+
+    if (result) {
+      file->imageSize = (size_t)batch->pkmimages[index].imageSize;
+    }
+    break;
+  }
+
+  if (!result) {
+    _glusFileUnmap(file->data, file->size);
+
+    file->data = 0;
+  }
+}
+
+// Decodes the image into its part of the batch data and unmaps the file.
+static GLUSvoid glusImageDecodeBatchFile(GLUSbatchfile *file,
+                                         GLUSimagebatch *batch,
+                                         GLUSuint index) {
+  GLUSubyte *data = batch->data + batch->offsets[index];
+
+  GLUSboolean result = GLUS_FALSE;
+
+  switch (file->type) {
+  case GLUS_BATCH_TGA:
+    batch->tgaimages[index].data = data;
+
+    result = _glusImageDecodeTga(file->data, file->size,
+                                 &batch->tgaimages[index]);
+
+    if (!result) {
+      memset(&batch->tgaimages[index], 0, sizeof(GLUStgaimage));
+    }
+    break;
+  case GLUS_BATCH_HDR:
+    batch->hdrimages[index].data = (GLUSfloat *)data;
+
+    result = _glusImageDecodeHdr(file->data, file->size,
+                                 &batch->hdrimages[index]);
+
+    if (!result) {
+      memset(&batch->hdrimages[index], 0, sizeof(GLUShdrimage));
+    }
+    break;
+  case GLUS_BATCH_PKM:
+    batch->pkmimages[index].data = data;
+
+    result = _glusImageDecodePkm(file->data, file->size,
+                                 &batch->pkmimages[index]);
+
+    if (!result) {
+      memset(&batch->pkmimages[index], 0, sizeof(GLUSpkmimage));
+    }
+    break;
+  }
+
+  batch->loaded[index] = result;
+
+  _glusFileUnmap(file->data, file->size);
+
+  file->data = 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadBatchPacked(
+    GLUSimagebatch *batch, const GLUSchar **filenames,
+    const GLUSuint numberFilenames, const GLUSuint numberThreads,
+    const GLUSenum hdrType) {
+  GLUSbatchfile *files;
+
+  size_t offset;
+
+#ifdef _OPENMP
+  GLUSuint threads = numberThreads;
+#endif
+
+  GLUSboolean result = GLUS_TRUE;
+
+  GLUSint i;
+
+  if (!batch) {
+    return GLUS_FALSE;
+  }
+
+  memset(batch, 0, sizeof(GLUSimagebatch));
+
+  if (!filenames || numberFilenames == 0 ||
+      !_glusImageGetHdrPixelSize(hdrType)) {
+    return GLUS_FALSE;
+  }
+
+#ifdef _OPENMP
+  if (threads == 0) {
+    threads = (GLUSuint)omp_get_num_procs();
+  }
+#else
+  (void)numberThreads;
+#endif
+
+  files = (GLUSbatchfile *)glusMemoryMalloc(numberFilenames *
+                                            sizeof(GLUSbatchfile));
+
+  batch->loaded = (GLUSboolean *)glusMemoryMalloc(numberFilenames *
+                                                  sizeof(GLUSboolean));
+  batch->tgaimages = (GLUStgaimage *)glusMemoryMalloc(numberFilenames *
+                                                      sizeof(GLUStgaimage));
+  batch->hdrimages = (GLUShdrimage *)glusMemoryMalloc(numberFilenames *
+                                                      sizeof(GLUShdrimage));
+  batch->pkmimages = (GLUSpkmimage *)glusMemoryMalloc(numberFilenames *
+                                                      sizeof(GLUSpkmimage));
+  batch->offsets =
+      (size_t *)glusMemoryMalloc(numberFilenames * sizeof(size_t));
+
+  if (!files || !batch->loaded || !batch->tgaimages || !batch->hdrimages ||
+      !batch->pkmimages || !batch->offsets) {
+    glusMemoryFree(files);
+
+    glusImageDestroyBatch(batch);
+
+    return GLUS_FALSE;
+  }
+
+  memset(files, 0, numberFilenames * sizeof(GLUSbatchfile));
+
+  memset(batch->loaded, 0, numberFilenames * sizeof(GLUSboolean));
+  memset(batch->tgaimages, 0, numberFilenames * sizeof(GLUStgaimage));
+  memset(batch->hdrimages, 0, numberFilenames * sizeof(GLUShdrimage));
+  memset(batch->pkmimages, 0, numberFilenames * sizeof(GLUSpkmimage));
+  memset(batch->offsets, 0, numberFilenames * sizeof(size_t));
+
+  batch->numberImages = numberFilenames;
+
+  // Only the headers are read, so the files are opened in parallel mainly to
+  // overlap the waiting for the file system.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+#endif
+  for (i = 0; i < (GLUSint)numberFilenames; i++) {
+    glusImageOpenBatchFile(&files[i], filenames[i], batch, (GLUSuint)i,
+                           hdrType);
+  }
+
+  // The images are stored in the order of the files.
+
+  offset = 0;
+
+  for (i = 0; i < (GLUSint)numberFilenames; i++) {
+    if (!files[i].data) {
+      continue;
+    }
+
+    // All images have to fit into the address space, otherwise the file is
+    // not loaded.
+    if (files[i].imageSize > (size_t)-1 - GLUS_BATCH_ALIGNMENT - offset) {
+      _glusFileUnmap(files[i].data, files[i].size);
+
+      files[i].data = 0;
+
+      continue;
+    }
+
+    offset = (offset + GLUS_BATCH_ALIGNMENT - 1) &
+             ~((size_t)GLUS_BATCH_ALIGNMENT - 1);
+
+    batch->offsets[i] = offset;
+
+    offset += files[i].imageSize;
+  }
+
+  if (offset > 0) {
+    batch->data = (GLUSubyte *)glusMemoryMalloc(offset);
+
+    if (!batch->data) {
+      for (i = 0; i < (GLUSint)numberFilenames; i++) {
+        if (files[i].data) {
+          _glusFileUnmap(files[i].data, files[i].size);
+        }
+      }
+
+      glusMemoryFree(files);
+
+      glusImageDestroyBatch(batch);
+
+      return GLUS_FALSE;
+    }
+
+    batch->size = offset;
+  }
+
+  // Images of different size and type take different time, so every thread
+  // takes the next file, when it is done.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+#endif
+  for (i = 0; i < (GLUSint)numberFilenames; i++) {
+    if (files[i].data) {
+      glusImageDecodeBatchFile(&files[i], batch, (GLUSuint)i);
+    }
+  }
+
+  for (i = 0; i < (GLUSint)numberFilenames; i++) {
+    if (!batch->loaded[i]) {
+      result = GLUS_FALSE;
+    }
+  }
+
+  glusMemoryFree(files);
+
+  return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadBatch(GLUSimagebatch *batch,
+                                            const GLUSchar **filenames,
+                                            const GLUSuint numberFilenames,
+                                            const GLUSuint numberThreads) {
+  return glusImageLoadBatchPacked(batch, filenames, numberFilenames,
+                                  numberThreads, GLUS_FLOAT);
+}
+
+GLUSvoid GLUSAPIENTRY glusImageDestroyBatch(GLUSimagebatch *batch) {
+  if (!batch) {
+    return;
+  }
+
+  if (batch->data) {
+    glusMemoryFree(batch->data);
+  }
+
+  if (batch->offsets) {
+    glusMemoryFree(batch->offsets);
+  }
+
+  if (batch->pkmimages) {
+    glusMemoryFree(batch->pkmimages);
+  }
+
+  if (batch->hdrimages) {
+    glusMemoryFree(batch->hdrimages);
+  }
+
+  if (batch->tgaimages) {
+    glusMemoryFree(batch->tgaimages);
+  }
+
+  if (batch->loaded) {
+    glusMemoryFree(batch->loaded);
+  }
+
+  memset(batch, 0, sizeof(GLUSimagebatch));
+}
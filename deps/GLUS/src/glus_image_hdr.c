@@ -18,24 +18,210 @@
 
 #include "GL/glus.h"
 
+// Width and height are stored as GLUSushort, so the previous loader accepted
+// all sizes up to 65535.
+#define GLUS_MAX_DIMENSION 65535
+
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4],
                                              GLUSfloat sampleWeight[2],
                                              const GLUSfloat st[2],
                                              GLUSint width, GLUSint height,
                                              GLUSint stride);
 
-extern GLUSboolean _glusFileCheckRead(FILE *f, size_t actualRead,
-                                      size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE *f, size_t actualWrite,
                                        size_t expectedWrite);
 
-static GLUSvoid glusImageConvertRGBE(GLUSfloat *rgb, const GLUSubyte *rgbe) {
-  GLUSfloat exponent = (GLUSfloat)(rgbe[3] - 128);
+extern GLUSubyte *_glusFileMap(const GLUSchar *filename, size_t *size,
+                               GLUSboolean copyOnWrite);
+
+extern GLUSvoid _glusFileUnmap(GLUSubyte *data, size_t size);
+
+// Converts RGBE pixels into floats. A channel is mantissa * 2^(exponent - 136),
+// which is exact in single precision, so the power of two is built directly
+// from its bits. Exponents below 10 give a denormalized power of two.
+static GLUSvoid glusImageConvertRGBE(GLUSfloat *rgb, const GLUSubyte *red,
+                                     const GLUSubyte *green,
+                                     const GLUSubyte *blue,
+                                     const GLUSubyte *exponent, GLUSint stride,
+                                     GLUSint numberPixels) {
+  GLUSuint bits, value;
+  GLUSfloat scale;
+
+  GLUSint i;
+
+  for (i = 0; i < numberPixels; i++) {
+    value = exponent[i * stride];
+
+    bits = value >= 10 ? (value - 9) << 23 : 1u << (value + 13);
+
+    memcpy(&scale, &bits, sizeof(GLUSfloat));
+
+    rgb[3 * i + 0] = (GLUSfloat)red[i * stride] * scale;
+    rgb[3 * i + 1] = (GLUSfloat)green[i * stride] * scale;
+    rgb[3 * i + 2] = (GLUSfloat)blue[i * stride] * scale;
+  }
+}
+
+// Packs non negative, finite floats into half floats, rounded to nearest even
+// like glusMathFloatToHalff. Both the denormalized and the normalized result
+// are calculated and selected with masks, so the loop can be vectorized.
+static GLUSvoid glusImagePackHalf(GLUSushort *half, const GLUSfloat *values,
+                                  GLUSint numberValues) {
+  // 0.5 has the unit in the last place of the smallest denormalized half.
+  const GLUSfloat denormalMagic = 0.5f;
+  const GLUSint denormalMagicBits = 0x3F000000;
+
+  GLUSint bits, denormal, normal, isDenormal, isInfinite;
+  GLUSfloat value;
+
+  GLUSint i;
+
+  for (i = 0; i < numberValues; i++) {
+    memcpy(&bits, &values[i], sizeof(GLUSint));
+
+    // The addition rounds away the bits below the denormalized half.
+    value = values[i] + denormalMagic;
+    memcpy(&denormal, &value, sizeof(GLUSint));
+    denormal -= denormalMagicBits;
+
+    // Rebias the exponent and round the mantissa to nearest even. A carry
+    // into the exponent gives the next power of two or infinity.
+    normal = (bits - 0x38000000 + 0xFFF + ((bits >> 13) & 1)) >> 13;
+
+    isDenormal = -(bits < 0x38800000);
+    isInfinite = -(bits >= 0x47800000);
+
+    normal = (denormal & isDenormal) | (normal & ~isDenormal);
+
+    half[i] = (GLUSushort)((0x7C00 & isInfinite) | (normal & ~isInfinite));
+  }
+}
+
+// Packs non negative, finite RGB floats into nine bit mantissas and a shared
+// five bit exponent, as specified by EXT_texture_shared_exponent.
+static GLUSvoid glusImagePackRGB9E5(GLUSuint *packed, const GLUSfloat *rgb,
+                                    GLUSint numberPixels) {
+  // Largest value with a nine bit mantissa and a bias of 15.
+  const GLUSfloat maxValue = 65408.0f;
+
+  GLUSfloat red, green, blue, maxRgb, scale;
+  GLUSuint bits, redMantissa, greenMantissa, blueMantissa, maxMantissa;
+  GLUSint exponent;
+
+  GLUSint i;
+
+  for (i = 0; i < numberPixels; i++) {
+    red = rgb[3 * i + 0] < maxValue ? rgb[3 * i + 0] : maxValue;
+    green = rgb[3 * i + 1] < maxValue ? rgb[3 * i + 1] : maxValue;
+    blue = rgb[3 * i + 2] < maxValue ? rgb[3 * i + 2] : maxValue;
+
+    maxRgb = red > green ? red : green;
+    maxRgb = maxRgb > blue ? maxRgb : blue;
+
+    // floor(log2(maxRgb)) + 1 + 15, at least 0
+    memcpy(&bits, &maxRgb, sizeof(GLUSuint));
+    exponent = (GLUSint)(bits >> 23) - 127 + 16;
+    exponent = exponent > 0 ? exponent : 0;
+
+    // 2^(24 - exponent), scaling the largest value below 512
+    bits = (GLUSuint)(151 - exponent) << 23;
+    memcpy(&scale, &bits, sizeof(GLUSfloat));
+
+    // Rounding up can reach 512, then the next exponent is needed.
+    maxMantissa = (GLUSuint)(GLUSint)(maxRgb * scale + 0.5f) >> 9;
+    exponent += (GLUSint)maxMantissa;
+    bits -= maxMantissa << 23;
+    memcpy(&scale, &bits, sizeof(GLUSfloat));
+
+    // Converting through signed integers is faster on most processors.
+    redMantissa = (GLUSuint)(GLUSint)(red * scale + 0.5f);
+    greenMantissa = (GLUSuint)(GLUSint)(green * scale + 0.5f);
+    blueMantissa = (GLUSuint)(GLUSint)(blue * scale + 0.5f);
+
+    packed[i] = redMantissa | (greenMantissa << 9) | (blueMantissa << 18) |
+                ((GLUSuint)exponent << 27);
+  }
+}
+
+// Unpacks one pixel of a HDR image into floats.
+static GLUSvoid glusImageUnpackHdrPixel(GLUSfloat rgb[3],
+                                        const GLUShdrimage *hdrimage,
+                                        size_t pixel) {
+  const GLUSushort *half;
+  GLUSuint packed, bits;
+  GLUSfloat scale;
+
+  switch (hdrimage->type) {
+  case GLUS_HALF_FLOAT:
+    half = (const GLUSushort *)hdrimage->data + pixel * 3;
+
+    rgb[0] = glusMathHalfToFloatf(half[0]);
+    rgb[1] = glusMathHalfToFloatf(half[1]);
+    rgb[2] = glusMathHalfToFloatf(half[2]);
+    break;
+  case GLUS_UNSIGNED_INT_5_9_9_9_REV:
+    packed = ((const GLUSuint *)hdrimage->data)[pixel];
+
+    // 2^(exponent - 15 - 9)
+    bits = ((packed >> 27) + 103) << 23;
+    memcpy(&scale, &bits, sizeof(GLUSfloat));
+
+    rgb[0] = (GLUSfloat)(packed & 0x1FF) * scale;
+    rgb[1] = (GLUSfloat)((packed >> 9) & 0x1FF) * scale;
+    rgb[2] = (GLUSfloat)((packed >> 18) & 0x1FF) * scale;
+    break;
+  default:
+    rgb[0] = hdrimage->data[pixel * 3 + 0];
+    rgb[1] = hdrimage->data[pixel * 3 + 1];
+    rgb[2] = hdrimage->data[pixel * 3 + 2];
+    break;
+  }
+}
+
+// Returns the size of one RGB pixel in the given type or 0, if the type is not
+// supported.
+size_t _glusImageGetHdrPixelSize(GLUSenum type) {
+  switch (type) {
+  case GLUS_FLOAT:
+    return 3 * sizeof(GLUSfloat);
+  case GLUS_HALF_FLOAT:
+    return 3 * sizeof(GLUSushort);
+  case GLUS_UNSIGNED_INT_5_9_9_9_REV:
+    return sizeof(GLUSuint);
+  }
+
+  return 0;
+}
 
-  rgb[0] = (GLUSfloat)rgbe[0] / 256.0f * powf(2.0f, exponent);
-  rgb[1] = (GLUSfloat)rgbe[1] / 256.0f * powf(2.0f, exponent);
-  rgb[2] = (GLUSfloat)rgbe[2] / 256.0f * powf(2.0f, exponent);
+// Converts a complete scanline of RGBE pixels and stores it in the type of the
+// image. For packed types, the floats are converted into the given row first.
+static GLUSvoid glusImageStoreHdrScanline(
+    GLUShdrimage *hdrimage, GLUSint y, GLUSfloat *row, const GLUSubyte *red,
+    const GLUSubyte *green, const GLUSubyte *blue, const GLUSubyte *exponent,
+    GLUSint stride) {
+  GLUSint width = hdrimage->width;
+
+  size_t pixel = (size_t)width * y;
+
+  switch (hdrimage->type) {
+  case GLUS_HALF_FLOAT:
+    glusImageConvertRGBE(row, red, green, blue, exponent, stride, width);
+
+    glusImagePackHalf((GLUSushort *)hdrimage->data + pixel * 3, row,
+                      width * 3);
+    break;
+  case GLUS_UNSIGNED_INT_5_9_9_9_REV:
+    glusImageConvertRGBE(row, red, green, blue, exponent, stride, width);
+
+    glusImagePackRGB9E5((GLUSuint *)hdrimage->data + pixel, row, width);
+    break;
+  default:
+    glusImageConvertRGBE(&hdrimage->data[pixel * 3], red, green, blue,
+                         exponent, stride, width);
+    break;
+  }
 }
+
 static GLUSvoid glusImageConvertRGB(GLUSubyte *rgbe, const GLUSfloat *rgb) {
   GLUSfloat significant[3];
   GLUSint exponent[3];
@@ -62,78 +248,60 @@ static GLUSvoid glusImageConvertRGB(GLUSubyte *rgbe, const GLUSfloat *rgb) {
   rgbe[3] = (GLUSubyte)(maxExponent + 128);
 }
 
-static GLUSint glusImageDecodeNewRLE(FILE *file, GLUSubyte *scanline,
-                                     GLUSint width) {
-  GLUSint channel, x, scanLength, maxScanLength;
-  GLUSubyte code, channelValue;
-  size_t elementsRead;
+// Decodes a scanline of the new RLE format. The four channels are compressed
+// one after the other, so every channel is stored contiguously in the
+// scanline.
+static GLUSboolean glusImageDecodeNewRLE(const GLUSubyte **current,
+                                         const GLUSubyte *end,
+                                         GLUSubyte *scanline, GLUSint width) {
+  const GLUSubyte *data = *current;
+  GLUSubyte *channelData;
 
-  maxScanLength = 0;
+  GLUSint channel, x, count;
 
-  // read each component
   for (channel = 0; channel < 4; channel++) {
-    x = 0;
+    channelData = &scanline[channel * width];
 
-    scanLength = 0;
+    x = 0;
 
     while (x < width) {
-      elementsRead = fread(&code, 1, 1, file);
-
-      if (!_glusFileCheckRead(file, elementsRead, 1)) {
-        return -1;
+      if (data >= end) {
+        return GLUS_FALSE;
       }
 
-      if (code > 128) {
-        // Run
+      count = *data++;
 
-        code &= 127;
-
-        scanLength += code;
+      if (count > 128) {
+        // Run
 
-        if (scanLength > width) {
-          glusFileClose(file);
+        count -= 128;
 
-          return -1;
+        if (count > width - x || data >= end) {
+          return GLUS_FALSE;
         }
 
-        elementsRead = fread(&channelValue, 1, 1, file);
+        memset(&channelData[x], *data, count);
 
-        if (!_glusFileCheckRead(file, elementsRead, 1)) {
-          return -1;
-        }
-
-        while (code--) {
-          scanline[x++ * 4 + channel] = channelValue;
-        }
+        data++;
       } else {
         // Non-run
 
-        scanLength += code;
-
-        if (scanLength > width) {
-          glusFileClose(file);
-
-          return -1;
+        if (count == 0 || count > width - x || end - data < count) {
+          return GLUS_FALSE;
         }
 
-        while (code--) {
-          elementsRead = fread(&channelValue, 1, 1, file);
+        memcpy(&channelData[x], data, count);
 
-          if (!_glusFileCheckRead(file, elementsRead, 1)) {
-            return -1;
-          }
-
-          scanline[x++ * 4 + channel] = channelValue;
-        }
+        data += count;
       }
-    }
 
-    if (scanLength > maxScanLength) {
-      maxScanLength = scanLength;
+      x += count;
     }
   }
 
-  return maxScanLength;
+  *current = data;
+
+  return GLUS_TRUE;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage *hdrimage,
@@ -164,6 +332,7 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage *hdrimage,
   hdrimage->height = height;
   hdrimage->depth = depth;
   hdrimage->format = format;
+  hdrimage->type = GLUS_FLOAT;
 
   return GLUS_TRUE;
 }
@@ -177,132 +346,143 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage *hdrimage,
 // http://radiance-online.org/cgi-bin/viewcvs.cgi/ray/src/common/color.c?view=markup
 // see http://www.flipcode.com/archives/HDR_Image_Reader.shtml
 
-GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar *filename,
-                                          GLUShdrimage *hdrimage) {
-  FILE *file;
+// Parses the information header and the resolution. Returns the beginning of
+// the scanlines or 0, if the header is invalid.
+static const GLUSubyte *glusImageParseHdrHeader(const GLUSubyte *buffer,
+                                                size_t length, GLUSint *width,
+                                                GLUSint *height) {
+  const GLUSubyte *current;
+  const GLUSubyte *end;
 
-  GLUSchar buffer[256];
-  GLUSchar currentChar, oldChar;
+  GLUSchar line[256];
 
-  GLUSint width, height, x, y, repeat, factor, i;
+  GLUSint i;
 
-  GLUSubyte *scanline;
-  GLUSubyte rgbe[4];
-  GLUSubyte prevRgbe[4];
+  end = buffer + length;
 
-  GLUSfloat rgb[3];
+  //
+  // Information header
+  //
 
-  size_t elementsRead;
+  // Identifier
+  if (length < 10 || (memcmp(buffer, "#?RADIANCE", 10) != 0 &&
+                      memcmp(buffer, "#?RGBE", 6) != 0)) {
+    return 0;
+  }
 
-  // check, if we have a valid pointer
-  if (!filename || !hdrimage) {
-    return GLUS_FALSE;
+  // Variables, an empty line indicates end of header
+  current = buffer + 6;
+  while (current + 1 < end && !(current[0] == '\n' && current[1] == '\n')) {
+    current++;
   }
 
-  hdrimage->width = 0;
-  hdrimage->height = 0;
-  hdrimage->depth = 0;
-  hdrimage->data = 0;
+  if (current + 1 >= end) {
+    return 0;
+  }
 
-  // open filename in "read binary" mode
-  file = glusFileOpen(filename, "rb");
+  current += 2;
 
-  if (!file) {
-    return GLUS_FALSE;
+  // Resolution
+  i = 0;
+  while (current < end && *current != '\n' && i < 255) {
+    line[i++] = (GLUSchar)*current++;
+  }
+  line[i] = 0;
+
+  if (current >= end || *current != '\n') {
+    return 0;
   }
 
-  elementsRead = fread(buffer, 10, 1, file);
+  current++;
 
-  if (!_glusFileCheckRead(file, elementsRead, 1)) {
-    return GLUS_FALSE;
+  if (sscanf(line, "-Y %d +X %d", height, width) != 2 || *width < 1 ||
+      *height < 1 || *width > GLUS_MAX_DIMENSION ||
+      *height > GLUS_MAX_DIMENSION) {
+    return 0;
   }
 
-  //
-  // Information header
-  //
+  return current;
+}
 
-  // Identifier
-  if (strncmp(buffer, "#?RADIANCE", 10)) {
-    glusFileClose(file);
+// Reads and checks the HDR header. The size, depth and format of the image are
+// set, the data is not allocated.
+GLUSboolean _glusImageReadHdrHeader(const GLUSubyte *buffer, size_t length,
+                                    GLUShdrimage *hdrimage) {
+  GLUSint width, height;
 
+  // check, if we have a valid pointer
+  if (!buffer || !hdrimage) {
     return GLUS_FALSE;
   }
 
-  // Go to variables
-  if (fseek(file, 1, SEEK_CUR)) {
-    glusFileClose(file);
+  hdrimage->width = 0;
+  hdrimage->height = 0;
+  hdrimage->depth = 0;
+  hdrimage->data = 0;
+  hdrimage->format = 0;
+  hdrimage->type = 0;
 
+  if (!glusImageParseHdrHeader(buffer, length, &width, &height)) {
     return GLUS_FALSE;
   }
 
-  // Variables
-  currentChar = 0;
-  while (GLUS_TRUE) {
-    oldChar = currentChar;
-
-    elementsRead = fread(&currentChar, 1, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1)) {
-      return GLUS_FALSE;
-    }
-
-    // Empty line indicates end of header
-    if (currentChar == '\n' && oldChar == '\n') {
-      break;
-    }
-  }
+  hdrimage->width = (GLUSushort)width;
+  hdrimage->height = (GLUSushort)height;
+  hdrimage->depth = 1;
+  hdrimage->format = GLUS_RGB;
+  hdrimage->type = GLUS_FLOAT;
 
-  // Resolution
-  i = 0;
-  while (GLUS_TRUE) {
-    elementsRead = fread(&currentChar, 1, 1, file);
+  return GLUS_TRUE;
+}
 
-    if (!_glusFileCheckRead(file, elementsRead, 1)) {
-      return GLUS_FALSE;
-    }
+// Decodes the scanlines into the already allocated data of the image. The
+// image has to be filled by _glusImageReadHdrHeader before, the type of the
+// image selects the stored type.
+GLUSboolean _glusImageDecodeHdr(const GLUSubyte *buffer, size_t length,
+                                GLUShdrimage *hdrimage) {
+  const GLUSubyte *current;
+  const GLUSubyte *end;
 
-    buffer[i++] = currentChar;
+  GLUSint width, height, x, y;
 
-    if (currentChar == '\n') {
-      break;
-    }
-  }
+  size_t remaining, repeat, factor;
 
-  if (!sscanf(buffer, "-Y %d +X %d", &height, &width)) {
-    glusFileClose(file);
+  GLUSubyte *scanline;
+  GLUSubyte rgbe[4];
+  GLUSubyte prevRgbe[4];
 
-    glusImageDestroyHdr(hdrimage);
+  GLUSfloat *row = 0;
 
+  if (!buffer || !hdrimage || !hdrimage->data ||
+      !_glusImageGetHdrPixelSize(hdrimage->type)) {
     return GLUS_FALSE;
   }
 
-  hdrimage->width = (GLUSushort)width;
-  hdrimage->height = (GLUSushort)height;
-  hdrimage->depth = 1;
-  hdrimage->format = GLUS_RGB;
-
-  hdrimage->data =
-      (GLUSfloat *)glusMemoryMalloc(width * height * 3 * sizeof(GLUSfloat));
-
-  if (!hdrimage->data) {
-    glusFileClose(file);
+  end = buffer + length;
 
-    glusImageDestroyHdr(hdrimage);
+  current = glusImageParseHdrHeader(buffer, length, &width, &height);
 
+  if (!current) {
     return GLUS_FALSE;
   }
 
-  // Scanlines
+  // Scanlines are planar for the new RLE format, otherwise the RGBE pixels are
+  // interleaved. Either way, a scanline is converted, when it is complete.
   scanline = (GLUSubyte *)glusMemoryMalloc(width * 4 * sizeof(GLUSubyte));
 
   if (!scanline) {
-    glusMemoryFree(scanline);
+    return GLUS_FALSE;
+  }
 
-    glusFileClose(file);
+  // Packed types are converted from a row of floats.
+  if (hdrimage->type != GLUS_FLOAT) {
+    row = (GLUSfloat *)glusMemoryMalloc(width * 3 * sizeof(GLUSfloat));
 
-    glusImageDestroyHdr(hdrimage);
+    if (!row) {
+      glusMemoryFree(scanline);
 
-    return GLUS_FALSE;
+      return GLUS_FALSE;
+    }
   }
 
   prevRgbe[0] = 0;
@@ -314,110 +494,79 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar *filename,
   x = 0;
   y = height - 1;
   while (y >= 0) {
-    elementsRead = fread(buffer, 4, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1)) {
-      glusMemoryFree(scanline);
-
-      glusImageDestroyHdr(hdrimage);
-
-      return GLUS_FALSE;
+    if (end - current < 4) {
+      break;
     }
 
-    repeat = 0;
-
     // Examine value
-    if (width < 32768 && buffer[0] == 2 && buffer[1] == 2 &&
-        buffer[2] == ((width >> 8) & 0xFF) && buffer[3] == (width & 0xFF)) {
+    if (x == 0 && width < 32768 && current[0] == 2 && current[1] == 2 &&
+        current[2] == ((width >> 8) & 0xFF) && current[3] == (width & 0xFF)) {
       // New RLE decoding
 
-      GLUSint scanlinePixels = glusImageDecodeNewRLE(file, scanline, width);
-
-      if (scanlinePixels < 0) {
-        glusMemoryFree(scanline);
+      current += 4;
 
-        // File already closed
-
-        glusImageDestroyHdr(hdrimage);
-
-        return GLUS_FALSE;
+      if (!glusImageDecodeNewRLE(&current, end, scanline, width)) {
+        break;
       }
 
-      for (i = 0; i < scanlinePixels; i++) {
-        if (y < 0) {
-          glusMemoryFree(scanline);
-
-          glusFileClose(file);
-
-          glusImageDestroyHdr(hdrimage);
-
-          return GLUS_FALSE;
-        }
+      glusImageStoreHdrScanline(hdrimage, y, row, scanline, scanline + width,
+                                scanline + 2 * width, scanline + 3 * width, 1);
 
-        glusImageConvertRGBE(rgb, &scanline[i * 4]);
+      factor = 1;
 
-        hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-        hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-        hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+      prevRgbe[0] = scanline[1 * width - 1];
+      prevRgbe[1] = scanline[2 * width - 1];
+      prevRgbe[2] = scanline[3 * width - 1];
+      prevRgbe[3] = scanline[4 * width - 1];
 
-        x++;
-        if (x >= width) {
-          y--;
-          x = 0;
-        }
-      }
+      y--;
 
-      factor = 1;
+      continue;
+    }
 
-      prevRgbe[0] = scanline[(scanlinePixels - 1) * 4 + 0];
-      prevRgbe[1] = scanline[(scanlinePixels - 1) * 4 + 1];
-      prevRgbe[2] = scanline[(scanlinePixels - 1) * 4 + 2];
-      prevRgbe[3] = scanline[(scanlinePixels - 1) * 4 + 3];
+    remaining = (size_t)width * y + (width - x);
 
-      continue;
-    } else if (buffer[0] == 1 && buffer[1] == 1 && buffer[2] == 1) {
+    if (current[0] == 1 && current[1] == 1 && current[2] == 1) {
       // Old RLE decoding
 
-      repeat = buffer[3] * factor;
+      repeat = current[3] * factor;
 
       rgbe[0] = prevRgbe[0];
       rgbe[1] = prevRgbe[1];
       rgbe[2] = prevRgbe[2];
       rgbe[3] = prevRgbe[3];
 
-      factor *= 256;
+      // Larger factors can only give too long runs.
+      if (factor <= remaining) {
+        factor *= 256;
+      }
     } else {
       // No RLE decoding
 
       repeat = 1;
 
-      rgbe[0] = buffer[0];
-      rgbe[1] = buffer[1];
-      rgbe[2] = buffer[2];
-      rgbe[3] = buffer[3];
+      rgbe[0] = current[0];
+      rgbe[1] = current[1];
+      rgbe[2] = current[2];
+      rgbe[3] = current[3];
 
       factor = 1;
     }
 
-    glusImageConvertRGBE(rgb, rgbe);
-
-    while (repeat) {
-      if (y < 0) {
-        glusMemoryFree(scanline);
-
-        glusFileClose(file);
+    current += 4;
 
-        glusImageDestroyHdr(hdrimage);
-
-        return GLUS_FALSE;
-      }
+    if (repeat > remaining) {
+      break;
+    }
 
-      hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-      hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-      hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+    while (repeat) {
+      memcpy(&scanline[x * 4], rgbe, 4);
 
       x++;
       if (x >= width) {
+        glusImageStoreHdrScanline(hdrimage, y, row, &scanline[0],
+                                  &scanline[1], &scanline[2], &scanline[3], 4);
+
         y--;
         x = 0;
       }
@@ -431,18 +580,116 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar *filename,
     prevRgbe[3] = rgbe[3];
   }
 
+  if (row) {
+    glusMemoryFree(row);
+  }
+
   glusMemoryFree(scanline);
 
-  glusFileClose(file);
+  // All scanlines have been decoded, if no error stopped the loop.
+  return y < 0 ? GLUS_TRUE : GLUS_FALSE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemoryPacked(
+    const GLUSubyte *buffer, size_t length, GLUShdrimage *hdrimage,
+    const GLUSenum type) {
+  size_t pixelSize = _glusImageGetHdrPixelSize(type);
+
+  if (!pixelSize) {
+    return GLUS_FALSE;
+  }
+
+  if (!_glusImageReadHdrHeader(buffer, length, hdrimage)) {
+    return GLUS_FALSE;
+  }
+
+  hdrimage->type = type;
+
+  // A large image does not fit into the address space of a 32 bit target.
+  if ((GLUSuint64)hdrimage->width * hdrimage->height * pixelSize >
+      (size_t)-1) {
+    glusImageDestroyHdr(hdrimage);
+
+    return GLUS_FALSE;
+  }
+
+  hdrimage->data = (GLUSfloat *)glusMemoryMalloc(
+      (size_t)hdrimage->width * hdrimage->height * pixelSize);
+
+  if (!hdrimage->data) {
+    glusImageDestroyHdr(hdrimage);
+
+    return GLUS_FALSE;
+  }
+
+  if (!_glusImageDecodeHdr(buffer, length, hdrimage)) {
+    glusImageDestroyHdr(hdrimage);
+
+    return GLUS_FALSE;
+  }
 
   return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemory(const GLUSubyte *buffer,
+                                                    size_t length,
+                                                    GLUShdrimage *hdrimage) {
+  return glusImageLoadHdrFromMemoryPacked(buffer, length, hdrimage,
+                                          GLUS_FLOAT);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrPacked(const GLUSchar *filename,
+                                                GLUShdrimage *hdrimage,
+                                                const GLUSenum type) {
+  GLUSchar buffer[GLUS_MAX_FILENAME];
+
+  GLUSubyte *data;
+  size_t size;
+
+  GLUSboolean result;
+
+  // check, if we have a valid pointer
+  if (!filename || !hdrimage) {
+    return GLUS_FALSE;
+  }
+
+  hdrimage->width = 0;
+  hdrimage->height = 0;
+  hdrimage->depth = 0;
+  hdrimage->data = 0;
+
+  if (strlen(GLUS_BASE_DIRECTORY) + strlen(filename) >= GLUS_MAX_FILENAME) {
+    return GLUS_FALSE;
+  }
+
+  strcpy(buffer, GLUS_BASE_DIRECTORY);
+  strcat(buffer, filename);
+
+  // map the whole file, so decoding reads directly from the page cache
+  data = _glusFileMap(buffer, &size, GLUS_FALSE);
+
+  if (!data) {
+    return GLUS_FALSE;
+  }
+
+  result = glusImageLoadHdrFromMemoryPacked(data, size, hdrimage, type);
+
+  _glusFileUnmap(data, size);
+
+  return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar *filename,
+                                          GLUShdrimage *hdrimage) {
+  return glusImageLoadHdrPacked(filename, hdrimage, GLUS_FLOAT);
+}
+
 GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar *filename,
                                           const GLUShdrimage *hdrimage) {
   FILE *file;
   size_t elementsWritten;
   GLUSubyte rgbe[4];
+  GLUSfloat rgb[3];
   GLUSint x, y;
 
   // check, if we have a valid pointer
@@ -479,7 +726,9 @@ GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar *filename,
   // Non compressed data
   for (y = hdrimage->height - 1; y >= 0; y--) {
     for (x = 0; x < hdrimage->width; x++) {
-      glusImageConvertRGB(rgbe, &hdrimage->data[(y * hdrimage->width + x) * 3]);
+      glusImageUnpackHdrPixel(rgb, hdrimage, (size_t)y * hdrimage->width + x);
+
+      glusImageConvertRGB(rgbe, rgb);
 
       elementsWritten = fwrite(rgbe, 1, 4 * sizeof(GLUSubyte), file);
 
@@ -512,6 +761,8 @@ GLUSvoid GLUSAPIENTRY glusImageDestroyHdr(GLUShdrimage *hdrimage) {
   hdrimage->depth = 0;
 
   hdrimage->format = 0;
+
+  hdrimage->type = 0;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageSampleHdr2D(GLUSfloat rgb[3],
@@ -520,12 +771,35 @@ GLUSboolean GLUSAPIENTRY glusImageSampleHdr2D(GLUSfloat rgb[3],
   GLUSint sampleIndex[4];
   GLUSfloat sampelWeight[2];
 
+  GLUSfloat texel[4][3];
+
   GLUSint i, stride;
 
   if (!rgb || !hdrimage || !st) {
     return GLUS_FALSE;
   }
 
+  // Packed RGB pixels are unpacked, so the indices are the pixels.
+  if (hdrimage->type == GLUS_HALF_FLOAT ||
+      hdrimage->type == GLUS_UNSIGNED_INT_5_9_9_9_REV) {
+    _glusImageGatherSamplePoints(sampleIndex, sampelWeight, st,
+                                 hdrimage->width, hdrimage->height, 1);
+
+    for (i = 0; i < 4; i++) {
+      glusImageUnpackHdrPixel(texel[i], hdrimage, (size_t)sampleIndex[i]);
+    }
+
+    for (i = 0; i < 3; i++) {
+      rgb[i] = texel[0][i] * sampelWeight[0] * sampelWeight[1];
+      rgb[i] += texel[1][i] * (1.0f - sampelWeight[0]) * sampelWeight[1];
+      rgb[i] += texel[2][i] * sampelWeight[0] * (1.0f - sampelWeight[1]);
+      rgb[i] += texel[3][i] * (1.0f - sampelWeight[0]) *
+                (1.0f - sampelWeight[1]);
+    }
+
+    return GLUS_TRUE;
+  }
+
   stride = 1;
   if (hdrimage->format == GLUS_RGB) {
     stride = 3;
@@ -18,51 +18,33 @@
 
 #include "GL/glus.h"
 
-GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar *filename,
-                                          GLUSpkmimage *pkmimage) {
-  GLUSbinaryfile binaryfile;
-
-  GLUSubyte *buffer;
-
-  GLUSubyte type;
-
+// Reads and checks the PKM header. The size, depth, format and image size are
+// set, the data is not allocated.
+GLUSboolean _glusImageReadPkmHeader(const GLUSubyte *buffer, size_t length,
+                                    GLUSpkmimage *pkmimage) {
   // check, if we have a valid pointer
-  if (!filename || !pkmimage) {
+  if (!buffer || !pkmimage) {
     return GLUS_FALSE;
   }
 
-  if (!glusFileLoadBinary(filename, &binaryfile)) {
+  pkmimage->width = 0;
+  pkmimage->height = 0;
+  pkmimage->depth = 0;
+  pkmimage->data = 0;
+  pkmimage->imageSize = 0;
+  pkmimage->internalformat = 0;
+
+  // the header has 16 bytes
+  if (length <= 16 || length - 16 > 0x7FFFFFFF) {
     return GLUS_FALSE;
   }
 
-  buffer = binaryfile.binary;
   if (!(buffer[0] == 'P' && buffer[1] == 'K' && buffer[2] == 'M' &&
         buffer[3] == ' ')) {
-    glusFileDestroyBinary(&binaryfile);
-
-    return GLUS_FALSE;
-  }
-  buffer += 7;
-
-  pkmimage->depth = 1;
-
-  pkmimage->imageSize = binaryfile.length - 16;
-  if (pkmimage->imageSize <= 0) {
-    glusFileDestroyBinary(&binaryfile);
-
     return GLUS_FALSE;
   }
 
-  pkmimage->data =
-      (GLUSubyte *)glusMemoryMalloc(pkmimage->imageSize * sizeof(GLUSubyte));
-  if (!pkmimage->data) {
-    glusFileDestroyBinary(&binaryfile);
-
-    return GLUS_FALSE;
-  }
-
-  type = *buffer;
-  switch (type) {
+  switch (buffer[7]) {
   case 1:
     pkmimage->internalformat = GLUS_COMPRESSED_RGB8_ETC2;
     break;
@@ -84,27 +66,64 @@ GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar *filename,
   case 8:
     pkmimage->internalformat = GLUS_COMPRESSED_SIGNED_RG11_EAC;
     break;
-  default: {
-    glusImageDestroyPkm(pkmimage);
+  default:
+    return GLUS_FALSE;
+  }
 
+  pkmimage->width = (GLUSushort)(buffer[12] * 256 + buffer[13]);
+  pkmimage->height = (GLUSushort)(buffer[14] * 256 + buffer[15]);
+  pkmimage->depth = 1;
+
+  pkmimage->imageSize = (GLUSint)(length - 16);
+
+  return GLUS_TRUE;
+}
+
+// Copies the compressed data into the already allocated data of the image. The
+// image has to be filled by _glusImageReadPkmHeader before.
+GLUSboolean _glusImageDecodePkm(const GLUSubyte *buffer, size_t length,
+                                GLUSpkmimage *pkmimage) {
+  if (!buffer || !pkmimage || !pkmimage->data ||
+      length < 16 + (size_t)pkmimage->imageSize) {
+    return GLUS_FALSE;
+  }
+
+  memcpy(pkmimage->data, buffer + 16, pkmimage->imageSize);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar *filename,
+                                          GLUSpkmimage *pkmimage) {
+  GLUSbinaryfile binaryfile;
+
+  // check, if we have a valid pointer
+  if (!filename || !pkmimage) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusFileLoadBinary(filename, &binaryfile)) {
+    return GLUS_FALSE;
+  }
+
+  if (!_glusImageReadPkmHeader(binaryfile.binary, (size_t)binaryfile.length,
+                               pkmimage)) {
     glusFileDestroyBinary(&binaryfile);
 
     return GLUS_FALSE;
-  } break;
   }
-  buffer += 5;
 
-  pkmimage->width = (GLUSushort)(*buffer) * 256;
-  buffer += 1;
-  pkmimage->width += (GLUSushort)(*buffer);
-  buffer += 1;
+  pkmimage->data =
+      (GLUSubyte *)glusMemoryMalloc(pkmimage->imageSize * sizeof(GLUSubyte));
+  if (!pkmimage->data) {
+    glusImageDestroyPkm(pkmimage);
 
-  pkmimage->height = (GLUSushort)(*buffer) * 256;
-  buffer += 1;
-  pkmimage->height += (GLUSushort)(*buffer);
-  buffer += 1;
+    glusFileDestroyBinary(&binaryfile);
+
+    return GLUS_FALSE;
+  }
 
-  memcpy(pkmimage->data, buffer, pkmimage->imageSize);
+  _glusImageDecodePkm(binaryfile.binary, (size_t)binaryfile.length, pkmimage);
 
   glusFileDestroyBinary(&binaryfile);
 
@@ -20,36 +20,150 @@
 
 #define GLUS_MAX_DIMENSION 16384
 
+// Weights of the red, green and blue channel for the luminance in 16 bit fixed
+// point.
+#define GLUS_LUMINANCE_RED 19594
+#define GLUS_LUMINANCE_GREEN 38467
+#define GLUS_LUMINANCE_BLUE 7471
+
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4],
                                              GLUSfloat sampleWeight[2],
                                              const GLUSfloat st[2],
                                              GLUSint width, GLUSint height,
                                              GLUSint stride);
 
-extern GLUSboolean _glusFileCheckRead(FILE *f, size_t actualRead,
-                                      size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE *f, size_t actualWrite,
                                        size_t expectedWrite);
 
-static GLUSvoid glusImageSwapColorChannel(GLUSint width, GLUSint height,
-                                          GLUSenum format, GLUSubyte *data) {
-  GLUSint i;
-  GLUSubyte temp;
-  GLUSint bytesPerPixel = 3;
+extern GLUSubyte *_glusFileMap(const GLUSchar *filename, size_t *size,
+                               GLUSboolean copyOnWrite);
+
+extern GLUSvoid _glusFileUnmap(GLUSubyte *data, size_t size);
+
+// Copies the pixels with swapped red and blue channels, so BGR(A) becomes
+// RGB(A) and vice versa.
+static GLUSvoid glusImageSwapColorChannel(GLUSubyte *target,
+                                          const GLUSubyte *source,
+                                          size_t numberPixels,
+                                          GLUSint numberChannels) {
+  size_t i;
+
+  if (numberChannels == 4) {
+    for (i = 0; i < numberPixels; i++) {
+      target[4 * i + 0] = source[4 * i + 2];
+      target[4 * i + 1] = source[4 * i + 1];
+      target[4 * i + 2] = source[4 * i + 0];
+      target[4 * i + 3] = source[4 * i + 3];
+    }
+  } else {
+    for (i = 0; i < numberPixels; i++) {
+      target[3 * i + 0] = source[3 * i + 2];
+      target[3 * i + 1] = source[3 * i + 1];
+      target[3 * i + 2] = source[3 * i + 0];
+    }
+  }
+}
 
-  if (!data) {
-    return;
+// Extracts one channel of a RGB or RGBA image.
+static GLUSvoid glusImageExtractChannel(GLUSubyte *target,
+                                        const GLUSubyte *source,
+                                        size_t numberPixels,
+                                        GLUSint sourceNumberChannels,
+                                        GLUSint channel) {
+  size_t i;
+
+  if (sourceNumberChannels == 4) {
+    for (i = 0; i < numberPixels; i++) {
+      target[i] = source[4 * i + channel];
+    }
+  } else {
+    for (i = 0; i < numberPixels; i++) {
+      target[i] = source[3 * i + channel];
+    }
   }
+}
 
-  if (format == GLUS_RGBA) {
-    bytesPerPixel = 4;
+// Expands a single channel image to RGB or RGBA. A target channel is the
+// source value, if its mask is 255, otherwise the fill value.
+static GLUSvoid glusImageExpandChannel(GLUSubyte *target,
+                                       const GLUSubyte *source,
+                                       size_t numberPixels,
+                                       GLUSint targetNumberChannels,
+                                       const GLUSubyte mask[4],
+                                       const GLUSubyte fill[4]) {
+  GLUSubyte mask0 = mask[0], mask1 = mask[1], mask2 = mask[2],
+            mask3 = mask[3];
+  GLUSubyte fill0 = fill[0], fill1 = fill[1], fill2 = fill[2],
+            fill3 = fill[3];
+
+  size_t i;
+
+  if (targetNumberChannels == 4) {
+    for (i = 0; i < numberPixels; i++) {
+      target[4 * i + 0] = (source[i] & mask0) | fill0;
+      target[4 * i + 1] = (source[i] & mask1) | fill1;
+      target[4 * i + 2] = (source[i] & mask2) | fill2;
+      target[4 * i + 3] = (source[i] & mask3) | fill3;
+    }
+  } else {
+    for (i = 0; i < numberPixels; i++) {
+      target[3 * i + 0] = (source[i] & mask0) | fill0;
+      target[3 * i + 1] = (source[i] & mask1) | fill1;
+      target[3 * i + 2] = (source[i] & mask2) | fill2;
+    }
   }
+}
+
+static GLUSvoid glusImageRGBToRGBA(GLUSubyte *target, const GLUSubyte *source,
+                                   size_t numberPixels) {
+  size_t i;
 
-  // swap the R and B values to get RGB since the bitmap color format is in BGR
-  for (i = 0; i < width * height * bytesPerPixel; i += bytesPerPixel) {
-    temp = data[i];
-    data[i] = data[i + 2];
-    data[i + 2] = temp;
+  for (i = 0; i < numberPixels; i++) {
+    target[4 * i + 0] = source[3 * i + 0];
+    target[4 * i + 1] = source[3 * i + 1];
+    target[4 * i + 2] = source[3 * i + 2];
+    target[4 * i + 3] = 255;
+  }
+}
+
+static GLUSvoid glusImageRGBAToRGB(GLUSubyte *target, const GLUSubyte *source,
+                                   size_t numberPixels) {
+  size_t i;
+
+  for (i = 0; i < numberPixels; i++) {
+    target[3 * i + 0] = source[4 * i + 0];
+    target[3 * i + 1] = source[4 * i + 1];
+    target[3 * i + 2] = source[4 * i + 2];
+  }
+}
+
+// Every weighted channel is rounded down on its own, which gives the same
+// luminance as summing up 0.299f, 0.587f and 0.114f times the channels in
+// 8 bit.
+static GLUSvoid glusImageColorToLuminance(GLUSubyte *target,
+                                          const GLUSubyte *source,
+                                          size_t numberPixels,
+                                          GLUSint sourceNumberChannels) {
+  GLUSuint red, green, blue;
+
+  size_t i;
+
+  if (sourceNumberChannels == 4) {
+    for (i = 0; i < numberPixels; i++) {
+      red = (source[4 * i + 0] * GLUS_LUMINANCE_RED) >> 16;
+      green = (source[4 * i + 1] * GLUS_LUMINANCE_GREEN) >> 16;
+      blue = (source[4 * i + 2] * GLUS_LUMINANCE_BLUE) >> 16;
+
+      target[i] = (GLUSubyte)(red + green + blue);
+    }
+  } else {
+    for (i = 0; i < numberPixels; i++) {
+      red = (source[3 * i + 0] * GLUS_LUMINANCE_RED) >> 16;
+      green = (source[3 * i + 1] * GLUS_LUMINANCE_GREEN) >> 16;
+      blue = (source[3 * i + 2] * GLUS_LUMINANCE_BLUE) >> 16;
+
+      target[i] = (GLUSubyte)(red + green + blue);
+    }
   }
 }
 
@@ -85,26 +199,73 @@ GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage *tgaimage,
   return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar *filename,
-                                          GLUStgaimage *tgaimage) {
-  FILE *file;
+// Converts pixels of the TGA data into the image. Colors are swapped from BGR
+// to RGB on the way, color map indices are looked up in the already swapped
+// color map.
+static GLUSboolean glusImageConvertTgaPixels(
+    GLUSubyte *target, const GLUSubyte *source, GLUSint numberPixels,
+    GLUSint bytesPerPixel, const GLUSubyte *colorMap, GLUSint firstEntryIndex,
+    GLUSint colorMapLength) {
+  GLUSint i;
 
-  GLUSboolean hasColorMap = GLUS_FALSE;
+  if (colorMap) {
+    for (i = 0; i < numberPixels; i++) {
+      GLUSint entry = (GLUSint)source[i] - firstEntryIndex;
 
+      if (entry < 0 || entry >= colorMapLength) {
+        return GLUS_FALSE;
+      }
+
+      memcpy(&target[i * bytesPerPixel], &colorMap[entry * bytesPerPixel],
+             bytesPerPixel);
+    }
+  } else if (bytesPerPixel >= 3) {
+    glusImageSwapColorChannel(target, source, (size_t)numberPixels,
+                              bytesPerPixel);
+  } else {
+    memcpy(target, source, (size_t)numberPixels * bytesPerPixel);
+  }
+
+  return GLUS_TRUE;
+}
+
+// Repeats the first pixel of the target, so the run has numberPixels pixels.
+static GLUSvoid glusImageFillTgaRun(GLUSubyte *target, GLUSint numberPixels,
+                                    GLUSint bytesPerPixel) {
+  size_t filled = (size_t)bytesPerPixel;
+  size_t total = (size_t)numberPixels * bytesPerPixel;
+  size_t copy;
+
+  if (bytesPerPixel == 1) {
+    memset(target + 1, target[0], total - 1);
+
+    return;
+  }
+
+  // double the already filled part, until the run is complete
+  while (filled < total) {
+    copy = filled < total - filled ? filled : total - filled;
+
+    memcpy(target + filled, target, copy);
+
+    filled += copy;
+  }
+}
+
+// Reads and checks the TGA header. The size, depth and format of the image are
+// set, the data is not allocated.
+GLUSboolean _glusImageReadTgaHeader(const GLUSubyte *buffer, size_t length,
+                                    GLUStgaimage *tgaimage) {
   GLUSubyte imageType;
   GLUSubyte bitsPerPixel;
 
-  GLUSushort firstEntryIndex;
-  GLUSushort colorMapLength;
+  GLUSubyte colorMapType;
+  GLUSint colorMapLength;
   GLUSubyte colorMapEntrySize;
-  GLUSubyte *colorMap = 0;
-
-  GLUSuint i, k;
-
-  size_t elementsRead;
+  size_t colorMapBytes;
 
   // check, if we have a valid pointer
-  if (!filename || !tgaimage) {
+  if (!buffer || !tgaimage) {
     return GLUS_FALSE;
   }
 
@@ -114,216 +275,153 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar *filename,
   tgaimage->data = 0;
   tgaimage->format = 0;
 
-  // open filename in "read binary" mode
-  file = glusFileOpen(filename, "rb");
-
-  if (!file) {
+  // the header has 18 bytes
+  if (length < 18) {
     return GLUS_FALSE;
   }
 
-  // seek through the tga header, up to the type:
-  if (fseek(file, 2, SEEK_CUR)) {
-    glusFileClose(file);
-
-    return GLUS_FALSE;
-  }
-
-  // read the image type
-  elementsRead = fread(&imageType, 1, 1, file);
-
-  if (!_glusFileCheckRead(file, elementsRead, 1)) {
-    return GLUS_FALSE;
-  }
+  colorMapType = buffer[1];
+  imageType = buffer[2];
 
   // check the type
   if (imageType != 1 && imageType != 2 && imageType != 3 && imageType != 9 &&
       imageType != 10 && imageType != 11) {
-    glusFileClose(file);
-
     return GLUS_FALSE;
   }
 
-  if (imageType == 1 || imageType == 9) {
-    hasColorMap = GLUS_TRUE;
-  }
-
-  if (!hasColorMap) {
-    // seek through the tga header, up to the width/height:
-    if (fseek(file, 9, SEEK_CUR)) {
-      glusFileClose(file);
-
-      return GLUS_FALSE;
-    }
-  } else {
-    elementsRead = fread(&firstEntryIndex, 2, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1)) {
-      glusImageDestroyTga(tgaimage);
-
-      return GLUS_FALSE;
-    }
-
-    elementsRead = fread(&colorMapLength, 2, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1)) {
-      glusImageDestroyTga(tgaimage);
-
-      return GLUS_FALSE;
-    }
-
-    elementsRead = fread(&colorMapEntrySize, 1, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1)) {
-      glusImageDestroyTga(tgaimage);
-
-      return GLUS_FALSE;
-    }
-
-    // seek through the tga header, up to the width/height:
-    if (fseek(file, 4, SEEK_CUR)) {
-      glusFileClose(file);
-
-      return GLUS_FALSE;
-    }
-  }
+  colorMapLength = (GLUSint)buffer[5] | ((GLUSint)buffer[6] << 8);
+  colorMapEntrySize = buffer[7];
 
-  // read the width
-  elementsRead = fread(&tgaimage->width, 2, 1, file);
+  tgaimage->width = (GLUSushort)(buffer[12] | (buffer[13] << 8));
+  tgaimage->height = (GLUSushort)(buffer[14] | (buffer[15] << 8));
+  tgaimage->depth = 1;
 
-  if (!_glusFileCheckRead(file, elementsRead, 1)) {
+  if (tgaimage->width > GLUS_MAX_DIMENSION ||
+      tgaimage->height > GLUS_MAX_DIMENSION) {
     glusImageDestroyTga(tgaimage);
 
     return GLUS_FALSE;
   }
 
-  if (tgaimage->width > GLUS_MAX_DIMENSION) {
+  bitsPerPixel = buffer[16];
+
+  // check the pixel depth
+  if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32) {
     glusImageDestroyTga(tgaimage);
 
     return GLUS_FALSE;
   }
 
-  // read the height
-  elementsRead = fread(&tgaimage->height, 2, 1, file);
-
-  if (!_glusFileCheckRead(file, elementsRead, 1)) {
-    glusImageDestroyTga(tgaimage);
-
-    return GLUS_FALSE;
+  colorMapBytes = 0;
+  if (colorMapType) {
+    colorMapBytes = (size_t)colorMapLength * ((colorMapEntrySize + 7) / 8);
   }
 
-  if (tgaimage->height > GLUS_MAX_DIMENSION) {
+  // the image identification field and the color map have to be there
+  if (length < 18 + (size_t)buffer[0] + colorMapBytes) {
     glusImageDestroyTga(tgaimage);
 
     return GLUS_FALSE;
   }
 
-  tgaimage->depth = 1;
+  if (imageType == 1 || imageType == 9) {
+    // only 8 bit indices into a 8, 24 or 32 bit color map are supported
+    if (!colorMapType || bitsPerPixel != 8 ||
+        (colorMapEntrySize != 8 && colorMapEntrySize != 24 &&
+         colorMapEntrySize != 32)) {
+      glusImageDestroyTga(tgaimage);
 
-  // read the bits per pixel
-  elementsRead = fread(&bitsPerPixel, 1, 1, file);
+      return GLUS_FALSE;
+    }
 
-  if (!_glusFileCheckRead(file, elementsRead, 1)) {
-    glusImageDestroyTga(tgaimage);
+    bitsPerPixel = colorMapEntrySize;
+  }
 
-    return GLUS_FALSE;
+  tgaimage->format = GLUS_SINGLE_CHANNEL;
+  if (bitsPerPixel == 24) {
+    tgaimage->format = GLUS_RGB;
+  } else if (bitsPerPixel == 32) {
+    tgaimage->format = GLUS_RGBA;
   }
 
-  // check the pixel depth
-  if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32) {
-    glusFileClose(file);
+  return GLUS_TRUE;
+}
 
-    glusImageDestroyTga(tgaimage);
+// Decodes the pixels into the already allocated data of the image. The image
+// has to be filled by _glusImageReadTgaHeader before.
+GLUSboolean _glusImageDecodeTga(const GLUSubyte *buffer, size_t length,
+                                GLUStgaimage *tgaimage) {
+  const GLUSubyte *current;
+  const GLUSubyte *end;
 
-    return GLUS_FALSE;
-  } else {
-    tgaimage->format = GLUS_SINGLE_CHANNEL;
-    if (bitsPerPixel == 24) {
-      tgaimage->format = GLUS_RGB;
-    } else if (bitsPerPixel == 32) {
-      tgaimage->format = GLUS_RGBA;
-    }
-  }
+  GLUSubyte imageType;
 
-  // move file pointer to beginning of targa data
-  if (fseek(file, 1, SEEK_CUR)) {
-    glusFileClose(file);
+  GLUSint firstEntryIndex;
+  GLUSint colorMapLength;
+  size_t colorMapBytes;
+  GLUSubyte *colorMap = 0;
 
-    glusImageDestroyTga(tgaimage);
+  GLUSint sourceBytesPerPixel;
+  GLUSint bytesPerPixel;
+
+  GLUSint numberPixels;
+  GLUSint pixelsRead;
 
+  if (!buffer || !tgaimage || !tgaimage->data) {
     return GLUS_FALSE;
   }
 
-  if (hasColorMap) {
-    // Create color map space.
+  end = buffer + length;
 
-    GLUSint bytesPerPixel = colorMapEntrySize / 8;
+  imageType = buffer[2];
 
-    colorMap = (GLUSubyte *)glusMemoryMalloc((size_t)colorMapLength *
-                                             bytesPerPixel * sizeof(GLUSubyte));
+  firstEntryIndex = (GLUSint)buffer[3] | ((GLUSint)buffer[4] << 8);
+  colorMapLength = (GLUSint)buffer[5] | ((GLUSint)buffer[6] << 8);
 
-    if (!colorMap) {
-      glusFileClose(file);
+  sourceBytesPerPixel = buffer[16] / 8;
 
-      glusImageDestroyTga(tgaimage);
-
-      return GLUS_FALSE;
-    }
+  bytesPerPixel = 1;
+  if (tgaimage->format == GLUS_RGB) {
+    bytesPerPixel = 3;
+  } else if (tgaimage->format == GLUS_RGBA) {
+    bytesPerPixel = 4;
+  }
 
-    // Read in the color map.
+  // skip the header and the image identification field
+  current = buffer + 18 + buffer[0];
 
-    elementsRead =
-        fread(colorMap, 1,
-              (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte), file);
+  colorMapBytes = 0;
+  if (buffer[1]) {
+    colorMapBytes = (size_t)colorMapLength * ((buffer[7] + 7) / 8);
+  }
 
-    if (!_glusFileCheckRead(file, elementsRead,
-                            (size_t)colorMapLength * bytesPerPixel *
-                                sizeof(GLUSubyte))) {
-      glusImageDestroyTga(tgaimage);
+  if (imageType == 1 || imageType == 9) {
+    // Create color map space.
 
-      glusMemoryFree(colorMap);
-      colorMap = 0;
+    colorMap = (GLUSubyte *)glusMemoryMalloc(colorMapBytes);
 
+    if (!colorMap) {
       return GLUS_FALSE;
     }
 
-    // swap the color if necessary
-    if (colorMapEntrySize == 24 || colorMapEntrySize == 32) {
-      glusImageSwapColorChannel(colorMapLength, 1,
-                                colorMapEntrySize == 24 ? GLUS_RGB : GLUS_RGBA,
-                                colorMap);
-    }
+    // copy the color map with swapped colors
+    glusImageConvertTgaPixels(colorMap, current, colorMapLength, bytesPerPixel,
+                              0, 0, 0);
   }
 
-  // allocate enough memory for the targa  data
-  tgaimage->data = (GLUSubyte *)glusMemoryMalloc(
-      (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+  // skip the color map, which is also allowed for not color mapped images
+  current += colorMapBytes;
 
-  // verify memory allocation
-  if (!tgaimage->data) {
-    glusFileClose(file);
-
-    glusImageDestroyTga(tgaimage);
-
-    if (hasColorMap) {
-      glusMemoryFree(colorMap);
-      colorMap = 0;
-    }
-
-    return GLUS_FALSE;
-  }
+  numberPixels = (GLUSint)tgaimage->width * (GLUSint)tgaimage->height;
 
   if (imageType == 1 || imageType == 2 || imageType == 3) {
-    // read in the raw data
-    elementsRead = fread(
-        tgaimage->data, 1,
-        (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
-
-    if (!_glusFileCheckRead(file, elementsRead,
-                            (size_t)tgaimage->width * tgaimage->height *
-                                bitsPerPixel / 8)) {
-      glusImageDestroyTga(tgaimage);
-
-      if (hasColorMap) {
+    // convert the raw data in one pass
+    if ((size_t)(end - current) <
+            (size_t)numberPixels * sourceBytesPerPixel ||
+        !glusImageConvertTgaPixels(tgaimage->data, current, numberPixels,
+                                   bytesPerPixel, colorMap, firstEntryIndex,
+                                   colorMapLength)) {
+      if (colorMap) {
         glusMemoryFree(colorMap);
         colorMap = 0;
       }
@@ -332,140 +430,140 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar *filename,
     }
   } else {
     // RLE encoded
-    GLUSint pixelsRead = 0;
-
-    while (pixelsRead < tgaimage->width * tgaimage->height) {
-      GLUSubyte amount;
-
-      elementsRead = fread(&amount, 1, 1, file);
+    pixelsRead = 0;
 
-      if (!_glusFileCheckRead(file, elementsRead, 1)) {
-        glusImageDestroyTga(tgaimage);
+    while (pixelsRead < numberPixels) {
+      GLUSint amount;
+      GLUSboolean isRun;
+      size_t packetBytes;
 
-        if (hasColorMap) {
-          glusMemoryFree(colorMap);
-          colorMap = 0;
-        }
-
-        return GLUS_FALSE;
+      if (current >= end) {
+        break;
       }
 
-      if (amount & 0x80) {
-        GLUSint i;
-        GLUSint k;
-
-        amount &= 0x7F;
+      isRun = (*current & 0x80) ? GLUS_TRUE : GLUS_FALSE;
+      amount = (*current & 0x7F) + 1;
+      current++;
 
-        amount++;
+      // a run stores one pixel, a raw packet all of them
+      packetBytes = (size_t)(isRun ? 1 : amount) * sourceBytesPerPixel;
 
-        // read in the rle data
-        elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1,
-                             bitsPerPixel / 8, file);
+      if (pixelsRead + amount > numberPixels ||
+          (size_t)(end - current) < packetBytes) {
+        break;
+      }
 
-        if (!_glusFileCheckRead(file, elementsRead, bitsPerPixel / 8)) {
-          glusImageDestroyTga(tgaimage);
+      if (!glusImageConvertTgaPixels(
+              &tgaimage->data[(size_t)pixelsRead * bytesPerPixel], current,
+              isRun ? 1 : amount, bytesPerPixel, colorMap, firstEntryIndex,
+              colorMapLength)) {
+        break;
+      }
 
-          if (hasColorMap) {
-            glusMemoryFree(colorMap);
-            colorMap = 0;
-          }
+      if (isRun) {
+        glusImageFillTgaRun(&tgaimage->data[(size_t)pixelsRead * bytesPerPixel],
+                            amount, bytesPerPixel);
+      }
 
-          return GLUS_FALSE;
-        }
+      current += packetBytes;
 
-        for (i = 1; i < amount; i++) {
-          for (k = 0; k < bitsPerPixel / 8; k++) {
-            tgaimage->data[(pixelsRead + i) * bitsPerPixel / 8 + k] =
-                tgaimage->data[pixelsRead * bitsPerPixel / 8 + k];
-          }
-        }
-      } else {
-        amount &= 0x7F;
+      pixelsRead += amount;
+    }
 
-        amount++;
+    // the data is truncated or a packet is invalid
+    if (pixelsRead < numberPixels) {
+      if (colorMap) {
+        glusMemoryFree(colorMap);
+        colorMap = 0;
+      }
 
-        // read in the raw data
-        elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1,
-                             (size_t)amount * bitsPerPixel / 8, file);
+      return GLUS_FALSE;
+    }
+  }
 
-        if (!_glusFileCheckRead(file, elementsRead,
-                                (size_t)amount * bitsPerPixel / 8)) {
-          glusImageDestroyTga(tgaimage);
+  if (colorMap) {
+    glusMemoryFree(colorMap);
+    colorMap = 0;
+  }
 
-          if (hasColorMap) {
-            glusMemoryFree(colorMap);
-            colorMap = 0;
-          }
+  return GLUS_TRUE;
+}
 
-          return GLUS_FALSE;
-        }
-      }
+GLUSboolean GLUSAPIENTRY glusImageLoadTgaFromMemory(const GLUSubyte *buffer,
+                                                    size_t length,
+                                                    GLUStgaimage *tgaimage) {
+  GLUSint bytesPerPixel;
 
-      pixelsRead += amount;
-    }
+  if (!_glusImageReadTgaHeader(buffer, length, tgaimage)) {
+    return GLUS_FALSE;
   }
 
-  // swap the color if necessary
-  if (bitsPerPixel == 24 || bitsPerPixel == 32) {
-    glusImageSwapColorChannel(tgaimage->width, tgaimage->height,
-                              tgaimage->format, tgaimage->data);
+  bytesPerPixel = 1;
+  if (tgaimage->format == GLUS_RGB) {
+    bytesPerPixel = 3;
+  } else if (tgaimage->format == GLUS_RGBA) {
+    bytesPerPixel = 4;
   }
 
-  // close the file
-  glusFileClose(file);
-
-  if (hasColorMap) {
-    GLUSubyte *data = tgaimage->data;
+  // allocate enough memory for the targa data
+  tgaimage->data = (GLUSubyte *)glusMemoryMalloc(
+      (size_t)tgaimage->width * tgaimage->height * bytesPerPixel);
 
-    GLUSint bytesPerPixel;
+  // verify memory allocation
+  if (!tgaimage->data) {
+    glusImageDestroyTga(tgaimage);
 
-    // Allocating new memory, as current memory is a look up table index and not
-    // a color.
+    return GLUS_FALSE;
+  }
 
-    bytesPerPixel = colorMapEntrySize / 8;
+  if (!_glusImageDecodeTga(buffer, length, tgaimage)) {
+    glusImageDestroyTga(tgaimage);
 
-    tgaimage->data = (GLUSubyte *)glusMemoryMalloc(
-        (size_t)tgaimage->width * tgaimage->height * bytesPerPixel);
+    return GLUS_FALSE;
+  }
 
-    if (!tgaimage->data) {
-      glusImageDestroyTga(tgaimage);
+  return GLUS_TRUE;
+}
 
-      glusMemoryFree(data);
-      data = 0;
+GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar *filename,
+                                          GLUStgaimage *tgaimage) {
+  GLUSchar buffer[GLUS_MAX_FILENAME];
 
-      glusMemoryFree(colorMap);
-      colorMap = 0;
+  GLUSubyte *data;
+  size_t size;
 
-      return GLUS_FALSE;
-    }
+  GLUSboolean result;
 
-    tgaimage->format = GLUS_SINGLE_CHANNEL;
-    if (colorMapEntrySize == 24) {
-      tgaimage->format = GLUS_RGB;
-    } else if (colorMapEntrySize == 32) {
-      tgaimage->format = GLUS_RGBA;
-    }
+  // check, if we have a valid pointer
+  if (!filename || !tgaimage) {
+    return GLUS_FALSE;
+  }
 
-    // Copy color values from the color map into the image data.
+  tgaimage->width = 0;
+  tgaimage->height = 0;
+  tgaimage->depth = 0;
+  tgaimage->data = 0;
+  tgaimage->format = 0;
 
-    for (i = 0; i < (GLUSuint)tgaimage->width * (GLUSuint)tgaimage->height;
-         i++) {
-      for (k = 0; k < (GLUSuint)bytesPerPixel; k++) {
-        tgaimage->data[i * bytesPerPixel + k] =
-            colorMap[(firstEntryIndex + data[i]) * bytesPerPixel + k];
-      }
-    }
+  if (strlen(GLUS_BASE_DIRECTORY) + strlen(filename) >= GLUS_MAX_FILENAME) {
+    return GLUS_FALSE;
+  }
 
-    // Freeing data.
+  strcpy(buffer, GLUS_BASE_DIRECTORY);
+  strcat(buffer, filename);
 
-    glusMemoryFree(data);
-    data = 0;
+  // map the whole file, so decoding reads directly from the page cache
+  data = _glusFileMap(buffer, &size, GLUS_FALSE);
 
-    glusMemoryFree(colorMap);
-    colorMap = 0;
+  if (!data) {
+    return GLUS_FALSE;
   }
 
-  return GLUS_TRUE;
+  result = glusImageLoadTgaFromMemory(data, size, tgaimage);
+
+  _glusFileUnmap(data, size);
+
+  return result;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar *filename,
@@ -558,27 +656,30 @@ GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar *filename,
     return GLUS_FALSE;
   }
 
-  data =
-      glusMemoryMalloc(tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+  data = tgaimage->data;
 
-  if (!data) {
-    glusFileClose(file);
+  // TGA stores the colors as BGR(A)
+  if (bitsPerPixel >= 24) {
+    data = (GLUSubyte *)glusMemoryMalloc(tgaimage->width * tgaimage->height *
+                                         bitsPerPixel / 8);
 
-    return GLUS_FALSE;
-  }
+    if (!data) {
+      glusFileClose(file);
 
-  memcpy(data, tgaimage->data,
-         tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+      return GLUS_FALSE;
+    }
 
-  if (bitsPerPixel >= 24) {
-    glusImageSwapColorChannel(tgaimage->width, tgaimage->height,
-                              tgaimage->format, data);
+    glusImageSwapColorChannel(data, tgaimage->data,
+                              (size_t)tgaimage->width * tgaimage->height,
+                              bitsPerPixel / 8);
   }
 
   elementsWritten = fwrite(
       data, 1, tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
 
-  glusMemoryFree(data);
+  if (data != tgaimage->data) {
+    glusMemoryFree(data);
+  }
 
   if (!_glusFileCheckWrite(file, elementsWritten,
                            tgaimage->width * tgaimage->height * bitsPerPixel /
@@ -666,11 +767,12 @@ GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage *targetImage,
                                              const GLUSenum targetFormat) {
   GLUSint targetNumberChannels = 1;
   GLUSint sourceNumberChannels = 1;
-  GLUSint x, y, z, c;
 
-  GLUSubyte channels[4] = {0, 0, 0, 255};
+  size_t numberPixels, i;
 
-  GLUSfloat toLuminace[3] = {0.299f, 0.587f, 0.114f};
+  GLUSubyte table[256];
+  GLUSubyte mask[4] = {0, 0, 0, 0};
+  GLUSubyte fill[4] = {0, 0, 0, 0};
 
   if (!targetImage || !sourceImage) {
     return GLUS_FALSE;
@@ -712,170 +814,61 @@ GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage *targetImage,
   targetImage->depth = sourceImage->depth;
   targetImage->format = targetFormat;
 
-  for (z = 0; z < targetImage->depth; z++) {
-    for (y = 0; y < targetImage->height; y++) {
-      for (x = 0; x < targetImage->width; x++) {
-        if (sourceImage->format == GLUS_RED) {
-          if (targetImage->format == GLUS_RED ||
-              targetImage->format == GLUS_RGB ||
-              targetImage->format == GLUS_RGBA) {
-            channels[0] =
-                sourceImage
-                    ->data[sourceNumberChannels * z * sourceImage->height *
-                               sourceImage->width +
-                           sourceNumberChannels * y * sourceImage->width +
-                           sourceNumberChannels * x + 0];
-
-            if (targetImage->format == GLUS_RGB ||
-                targetImage->format == GLUS_RGBA) {
-              channels[1] = 0;
-              channels[2] = 0;
-
-              if (targetImage->format == GLUS_RGBA) {
-                channels[3] = 255;
-              }
-            }
-          } else if (targetImage->format == GLUS_ALPHA) {
-            channels[0] = 255;
-          } else if (targetImage->format == GLUS_LUMINANCE) {
-            channels[0] =
-                sourceImage
-                    ->data[sourceNumberChannels * z * sourceImage->height *
-                               sourceImage->width +
-                           sourceNumberChannels * y * sourceImage->width +
-                           sourceNumberChannels * x + 0] *
-                toLuminace[0];
-          }
-        } else if (sourceImage->format == GLUS_ALPHA) {
-          if (targetImage->format == GLUS_LUMINANCE ||
-              targetImage->format == GLUS_RED ||
-              targetImage->format == GLUS_RGB ||
-              targetImage->format == GLUS_RGBA) {
-            channels[0] = 0;
-
-            if (targetImage->format == GLUS_RGB ||
-                targetImage->format == GLUS_RGBA) {
-              channels[1] = 0;
-              channels[2] = 0;
-
-              if (targetImage->format == GLUS_RGBA) {
-                channels[3] =
-                    sourceImage
-                        ->data[sourceNumberChannels * z * sourceImage->height *
-                                   sourceImage->width +
-                               sourceNumberChannels * y * sourceImage->width +
-                               sourceNumberChannels * x + 0];
-              }
-            }
-          } else if (targetImage->format == GLUS_ALPHA) {
-            channels[0] =
-                sourceImage
-                    ->data[sourceNumberChannels * z * sourceImage->height *
-                               sourceImage->width +
-                           sourceNumberChannels * y * sourceImage->width +
-                           sourceNumberChannels * x + 0];
-          }
-        } else if (sourceImage->format == GLUS_LUMINANCE) {
-          if (targetImage->format == GLUS_RED) {
-            channels[0] = glusMathClampf(
-                sourceImage
-                        ->data[sourceNumberChannels * z * sourceImage->height *
-                                   sourceImage->width +
-                               sourceNumberChannels * y * sourceImage->width +
-                               sourceNumberChannels * x + 0] /
-                    toLuminace[0],
-                0.0f, 1.0f);
-          } else if (targetImage->format == GLUS_RGB ||
-                     targetImage->format == GLUS_RGBA) {
-            channels[0] =
-                sourceImage
-                    ->data[sourceNumberChannels * z * sourceImage->height *
-                               sourceImage->width +
-                           sourceNumberChannels * y * sourceImage->width +
-                           sourceNumberChannels * x + 0];
-            channels[1] = channels[0];
-            channels[2] = channels[0];
-
-            if (targetImage->format == GLUS_RGBA) {
-              channels[3] = 255;
-            }
-          } else if (targetImage->format == GLUS_ALPHA) {
-            channels[0] = 255;
-          } else if (targetImage->format == GLUS_LUMINANCE) {
-            channels[0] =
-                sourceImage
-                    ->data[sourceNumberChannels * z * sourceImage->height *
-                               sourceImage->width +
-                           sourceNumberChannels * y * sourceImage->width +
-                           sourceNumberChannels * x + 0];
-          }
-        }
-        if (sourceImage->format == GLUS_RGB ||
-            sourceImage->format == GLUS_RGBA) {
-          if (targetImage->format == GLUS_RED) {
-            channels[0] =
-                sourceImage
-                    ->data[sourceNumberChannels * z * sourceImage->height *
-                               sourceImage->width +
-                           sourceNumberChannels * y * sourceImage->width +
-                           sourceNumberChannels * x + 0];
-          } else if (targetImage->format == GLUS_ALPHA) {
-            if (sourceImage->format == GLUS_RGB) {
-              channels[0] = 255;
-            } else if (sourceImage->format == GLUS_RGBA) {
-              channels[0] =
-                  sourceImage
-                      ->data[sourceNumberChannels * z * sourceImage->height *
-                                 sourceImage->width +
-                             sourceNumberChannels * y * sourceImage->width +
-                             sourceNumberChannels * x + 3];
-            }
-          } else if (targetImage->format == GLUS_LUMINANCE) {
-            channels[0] = 0.0f;
-
-            for (c = 0; c < 3; c++) {
-              channels[0] +=
-                  sourceImage
-                      ->data[sourceNumberChannels * z * sourceImage->height *
-                                 sourceImage->width +
-                             sourceNumberChannels * y * sourceImage->width +
-                             sourceNumberChannels * x + c] *
-                  toLuminace[c];
-            }
-          } else if (targetImage->format == GLUS_RGB ||
-                     targetImage->format == GLUS_RGBA) {
-            for (c = 0; c < 3; c++) {
-              channels[c] =
-                  sourceImage
-                      ->data[sourceNumberChannels * z * sourceImage->height *
-                                 sourceImage->width +
-                             sourceNumberChannels * y * sourceImage->width +
-                             sourceNumberChannels * x + c];
-            }
-
-            if (targetImage->format == GLUS_RGBA) {
-              if (sourceImage->format == GLUS_RGBA) {
-                channels[3] =
-                    sourceImage
-                        ->data[sourceNumberChannels * z * sourceImage->height *
-                                   sourceImage->width +
-                               sourceNumberChannels * y * sourceImage->width +
-                               sourceNumberChannels * x + 3];
-              } else {
-                channels[3] = 255;
-              }
-            }
-          }
-        }
-
-        for (c = 0; c < targetNumberChannels; c++) {
-          targetImage->data[targetNumberChannels * z * targetImage->height *
-                                targetImage->width +
-                            targetNumberChannels * y * targetImage->width +
-                            targetNumberChannels * x + c] = channels[c];
-        }
+  numberPixels = (size_t)sourceImage->width * sourceImage->height *
+                 sourceImage->depth;
+
+  if (sourceImage->format == targetFormat) {
+    memcpy(targetImage->data, sourceImage->data,
+           numberPixels * targetNumberChannels);
+  } else if (targetFormat == GLUS_ALPHA) {
+    if (sourceImage->format == GLUS_RGBA) {
+      glusImageExtractChannel(targetImage->data, sourceImage->data,
+                              numberPixels, 4, 3);
+    } else {
+      memset(targetImage->data, 255, numberPixels);
+    }
+  } else if (sourceImage->format == GLUS_ALPHA && targetNumberChannels == 1) {
+    memset(targetImage->data, 0, numberPixels);
+  } else if (sourceNumberChannels == 1 && targetNumberChannels == 1) {
+    // red to luminance and back
+    for (i = 0; i < 256; i++) {
+      if (targetFormat == GLUS_LUMINANCE) {
+        table[i] = (GLUSubyte)((i * GLUS_LUMINANCE_RED) >> 16);
+      } else {
+        table[i] = (GLUSubyte)glusMathClampf((GLUSfloat)i / 0.299f, 0.0f,
+                                             255.0f);
       }
     }
+
+    for (i = 0; i < numberPixels; i++) {
+      targetImage->data[i] = table[sourceImage->data[i]];
+    }
+  } else if (sourceNumberChannels == 1) {
+    // the value goes into the masked channels, the others are filled
+    if (sourceImage->format == GLUS_RED) {
+      mask[0] = 255;
+      fill[3] = 255;
+    } else if (sourceImage->format == GLUS_LUMINANCE) {
+      mask[0] = 255;
+      mask[1] = 255;
+      mask[2] = 255;
+      fill[3] = 255;
+    } else {
+      mask[3] = 255;
+    }
+
+    glusImageExpandChannel(targetImage->data, sourceImage->data, numberPixels,
+                           targetNumberChannels, mask, fill);
+  } else if (targetFormat == GLUS_RED) {
+    glusImageExtractChannel(targetImage->data, sourceImage->data, numberPixels,
+                            sourceNumberChannels, 0);
+  } else if (targetFormat == GLUS_LUMINANCE) {
+    glusImageColorToLuminance(targetImage->data, sourceImage->data,
+                              numberPixels, sourceNumberChannels);
+  } else if (targetFormat == GLUS_RGBA) {
+    glusImageRGBToRGBA(targetImage->data, sourceImage->data, numberPixels);
+  } else {
+    glusImageRGBAToRGB(targetImage->data, sourceImage->data, numberPixels);
   }
 
   return GLUS_TRUE;
@@ -883,10 +876,13 @@ GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage *targetImage,
 
 GLUSboolean GLUSAPIENTRY glusImageToPremultiplyTga(
     GLUStgaimage *targetImage, const GLUStgaimage *sourceImage) {
-  GLUSint x, y, z, c;
+  const GLUSubyte *source;
+  GLUSubyte *target;
+
+  size_t numberPixels, i;
 
-  GLUSfloat alpha;
-  GLUSfloat channel;
+  GLUSuint alpha;
+  GLUSuint value;
 
   if (!targetImage || !sourceImage) {
     return GLUS_FALSE;
@@ -908,27 +904,26 @@ GLUSboolean GLUSAPIENTRY glusImageToPremultiplyTga(
   targetImage->depth = sourceImage->depth;
   targetImage->format = sourceImage->format;
 
-  for (z = 0; z < targetImage->depth; z++) {
-    for (y = 0; y < targetImage->height; y++) {
-      for (x = 0; x < targetImage->width; x++) {
-        alpha = (GLUSfloat)sourceImage
-                    ->data[4 * z * targetImage->height * targetImage->width +
-                           4 * y * targetImage->width + 4 * x + 3] /
-                255.0f;
-
-        for (c = 0; c < 3; c++) {
-          channel =
-              (GLUSfloat)sourceImage
-                  ->data[4 * z * targetImage->height * targetImage->width +
-                         4 * y * targetImage->width + 4 * x + c] /
-              255.0f;
-
-          targetImage->data[4 * z * targetImage->height * targetImage->width +
-                            4 * y * targetImage->width + 4 * x + c] =
-              (GLUSubyte)glusMathClampf(channel * alpha * 255.0f, 0.0f, 255.0f);
-        }
-      }
-    }
+  numberPixels = (size_t)sourceImage->width * sourceImage->height *
+                 sourceImage->depth;
+
+  source = sourceImage->data;
+  target = targetImage->data;
+
+  // value * alpha / 255 rounded down, exact for all 8 bit values
+  for (i = 0; i < numberPixels; i++) {
+    alpha = source[4 * i + 3];
+
+    value = source[4 * i + 0] * alpha;
+    target[4 * i + 0] = (GLUSubyte)((value + 1 + (value >> 8)) >> 8);
+
+    value = source[4 * i + 1] * alpha;
+    target[4 * i + 1] = (GLUSubyte)((value + 1 + (value >> 8)) >> 8);
+
+    value = source[4 * i + 2] * alpha;
+    target[4 * i + 2] = (GLUSubyte)((value + 1 + (value >> 8)) >> 8);
+
+    target[4 * i + 3] = (GLUSubyte)alpha;
   }
 
   return GLUS_TRUE;
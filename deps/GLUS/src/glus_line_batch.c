@@ -0,0 +1,321 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_LINE_BATCH_START_CAPACITY 1024
+
+// Grows the memory to at least the required number of elements. The memory
+// stays valid, if growing fails.
+static GLUSboolean glusLineBatchGrowf(GLUSvoid **memory, GLUSuint *capacity,
+                                      const GLUSuint64 required,
+                                      const size_t elementSize) {
+  GLUSuint64 newCapacity;
+
+  GLUSvoid *newMemory;
+
+  if (required <= *capacity) {
+    return GLUS_TRUE;
+  }
+
+  newCapacity = *capacity > 0 ? *capacity : GLUS_LINE_BATCH_START_CAPACITY;
+
+  while (newCapacity < required) {
+    newCapacity *= 2;
+  }
+
+  if (newCapacity > 0xFFFFFFFF) {
+    newCapacity = 0xFFFFFFFF;
+  }
+
+  newMemory = glusMemoryRealloc(*memory, (size_t)newCapacity * elementSize);
+
+  if (!newMemory) {
+    return GLUS_FALSE;
+  }
+
+  *memory = newMemory;
+  *capacity = (GLUSuint)newCapacity;
+
+  return GLUS_TRUE;
+}
+
+// Makes room for the given number of additional vertices, indices and lines.
+static GLUSboolean glusLineBatchReservef(GLUSlinebatch *lineBatch,
+                                         const GLUSuint64 numberVertices,
+                                         const GLUSuint64 numberIndices,
+                                         const GLUSuint64 numberLines) {
+  GLUSuint64 totalVertices = lineBatch->numberVertices + numberVertices;
+  GLUSuint64 totalIndices = lineBatch->numberIndices + numberIndices;
+  GLUSuint64 totalLines = lineBatch->numberLines + numberLines;
+
+  // The restart index itself can not address a vertex.
+  if (totalVertices > GLUS_PRIMITIVE_RESTART_INDEX ||
+      totalIndices > 0xFFFFFFFF || totalLines > 0xFFFFFFFF) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusLineBatchGrowf((GLUSvoid **)&lineBatch->vertices,
+                          &lineBatch->capacityVertices, totalVertices,
+                          4 * sizeof(GLUSfloat))) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusLineBatchGrowf((GLUSvoid **)&lineBatch->indices,
+                          &lineBatch->capacityIndices, totalIndices,
+                          sizeof(GLUSindex))) {
+    return GLUS_FALSE;
+  }
+
+  if (lineBatch->capacityLines < totalLines) {
+    GLUSuint capacityLines = lineBatch->capacityLines;
+
+    if (!glusLineBatchGrowf((GLUSvoid **)&lineBatch->lineFirstIndices,
+                            &capacityLines, totalLines, sizeof(GLUSuint))) {
+      return GLUS_FALSE;
+    }
+
+    capacityLines = lineBatch->capacityLines;
+
+    if (!glusLineBatchGrowf((GLUSvoid **)&lineBatch->lineNumberIndices,
+                            &capacityLines, totalLines, sizeof(GLUSuint))) {
+      return GLUS_FALSE;
+    }
+
+    lineBatch->capacityLines = capacityLines;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Copies the vertices and returns the index of the first one.
+static GLUSuint glusLineBatchAddVerticesf(GLUSlinebatch *lineBatch,
+                                          const GLUSfloat *vertices,
+                                          const GLUSuint numberVertices) {
+  GLUSuint firstVertex = lineBatch->numberVertices;
+
+  memcpy(&lineBatch->vertices[4 * firstVertex], vertices,
+         4 * numberVertices * sizeof(GLUSfloat));
+
+  lineBatch->numberVertices += numberVertices;
+
+  return firstVertex;
+}
+
+static GLUSvoid glusLineBatchBeginLinef(GLUSlinebatch *lineBatch) {
+  if (lineBatch->numberIndices > 0) {
+    lineBatch->indices[lineBatch->numberIndices++] =
+        GLUS_PRIMITIVE_RESTART_INDEX;
+  }
+
+  lineBatch->lineFirstIndices[lineBatch->numberLines] =
+      lineBatch->numberIndices;
+}
+
+static GLUSvoid glusLineBatchEndLinef(GLUSlinebatch *lineBatch) {
+  lineBatch->lineNumberIndices[lineBatch->numberLines] =
+      lineBatch->numberIndices -
+      lineBatch->lineFirstIndices[lineBatch->numberLines];
+
+  lineBatch->numberLines++;
+}
+
+// Appends vertices and line strips, which are separated by the restart index.
+// Every strip becomes a line of its own.
+GLUSboolean _glusLineBatchAddIndexed(GLUSlinebatch *lineBatch,
+                                     const GLUSfloat *vertices,
+                                     const GLUSuint numberVertices,
+                                     const GLUSindex *indices,
+                                     const GLUSuint numberIndices) {
+  GLUSuint i;
+
+  GLUSuint firstVertex;
+
+  GLUSuint numberLines = 0;
+
+  if (!lineBatch || (numberVertices > 0 && !vertices) ||
+      (numberIndices > 0 && !indices)) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < numberIndices; i++) {
+    if (indices[i] == GLUS_PRIMITIVE_RESTART_INDEX) {
+      continue;
+    }
+
+    if (indices[i] >= numberVertices) {
+      return GLUS_FALSE;
+    }
+
+    if (i == 0 || indices[i - 1] == GLUS_PRIMITIVE_RESTART_INDEX) {
+      numberLines++;
+    }
+  }
+
+  if (!glusLineBatchReservef(lineBatch, numberVertices,
+                             (GLUSuint64)numberIndices + 1, numberLines)) {
+    return GLUS_FALSE;
+  }
+
+  firstVertex = glusLineBatchAddVerticesf(lineBatch, vertices, numberVertices);
+
+  for (i = 0; i < numberIndices; i++) {
+    if (indices[i] == GLUS_PRIMITIVE_RESTART_INDEX) {
+      continue;
+    }
+
+    if (i == 0 || indices[i - 1] == GLUS_PRIMITIVE_RESTART_INDEX) {
+      glusLineBatchBeginLinef(lineBatch);
+    }
+
+    lineBatch->indices[lineBatch->numberIndices++] =
+        (GLUSindex)(firstVertex + indices[i]);
+
+    if (i + 1 == numberIndices ||
+        indices[i + 1] == GLUS_PRIMITIVE_RESTART_INDEX) {
+      glusLineBatchEndLinef(lineBatch);
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusLineBatchInitf(GLUSlinebatch *lineBatch) {
+  if (!lineBatch) {
+    return GLUS_FALSE;
+  }
+
+  memset(lineBatch, 0, sizeof(GLUSlinebatch));
+
+  lineBatch->mode = GLUS_LINE_STRIP;
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusLineBatchAddLinef(GLUSlinebatch *lineBatch,
+                                               const GLUSline *line) {
+  GLUSuint i;
+
+  GLUSuint firstVertex;
+
+  if (!lineBatch || !line || !line->vertices || !line->indices ||
+      line->numberIndices < 2) {
+    return GLUS_FALSE;
+  }
+
+  if (line->mode != GLUS_LINES && line->mode != GLUS_LINE_STRIP &&
+      line->mode != GLUS_LINE_LOOP) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < line->numberIndices; i++) {
+    if (line->indices[i] >= line->numberVertices) {
+      return GLUS_FALSE;
+    }
+  }
+
+  // Separated segments need a restart index each.
+  if (!glusLineBatchReservef(lineBatch, line->numberVertices,
+                             2 * (GLUSuint64)line->numberIndices + 2, 1)) {
+    return GLUS_FALSE;
+  }
+
+  firstVertex = glusLineBatchAddVerticesf(lineBatch, line->vertices,
+                                          line->numberVertices);
+
+  glusLineBatchBeginLinef(lineBatch);
+
+  if (line->mode == GLUS_LINES) {
+    for (i = 0; i + 1 < line->numberIndices; i += 2) {
+      // A segment starting at the end of the previous one continues the strip.
+      if (i == 0 || line->indices[i] != line->indices[i - 1]) {
+        if (i > 0) {
+          lineBatch->indices[lineBatch->numberIndices++] =
+              GLUS_PRIMITIVE_RESTART_INDEX;
+        }
+
+        lineBatch->indices[lineBatch->numberIndices++] =
+            (GLUSindex)(firstVertex + line->indices[i]);
+      }
+
+      lineBatch->indices[lineBatch->numberIndices++] =
+          (GLUSindex)(firstVertex + line->indices[i + 1]);
+    }
+  } else {
+    for (i = 0; i < line->numberIndices; i++) {
+      lineBatch->indices[lineBatch->numberIndices++] =
+          (GLUSindex)(firstVertex + line->indices[i]);
+    }
+
+    if (line->mode == GLUS_LINE_LOOP) {
+      lineBatch->indices[lineBatch->numberIndices++] =
+          (GLUSindex)(firstVertex + line->indices[0]);
+    }
+  }
+
+  glusLineBatchEndLinef(lineBatch);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusLineBatchAddPolylinef(
+    GLUSlinebatch *lineBatch, const GLUSfloat *vertices,
+    const GLUSuint numberVertices, const GLUSboolean closed) {
+  GLUSuint i;
+
+  GLUSuint firstVertex;
+
+  if (!lineBatch || !vertices || numberVertices < 2) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusLineBatchReservef(lineBatch, numberVertices,
+                             (GLUSuint64)numberVertices + 2, 1)) {
+    return GLUS_FALSE;
+  }
+
+  firstVertex = glusLineBatchAddVerticesf(lineBatch, vertices, numberVertices);
+
+  glusLineBatchBeginLinef(lineBatch);
+
+  for (i = 0; i < numberVertices; i++) {
+    lineBatch->indices[lineBatch->numberIndices++] =
+        (GLUSindex)(firstVertex + i);
+  }
+
+  if (closed) {
+    lineBatch->indices[lineBatch->numberIndices++] = (GLUSindex)firstVertex;
+  }
+
+  glusLineBatchEndLinef(lineBatch);
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusLineBatchDestroyf(GLUSlinebatch *lineBatch) {
+  if (!lineBatch) {
+    return;
+  }
+
+  glusMemoryFree(lineBatch->vertices);
+  glusMemoryFree(lineBatch->indices);
+  glusMemoryFree(lineBatch->lineFirstIndices);
+  glusMemoryFree(lineBatch->lineNumberIndices);
+
+  memset(lineBatch, 0, sizeof(GLUSlinebatch));
+}
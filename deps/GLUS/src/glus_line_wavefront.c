@@ -21,7 +21,15 @@
 extern GLUSboolean _glusWavefrontParseLine(const GLUSchar *filename,
                                            GLUSline *line);
 
+extern GLUSboolean _glusWavefrontParseLineBatch(const GLUSchar *filename,
+                                                GLUSlinebatch *lineBatch);
+
 GLUSboolean GLUSAPIENTRY glusLineLoadWavefront(const GLUSchar *filename,
                                                GLUSline *line) {
   return _glusWavefrontParseLine(filename, line);
 }
+
+GLUSboolean GLUSAPIENTRY glusLineLoadWavefrontBatch(const GLUSchar *filename,
+                                                    GLUSlinebatch *lineBatch) {
+  return _glusWavefrontParseLineBatch(filename, lineBatch);
+}
@@ -57,3 +57,82 @@ GLUSfloat GLUSAPIENTRY glusMathLengthf(const GLUSfloat x, const GLUSfloat y,
                                        const GLUSfloat z) {
   return sqrtf(x * x + y * y + z * z);
 }
+
+GLUSushort GLUSAPIENTRY glusMathFloatToHalff(const GLUSfloat value) {
+  GLUSuint bits, absolute, sign, result, remainder;
+
+  memcpy(&bits, &value, sizeof(GLUSuint));
+
+  sign = (bits >> 16) & 0x8000;
+  absolute = bits & 0x7FFFFFFF;
+
+  // Infinity and not a number, keeping a not a number as such.
+  if (absolute >= 0x7F800000) {
+    return (GLUSushort)(sign | 0x7C00 | (absolute > 0x7F800000 ? 0x200 : 0));
+  }
+
+  // At least 65520 rounds to infinity.
+  if (absolute >= 0x477FF000) {
+    return (GLUSushort)(sign | 0x7C00);
+  }
+
+  // Below the smallest normal half float, the result is denormalized.
+  if (absolute < 0x38800000) {
+    GLUSuint shift, halfway;
+
+    if (absolute < 0x33000000) {
+      return (GLUSushort)sign;
+    }
+
+    shift = 126 - (absolute >> 23);
+    halfway = 1u << (shift - 1);
+
+    absolute = (absolute & 0x7FFFFF) | 0x800000;
+
+    result = absolute >> shift;
+    remainder = absolute & ((1u << shift) - 1);
+
+    if (remainder > halfway || (remainder == halfway && (result & 1))) {
+      result++;
+    }
+
+    return (GLUSushort)(sign | result);
+  }
+
+  // Rebias the exponent and round the mantissa to nearest even.
+  result = (absolute - 0x38000000) >> 13;
+  remainder = absolute & 0x1FFF;
+
+  if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1))) {
+    result++;
+  }
+
+  return (GLUSushort)(sign | result);
+}
+
+GLUSfloat GLUSAPIENTRY glusMathHalfToFloatf(const GLUSushort half) {
+  GLUSuint sign = ((GLUSuint)half & 0x8000) << 16;
+  GLUSuint exponent = ((GLUSuint)half >> 10) & 0x1F;
+  GLUSuint mantissa = (GLUSuint)half & 0x3FF;
+
+  GLUSuint bits;
+
+  GLUSfloat value;
+
+  if (exponent == 0) {
+    // Zero and denormalized values are a multiple of 2^-24.
+    value = (GLUSfloat)mantissa * 5.9604644775390625e-8f;
+
+    return sign ? -value : value;
+  }
+
+  if (exponent == 31) {
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+
+  memcpy(&value, &bits, sizeof(GLUSfloat));
+
+  return value;
+}
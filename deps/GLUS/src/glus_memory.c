@@ -20,4 +20,8 @@
 
 void *GLUSAPIENTRY glusMemoryMalloc(size_t size) { return malloc(size); }
 
+void *GLUSAPIENTRY glusMemoryRealloc(void *pointer, size_t size) {
+  return realloc(pointer, size);
+}
+
 void GLUSAPIENTRY glusMemoryFree(void *pointer) { free(pointer); }
@@ -18,6 +18,15 @@
 
 #include "GL/glus.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+extern GLUSboolean _glusWavefrontCacheContains(const GLUSvoid *cache,
+                                               const GLUSvoid *pointer);
+
+extern GLUSvoid _glusWavefrontCacheDestroy(GLUSvoid *cache);
+
 static GLUSvoid glusShapeInitf(GLUSshape *shape) {
   if (!shape) {
     return;
@@ -94,6 +103,42 @@ static GLUSboolean glusShapeFinalizef(GLUSshape *shape) {
   return GLUS_TRUE;
 }
 
+// Pi in double precision for the sine and cosine tables.
+#define GLUS_SHAPE_PI 3.1415926535897932384626433832795
+
+// Creates a table with the sines and cosines of numberSteps + 1 equal steps
+// around the circle. The cosines follow the sines, so only the returned
+// pointer has to be freed. The last step is set to the first one, so seams
+// are closed exactly.
+static GLUSfloat *glusShapeCreateSinCosf(const GLUSuint numberSteps) {
+  GLUSuint i;
+
+  GLUSfloat *sines;
+  GLUSfloat *cosines;
+
+  sines = (GLUSfloat *)glusMemoryMalloc(2 * (numberSteps + 1) *
+                                        sizeof(GLUSfloat));
+
+  if (!sines) {
+    return 0;
+  }
+
+  cosines = sines + numberSteps + 1;
+
+  for (i = 0; i < numberSteps; i++) {
+    GLUSdouble angle =
+        2.0 * GLUS_SHAPE_PI * (GLUSdouble)i / (GLUSdouble)numberSteps;
+
+    sines[i] = (GLUSfloat)sin(angle);
+    cosines[i] = (GLUSfloat)cos(angle);
+  }
+
+  sines[numberSteps] = sines[0];
+  cosines[numberSteps] = cosines[0];
+
+  return sines;
+}
+
 GLUSboolean GLUSAPIENTRY glusShapeCreatePlanef(GLUSshape *shape,
                                                const GLUSfloat halfExtend) {
   GLUSuint i;
@@ -364,7 +409,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateDiscf(GLUSshape *shape,
   GLUSuint numberVertices = numberSectors + 2;
   GLUSuint numberIndices = numberSectors * 3;
 
-  GLUSfloat angleStep = (2.0f * GLUS_PI) / ((GLUSfloat)numberSectors);
+  GLUSfloat *sines;
+  GLUSfloat *cosines;
 
   GLUSuint indexIndices;
   GLUSuint indexCounter;
@@ -401,6 +447,16 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateDiscf(GLUSshape *shape,
     return GLUS_FALSE;
   }
 
+  sines = glusShapeCreateSinCosf(numberSectors);
+
+  if (!sines) {
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  cosines = sines + numberSectors + 1;
+
   // Center
   shape->vertices[vertexCounter * 4 + 0] = 0.0f;
   shape->vertices[vertexCounter * 4 + 1] = 0.0f;
@@ -421,10 +477,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateDiscf(GLUSshape *shape,
   vertexCounter++;
 
   for (i = 0; i < numberSectors + 1; i++) {
-    GLUSfloat currentAngle = angleStep * (GLUSfloat)i;
-
-    shape->vertices[vertexCounter * 4 + 0] = cosf(currentAngle) * radius;
-    shape->vertices[vertexCounter * 4 + 1] = sinf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 0] = cosines[i] * radius;
+    shape->vertices[vertexCounter * 4 + 1] = sines[i] * radius;
     shape->vertices[vertexCounter * 4 + 2] = 0.0f;
     shape->vertices[vertexCounter * 4 + 3] = 1.0f;
 
@@ -436,8 +490,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateDiscf(GLUSshape *shape,
     shape->tangents[vertexCounter * 3 + 1] = 0.0f;
     shape->tangents[vertexCounter * 3 + 2] = 0.0f;
 
-    shape->texCoords[vertexCounter * 2 + 0] = 0.5f * cosf(currentAngle) * 0.5f;
-    shape->texCoords[vertexCounter * 2 + 1] = 0.5f * sinf(currentAngle) * 0.5f;
+    shape->texCoords[vertexCounter * 2 + 0] = 0.5f * cosines[i] * 0.5f;
+    shape->texCoords[vertexCounter * 2 + 1] = 0.5f * sines[i] * 0.5f;
 
     vertexCounter++;
   }
@@ -455,6 +509,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateDiscf(GLUSshape *shape,
     indexCounter++;
   }
 
+  glusMemoryFree(sines);
+
   if (!glusShapeFinalizef(shape)) {
     glusShapeDestroyf(shape);
 
@@ -591,24 +647,21 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCubef(GLUSshape *shape,
   return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusShapeCreateSpheref(GLUSshape *shape,
-                                                const GLUSfloat radius,
-                                                const GLUSuint numberSlices) {
+// Creates the upper part of a sphere with the given number of parallels. Half
+// of the slices as parallels give a full sphere.
+static GLUSboolean glusShapeCreateSphereSegmentf(
+    GLUSshape *shape, const GLUSfloat radius, const GLUSuint numberSlices,
+    const GLUSuint numberParallels) {
   GLUSuint i, j;
 
-  GLUSuint numberParallels = numberSlices / 2;
   GLUSuint numberVertices = (numberParallels + 1) * (numberSlices + 1);
   GLUSuint numberIndices = numberParallels * numberSlices * 6;
 
-  GLUSfloat angleStep = (2.0f * GLUS_PI) / ((GLUSfloat)numberSlices);
+  GLUSfloat *sines;
+  GLUSfloat *cosines;
 
   GLUSuint indexIndices;
 
-  // used later to help us calculating tangents vectors
-  GLUSfloat helpVector[3] = {1.0f, 0.0f, 0.0f};
-  GLUSfloat helpQuaternion[4];
-  GLUSfloat helpMatrix[16];
-
   if (numberSlices < 3 || numberVertices > GLUS_MAX_VERTICES ||
       numberIndices > GLUS_MAX_INDICES) {
     return GLUS_FALSE;
@@ -639,154 +692,55 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateSpheref(GLUSshape *shape,
     return GLUS_FALSE;
   }
 
-  for (i = 0; i < numberParallels + 1; i++) {
-    for (j = 0; j < numberSlices + 1; j++) {
-      GLUSuint vertexIndex = (i * (numberSlices + 1) + j) * 4;
-      GLUSuint normalIndex = (i * (numberSlices + 1) + j) * 3;
-      GLUSuint tangentIndex = (i * (numberSlices + 1) + j) * 3;
-      GLUSuint texCoordsIndex = (i * (numberSlices + 1) + j) * 2;
-
-      shape->vertices[vertexIndex + 0] = radius *
-                                         sinf(angleStep * (GLUSfloat)i) *
-                                         sinf(angleStep * (GLUSfloat)j);
-      shape->vertices[vertexIndex + 1] =
-          radius * cosf(angleStep * (GLUSfloat)i);
-      shape->vertices[vertexIndex + 2] = radius *
-                                         sinf(angleStep * (GLUSfloat)i) *
-                                         cosf(angleStep * (GLUSfloat)j);
-      shape->vertices[vertexIndex + 3] = 1.0f;
-
-      shape->normals[normalIndex + 0] =
-          shape->vertices[vertexIndex + 0] / radius;
-      shape->normals[normalIndex + 1] =
-          shape->vertices[vertexIndex + 1] / radius;
-      shape->normals[normalIndex + 2] =
-          shape->vertices[vertexIndex + 2] / radius;
-
-      shape->texCoords[texCoordsIndex + 0] =
-          (GLUSfloat)j / (GLUSfloat)numberSlices;
-      shape->texCoords[texCoordsIndex + 1] =
-          1.0f - (GLUSfloat)i / (GLUSfloat)numberParallels;
-
-      // use quaternion to get the tangent vector
-      glusQuaternionRotateRyf(helpQuaternion,
-                              360.0f * shape->texCoords[texCoordsIndex + 0]);
-      glusQuaternionGetMatrix4x4f(helpMatrix, helpQuaternion);
-
-      glusMatrix4x4MultiplyVector3f(&shape->tangents[tangentIndex], helpMatrix,
-                                    helpVector);
-    }
-  }
+  // The parallels use the same angle step as the slices.
+  sines = glusShapeCreateSinCosf(numberSlices);
 
-  indexIndices = 0;
-  for (i = 0; i < numberParallels; i++) {
-    for (j = 0; j < numberSlices; j++) {
-      shape->indices[indexIndices++] = i * (numberSlices + 1) + j;
-      shape->indices[indexIndices++] = (i + 1) * (numberSlices + 1) + j;
-      shape->indices[indexIndices++] = (i + 1) * (numberSlices + 1) + (j + 1);
-
-      shape->indices[indexIndices++] = i * (numberSlices + 1) + j;
-      shape->indices[indexIndices++] = (i + 1) * (numberSlices + 1) + (j + 1);
-      shape->indices[indexIndices++] = i * (numberSlices + 1) + (j + 1);
-    }
-  }
-
-  if (!glusShapeFinalizef(shape)) {
+  if (!sines) {
     glusShapeDestroyf(shape);
 
     return GLUS_FALSE;
   }
 
-  return GLUS_TRUE;
-}
-
-GLUSboolean GLUSAPIENTRY glusShapeCreateDomef(GLUSshape *shape,
-                                              const GLUSfloat radius,
-                                              const GLUSuint numberSlices) {
-  GLUSuint i, j;
-
-  GLUSuint numberParallels = numberSlices / 4;
-  GLUSuint numberVertices = (numberParallels + 1) * (numberSlices + 1);
-  GLUSuint numberIndices = numberParallels * numberSlices * 6;
-
-  GLUSfloat angleStep = (2.0f * GLUS_PI) / ((GLUSfloat)numberSlices);
-
-  GLUSuint indexIndices;
-
-  // used later to help us calculating tangents vectors
-  GLUSfloat helpVector[3] = {1.0f, 0.0f, 0.0f};
-  GLUSfloat helpQuaternion[4];
-  GLUSfloat helpMatrix[16];
-
-  if (numberSlices < 3 || numberVertices > GLUS_MAX_VERTICES ||
-      numberIndices > GLUS_MAX_INDICES) {
-    return GLUS_FALSE;
-  }
-
-  if (!shape) {
-    return GLUS_FALSE;
-  }
-  glusShapeInitf(shape);
-
-  shape->numberVertices = numberVertices;
-  shape->numberIndices = numberIndices;
+  cosines = sines + numberSlices + 1;
 
-  shape->vertices =
-      (GLUSfloat *)glusMemoryMalloc(4 * numberVertices * sizeof(GLUSfloat));
-  shape->normals =
-      (GLUSfloat *)glusMemoryMalloc(3 * numberVertices * sizeof(GLUSfloat));
-  shape->tangents =
-      (GLUSfloat *)glusMemoryMalloc(3 * numberVertices * sizeof(GLUSfloat));
-  shape->texCoords =
-      (GLUSfloat *)glusMemoryMalloc(2 * numberVertices * sizeof(GLUSfloat));
-  shape->indices =
-      (GLUSindex *)glusMemoryMalloc(numberIndices * sizeof(GLUSindex));
-
-  if (!glusShapeCheckf(shape)) {
-    glusShapeDestroyf(shape);
+  for (i = 0; i < numberParallels + 1; i++) {
+    GLUSfloat sinParallel = sines[i];
+    GLUSfloat cosParallel = cosines[i];
 
-    return GLUS_FALSE;
-  }
+    GLUSfloat t = 1.0f - (GLUSfloat)i / (GLUSfloat)numberParallels;
 
-  for (i = 0; i < numberParallels + 1; i++) {
     for (j = 0; j < numberSlices + 1; j++) {
       GLUSuint vertexIndex = (i * (numberSlices + 1) + j) * 4;
       GLUSuint normalIndex = (i * (numberSlices + 1) + j) * 3;
       GLUSuint tangentIndex = (i * (numberSlices + 1) + j) * 3;
       GLUSuint texCoordsIndex = (i * (numberSlices + 1) + j) * 2;
 
-      shape->vertices[vertexIndex + 0] = radius *
-                                         sinf(angleStep * (GLUSfloat)i) *
-                                         sinf(angleStep * (GLUSfloat)j);
-      shape->vertices[vertexIndex + 1] =
-          radius * cosf(angleStep * (GLUSfloat)i);
-      shape->vertices[vertexIndex + 2] = radius *
-                                         sinf(angleStep * (GLUSfloat)i) *
-                                         cosf(angleStep * (GLUSfloat)j);
+      GLUSfloat x = sinParallel * sines[j];
+      GLUSfloat z = sinParallel * cosines[j];
+
+      shape->vertices[vertexIndex + 0] = radius * x;
+      shape->vertices[vertexIndex + 1] = radius * cosParallel;
+      shape->vertices[vertexIndex + 2] = radius * z;
       shape->vertices[vertexIndex + 3] = 1.0f;
 
-      shape->normals[normalIndex + 0] =
-          shape->vertices[vertexIndex + 0] / radius;
-      shape->normals[normalIndex + 1] =
-          shape->vertices[vertexIndex + 1] / radius;
-      shape->normals[normalIndex + 2] =
-          shape->vertices[vertexIndex + 2] / radius;
+      shape->normals[normalIndex + 0] = x;
+      shape->normals[normalIndex + 1] = cosParallel;
+      shape->normals[normalIndex + 2] = z;
 
       shape->texCoords[texCoordsIndex + 0] =
           (GLUSfloat)j / (GLUSfloat)numberSlices;
-      shape->texCoords[texCoordsIndex + 1] =
-          1.0f - (GLUSfloat)i / (GLUSfloat)numberParallels;
+      shape->texCoords[texCoordsIndex + 1] = t;
 
-      // use quaternion to get the tangent vector
-      glusQuaternionRotateRyf(helpQuaternion,
-                              360.0f * shape->texCoords[texCoordsIndex + 0]);
-      glusQuaternionGetMatrix4x4f(helpMatrix, helpQuaternion);
-
-      glusMatrix4x4MultiplyVector3f(&shape->tangents[tangentIndex], helpMatrix,
-                                    helpVector);
+      // The tangent is the x axis rotated around the y axis by the angle of
+      // the slice.
+      shape->tangents[tangentIndex + 0] = cosines[j];
+      shape->tangents[tangentIndex + 1] = 0.0f;
+      shape->tangents[tangentIndex + 2] = -sines[j];
     }
   }
 
+  glusMemoryFree(sines);
+
   indexIndices = 0;
   for (i = 0; i < numberParallels; i++) {
     for (j = 0; j < numberSlices; j++) {
@@ -809,6 +763,20 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateDomef(GLUSshape *shape,
   return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusShapeCreateSpheref(GLUSshape *shape,
+                                                const GLUSfloat radius,
+                                                const GLUSuint numberSlices) {
+  return glusShapeCreateSphereSegmentf(shape, radius, numberSlices,
+                                       numberSlices / 2);
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeCreateDomef(GLUSshape *shape,
+                                              const GLUSfloat radius,
+                                              const GLUSuint numberSlices) {
+  return glusShapeCreateSphereSegmentf(shape, radius, numberSlices,
+                                       numberSlices / 4);
+}
+
 /*
  * @author Pablo Alonso-Villaverde Roza
  * @author Norbert Nopper
@@ -819,25 +787,17 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateTorusf(GLUSshape *shape,
                                                const GLUSuint numberSlices,
                                                const GLUSuint numberStacks) {
   // s, t = parametric values of the equations, in the range [0,1]
-  GLUSfloat s = 0;
-  GLUSfloat t = 0;
-
-  // sIncr, tIncr are increment values aplied to s and t on each loop iteration
-  // to generate the torus
-  GLUSfloat sIncr;
-  GLUSfloat tIncr;
+  GLUSfloat s, t;
 
   // to store precomputed sin and cos values
   GLUSfloat cos2PIs, sin2PIs, cos2PIt, sin2PIt;
 
+  // tables with the sin and cos values of all slices and stacks
+  GLUSfloat *sinesS, *cosinesS, *sinesT, *cosinesT;
+
   GLUSuint numberVertices;
   GLUSuint numberIndices;
 
-  // used later to help us calculating tangents vectors
-  GLUSfloat helpVector[3] = {0.0f, 1.0f, 0.0f};
-  GLUSfloat helpQuaternion[4];
-  GLUSfloat helpMatrix[16];
-
   // indices for each type of buffer (of vertices, indices, normals...)
   GLUSuint indexVertices, indexIndices, indexNormals, indexTangents,
       indexTexCoords;
@@ -885,20 +845,33 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateTorusf(GLUSshape *shape,
     return GLUS_FALSE;
   }
 
-  sIncr = 1.0f / (GLUSfloat)numberSlices;
-  tIncr = 1.0f / (GLUSfloat)numberStacks;
+  sinesS = glusShapeCreateSinCosf(numberSlices);
+  sinesT = glusShapeCreateSinCosf(numberStacks);
+
+  if (!sinesS || !sinesT) {
+    glusMemoryFree(sinesS);
+    glusMemoryFree(sinesT);
+
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  cosinesS = sinesS + numberSlices + 1;
+  cosinesT = sinesT + numberStacks + 1;
 
   // generate vertices and its attributes
-  for (sideCount = 0; sideCount <= numberSlices; ++sideCount, s += sIncr) {
-    // precompute some values
-    cos2PIs = (GLUSfloat)cosf(2.0f * GLUS_PI * s);
-    sin2PIs = (GLUSfloat)sinf(2.0f * GLUS_PI * s);
+  for (sideCount = 0; sideCount <= numberSlices; ++sideCount) {
+    s = (GLUSfloat)sideCount / (GLUSfloat)numberSlices;
+
+    cos2PIs = cosinesS[sideCount];
+    sin2PIs = sinesS[sideCount];
 
-    t = 0.0f;
-    for (faceCount = 0; faceCount <= numberStacks; ++faceCount, t += tIncr) {
-      // precompute some values
-      cos2PIt = (GLUSfloat)cosf(2.0f * GLUS_PI * t);
-      sin2PIt = (GLUSfloat)sinf(2.0f * GLUS_PI * t);
+    for (faceCount = 0; faceCount <= numberStacks; ++faceCount) {
+      t = (GLUSfloat)faceCount / (GLUSfloat)numberStacks;
+
+      cos2PIt = cosinesT[faceCount];
+      sin2PIt = sinesT[faceCount];
 
       // generate vertex and stores it in the right position
       indexVertices = ((sideCount * (numberStacks + 1)) + faceCount) * 4;
@@ -923,17 +896,17 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateTorusf(GLUSshape *shape,
       shape->texCoords[indexTexCoords + 0] = s;
       shape->texCoords[indexTexCoords + 1] = t;
 
-      // use quaternion to get the tangent vector
-      glusQuaternionRotateRzf(helpQuaternion, 360.0f * s);
-      glusQuaternionGetMatrix4x4f(helpMatrix, helpQuaternion);
-
+      // the tangent is the y axis rotated around the z axis by 2PIs
       indexTangents = ((sideCount * (numberStacks + 1)) + faceCount) * 3;
-
-      glusMatrix4x4MultiplyVector3f(&shape->tangents[indexTangents], helpMatrix,
-                                    helpVector);
+      shape->tangents[indexTangents + 0] = -sin2PIs;
+      shape->tangents[indexTangents + 1] = cos2PIs;
+      shape->tangents[indexTangents + 2] = 0.0f;
     }
   }
 
+  glusMemoryFree(sinesS);
+  glusMemoryFree(sinesT);
+
   // generate indices
   indexIndices = 0;
   for (sideCount = 0; sideCount < numberSlices; ++sideCount) {
@@ -975,7 +948,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCylinderf(GLUSshape *shape,
   GLUSuint numberVertices = (numberSlices + 2) * 2 + (numberSlices + 1) * 2;
   GLUSuint numberIndices = numberSlices * 3 * 2 + numberSlices * 6;
 
-  GLUSfloat angleStep = (2.0f * GLUS_PI) / ((GLUSfloat)numberSlices);
+  GLUSfloat *sines;
+  GLUSfloat *cosines;
 
   GLUSuint indexIndices;
   GLUSuint centerIndex;
@@ -1013,6 +987,16 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCylinderf(GLUSshape *shape,
     return GLUS_FALSE;
   }
 
+  sines = glusShapeCreateSinCosf(numberSlices);
+
+  if (!sines) {
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  cosines = sines + numberSlices + 1;
+
   // Center bottom
   shape->vertices[vertexCounter * 4 + 0] = 0.0f;
   shape->vertices[vertexCounter * 4 + 1] = -halfExtend;
@@ -1034,20 +1018,19 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCylinderf(GLUSshape *shape,
 
   // Bottom
   for (i = 0; i < numberSlices + 1; i++) {
-    GLUSfloat currentAngle = angleStep * (GLUSfloat)i;
 
-    shape->vertices[vertexCounter * 4 + 0] = cosf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 0] = cosines[i] * radius;
     shape->vertices[vertexCounter * 4 + 1] = -halfExtend;
-    shape->vertices[vertexCounter * 4 + 2] = -sinf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 2] = -sines[i] * radius;
     shape->vertices[vertexCounter * 4 + 3] = 1.0f;
 
     shape->normals[vertexCounter * 3 + 0] = 0.0f;
     shape->normals[vertexCounter * 3 + 1] = -1.0f;
     shape->normals[vertexCounter * 3 + 2] = 0.0f;
 
-    shape->tangents[vertexCounter * 3 + 0] = sinf(currentAngle);
+    shape->tangents[vertexCounter * 3 + 0] = sines[i];
     shape->tangents[vertexCounter * 3 + 1] = 0.0f;
-    shape->tangents[vertexCounter * 3 + 2] = cosf(currentAngle);
+    shape->tangents[vertexCounter * 3 + 2] = cosines[i];
 
     shape->texCoords[vertexCounter * 2 + 0] = 0.0f;
     shape->texCoords[vertexCounter * 2 + 1] = 0.0f;
@@ -1076,20 +1059,19 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCylinderf(GLUSshape *shape,
 
   // Top
   for (i = 0; i < numberSlices + 1; i++) {
-    GLUSfloat currentAngle = angleStep * (GLUSfloat)i;
 
-    shape->vertices[vertexCounter * 4 + 0] = cosf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 0] = cosines[i] * radius;
     shape->vertices[vertexCounter * 4 + 1] = halfExtend;
-    shape->vertices[vertexCounter * 4 + 2] = -sinf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 2] = -sines[i] * radius;
     shape->vertices[vertexCounter * 4 + 3] = 1.0f;
 
     shape->normals[vertexCounter * 3 + 0] = 0.0f;
     shape->normals[vertexCounter * 3 + 1] = 1.0f;
     shape->normals[vertexCounter * 3 + 2] = 0.0f;
 
-    shape->tangents[vertexCounter * 3 + 0] = -sinf(currentAngle);
+    shape->tangents[vertexCounter * 3 + 0] = -sines[i];
     shape->tangents[vertexCounter * 3 + 1] = 0.0f;
-    shape->tangents[vertexCounter * 3 + 2] = -cosf(currentAngle);
+    shape->tangents[vertexCounter * 3 + 2] = -cosines[i];
 
     shape->texCoords[vertexCounter * 2 + 0] = 1.0f;
     shape->texCoords[vertexCounter * 2 + 1] = 1.0f;
@@ -1098,23 +1080,22 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCylinderf(GLUSshape *shape,
   }
 
   for (i = 0; i < numberSlices + 1; i++) {
-    GLUSfloat currentAngle = angleStep * (GLUSfloat)i;
 
     GLUSfloat sign = -1.0f;
 
     for (j = 0; j < 2; j++) {
-      shape->vertices[vertexCounter * 4 + 0] = cosf(currentAngle) * radius;
+      shape->vertices[vertexCounter * 4 + 0] = cosines[i] * radius;
       shape->vertices[vertexCounter * 4 + 1] = halfExtend * sign;
-      shape->vertices[vertexCounter * 4 + 2] = -sinf(currentAngle) * radius;
+      shape->vertices[vertexCounter * 4 + 2] = -sines[i] * radius;
       shape->vertices[vertexCounter * 4 + 3] = 1.0f;
 
-      shape->normals[vertexCounter * 3 + 0] = cosf(currentAngle);
+      shape->normals[vertexCounter * 3 + 0] = cosines[i];
       shape->normals[vertexCounter * 3 + 1] = 0.0f;
-      shape->normals[vertexCounter * 3 + 2] = -sinf(currentAngle);
+      shape->normals[vertexCounter * 3 + 2] = -sines[i];
 
-      shape->tangents[vertexCounter * 3 + 0] = -sinf(currentAngle);
+      shape->tangents[vertexCounter * 3 + 0] = -sines[i];
       shape->tangents[vertexCounter * 3 + 1] = 0.0f;
-      shape->tangents[vertexCounter * 3 + 2] = -cosf(currentAngle);
+      shape->tangents[vertexCounter * 3 + 2] = -cosines[i];
 
       shape->texCoords[vertexCounter * 2 + 0] =
           (GLUSfloat)i / (GLUSfloat)numberSlices;
@@ -1167,6 +1148,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateCylinderf(GLUSshape *shape,
     indexCounter += 2;
   }
 
+  glusMemoryFree(sines);
+
   if (!glusShapeFinalizef(shape)) {
     glusShapeDestroyf(shape);
 
@@ -1187,7 +1170,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateConef(GLUSshape *shape,
       (numberSlices + 2) + (numberSlices + 1) * (numberStacks + 1);
   GLUSuint numberIndices = numberSlices * 3 + numberSlices * 6 * numberStacks;
 
-  GLUSfloat angleStep = (2.0f * GLUS_PI) / ((GLUSfloat)numberSlices);
+  GLUSfloat *sines;
+  GLUSfloat *cosines;
 
   GLUSuint indexIndices;
   GLUSuint centerIndex;
@@ -1229,6 +1213,16 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateConef(GLUSshape *shape,
     return GLUS_FALSE;
   }
 
+  sines = glusShapeCreateSinCosf(numberSlices);
+
+  if (!sines) {
+    glusShapeDestroyf(shape);
+
+    return GLUS_FALSE;
+  }
+
+  cosines = sines + numberSlices + 1;
+
   // Center bottom
   shape->vertices[vertexCounter * 4 + 0] = 0.0f;
   shape->vertices[vertexCounter * 4 + 1] = -halfExtend;
@@ -1250,20 +1244,19 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateConef(GLUSshape *shape,
 
   // Bottom
   for (i = 0; i < numberSlices + 1; i++) {
-    GLUSfloat currentAngle = angleStep * (GLUSfloat)i;
 
-    shape->vertices[vertexCounter * 4 + 0] = cosf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 0] = cosines[i] * radius;
     shape->vertices[vertexCounter * 4 + 1] = -halfExtend;
-    shape->vertices[vertexCounter * 4 + 2] = -sinf(currentAngle) * radius;
+    shape->vertices[vertexCounter * 4 + 2] = -sines[i] * radius;
     shape->vertices[vertexCounter * 4 + 3] = 1.0f;
 
     shape->normals[vertexCounter * 3 + 0] = 0.0f;
     shape->normals[vertexCounter * 3 + 1] = -1.0f;
     shape->normals[vertexCounter * 3 + 2] = 0.0f;
 
-    shape->tangents[vertexCounter * 3 + 0] = sinf(currentAngle);
+    shape->tangents[vertexCounter * 3 + 0] = sines[i];
     shape->tangents[vertexCounter * 3 + 1] = 0.0f;
-    shape->tangents[vertexCounter * 3 + 2] = cosf(currentAngle);
+    shape->tangents[vertexCounter * 3 + 2] = cosines[i];
 
     shape->texCoords[vertexCounter * 2 + 0] = 0.0f;
     shape->texCoords[vertexCounter * 2 + 1] = 0.0f;
@@ -1275,23 +1268,22 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateConef(GLUSshape *shape,
     GLUSfloat level = (GLUSfloat)j / (GLUSfloat)numberStacks;
 
     for (i = 0; i < numberSlices + 1; i++) {
-      GLUSfloat currentAngle = angleStep * (GLUSfloat)i;
 
       shape->vertices[vertexCounter * 4 + 0] =
-          cosf(currentAngle) * radius * (1.0f - level);
+          cosines[i] * radius * (1.0f - level);
       shape->vertices[vertexCounter * 4 + 1] =
           -halfExtend + 2.0f * halfExtend * level;
       shape->vertices[vertexCounter * 4 + 2] =
-          -sinf(currentAngle) * radius * (1.0f - level);
+          -sines[i] * radius * (1.0f - level);
       shape->vertices[vertexCounter * 4 + 3] = 1.0f;
 
-      shape->normals[vertexCounter * 3 + 0] = h / l * cosf(currentAngle);
+      shape->normals[vertexCounter * 3 + 0] = h / l * cosines[i];
       shape->normals[vertexCounter * 3 + 1] = r / l;
-      shape->normals[vertexCounter * 3 + 2] = h / l * -sinf(currentAngle);
+      shape->normals[vertexCounter * 3 + 2] = h / l * -sines[i];
 
-      shape->tangents[vertexCounter * 3 + 0] = -sinf(currentAngle);
+      shape->tangents[vertexCounter * 3 + 0] = -sines[i];
       shape->tangents[vertexCounter * 3 + 1] = 0.0f;
-      shape->tangents[vertexCounter * 3 + 2] = -cosf(currentAngle);
+      shape->tangents[vertexCounter * 3 + 2] = -cosines[i];
 
       shape->texCoords[vertexCounter * 2 + 0] =
           (GLUSfloat)i / (GLUSfloat)numberSlices;
@@ -1332,6 +1324,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateConef(GLUSshape *shape,
     indexCounter++;
   }
 
+  glusMemoryFree(sines);
+
   if (!glusShapeFinalizef(shape)) {
     glusShapeDestroyf(shape);
 
@@ -1341,9 +1335,225 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateConef(GLUSshape *shape,
   return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusShapeCalculateTangentBitangentf(GLUSshape *shape) {
+// Number of triangles, from which on the tangent space is calculated in
+// parallel.
+#define GLUS_SHAPE_PARALLEL_TRIANGLES 16384
+
+// Calculates the normalized tangent and bitangent of the triangle with the
+// given vertex indices.
+static GLUSvoid glusShapeCalculateTriangleTangentf(const GLUSshape *shape,
+                                                   GLUSuint index0,
+                                                   GLUSuint index1,
+                                                   GLUSuint index2,
+                                                   GLUSfloat *tangent,
+                                                   GLUSfloat *bitangent) {
+  GLUSfloat s1, t1, s2, t2;
+  GLUSfloat Q1[4];
+  GLUSfloat Q2[4];
+  GLUSfloat scalar;
+
+  s1 = shape->texCoords[2 * index1] - shape->texCoords[2 * index0];
+  t1 = shape->texCoords[2 * index1 + 1] - shape->texCoords[2 * index0 + 1];
+  s2 = shape->texCoords[2 * index2] - shape->texCoords[2 * index0];
+  t2 = shape->texCoords[2 * index2 + 1] - shape->texCoords[2 * index0 + 1];
+
+  scalar = 1.0f / (s1 * t2 - s2 * t1);
+
+  glusPoint4SubtractPoint4f(Q1, &shape->vertices[4 * index1],
+                            &shape->vertices[4 * index0]);
+  Q1[3] = 1.0f;
+  glusPoint4SubtractPoint4f(Q2, &shape->vertices[4 * index2],
+                            &shape->vertices[4 * index0]);
+  Q2[3] = 1.0f;
+
+  tangent[0] = scalar * (t2 * Q1[0] - t1 * Q2[0]);
+  tangent[1] = scalar * (t2 * Q1[1] - t1 * Q2[1]);
+  tangent[2] = scalar * (t2 * Q1[2] - t1 * Q2[2]);
+
+  bitangent[0] = scalar * (-s2 * Q1[0] + s1 * Q2[0]);
+  bitangent[1] = scalar * (-s2 * Q1[1] + s1 * Q2[1]);
+  bitangent[2] = scalar * (-s2 * Q1[2] + s1 * Q2[2]);
+
+  glusVector3Normalizef(tangent);
+
+  glusVector3Normalizef(bitangent);
+}
+
+// Adds a triangle tangent and bitangent to the given vertex.
+static GLUSvoid glusShapeAddTangentf(GLUSshape *shape, GLUSuint index,
+                                     const GLUSfloat *tangent,
+                                     const GLUSfloat *bitangent) {
+  shape->tangents[3 * index] += tangent[0];
+  shape->tangents[3 * index + 1] += tangent[1];
+  shape->tangents[3 * index + 2] += tangent[2];
+
+  shape->bitangents[3 * index] += bitangent[0];
+  shape->bitangents[3 * index + 1] += bitangent[1];
+  shape->bitangents[3 * index + 2] += bitangent[2];
+}
+
+// Makes the summed up tangent of the vertex orthogonal to the normal with
+// Gram-Schmidt. The bitangent is then the cross product of the normal and the
+// tangent, pointing to the side of the summed up bitangent, so mirrored
+// texture coordinates keep their handedness. Without a normal, the summed up
+// vectors are only normalized.
+static GLUSvoid glusShapeOrthonormalizeTangentf(GLUSshape *shape,
+                                                GLUSuint index) {
+  GLUSfloat *tangent = &shape->tangents[3 * index];
+  GLUSfloat *bitangent = &shape->bitangents[3 * index];
+
+  const GLUSfloat *normal;
+
+  GLUSfloat lengthSquared;
+  GLUSfloat projection;
+
+  GLUSfloat crossProduct[3];
+
+  GLUSint k;
+
+  if (!shape->normals) {
+    glusVector3Normalizef(tangent);
+    glusVector3Normalizef(bitangent);
+
+    return;
+  }
+
+  normal = &shape->normals[3 * index];
+
+  lengthSquared = glusVector3Dotf(normal, normal);
+
+  if (lengthSquared == 0.0f) {
+    glusVector3Normalizef(tangent);
+    glusVector3Normalizef(bitangent);
+
+    return;
+  }
+
+  projection = glusVector3Dotf(normal, tangent) / lengthSquared;
+
+  for (k = 0; k < 3; k++) {
+    tangent[k] -= projection * normal[k];
+  }
+
+  // The tangent is parallel to the normal, so there is no tangent plane.
+  if (!glusVector3Normalizef(tangent)) {
+    glusVector3Normalizef(bitangent);
+
+    return;
+  }
+
+  glusVector3Crossf(crossProduct, normal, tangent);
+
+  glusVector3Normalizef(crossProduct);
+
+  if (glusVector3Dotf(crossProduct, bitangent) < 0.0f) {
+    for (k = 0; k < 3; k++) {
+      crossProduct[k] = -crossProduct[k];
+    }
+  }
+
+  for (k = 0; k < 3; k++) {
+    bitangent[k] = crossProduct[k];
+  }
+}
+
+#ifdef _OPENMP
+// Adds the triangle tangents to the vertices in the range [firstVertex,
+// lastVertex) and orthonormalizes them. The indices are walked in order, so
+// each vertex sums up its triangles in the same order as a serial pass and only
+// the owner of a vertex writes to it.
+static GLUSvoid glusShapeAccumulateTangentf(GLUSshape *shape,
+                                            const GLUSfloat *triangleTangents,
+                                            const GLUSfloat *triangleBitangents,
+                                            GLUSuint numberTriangles,
+                                            GLUSuint firstVertex,
+                                            GLUSuint lastVertex) {
   GLUSuint i;
 
+  for (i = 0; i < numberTriangles * 3; i++) {
+    GLUSuint index = shape->indices[i];
+
+    if (index < firstVertex || index >= lastVertex) {
+      continue;
+    }
+
+    glusShapeAddTangentf(shape, index, &triangleTangents[3 * (i / 3)],
+                         &triangleBitangents[3 * (i / 3)]);
+  }
+
+  // Orthonormalize, as several triangles have added a vector
+  for (i = firstVertex; i < lastVertex; i++) {
+    glusShapeOrthonormalizeTangentf(shape, i);
+  }
+}
+
+// Calculates the tangents of an indexed shape with several threads.
+static GLUSboolean
+glusShapeCalculateTangentParallelf(GLUSshape *shape, GLUSuint numberTriangles) {
+  GLUSfloat *triangleTangents;
+  GLUSfloat *triangleBitangents;
+
+  GLUSint i;
+
+  triangleTangents =
+      (GLUSfloat *)glusMemoryMalloc(3 * numberTriangles * sizeof(GLUSfloat));
+  triangleBitangents =
+      (GLUSfloat *)glusMemoryMalloc(3 * numberTriangles * sizeof(GLUSfloat));
+
+  if (!triangleTangents || !triangleBitangents) {
+    glusMemoryFree(triangleTangents);
+    glusMemoryFree(triangleBitangents);
+
+    return GLUS_FALSE;
+  }
+
+  // The triangles are independent of each other.
+#pragma omp parallel for
+  for (i = 0; i < (GLUSint)numberTriangles; i++) {
+    glusShapeCalculateTriangleTangentf(
+        shape, shape->indices[3 * i], shape->indices[3 * i + 1],
+        shape->indices[3 * i + 2], &triangleTangents[3 * i],
+        &triangleBitangents[3 * i]);
+  }
+
+  // Shared vertices are partitioned by index, so no two threads add to the
+  // same vertex.
+#pragma omp parallel
+  {
+    GLUSuint numberThreads = (GLUSuint)omp_get_num_threads();
+
+    GLUSuint thread = (GLUSuint)omp_get_thread_num();
+
+    GLUSuint verticesPerThread =
+        (shape->numberVertices + numberThreads - 1) / numberThreads;
+
+    GLUSuint firstVertex = thread * verticesPerThread;
+
+    GLUSuint lastVertex = firstVertex + verticesPerThread;
+
+    if (lastVertex > shape->numberVertices) {
+      lastVertex = shape->numberVertices;
+    }
+
+    if (firstVertex < lastVertex) {
+      glusShapeAccumulateTangentf(shape, triangleTangents,
+                                  triangleBitangents, numberTriangles,
+                                  firstVertex, lastVertex);
+    }
+  }
+
+  glusMemoryFree(triangleTangents);
+  glusMemoryFree(triangleBitangents);
+
+  return GLUS_TRUE;
+}
+#endif
+
+GLUSboolean GLUSAPIENTRY glusShapeCalculateTangentBitangentf(GLUSshape *shape) {
+  GLUSint i;
+
+  GLUSuint numberTriangles;
+
   if (!shape || !shape->vertices || !shape->texCoords ||
       shape->mode != GLUS_TRIANGLES) {
     return GLUS_FALSE;
@@ -1369,144 +1579,60 @@ GLUSboolean GLUSAPIENTRY glusShapeCalculateTangentBitangentf(GLUSshape *shape) {
   }
 
   // Reset all tangents to 0.0f
-  for (i = 0; i < shape->numberVertices; i++) {
-    shape->tangents[i * 3] = 0.0f;
-    shape->tangents[i * 3 + 1] = 0.0f;
-    shape->tangents[i * 3 + 2] = 0.0f;
-
-    shape->bitangents[i * 3] = 0.0f;
-    shape->bitangents[i * 3 + 1] = 0.0f;
-    shape->bitangents[i * 3 + 2] = 0.0f;
-  }
+  memset(shape->tangents, 0, 3 * shape->numberVertices * sizeof(GLUSfloat));
+  memset(shape->bitangents, 0, 3 * shape->numberVertices * sizeof(GLUSfloat));
 
   if (shape->numberIndices > 0) {
-    float s1, t1, s2, t2;
-    float Q1[4];
-    float Q2[4];
-    float tangent[3];
-    float bitangent[3];
-    float scalar;
-
-    for (i = 0; i < shape->numberIndices; i += 3) {
-      s1 = shape->texCoords[2 * shape->indices[i + 1]] -
-           shape->texCoords[2 * shape->indices[i]];
-      t1 = shape->texCoords[2 * shape->indices[i + 1] + 1] -
-           shape->texCoords[2 * shape->indices[i] + 1];
-      s2 = shape->texCoords[2 * shape->indices[i + 2]] -
-           shape->texCoords[2 * shape->indices[i]];
-      t2 = shape->texCoords[2 * shape->indices[i + 2] + 1] -
-           shape->texCoords[2 * shape->indices[i] + 1];
-
-      scalar = 1.0f / (s1 * t2 - s2 * t1);
-
-      glusPoint4SubtractPoint4f(Q1, &shape->vertices[4 * shape->indices[i + 1]],
-                                &shape->vertices[4 * shape->indices[i]]);
-      Q1[3] = 1.0f;
-      glusPoint4SubtractPoint4f(Q2, &shape->vertices[4 * shape->indices[i + 2]],
-                                &shape->vertices[4 * shape->indices[i]]);
-      Q2[3] = 1.0f;
-
-      tangent[0] = scalar * (t2 * Q1[0] - t1 * Q2[0]);
-      tangent[1] = scalar * (t2 * Q1[1] - t1 * Q2[1]);
-      tangent[2] = scalar * (t2 * Q1[2] - t1 * Q2[2]);
-
-      bitangent[0] = scalar * (-s2 * Q1[0] + s1 * Q2[0]);
-      bitangent[1] = scalar * (-s2 * Q1[1] + s1 * Q2[1]);
-      bitangent[2] = scalar * (-s2 * Q1[2] + s1 * Q2[2]);
-
-      glusVector3Normalizef(tangent);
-
-      glusVector3Normalizef(bitangent);
-
-      shape->tangents[3 * shape->indices[i]] += tangent[0];
-      shape->tangents[3 * shape->indices[i] + 1] += tangent[1];
-      shape->tangents[3 * shape->indices[i] + 2] += tangent[2];
-
-      shape->tangents[3 * shape->indices[i + 1]] += tangent[0];
-      shape->tangents[3 * shape->indices[i + 1] + 1] += tangent[1];
-      shape->tangents[3 * shape->indices[i + 1] + 2] += tangent[2];
-
-      shape->tangents[3 * shape->indices[i + 2]] += tangent[0];
-      shape->tangents[3 * shape->indices[i + 2] + 1] += tangent[1];
-      shape->tangents[3 * shape->indices[i + 2] + 2] += tangent[2];
-
-      shape->bitangents[3 * shape->indices[i]] += bitangent[0];
-      shape->bitangents[3 * shape->indices[i] + 1] += bitangent[1];
-      shape->bitangents[3 * shape->indices[i] + 2] += bitangent[2];
-
-      shape->bitangents[3 * shape->indices[i + 1]] += bitangent[0];
-      shape->bitangents[3 * shape->indices[i + 1] + 1] += bitangent[1];
-      shape->bitangents[3 * shape->indices[i + 1] + 2] += bitangent[2];
-
-      shape->bitangents[3 * shape->indices[i + 2]] += bitangent[0];
-      shape->bitangents[3 * shape->indices[i + 2] + 1] += bitangent[1];
-      shape->bitangents[3 * shape->indices[i + 2] + 2] += bitangent[2];
+    GLUSfloat tangent[3];
+    GLUSfloat bitangent[3];
+
+    numberTriangles = shape->numberIndices / 3;
+
+#ifdef _OPENMP
+    if (numberTriangles >= GLUS_SHAPE_PARALLEL_TRIANGLES &&
+        omp_get_max_threads() > 1) {
+      return glusShapeCalculateTangentParallelf(shape, numberTriangles);
     }
-  } else {
-    float s1, t1, s2, t2;
-    float Q1[4];
-    float Q2[4];
-    float tangent[3];
-    float bitangent[3];
-    float scalar;
-
-    for (i = 0; i < shape->numberVertices; i += 3) {
-      s1 = shape->texCoords[2 * (i + 1)] - shape->texCoords[2 * i];
-      t1 = shape->texCoords[2 * (i + 1) + 1] - shape->texCoords[2 * i + 1];
-      s2 = shape->texCoords[2 * (i + 2)] - shape->texCoords[2 * i];
-      t2 = shape->texCoords[2 * (i + 2) + 1] - shape->texCoords[2 * i + 1];
-
-      scalar = 1.0f / (s1 * t2 - s2 * t1);
-
-      glusPoint4SubtractPoint4f(Q1, &shape->vertices[4 * (i + 1)],
-                                &shape->vertices[4 * i]);
-      Q1[3] = 1.0f;
-      glusPoint4SubtractPoint4f(Q2, &shape->vertices[4 * (i + 2)],
-                                &shape->vertices[4 * i]);
-      Q2[3] = 1.0f;
-
-      tangent[0] = scalar * (t2 * Q1[0] - t1 * Q2[0]);
-      tangent[1] = scalar * (t2 * Q1[1] - t1 * Q2[1]);
-      tangent[2] = scalar * (t2 * Q1[2] - t1 * Q2[2]);
-
-      bitangent[0] = scalar * (-s2 * Q1[0] + s1 * Q2[0]);
-      bitangent[1] = scalar * (-s2 * Q1[1] + s1 * Q2[1]);
-      bitangent[2] = scalar * (-s2 * Q1[2] + s1 * Q2[2]);
-
-      glusVector3Normalizef(tangent);
-
-      glusVector3Normalizef(bitangent);
-
-      shape->tangents[3 * i] += tangent[0];
-      shape->tangents[3 * i + 1] += tangent[1];
-      shape->tangents[3 * i + 2] += tangent[2];
-
-      shape->tangents[3 * (i + 1)] += tangent[0];
-      shape->tangents[3 * (i + 1) + 1] += tangent[1];
-      shape->tangents[3 * (i + 1) + 2] += tangent[2];
-
-      shape->tangents[3 * (i + 2)] += tangent[0];
-      shape->tangents[3 * (i + 2) + 1] += tangent[1];
-      shape->tangents[3 * (i + 2) + 2] += tangent[2];
-
-      shape->bitangents[3 * i] += bitangent[0];
-      shape->bitangents[3 * i + 1] += bitangent[1];
-      shape->bitangents[3 * i + 2] += bitangent[2];
-
-      shape->bitangents[3 * (i + 1)] += bitangent[0];
-      shape->bitangents[3 * (i + 1) + 1] += bitangent[1];
-      shape->bitangents[3 * (i + 1) + 2] += bitangent[2];
-
-      shape->bitangents[3 * (i + 2)] += bitangent[0];
-      shape->bitangents[3 * (i + 2) + 1] += bitangent[1];
-      shape->bitangents[3 * (i + 2) + 2] += bitangent[2];
+#endif
+
+    for (i = 0; i < (GLUSint)numberTriangles; i++) {
+      glusShapeCalculateTriangleTangentf(
+          shape, shape->indices[3 * i], shape->indices[3 * i + 1],
+          shape->indices[3 * i + 2], tangent, bitangent);
+
+      glusShapeAddTangentf(shape, shape->indices[3 * i], tangent, bitangent);
+      glusShapeAddTangentf(shape, shape->indices[3 * i + 1], tangent,
+                           bitangent);
+      glusShapeAddTangentf(shape, shape->indices[3 * i + 2], tangent,
+                           bitangent);
     }
-  }
 
-  // Normalize, as several triangles have added a vector
-  for (i = 0; i < shape->numberVertices; i++) {
-    glusVector3Normalizef(&(shape->tangents[i * 3]));
-    glusVector3Normalizef(&(shape->bitangents[i * 3]));
+    // Orthonormalize, as several triangles have added a vector
+    for (i = 0; i < (GLUSint)shape->numberVertices; i++) {
+      glusShapeOrthonormalizeTangentf(shape, (GLUSuint)i);
+    }
+  } else {
+    numberTriangles = shape->numberVertices / 3;
+
+    // Every vertex belongs to exactly one triangle.
+#ifdef _OPENMP
+#pragma omp parallel for if (numberTriangles >= GLUS_SHAPE_PARALLEL_TRIANGLES)
+#endif
+    for (i = 0; i < (GLUSint)numberTriangles; i++) {
+      GLUSfloat tangent[3];
+      GLUSfloat bitangent[3];
+
+      GLUSuint k;
+
+      glusShapeCalculateTriangleTangentf(shape, 3 * i, 3 * i + 1, 3 * i + 2,
+                                         tangent, bitangent);
+
+      for (k = 3 * i; k < 3 * (GLUSuint)i + 3; k++) {
+        glusShapeAddTangentf(shape, k, tangent, bitangent);
+
+        glusShapeOrthonormalizeTangentf(shape, k);
+      }
+    }
   }
 
   return GLUS_TRUE;
@@ -1607,11 +1733,40 @@ GLUSboolean GLUSAPIENTRY glusShapeCopyf(GLUSshape *shape,
   return GLUS_TRUE;
 }
 
+// Attributes inside the cache file are released by unmapping it. Attributes
+// created later, e.g. tangents, are still freed.
+static GLUSvoid glusShapeDetachCachef(GLUSshape *shape) {
+  GLUSfloat **attributes[6];
+
+  GLUSuint i;
+
+  attributes[0] = &shape->vertices;
+  attributes[1] = &shape->normals;
+  attributes[2] = &shape->tangents;
+  attributes[3] = &shape->bitangents;
+  attributes[4] = &shape->texCoords;
+  attributes[5] = &shape->allAttributes;
+
+  for (i = 0; i < 6; i++) {
+    if (_glusWavefrontCacheContains(shape->cache, *attributes[i])) {
+      *attributes[i] = 0;
+    }
+  }
+
+  if (_glusWavefrontCacheContains(shape->cache, shape->indices)) {
+    shape->indices = 0;
+  }
+}
+
 GLUSvoid GLUSAPIENTRY glusShapeDestroyf(GLUSshape *shape) {
   if (!shape) {
     return;
   }
 
+  if (shape->cache) {
+    glusShapeDetachCachef(shape);
+  }
+
   if (shape->vertices) {
     glusMemoryFree(shape->vertices);
 
@@ -1654,6 +1809,12 @@ GLUSvoid GLUSAPIENTRY glusShapeDestroyf(GLUSshape *shape) {
     shape->indices = 0;
   }
 
+  if (shape->cache) {
+    _glusWavefrontCacheDestroy(shape->cache);
+
+    shape->cache = 0;
+  }
+
   shape->numberVertices = 0;
   shape->numberIndices = 0;
   shape->mode = 0;
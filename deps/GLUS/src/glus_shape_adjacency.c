@@ -30,125 +30,641 @@ static GLUSboolean glusShapeCheckCompletef(GLUSshape *shape) {
          shape->indices;
 }
 
-static GLUSboolean glusShapeFindIndexByIndicesf(GLUSuint *adjacentIndex,
-                                                GLUSuint triangleFirstIndex,
-                                                GLUSuint edge,
-                                                const GLUSshape *shape) {
-  GLUSuint i, k, m;
+// Marks an empty entry in the hash tables and lists.
+#define GLUS_NO_ENTRY 0xFFFFFFFF
 
-  GLUSuint equalIndices;
+/**
+ * Entry of the edge hash table. The smaller vertex index is stored first, so
+ * both directions of an edge share one entry.
+ */
+typedef struct _GLUSadjacencyedge {
+  /**
+   * The vertex indices of the edge.
+   */
+  GLUSuint index[2];
+
+  /**
+   * The first two triangles with this edge in the order of the indices.
+   */
+  GLUSuint triangle[2];
+
+} GLUSadjacencyedge;
+
+/**
+ * Entry of the spatial hash table. The vertices of a cell are stored one after
+ * another.
+ */
+typedef struct _GLUSadjacencycell {
+  /**
+   * The coordinates of the cell.
+   */
+  GLUSint cell[3];
+
+  /**
+   * The first vertex of the cell in cellVertices and cellPositions.
+   */
+  GLUSuint firstVertex;
+
+  /**
+   * The number of vertices in the cell. Zero marks an empty entry.
+   */
+  GLUSuint numberVertices;
+
+} GLUSadjacencycell;
+
+/**
+ * Lookup structures for finding adjacent triangles in constant time.
+ */
+typedef struct _GLUSadjacencybuilder {
+  const GLUSshape *shape;
+
+  GLUSuint numberTriangles;
+
+  /**
+   * Edge hash table.
+   */
+  GLUSadjacencyedge *edges;
+  GLUSuint edgesMask;
+
+  /**
+   * Triangles of every vertex in ascending order. The triangles of vertex i
+   * are stored from firstTriangle[i] to firstTriangle[i + 1].
+   */
+  GLUSuint *firstTriangle;
+  GLUSuint *triangles;
+
+  /**
+   * Spatial hash table of the vertices.
+   */
+  GLUSadjacencycell *cells;
+  GLUSuint cellsMask;
+  GLUSuint *cellVertices;
+  GLUSfloat *cellPositions;
+
+  /**
+   * Triangles, which have a vertex near an edge.
+   */
+  GLUSuint *candidates;
+  GLUSuint numberCandidates;
+  GLUSuint capacityCandidates;
+
+} GLUSadjacencybuilder;
+
+// Mixes all bits, as the tables are addressed by the lower bits.
+static GLUSuint glusShapeMixHashf(GLUSuint hash) {
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+
+  return hash;
+}
 
-  GLUSuint edgeIndices[2];
+static GLUSuint glusShapeHashEdgef(GLUSuint index0, GLUSuint index1) {
+  return glusShapeMixHashf(index0 * 0x9E3779B1u + index1);
+}
+
+static GLUSuint glusShapeHashCellf(const GLUSint *cell) {
+  return glusShapeMixHashf(((GLUSuint)cell[0] * 0x9E3779B1u +
+                            (GLUSuint)cell[1]) * 0x9E3779B1u +
+                           (GLUSuint)cell[2]);
+}
+
+// The cells are four times as large as the tolerance. So all vertices within
+// the tolerance are in the same cell or in the neighbouring one, which is
+// closer. The position inside the cell tells, which neighbour this is.
+static GLUSvoid glusShapeGetCellf(GLUSint *cell, GLUSint *direction,
+                                  const GLUSfloat *vertex) {
+  GLUSuint i;
+
+  for (i = 0; i < 3; i++) {
+    double position = (double)vertex[i] / (4.0 * GLUS_POINT_TOLERANCE);
+
+    double coordinate = floor(position);
+
+    direction[i] = position - coordinate < 0.5 ? -1 : 1;
+
+    // Clamping keeps neighbouring cells neighbours.
+    if (coordinate != coordinate) {
+      coordinate = 0.0;
+    } else if (coordinate < -1073741824.0) {
+      coordinate = -1073741824.0;
+    } else if (coordinate > 1073741824.0) {
+      coordinate = 1073741824.0;
+    }
+
+    cell[i] = (GLUSint)coordinate;
+  }
+}
+
+static GLUSadjacencycell *
+glusShapeFindCellf(const GLUSadjacencybuilder *builder, const GLUSint *cell) {
+  GLUSuint hash = glusShapeHashCellf(cell) & builder->cellsMask;
+
+  while (builder->cells[hash].numberVertices != 0) {
+    if (builder->cells[hash].cell[0] == cell[0] &&
+        builder->cells[hash].cell[1] == cell[1] &&
+        builder->cells[hash].cell[2] == cell[2]) {
+      break;
+    }
+
+    hash = (hash + 1) & builder->cellsMask;
+  }
+
+  return &builder->cells[hash];
+}
+
+static GLUSadjacencyedge *
+glusShapeFindEdgef(const GLUSadjacencybuilder *builder, GLUSuint index0,
+                   GLUSuint index1) {
+  GLUSuint hash;
+
+  if (index0 > index1) {
+    GLUSuint temp = index0;
+
+    index0 = index1;
+    index1 = temp;
+  }
+
+  hash = glusShapeHashEdgef(index0, index1) & builder->edgesMask;
+
+  while (builder->edges[hash].triangle[0] != GLUS_NO_ENTRY) {
+    if (builder->edges[hash].index[0] == index0 &&
+        builder->edges[hash].index[1] == index1) {
+      break;
+    }
+
+    hash = (hash + 1) & builder->edgesMask;
+  }
+
+  return &builder->edges[hash];
+}
+
+static GLUSboolean glusShapeIsDegeneratedf(const GLUSshape *shape,
+                                           GLUSuint triangle) {
+  return shape->indices[3 * triangle + 0] == shape->indices[3 * triangle + 1] ||
+         shape->indices[3 * triangle + 0] == shape->indices[3 * triangle + 2] ||
+         shape->indices[3 * triangle + 1] == shape->indices[3 * triangle + 2];
+}
+
+// Moves the used cells into a table with at least half of it empty.
+static GLUSboolean glusShapeCompactCellsf(GLUSadjacencybuilder *builder,
+                                         GLUSuint numberCells) {
+  GLUSadjacencycell *usedCells = builder->cells;
+  GLUSuint usedMask = builder->cellsMask;
+
+  GLUSuint capacity = 1;
+
+  GLUSuint i;
+
+  while (capacity < 2 * numberCells) {
+    capacity *= 2;
+  }
+
+  builder->cells = (GLUSadjacencycell *)glusMemoryMalloc(
+      (size_t)capacity * sizeof(GLUSadjacencycell));
+  builder->cellsMask = capacity - 1;
+
+  if (!builder->cells) {
+    glusMemoryFree(usedCells);
 
-  if (!adjacentIndex || !shape) {
     return GLUS_FALSE;
   }
 
-  if (shape->mode != GLUS_TRIANGLES) {
+  memset(builder->cells, 0, (size_t)capacity * sizeof(GLUSadjacencycell));
+
+  for (i = 0; i <= usedMask; i++) {
+    if (usedCells[i].numberVertices != 0) {
+      *glusShapeFindCellf(builder, usedCells[i].cell) = usedCells[i];
+    }
+  }
+
+  glusMemoryFree(usedCells);
+
+  return GLUS_TRUE;
+}
+
+static GLUSvoid glusShapeDestroyAdjacencyBuilderf(GLUSadjacencybuilder *builder) {
+  glusMemoryFree(builder->edges);
+  glusMemoryFree(builder->firstTriangle);
+  glusMemoryFree(builder->triangles);
+  glusMemoryFree(builder->cells);
+  glusMemoryFree(builder->cellVertices);
+  glusMemoryFree(builder->cellPositions);
+  glusMemoryFree(builder->candidates);
+
+  memset(builder, 0, sizeof(GLUSadjacencybuilder));
+}
+
+static GLUSboolean glusShapeInitAdjacencyBuilderf(GLUSadjacencybuilder *builder,
+                                                  const GLUSshape *shape) {
+  GLUSuint i, k;
+
+  GLUSuint capacity, offset;
+
+  GLUSuint numberCells = 0;
+
+  memset(builder, 0, sizeof(GLUSadjacencybuilder));
+
+  builder->shape = shape;
+  builder->numberTriangles = shape->numberIndices / 3;
+
+  for (i = 0; i < builder->numberTriangles * 3; i++) {
+    if (shape->indices[i] >= shape->numberVertices) {
+      return GLUS_FALSE;
+    }
+  }
+
+  // At most three edges per triangle, so the table is at most 3/4 full.
+  capacity = 1;
+  while (capacity < 4 * builder->numberTriangles) {
+    if (capacity >= 0x40000000) {
+      return GLUS_FALSE;
+    }
+
+    capacity *= 2;
+  }
+
+  builder->edges = (GLUSadjacencyedge *)glusMemoryMalloc(
+      (size_t)capacity * sizeof(GLUSadjacencyedge));
+  builder->edgesMask = capacity - 1;
+
+  builder->firstTriangle = (GLUSuint *)glusMemoryMalloc(
+      ((size_t)shape->numberVertices + 1) * sizeof(GLUSuint));
+  builder->triangles = (GLUSuint *)glusMemoryMalloc(
+      ((size_t)builder->numberTriangles * 3 + 1) * sizeof(GLUSuint));
+
+  // At least half of the spatial hash table is empty.
+  capacity = 1;
+  while (capacity < 2 * shape->numberVertices) {
+    if (capacity >= 0x80000000) {
+      glusShapeDestroyAdjacencyBuilderf(builder);
+
+      return GLUS_FALSE;
+    }
+
+    capacity *= 2;
+  }
+
+  builder->cells = (GLUSadjacencycell *)glusMemoryMalloc(
+      (size_t)capacity * sizeof(GLUSadjacencycell));
+  builder->cellsMask = capacity - 1;
+  builder->cellVertices = (GLUSuint *)glusMemoryMalloc(
+      ((size_t)shape->numberVertices + 1) * sizeof(GLUSuint));
+  builder->cellPositions = (GLUSfloat *)glusMemoryMalloc(
+      ((size_t)shape->numberVertices + 1) * 3 * sizeof(GLUSfloat));
+
+  if (!builder->edges || !builder->firstTriangle || !builder->triangles ||
+      !builder->cells || !builder->cellVertices || !builder->cellPositions) {
+    glusShapeDestroyAdjacencyBuilderf(builder);
+
     return GLUS_FALSE;
   }
 
-  for (i = 0; i < shape->numberIndices / 3; i++) {
-    // Skip same triangle
-    if (triangleFirstIndex == i * 3) {
+  memset(builder->edges, 0xFF,
+         (size_t)(builder->edgesMask + 1) * sizeof(GLUSadjacencyedge));
+  memset(builder->cells, 0,
+         (size_t)(builder->cellsMask + 1) * sizeof(GLUSadjacencycell));
+
+  // Edges of the triangles. Degenerated triangles have no valid edge.
+  for (i = 0; i < builder->numberTriangles; i++) {
+    if (glusShapeIsDegeneratedf(shape, i)) {
       continue;
     }
 
-    equalIndices = 0;
-
     for (k = 0; k < 3; k++) {
-      for (m = 0 + edge; m < 2 + edge; m++) {
-        if (shape->indices[triangleFirstIndex + (m % 3)] ==
-            shape->indices[i * 3 + k]) {
-          equalIndices++;
+      GLUSadjacencyedge *edge = glusShapeFindEdgef(
+          builder, shape->indices[3 * i + k],
+          shape->indices[3 * i + (k + 1) % 3]);
 
-          edgeIndices[m - edge] = shape->indices[i * 3 + k];
+      if (edge->triangle[0] == GLUS_NO_ENTRY) {
+        edge->index[0] = shape->indices[3 * i + k];
+        edge->index[1] = shape->indices[3 * i + (k + 1) % 3];
 
-          break;
+        if (edge->index[0] > edge->index[1]) {
+          edge->index[0] = shape->indices[3 * i + (k + 1) % 3];
+          edge->index[1] = shape->indices[3 * i + k];
         }
+
+        edge->triangle[0] = i;
+      } else if (edge->triangle[1] == GLUS_NO_ENTRY) {
+        edge->triangle[1] = i;
       }
     }
+  }
 
-    if (equalIndices == 2) {
-      for (k = 0; k < 3; k++) {
-        if (shape->indices[i * 3 + k] != edgeIndices[0] &&
-            shape->indices[i * 3 + k] != edgeIndices[1]) {
-          *adjacentIndex = shape->indices[i * 3 + k];
+  // Triangles per vertex as a prefix sum over the counts.
+  memset(builder->firstTriangle, 0,
+         ((size_t)shape->numberVertices + 1) * sizeof(GLUSuint));
 
-          break;
-        }
-      }
+  for (i = 0; i < builder->numberTriangles * 3; i++) {
+    builder->firstTriangle[shape->indices[i] + 1]++;
+  }
 
-      return GLUS_TRUE;
+  for (i = 0; i < shape->numberVertices; i++) {
+    builder->firstTriangle[i + 1] += builder->firstTriangle[i];
+  }
+
+  for (i = 0; i < builder->numberTriangles * 3; i++) {
+    builder->triangles[builder->firstTriangle[shape->indices[i]]++] = i / 3;
+  }
+
+  for (i = shape->numberVertices; i > 0; i--) {
+    builder->firstTriangle[i] = builder->firstTriangle[i - 1];
+  }
+  builder->firstTriangle[0] = 0;
+
+  // Used vertices sorted into the spatial hash table. First, the vertices of
+  // each cell are counted ...
+  for (i = 0; i < shape->numberVertices; i++) {
+    GLUSadjacencycell *cell;
+
+    GLUSint coordinates[3];
+    GLUSint direction[3];
+
+    if (builder->firstTriangle[i] == builder->firstTriangle[i + 1]) {
+      continue;
     }
+
+    glusShapeGetCellf(coordinates, direction, &shape->vertices[4 * i]);
+
+    cell = glusShapeFindCellf(builder, coordinates);
+
+    cell->cell[0] = coordinates[0];
+    cell->cell[1] = coordinates[1];
+    cell->cell[2] = coordinates[2];
+
+    if (cell->numberVertices == 0) {
+      numberCells++;
+    }
+
+    cell->numberVertices++;
   }
 
-  return GLUS_FALSE;
+  // ... then, the table is shrunk to the used cells, as it is accessed
+  // randomly ...
+  if (!glusShapeCompactCellsf(builder, numberCells)) {
+    glusShapeDestroyAdjacencyBuilderf(builder);
+
+    return GLUS_FALSE;
+  }
+
+  // ... the space for the vertices is assigned ...
+  offset = 0;
+  for (i = 0; i <= builder->cellsMask; i++) {
+    builder->cells[i].firstVertex = offset;
+
+    offset += builder->cells[i].numberVertices;
+  }
+
+  // ... and finally, the vertices are copied to their cells.
+  for (i = 0; i < shape->numberVertices; i++) {
+    GLUSadjacencycell *cell;
+
+    GLUSint coordinates[3];
+    GLUSint direction[3];
+
+    if (builder->firstTriangle[i] == builder->firstTriangle[i + 1]) {
+      continue;
+    }
+
+    glusShapeGetCellf(coordinates, direction, &shape->vertices[4 * i]);
+
+    cell = glusShapeFindCellf(builder, coordinates);
+
+    builder->cellVertices[cell->firstVertex] = i;
+    memcpy(&builder->cellPositions[3 * cell->firstVertex],
+           &shape->vertices[4 * i], 3 * sizeof(GLUSfloat));
+
+    cell->firstVertex++;
+  }
+
+  for (i = 0; i <= builder->cellsMask; i++) {
+    builder->cells[i].firstVertex -= builder->cells[i].numberVertices;
+  }
+
+  return GLUS_TRUE;
 }
 
-static GLUSboolean glusShapeFindIndexByVerticesf(GLUSuint *adjacentIndex,
-                                                 GLUSuint triangleIndex,
-                                                 GLUSuint edge,
-                                                 const GLUSshape *shape) {
-  GLUSuint i, k, m;
+static GLUSboolean glusShapeFindIndexByIndicesf(
+    GLUSuint *adjacentIndex, GLUSuint triangleFirstIndex, GLUSuint edge,
+    const GLUSadjacencybuilder *builder) {
+  const GLUSshape *shape = builder->shape;
 
-  GLUSuint equalVertices, walkerIndex, searchIndex;
+  const GLUSadjacencyedge *adjacencyEdge;
 
   GLUSuint edgeIndices[2];
 
-  if (!adjacentIndex || !shape) {
-    return GLUS_FALSE;
+  GLUSuint triangle, k;
+
+  edgeIndices[0] = shape->indices[triangleFirstIndex + edge];
+  edgeIndices[1] = shape->indices[triangleFirstIndex + (edge + 1) % 3];
+
+  adjacencyEdge = glusShapeFindEdgef(builder, edgeIndices[0], edgeIndices[1]);
+
+  // Skip same triangle
+  triangle = adjacencyEdge->triangle[0];
+  if (triangle == triangleFirstIndex / 3) {
+    triangle = adjacencyEdge->triangle[1];
   }
 
-  if (shape->mode != GLUS_TRIANGLES) {
+  if (triangle == GLUS_NO_ENTRY) {
     return GLUS_FALSE;
   }
 
-  for (i = 0; i < shape->numberIndices / 3; i++) {
-    // Skip same triangle
-    if (triangleIndex == i * 3) {
-      continue;
+  for (k = 0; k < 3; k++) {
+    if (shape->indices[triangle * 3 + k] != edgeIndices[0] &&
+        shape->indices[triangle * 3 + k] != edgeIndices[1]) {
+      *adjacentIndex = shape->indices[triangle * 3 + k];
+
+      break;
     }
+  }
+
+  return GLUS_TRUE;
+}
+
+// Tests, if the triangle i shares the edge by comparing the vertices.
+static GLUSboolean glusShapeMatchTriangleByVerticesf(GLUSuint *adjacentIndex,
+                                                     GLUSuint triangleIndex,
+                                                     GLUSuint edge, GLUSuint i,
+                                                     const GLUSshape *shape) {
+  GLUSuint k, m;
+
+  GLUSuint equalVertices = 0, walkerIndex, searchIndex;
 
-    equalVertices = 0;
+  GLUSuint edgeIndices[2] = {GLUS_NO_ENTRY, GLUS_NO_ENTRY};
+
+  for (k = 0; k < 3; k++) {
+    walkerIndex = shape->indices[i * 3 + k];
+
+    for (m = 0 + edge; m < 2 + edge; m++) {
+      searchIndex = shape->indices[triangleIndex + (m % 3)];
+
+      if (shape->vertices[4 * searchIndex + 0] >=
+              shape->vertices[4 * walkerIndex + 0] - GLUS_POINT_TOLERANCE &&
+          shape->vertices[4 * searchIndex + 0] <=
+              shape->vertices[4 * walkerIndex + 0] + GLUS_POINT_TOLERANCE &&
+          shape->vertices[4 * searchIndex + 1] >=
+              shape->vertices[4 * walkerIndex + 1] - GLUS_POINT_TOLERANCE &&
+          shape->vertices[4 * searchIndex + 1] <=
+              shape->vertices[4 * walkerIndex + 1] + GLUS_POINT_TOLERANCE &&
+          shape->vertices[4 * searchIndex + 2] >=
+              shape->vertices[4 * walkerIndex + 2] - GLUS_POINT_TOLERANCE &&
+          shape->vertices[4 * searchIndex + 2] <=
+              shape->vertices[4 * walkerIndex + 2] + GLUS_POINT_TOLERANCE) {
+        equalVertices++;
+
+        edgeIndices[m - edge] = walkerIndex;
+
+        break;
+      }
+    }
+  }
 
+  if (equalVertices == 2) {
     for (k = 0; k < 3; k++) {
-      walkerIndex = shape->indices[i * 3 + k];
-
-      for (m = 0 + edge; m < 2 + edge; m++) {
-        searchIndex = shape->indices[triangleIndex + (m % 3)];
-
-        if (shape->vertices[4 * searchIndex + 0] >=
-                shape->vertices[4 * walkerIndex + 0] - GLUS_POINT_TOLERANCE &&
-            shape->vertices[4 * searchIndex + 0] <=
-                shape->vertices[4 * walkerIndex + 0] + GLUS_POINT_TOLERANCE &&
-            shape->vertices[4 * searchIndex + 1] >=
-                shape->vertices[4 * walkerIndex + 1] - GLUS_POINT_TOLERANCE &&
-            shape->vertices[4 * searchIndex + 1] <=
-                shape->vertices[4 * walkerIndex + 1] + GLUS_POINT_TOLERANCE &&
-            shape->vertices[4 * searchIndex + 2] >=
-                shape->vertices[4 * walkerIndex + 2] - GLUS_POINT_TOLERANCE &&
-            shape->vertices[4 * searchIndex + 2] <=
-                shape->vertices[4 * walkerIndex + 2] + GLUS_POINT_TOLERANCE) {
-          equalVertices++;
-
-          edgeIndices[m - edge] = walkerIndex;
-
-          break;
-        }
+      if (shape->indices[i * 3 + k] != edgeIndices[0] &&
+          shape->indices[i * 3 + k] != edgeIndices[1]) {
+        *adjacentIndex = shape->indices[i * 3 + k];
+
+        break;
       }
     }
 
-    if (equalVertices == 2) {
-      for (k = 0; k < 3; k++) {
-        if (shape->indices[i * 3 + k] != edgeIndices[0] &&
-            shape->indices[i * 3 + k] != edgeIndices[1]) {
-          *adjacentIndex = shape->indices[i * 3 + k];
+    return GLUS_TRUE;
+  }
 
-          break;
+  return GLUS_FALSE;
+}
+
+static GLUSboolean glusShapeAddCandidatef(GLUSadjacencybuilder *builder,
+                                          GLUSuint triangle) {
+  if (builder->numberCandidates == builder->capacityCandidates) {
+    GLUSuint newCapacity =
+        builder->capacityCandidates > 0 ? 2 * builder->capacityCandidates : 64;
+
+    GLUSuint *newCandidates = (GLUSuint *)glusMemoryRealloc(
+        builder->candidates, (size_t)newCapacity * sizeof(GLUSuint));
+
+    if (!newCandidates) {
+      return GLUS_FALSE;
+    }
+
+    builder->candidates = newCandidates;
+    builder->capacityCandidates = newCapacity;
+  }
+
+  builder->candidates[builder->numberCandidates++] = triangle;
+
+  return GLUS_TRUE;
+}
+
+// Adds all triangles with a vertex within the tolerance of the given vertex.
+static GLUSboolean glusShapeAddCandidatesf(GLUSadjacencybuilder *builder,
+                                           GLUSuint searchIndex) {
+  const GLUSshape *shape = builder->shape;
+
+  const GLUSfloat *search = &shape->vertices[4 * searchIndex];
+
+  GLUSint coordinates[3];
+  GLUSint direction[3];
+  GLUSint neighbour[3];
+
+  GLUSint x, y, z;
+
+  glusShapeGetCellf(coordinates, direction, search);
+
+  for (z = 0; z < 2; z++) {
+    for (y = 0; y < 2; y++) {
+      for (x = 0; x < 2; x++) {
+        const GLUSadjacencycell *cell;
+
+        GLUSuint k;
+
+        neighbour[0] = coordinates[0] + x * direction[0];
+        neighbour[1] = coordinates[1] + y * direction[1];
+        neighbour[2] = coordinates[2] + z * direction[2];
+
+        cell = glusShapeFindCellf(builder, neighbour);
+
+        for (k = cell->firstVertex;
+             k < cell->firstVertex + cell->numberVertices; k++) {
+          const GLUSfloat *walker = &builder->cellPositions[3 * k];
+
+          GLUSuint walkerIndex = builder->cellVertices[k];
+
+          GLUSuint i;
+
+          if (!(search[0] >= walker[0] - GLUS_POINT_TOLERANCE &&
+                search[0] <= walker[0] + GLUS_POINT_TOLERANCE &&
+                search[1] >= walker[1] - GLUS_POINT_TOLERANCE &&
+                search[1] <= walker[1] + GLUS_POINT_TOLERANCE &&
+                search[2] >= walker[2] - GLUS_POINT_TOLERANCE &&
+                search[2] <= walker[2] + GLUS_POINT_TOLERANCE)) {
+            continue;
+          }
+
+          for (i = builder->firstTriangle[walkerIndex];
+               i < builder->firstTriangle[walkerIndex + 1]; i++) {
+            if (!glusShapeAddCandidatef(builder, builder->triangles[i])) {
+              return GLUS_FALSE;
+            }
+          }
         }
       }
+    }
+  }
 
+  return GLUS_TRUE;
+}
+
+// Sorts the few candidates of an edge in ascending order.
+static GLUSvoid glusShapeSortCandidatesf(GLUSadjacencybuilder *builder) {
+  GLUSuint i, k;
+
+  for (i = 1; i < builder->numberCandidates; i++) {
+    GLUSuint triangle = builder->candidates[i];
+
+    for (k = i; k > 0 && builder->candidates[k - 1] > triangle; k--) {
+      builder->candidates[k] = builder->candidates[k - 1];
+    }
+
+    builder->candidates[k] = triangle;
+  }
+}
+
+// Only triangles with a vertex near the edge can share it. These are tested in
+// the order of the indices, so the first matching triangle is found.
+static GLUSboolean glusShapeFindIndexByVerticesf(GLUSuint *adjacentIndex,
+                                                 GLUSuint triangleIndex,
+                                                 GLUSuint edge,
+                                                 GLUSadjacencybuilder *builder) {
+  const GLUSshape *shape = builder->shape;
+
+  GLUSuint i;
+
+  builder->numberCandidates = 0;
+
+  if (!glusShapeAddCandidatesf(builder,
+                               shape->indices[triangleIndex + edge]) ||
+      !glusShapeAddCandidatesf(builder,
+                               shape->indices[triangleIndex + (edge + 1) % 3])) {
+    return GLUS_FALSE;
+  }
+
+  glusShapeSortCandidatesf(builder);
+
+  for (i = 0; i < builder->numberCandidates; i++) {
+    // Skip same and already tested triangle
+    if (triangleIndex == builder->candidates[i] * 3 ||
+        (i > 0 && builder->candidates[i] == builder->candidates[i - 1])) {
+      continue;
+    }
+
+    if (glusShapeMatchTriangleByVerticesf(adjacentIndex, triangleIndex, edge,
+                                          builder->candidates[i], shape)) {
       return GLUS_TRUE;
     }
   }
@@ -164,6 +680,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(
 
   GLUSuint adjacentIndex, edge;
 
+  GLUSadjacencybuilder builder;
+
   if (!adjacencyShape || !sourceShape) {
     return GLUS_FALSE;
   }
@@ -198,6 +716,12 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(
     return GLUS_FALSE;
   }
 
+  if (!glusShapeInitAdjacencyBuilderf(&builder, sourceShape)) {
+    glusShapeDestroyf(adjacencyShape);
+
+    return GLUS_FALSE;
+  }
+
   // Process all triangles
   for (i = 0; i < sourceShape->numberIndices / 3; i++) {
     // For now, all adjacent triangles are degenerated.
@@ -221,7 +745,7 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(
 
       // ... by scanning the indices ...
       if (glusShapeFindIndexByIndicesf(&adjacentIndex, 3 * i, edge,
-                                       sourceShape)) {
+                                       &builder)) {
         adjacencyShape->indices[6 * i + edge * 2 + 1] = adjacentIndex;
 
         continue;
@@ -229,7 +753,7 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(
 
       // ... and if not found, compare the vertices.
       if (glusShapeFindIndexByVerticesf(&adjacentIndex, 3 * i, edge,
-                                        sourceShape)) {
+                                        &builder)) {
         adjacencyShape->indices[6 * i + edge * 2 + 1] = adjacentIndex;
 
         continue;
@@ -241,5 +765,7 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(
     }
   }
 
+  glusShapeDestroyAdjacencyBuilderf(&builder);
+
   return GLUS_TRUE;
 }
@@ -0,0 +1,1077 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Below this number of triangles, starting threads costs more than it saves.
+#define GLUS_LOD_PARALLEL_TRIANGLES 16384
+
+// Marks a missing vertex.
+#define GLUS_LOD_NO_VERTEX 0xFFFFFFFF
+
+// Borders and seams are weighted higher than the surface, so they keep their
+// shape.
+#define GLUS_LOD_EDGE_WEIGHT 10.0f
+
+// Cache size used to order the triangles of every level.
+#define GLUS_LOD_CACHE_SIZE 16
+
+// Kinds of vertices. All vertices at one position have the same kind.
+#define GLUS_LOD_MANIFOLD 0
+#define GLUS_LOD_BORDER 1
+#define GLUS_LOD_SEAM 2
+#define GLUS_LOD_LOCKED 3
+
+/**
+ * Which kind of vertex can be collapsed onto which kind.
+ */
+static const GLUSubyte g_canCollapse[4][4] = {
+    {1, 1, 1, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}, {0, 0, 0, 0}};
+
+/**
+ * Symmetric matrix, vector and scalar of a quadric error. The weight is the
+ * sum of the weights of all added planes.
+ */
+typedef struct _GLUSquadric {
+  GLUSfloat a00, a11, a22;
+  GLUSfloat a10, a20, a21;
+  GLUSfloat b0, b1, b2;
+  GLUSfloat c;
+  GLUSfloat w;
+
+} GLUSquadric;
+
+/**
+ * Collapse of the first vertex onto the second one.
+ */
+typedef struct _GLUScollapse {
+  GLUSuint vertex[2];
+
+  GLUSfloat error;
+
+} GLUScollapse;
+
+/**
+ * The state of the simplification, which is kept from level to level.
+ */
+typedef struct _GLUSlodbuilder {
+  const GLUSfloat *vertices;
+  GLUSuint numberVertices;
+
+  /**
+   * The first vertex with the same position.
+   */
+  GLUSuint *remap;
+
+  /**
+   * The next vertex with the same position, forming a ring.
+   */
+  GLUSuint *wedge;
+
+  GLUSubyte *kind;
+
+  /**
+   * The other vertex of the outgoing and incoming open edge of a border or
+   * seam.
+   */
+  GLUSuint *loop;
+  GLUSuint *loopBack;
+
+  /**
+   * The quadric of every position, stored at its first vertex.
+   */
+  GLUSquadric *quadrics;
+
+  /**
+   * The current triangles.
+   */
+  GLUSuint *indices;
+  GLUSuint numberIndices;
+
+  /**
+   * The triangles around every position.
+   */
+  GLUSuint *firstTriangle;
+  GLUSuint *triangles;
+
+  GLUScollapse *collapses;
+  GLUSuint *order;
+  GLUSuint *sortTemp;
+
+  GLUSuint *collapseRemap;
+  GLUSubyte *collapseLocked;
+
+} GLUSlodbuilder;
+
+static GLUSvoid glusShapeLodGetPositionf(GLUSfloat *position,
+                                         const GLUSlodbuilder *builder,
+                                         const GLUSuint vertex) {
+  position[0] = builder->vertices[4 * vertex + 0];
+  position[1] = builder->vertices[4 * vertex + 1];
+  position[2] = builder->vertices[4 * vertex + 2];
+}
+
+static GLUSvoid glusShapeLodAddPlanef(GLUSquadric *quadric,
+                                      const GLUSfloat normal[3],
+                                      const GLUSfloat distance,
+                                      const GLUSfloat weight) {
+  quadric->a00 += normal[0] * normal[0] * weight;
+  quadric->a11 += normal[1] * normal[1] * weight;
+  quadric->a22 += normal[2] * normal[2] * weight;
+  quadric->a10 += normal[1] * normal[0] * weight;
+  quadric->a20 += normal[2] * normal[0] * weight;
+  quadric->a21 += normal[2] * normal[1] * weight;
+  quadric->b0 += normal[0] * distance * weight;
+  quadric->b1 += normal[1] * distance * weight;
+  quadric->b2 += normal[2] * distance * weight;
+  quadric->c += distance * distance * weight;
+  quadric->w += weight;
+}
+
+static GLUSvoid glusShapeLodAddQuadricf(GLUSquadric *quadric,
+                                        const GLUSquadric *other) {
+  quadric->a00 += other->a00;
+  quadric->a11 += other->a11;
+  quadric->a22 += other->a22;
+  quadric->a10 += other->a10;
+  quadric->a20 += other->a20;
+  quadric->a21 += other->a21;
+  quadric->b0 += other->b0;
+  quadric->b1 += other->b1;
+  quadric->b2 += other->b2;
+  quadric->c += other->c;
+  quadric->w += other->w;
+}
+
+// Returns the sum of the squared distances to all planes without the weight.
+static GLUSfloat glusShapeLodEvaluatef(const GLUSquadric *quadric,
+                                      const GLUSfloat *point) {
+  GLUSfloat x = point[0];
+  GLUSfloat y = point[1];
+  GLUSfloat z = point[2];
+
+  return quadric->a00 * x * x + quadric->a11 * y * y + quadric->a22 * z * z +
+         2.0f * (quadric->a10 * x * y + quadric->a20 * x * z +
+                 quadric->a21 * y * z) +
+         2.0f * (quadric->b0 * x + quadric->b1 * y + quadric->b2 * z) +
+         quadric->c;
+}
+
+// The error of moving both positions of an edge to the given point.
+static GLUSfloat glusShapeLodGetErrorf(const GLUSlodbuilder *builder,
+                                      const GLUSuint vertex0,
+                                      const GLUSuint vertex1,
+                                      const GLUSfloat *point) {
+  const GLUSquadric *quadric0 = &builder->quadrics[builder->remap[vertex0]];
+  const GLUSquadric *quadric1 = &builder->quadrics[builder->remap[vertex1]];
+
+  GLUSfloat weight = quadric0->w + quadric1->w;
+
+  GLUSfloat error = glusShapeLodEvaluatef(quadric0, point) +
+                    glusShapeLodEvaluatef(quadric1, point);
+
+  return weight > 0.0f ? fabsf(error) / weight : 0.0f;
+}
+
+// Adds the plane of a triangle, weighted by its area.
+static GLUSvoid glusShapeLodAddTrianglef(GLUSlodbuilder *builder,
+                                         const GLUSuint *triangle) {
+  GLUSfloat p0[3], p1[3], p2[3];
+  GLUSfloat edge0[3], edge1[3];
+  GLUSfloat normal[3];
+
+  GLUSfloat area;
+
+  GLUSuint k;
+
+  glusShapeLodGetPositionf(p0, builder, triangle[0]);
+  glusShapeLodGetPositionf(p1, builder, triangle[1]);
+  glusShapeLodGetPositionf(p2, builder, triangle[2]);
+
+  glusVector3SubtractVector3f(edge0, p1, p0);
+  glusVector3SubtractVector3f(edge1, p2, p0);
+
+  glusVector3Crossf(normal, edge0, edge1);
+
+  area = glusVector3Lengthf(normal);
+
+  if (area == 0.0f) {
+    return;
+  }
+
+  glusVector3MultiplyScalarf(normal, normal, 1.0f / area);
+
+  for (k = 0; k < 3; k++) {
+    glusShapeLodAddPlanef(&builder->quadrics[builder->remap[triangle[k]]],
+                          normal, -glusVector3Dotf(normal, p0), area);
+  }
+}
+
+// Adds the plane, which is perpendicular to the triangle through an edge.
+static GLUSvoid glusShapeLodAddEdgef(GLUSlodbuilder *builder,
+                                     const GLUSuint vertex0,
+                                     const GLUSuint vertex1,
+                                     const GLUSuint vertex2) {
+  GLUSfloat p0[3], p1[3], p2[3];
+  GLUSfloat edge[3], other[3];
+  GLUSfloat normal[3];
+
+  GLUSfloat length;
+  GLUSfloat projection;
+  GLUSfloat altitude;
+
+  glusShapeLodGetPositionf(p0, builder, vertex0);
+  glusShapeLodGetPositionf(p1, builder, vertex1);
+  glusShapeLodGetPositionf(p2, builder, vertex2);
+
+  glusVector3SubtractVector3f(edge, p1, p0);
+  glusVector3SubtractVector3f(other, p2, p0);
+
+  length = glusVector3Lengthf(edge);
+
+  if (length == 0.0f) {
+    return;
+  }
+
+  glusVector3MultiplyScalarf(edge, edge, 1.0f / length);
+
+  // The normal is the altitude of the third vertex onto the edge.
+  projection = glusVector3Dotf(other, edge);
+
+  normal[0] = other[0] - edge[0] * projection;
+  normal[1] = other[1] - edge[1] * projection;
+  normal[2] = other[2] - edge[2] * projection;
+
+  altitude = glusVector3Lengthf(normal);
+
+  if (altitude == 0.0f) {
+    return;
+  }
+
+  glusVector3MultiplyScalarf(normal, normal, 1.0f / altitude);
+
+  glusShapeLodAddPlanef(&builder->quadrics[builder->remap[vertex0]], normal,
+                        -glusVector3Dotf(normal, p0),
+                        length * length * GLUS_LOD_EDGE_WEIGHT);
+  glusShapeLodAddPlanef(&builder->quadrics[builder->remap[vertex1]], normal,
+                        -glusVector3Dotf(normal, p0),
+                        length * length * GLUS_LOD_EDGE_WEIGHT);
+}
+
+static GLUSuint glusShapeLodHashPositionf(const GLUSfloat *position) {
+  GLUSuint bits[3];
+
+  GLUSfloat value[3];
+
+  GLUSuint hash;
+
+  // Adding zero turns -0.0 into 0.0, which is equal.
+  value[0] = position[0] + 0.0f;
+  value[1] = position[1] + 0.0f;
+  value[2] = position[2] + 0.0f;
+
+  memcpy(bits, value, sizeof(bits));
+
+  hash = (bits[0] * 0x9E3779B1u + bits[1]) * 0x9E3779B1u + bits[2];
+
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+// Finds the vertices with the same position and links them to a ring.
+static GLUSboolean glusShapeLodInitRemapf(GLUSlodbuilder *builder) {
+  GLUSuint *table;
+
+  GLUSuint capacity = 1;
+
+  GLUSuint i;
+
+  while (capacity < 2 * builder->numberVertices) {
+    capacity *= 2;
+  }
+
+  table = (GLUSuint *)glusMemoryMalloc(capacity * sizeof(GLUSuint));
+
+  if (!table) {
+    return GLUS_FALSE;
+  }
+
+  memset(table, 0xFF, capacity * sizeof(GLUSuint));
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    const GLUSfloat *position = &builder->vertices[4 * i];
+
+    GLUSuint slot = glusShapeLodHashPositionf(position) & (capacity - 1);
+
+    while (table[slot] != GLUS_LOD_NO_VERTEX) {
+      const GLUSfloat *other = &builder->vertices[4 * table[slot]];
+
+      if (position[0] == other[0] && position[1] == other[1] &&
+          position[2] == other[2]) {
+        break;
+      }
+
+      slot = (slot + 1) & (capacity - 1);
+    }
+
+    if (table[slot] == GLUS_LOD_NO_VERTEX) {
+      table[slot] = i;
+
+      builder->remap[i] = i;
+      builder->wedge[i] = i;
+    } else {
+      GLUSuint first = table[slot];
+
+      builder->remap[i] = first;
+      builder->wedge[i] = builder->wedge[first];
+      builder->wedge[first] = i;
+    }
+  }
+
+  glusMemoryFree(table);
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusShapeLodHasEdgef(const GLUSuint *firstEdge,
+                                        const GLUSuint *edges,
+                                        const GLUSuint vertex0,
+                                        const GLUSuint vertex1) {
+  GLUSuint i;
+
+  for (i = firstEdge[vertex0]; i < firstEdge[vertex0 + 1]; i++) {
+    if (edges[i] == vertex1) {
+      return GLUS_TRUE;
+    }
+  }
+
+  return GLUS_FALSE;
+}
+
+static GLUSboolean glusShapeLodIsOpenf(const GLUSuint open,
+                                       const GLUSuint vertex) {
+  return open != GLUS_LOD_NO_VERTEX && open != vertex;
+}
+
+// Finds the open edges, i.e. edges without an opposite edge, and classifies
+// the vertices. A position with one open edge in and out is a border. Two
+// vertices at one position, whose open edges connect the same positions, are
+// a seam. Everything else, which has open edges, is locked.
+static GLUSboolean glusShapeLodClassifyf(GLUSlodbuilder *builder) {
+  GLUSuint *firstEdge;
+  GLUSuint *edges;
+
+  GLUSuint i, k;
+
+  firstEdge = (GLUSuint *)glusMemoryMalloc((builder->numberVertices + 1) *
+                                           sizeof(GLUSuint));
+  edges = (GLUSuint *)glusMemoryMalloc(builder->numberIndices *
+                                       sizeof(GLUSuint));
+
+  if (!firstEdge || !edges) {
+    glusMemoryFree(firstEdge);
+    glusMemoryFree(edges);
+
+    return GLUS_FALSE;
+  }
+
+  memset(firstEdge, 0, (builder->numberVertices + 1) * sizeof(GLUSuint));
+
+  for (i = 0; i < builder->numberIndices; i++) {
+    firstEdge[builder->indices[i] + 1]++;
+  }
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    firstEdge[i + 1] += firstEdge[i];
+  }
+
+  for (i = 0; i < builder->numberIndices; i++) {
+    GLUSuint next = i - i % 3 + (i + 1) % 3;
+
+    edges[firstEdge[builder->indices[i]]++] = builder->indices[next];
+  }
+
+  for (i = builder->numberVertices; i > 0; i--) {
+    firstEdge[i] = firstEdge[i - 1];
+  }
+
+  firstEdge[0] = 0;
+
+  // A vertex with several open edges points to itself.
+
+  memset(builder->loop, 0xFF, builder->numberVertices * sizeof(GLUSuint));
+  memset(builder->loopBack, 0xFF, builder->numberVertices * sizeof(GLUSuint));
+
+  for (i = 0; i < builder->numberIndices; i++) {
+    GLUSuint vertex0 = builder->indices[i];
+    GLUSuint vertex1 = builder->indices[i - i % 3 + (i + 1) % 3];
+
+    if (glusShapeLodHasEdgef(firstEdge, edges, vertex1, vertex0)) {
+      continue;
+    }
+
+    builder->loop[vertex0] =
+        builder->loop[vertex0] == GLUS_LOD_NO_VERTEX ? vertex1 : vertex0;
+    builder->loopBack[vertex1] =
+        builder->loopBack[vertex1] == GLUS_LOD_NO_VERTEX ? vertex0 : vertex1;
+  }
+
+  glusMemoryFree(firstEdge);
+  glusMemoryFree(edges);
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    GLUSuint other = builder->wedge[i];
+
+    if (builder->remap[i] != i) {
+      continue;
+    }
+
+    builder->kind[i] = GLUS_LOD_LOCKED;
+
+    if (other == i) {
+      if (builder->loop[i] == GLUS_LOD_NO_VERTEX &&
+          builder->loopBack[i] == GLUS_LOD_NO_VERTEX) {
+        builder->kind[i] = GLUS_LOD_MANIFOLD;
+      } else if (glusShapeLodIsOpenf(builder->loop[i], i) &&
+                 glusShapeLodIsOpenf(builder->loopBack[i], i)) {
+        builder->kind[i] = GLUS_LOD_BORDER;
+      }
+    } else if (builder->wedge[other] == i) {
+      if (glusShapeLodIsOpenf(builder->loop[i], i) &&
+          glusShapeLodIsOpenf(builder->loopBack[i], i) &&
+          glusShapeLodIsOpenf(builder->loop[other], other) &&
+          glusShapeLodIsOpenf(builder->loopBack[other], other) &&
+          builder->remap[builder->loopBack[i]] ==
+              builder->remap[builder->loop[other]] &&
+          builder->remap[builder->loop[i]] ==
+              builder->remap[builder->loopBack[other]] &&
+          builder->remap[builder->loop[i]] !=
+              builder->remap[builder->loopBack[i]]) {
+        builder->kind[i] = GLUS_LOD_SEAM;
+      }
+    }
+  }
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    builder->kind[i] = builder->kind[builder->remap[i]];
+  }
+
+  // The quadrics contain the planes of the triangles and of the open edges.
+
+  memset(builder->quadrics, 0,
+         builder->numberVertices * sizeof(GLUSquadric));
+
+  for (i = 0; i < builder->numberIndices; i += 3) {
+    glusShapeLodAddTrianglef(builder, &builder->indices[i]);
+
+    for (k = 0; k < 3; k++) {
+      GLUSuint vertex0 = builder->indices[i + k];
+      GLUSuint vertex1 = builder->indices[i + (k + 1) % 3];
+
+      if (builder->kind[vertex0] != builder->kind[vertex1] ||
+          (builder->kind[vertex0] != GLUS_LOD_BORDER &&
+           builder->kind[vertex0] != GLUS_LOD_SEAM) ||
+          builder->loop[vertex0] != vertex1) {
+        continue;
+      }
+
+      // Both sides of a seam have this edge, so it is added only once.
+      if (builder->kind[vertex0] == GLUS_LOD_SEAM &&
+          builder->remap[vertex0] > builder->remap[vertex1]) {
+        continue;
+      }
+
+      glusShapeLodAddEdgef(builder, vertex0, vertex1,
+                           builder->indices[i + (k + 2) % 3]);
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSvoid glusShapeLodDestroyBuilderf(GLUSlodbuilder *builder) {
+  glusMemoryFree(builder->remap);
+  glusMemoryFree(builder->wedge);
+  glusMemoryFree(builder->kind);
+  glusMemoryFree(builder->loop);
+  glusMemoryFree(builder->loopBack);
+  glusMemoryFree(builder->quadrics);
+  glusMemoryFree(builder->indices);
+  glusMemoryFree(builder->firstTriangle);
+  glusMemoryFree(builder->triangles);
+  glusMemoryFree(builder->collapses);
+  glusMemoryFree(builder->order);
+  glusMemoryFree(builder->sortTemp);
+  glusMemoryFree(builder->collapseRemap);
+  glusMemoryFree(builder->collapseLocked);
+
+  memset(builder, 0, sizeof(GLUSlodbuilder));
+}
+
+static GLUSboolean glusShapeLodInitBuilderf(GLUSlodbuilder *builder,
+                                           const GLUSshape *shape) {
+  GLUSuint numberVertices = shape->numberVertices;
+  GLUSuint numberIndices = shape->numberIndices;
+
+  GLUSuint i;
+
+  memset(builder, 0, sizeof(GLUSlodbuilder));
+
+  builder->vertices = shape->vertices;
+  builder->numberVertices = numberVertices;
+  builder->numberIndices = numberIndices;
+
+  builder->remap =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->wedge =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->kind =
+      (GLUSubyte *)glusMemoryMalloc(numberVertices * sizeof(GLUSubyte));
+  builder->loop =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->loopBack =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->quadrics =
+      (GLUSquadric *)glusMemoryMalloc(numberVertices * sizeof(GLUSquadric));
+  builder->indices =
+      (GLUSuint *)glusMemoryMalloc(numberIndices * sizeof(GLUSuint));
+  builder->firstTriangle =
+      (GLUSuint *)glusMemoryMalloc((numberVertices + 1) * sizeof(GLUSuint));
+  builder->triangles =
+      (GLUSuint *)glusMemoryMalloc(numberIndices * sizeof(GLUSuint));
+  builder->collapses =
+      (GLUScollapse *)glusMemoryMalloc(numberIndices * sizeof(GLUScollapse));
+  builder->order =
+      (GLUSuint *)glusMemoryMalloc(numberIndices * sizeof(GLUSuint));
+  builder->sortTemp =
+      (GLUSuint *)glusMemoryMalloc(numberIndices * sizeof(GLUSuint));
+  builder->collapseRemap =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->collapseLocked =
+      (GLUSubyte *)glusMemoryMalloc(numberVertices * sizeof(GLUSubyte));
+
+  if (!builder->remap || !builder->wedge || !builder->kind || !builder->loop ||
+      !builder->loopBack || !builder->quadrics || !builder->indices ||
+      !builder->firstTriangle || !builder->triangles || !builder->collapses ||
+      !builder->order || !builder->sortTemp || !builder->collapseRemap ||
+      !builder->collapseLocked) {
+    glusShapeLodDestroyBuilderf(builder);
+
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < numberIndices; i++) {
+    builder->indices[i] = (GLUSuint)shape->indices[i];
+  }
+
+  for (i = 0; i < numberVertices; i++) {
+    builder->collapseRemap[i] = i;
+  }
+
+  if (!glusShapeLodInitRemapf(builder) || !glusShapeLodClassifyf(builder)) {
+    glusShapeLodDestroyBuilderf(builder);
+
+    return GLUS_FALSE;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Stores the current triangles around every position.
+static GLUSvoid glusShapeLodUpdateTrianglesf(GLUSlodbuilder *builder) {
+  GLUSuint *firstTriangle = builder->firstTriangle;
+
+  GLUSuint i;
+
+  memset(firstTriangle, 0, (builder->numberVertices + 1) * sizeof(GLUSuint));
+
+  for (i = 0; i < builder->numberIndices; i++) {
+    firstTriangle[builder->remap[builder->indices[i]] + 1]++;
+  }
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    firstTriangle[i + 1] += firstTriangle[i];
+  }
+
+  for (i = 0; i < builder->numberIndices; i++) {
+    builder->triangles[firstTriangle[builder->remap[builder->indices[i]]]++] =
+        i / 3;
+  }
+
+  for (i = builder->numberVertices; i > 0; i--) {
+    firstTriangle[i] = firstTriangle[i - 1];
+  }
+
+  firstTriangle[0] = 0;
+}
+
+// Finds the cheaper allowed direction of the collapse of an edge.
+static GLUSvoid glusShapeLodPickCollapsef(GLUScollapse *collapse,
+                                         const GLUSlodbuilder *builder,
+                                         const GLUSuint vertex0,
+                                         const GLUSuint vertex1) {
+  GLUSubyte kind0 = builder->kind[vertex0];
+  GLUSubyte kind1 = builder->kind[vertex1];
+
+  GLUSfloat point[3];
+
+  GLUSfloat error;
+
+  collapse->vertex[0] = GLUS_LOD_NO_VERTEX;
+
+  // Borders and seams only collapse along their own open edges.
+  if (kind0 == kind1 &&
+      (kind0 == GLUS_LOD_BORDER || kind0 == GLUS_LOD_SEAM)) {
+    if (builder->loop[vertex0] != vertex1) {
+      return;
+    }
+  } else if (builder->remap[vertex0] > builder->remap[vertex1]) {
+    // Inner edges are found in both triangles, so only one is used.
+    return;
+  }
+
+  if (g_canCollapse[kind0][kind1]) {
+    glusShapeLodGetPositionf(point, builder, vertex1);
+
+    collapse->vertex[0] = vertex0;
+    collapse->vertex[1] = vertex1;
+    collapse->error = glusShapeLodGetErrorf(builder, vertex0, vertex1, point);
+  }
+
+  if (g_canCollapse[kind1][kind0]) {
+    glusShapeLodGetPositionf(point, builder, vertex0);
+
+    error = glusShapeLodGetErrorf(builder, vertex0, vertex1, point);
+
+    if (collapse->vertex[0] == GLUS_LOD_NO_VERTEX || error < collapse->error) {
+      collapse->vertex[0] = vertex1;
+      collapse->vertex[1] = vertex0;
+      collapse->error = error;
+    }
+  }
+}
+
+// Sorts the collapses by their error. As the errors are not negative, their
+// bits sort like unsigned integers.
+static GLUSvoid glusShapeLodSortCollapsesf(GLUSlodbuilder *builder,
+                                          const GLUSuint numberCollapses) {
+  GLUSuint histogram[2048];
+
+  GLUSuint *source = builder->sortTemp;
+  GLUSuint *target = builder->order;
+
+  GLUSuint *swap;
+
+  GLUSuint pass, i;
+
+  for (i = 0; i < numberCollapses; i++) {
+    target[i] = i;
+  }
+
+  for (pass = 0; pass < 3; pass++) {
+    GLUSuint sum = 0;
+
+    swap = source;
+    source = target;
+    target = swap;
+
+    memset(histogram, 0, sizeof(histogram));
+
+    for (i = 0; i < numberCollapses; i++) {
+      GLUSuint key;
+
+      memcpy(&key, &builder->collapses[source[i]].error, sizeof(GLUSuint));
+
+      histogram[(key >> (11 * pass)) & 2047]++;
+    }
+
+    for (i = 0; i < 2048; i++) {
+      GLUSuint count = histogram[i];
+
+      histogram[i] = sum;
+
+      sum += count;
+    }
+
+    for (i = 0; i < numberCollapses; i++) {
+      GLUSuint key;
+
+      memcpy(&key, &builder->collapses[source[i]].error, sizeof(GLUSuint));
+
+      target[histogram[(key >> (11 * pass)) & 2047]++] = source[i];
+    }
+  }
+
+  // After an odd number of passes, the result is in the temporary array.
+  if (target != builder->order) {
+    memcpy(builder->order, target, numberCollapses * sizeof(GLUSuint));
+  }
+}
+
+// Checks, if a triangle around the position would turn around, if the
+// position is moved to the point.
+static GLUSboolean glusShapeLodHasFlipf(const GLUSlodbuilder *builder,
+                                        const GLUSuint position0,
+                                        const GLUSuint position1,
+                                        const GLUSfloat *point) {
+  GLUSuint i, k;
+
+  for (i = builder->firstTriangle[position0];
+       i < builder->firstTriangle[position0 + 1]; i++) {
+    const GLUSuint *triangle = &builder->indices[3 * builder->triangles[i]];
+
+    GLUSfloat p0[3], p1[3], p2[3];
+    GLUSfloat edge0[3], edge1[3];
+    GLUSfloat before[3], after[3];
+
+    for (k = 0; k < 3; k++) {
+      if (builder->remap[triangle[k]] == position0) {
+        break;
+      }
+    }
+
+    // Triangles with both positions are removed by the collapse.
+    if (builder->remap[triangle[(k + 1) % 3]] == position1 ||
+        builder->remap[triangle[(k + 2) % 3]] == position1) {
+      continue;
+    }
+
+    glusShapeLodGetPositionf(p0, builder, triangle[k]);
+    glusShapeLodGetPositionf(p1, builder, triangle[(k + 1) % 3]);
+    glusShapeLodGetPositionf(p2, builder, triangle[(k + 2) % 3]);
+
+    glusVector3SubtractVector3f(edge0, p1, p0);
+    glusVector3SubtractVector3f(edge1, p2, p0);
+    glusVector3Crossf(before, edge0, edge1);
+
+    glusVector3SubtractVector3f(edge0, p1, point);
+    glusVector3SubtractVector3f(edge1, p2, point);
+    glusVector3Crossf(after, edge0, edge1);
+
+    // Triangles, which are already degenerated, can not flip.
+    if (glusVector3Dotf(before, before) > 0.0f &&
+        glusVector3Dotf(before, after) <= 0.0f) {
+      return GLUS_TRUE;
+    }
+  }
+
+  return GLUS_FALSE;
+}
+
+// Returns the highest accepted error of a pass.
+static GLUSfloat glusShapeLodGetErrorGoalf(const GLUSlodbuilder *builder,
+                                           const GLUSuint numberCollapses,
+                                           const GLUSuint edgeGoal) {
+  if (edgeGoal < numberCollapses) {
+    return 1.5f * builder->collapses[builder->order[edgeGoal]].error;
+  }
+
+  return builder->collapses[builder->order[numberCollapses - 1]].error;
+}
+
+// Performs the cheapest collapses, which do not share a position. Returns the
+// number of removed triangles.
+static GLUSuint glusShapeLodCollapsef(GLUSlodbuilder *builder,
+                                      const GLUSuint numberCollapses,
+                                      const GLUSuint triangleGoal) {
+  GLUSuint edgeGoal = triangleGoal / 2;
+
+  GLUSfloat errorGoal;
+
+  GLUSuint numberTriangles = 0;
+
+  GLUSuint i;
+
+  // Many collapses are skipped, as they share a position with a cheaper one.
+  // So a higher error than the one of the goal is accepted.
+  errorGoal = glusShapeLodGetErrorGoalf(builder, numberCollapses, edgeGoal);
+
+  memset(builder->collapseLocked, 0,
+         builder->numberVertices * sizeof(GLUSubyte));
+
+  for (i = 0; i < numberCollapses; i++) {
+    const GLUScollapse *collapse = &builder->collapses[builder->order[i]];
+
+    GLUSuint vertex0 = collapse->vertex[0];
+    GLUSuint vertex1 = collapse->vertex[1];
+
+    GLUSuint position0 = builder->remap[vertex0];
+    GLUSuint position1 = builder->remap[vertex1];
+
+    GLUSfloat point[3];
+
+    if (collapse->error > errorGoal || numberTriangles >= triangleGoal) {
+      break;
+    }
+
+    if (builder->collapseLocked[position0] ||
+        builder->collapseLocked[position1]) {
+      continue;
+    }
+
+    glusShapeLodGetPositionf(point, builder, vertex1);
+
+    // A flipping collapse does not count, so the goal moves on.
+    if (glusShapeLodHasFlipf(builder, position0, position1, point)) {
+      edgeGoal++;
+
+      errorGoal = glusShapeLodGetErrorGoalf(builder, numberCollapses, edgeGoal);
+
+      continue;
+    }
+
+    if (builder->kind[vertex0] == GLUS_LOD_SEAM) {
+      // The other side of the seam follows along its own open edge.
+      GLUSuint other0 = builder->wedge[vertex0];
+      GLUSuint other1 = builder->loop[vertex0] == vertex1
+                            ? builder->loopBack[other0]
+                            : builder->loop[other0];
+
+      if (other1 == GLUS_LOD_NO_VERTEX ||
+          builder->remap[other1] != position1) {
+        continue;
+      }
+
+      builder->collapseRemap[vertex0] = vertex1;
+      builder->collapseRemap[other0] = other1;
+    } else {
+      GLUSuint wedge = vertex0;
+
+      do {
+        builder->collapseRemap[wedge] = vertex1;
+
+        wedge = builder->wedge[wedge];
+      } while (wedge != vertex0);
+    }
+
+    glusShapeLodAddQuadricf(&builder->quadrics[position1],
+                            &builder->quadrics[position0]);
+
+    builder->collapseLocked[position0] = GLUS_TRUE;
+    builder->collapseLocked[position1] = GLUS_TRUE;
+
+    // A border edge has only one triangle.
+    numberTriangles += builder->kind[vertex0] == GLUS_LOD_BORDER ? 1 : 2;
+  }
+
+  return numberTriangles;
+}
+
+// Applies the collapses to the triangles and the open edges and removes the
+// triangles, which became degenerated.
+static GLUSvoid glusShapeLodApplyCollapsesf(GLUSlodbuilder *builder) {
+  GLUSuint numberIndices = 0;
+
+  GLUSuint i;
+
+  for (i = 0; i < builder->numberIndices; i += 3) {
+    GLUSuint vertex0 = builder->collapseRemap[builder->indices[i + 0]];
+    GLUSuint vertex1 = builder->collapseRemap[builder->indices[i + 1]];
+    GLUSuint vertex2 = builder->collapseRemap[builder->indices[i + 2]];
+
+    GLUSuint position0 = builder->remap[vertex0];
+    GLUSuint position1 = builder->remap[vertex1];
+    GLUSuint position2 = builder->remap[vertex2];
+
+    if (position0 == position1 || position1 == position2 ||
+        position2 == position0) {
+      continue;
+    }
+
+    builder->indices[numberIndices + 0] = vertex0;
+    builder->indices[numberIndices + 1] = vertex1;
+    builder->indices[numberIndices + 2] = vertex2;
+
+    numberIndices += 3;
+  }
+
+  builder->numberIndices = numberIndices;
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    GLUSuint next = builder->loop[i];
+    GLUSuint previous = builder->loopBack[i];
+
+    // If the edge was collapsed onto this vertex, the loop continues with the
+    // next vertex of the removed one.
+    if (next != GLUS_LOD_NO_VERTEX) {
+      builder->loop[i] = builder->collapseRemap[next] == i
+                             ? builder->loop[next]
+                             : builder->collapseRemap[next];
+    }
+
+    if (previous != GLUS_LOD_NO_VERTEX) {
+      builder->loopBack[i] = builder->collapseRemap[previous] == i
+                                 ? builder->loopBack[previous]
+                                 : builder->collapseRemap[previous];
+    }
+  }
+
+  for (i = 0; i < builder->numberVertices; i++) {
+    builder->collapseRemap[i] = i;
+  }
+}
+
+// Collapses edges in passes, until the number of triangles is reached or no
+// edge can be collapsed anymore.
+static GLUSvoid glusShapeLodSimplifyf(GLUSlodbuilder *builder,
+                                     const GLUSuint targetIndices) {
+  while (builder->numberIndices > targetIndices) {
+    GLUSuint numberCollapses = 0;
+
+    GLUSint i;
+
+    glusShapeLodUpdateTrianglesf(builder);
+
+    // The collapse of every edge is evaluated independently.
+
+#ifdef _OPENMP
+#pragma omp parallel for if (builder->numberIndices >= 3 * GLUS_LOD_PARALLEL_TRIANGLES)
+#endif
+    for (i = 0; i < (GLUSint)builder->numberIndices; i++) {
+      GLUSuint next = (GLUSuint)i - (GLUSuint)i % 3 + ((GLUSuint)i + 1) % 3;
+
+      glusShapeLodPickCollapsef(&builder->collapses[i], builder,
+                                builder->indices[i], builder->indices[next]);
+    }
+
+    for (i = 0; i < (GLUSint)builder->numberIndices; i++) {
+      if (builder->collapses[i].vertex[0] != GLUS_LOD_NO_VERTEX) {
+        builder->collapses[numberCollapses++] = builder->collapses[i];
+      }
+    }
+
+    if (numberCollapses == 0) {
+      break;
+    }
+
+    glusShapeLodSortCollapsesf(builder, numberCollapses);
+
+    if (glusShapeLodCollapsef(builder, numberCollapses,
+                              (builder->numberIndices - targetIndices) / 3) ==
+        0) {
+      break;
+    }
+
+    glusShapeLodApplyCollapsesf(builder);
+  }
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeCreateLevelsOfDetailf(
+    GLUSshape *lodShape, GLUSuint *firstIndices, GLUSuint *numberIndices,
+    const GLUSshape *sourceShape, const GLUSfloat *ratios,
+    const GLUSuint numberLevels) {
+  GLUSlodbuilder builder;
+
+  GLUSindex *indices = 0;
+
+  GLUSuint totalIndices = 0;
+
+  GLUSuint level, i;
+
+  if (!lodShape || !firstIndices || !numberIndices || !sourceShape ||
+      !ratios || numberLevels == 0 || !sourceShape->vertices ||
+      !sourceShape->indices || sourceShape->mode != GLUS_TRIANGLES ||
+      sourceShape->numberIndices % 3 != 0) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < sourceShape->numberIndices; i++) {
+    if (sourceShape->indices[i] >= sourceShape->numberVertices) {
+      return GLUS_FALSE;
+    }
+  }
+
+  if (!glusShapeLodInitBuilderf(&builder, sourceShape)) {
+    return GLUS_FALSE;
+  }
+
+  for (level = 0; level < numberLevels; level++) {
+    GLUSfloat ratio = ratios[level];
+
+    GLUSuint numberTriangles;
+
+    GLUSindex *grown;
+
+    if (!(ratio >= 0.0f)) {
+      ratio = 0.0f;
+    } else if (ratio > 1.0f) {
+      ratio = 1.0f;
+    }
+
+    numberTriangles =
+        (GLUSuint)(ratio * (GLUSfloat)(sourceShape->numberIndices / 3));
+
+    glusShapeLodSimplifyf(&builder, 3 * numberTriangles);
+
+    grown = (GLUSindex *)glusMemoryRealloc(
+        indices, (totalIndices + builder.numberIndices) * sizeof(GLUSindex));
+
+    if (!grown && totalIndices + builder.numberIndices > 0) {
+      glusMemoryFree(indices);
+
+      glusShapeLodDestroyBuilderf(&builder);
+
+      return GLUS_FALSE;
+    }
+
+    indices = grown;
+
+    for (i = 0; i < builder.numberIndices; i++) {
+      indices[totalIndices + i] = (GLUSindex)builder.indices[i];
+    }
+
+    firstIndices[level] = totalIndices;
+    numberIndices[level] = builder.numberIndices;
+
+    totalIndices += builder.numberIndices;
+  }
+
+  glusShapeLodDestroyBuilderf(&builder);
+
+  if (!glusShapeCopyf(lodShape, sourceShape)) {
+    glusMemoryFree(indices);
+
+    return GLUS_FALSE;
+  }
+
+  glusMemoryFree(lodShape->indices);
+
+  lodShape->indices = indices;
+  lodShape->numberIndices = totalIndices;
+
+  // Every level is ordered for the vertex cache on its own.
+  for (level = 0; level < numberLevels; level++) {
+    GLUSshape levelShape = *lodShape;
+
+    levelShape.indices = &lodShape->indices[firstIndices[level]];
+    levelShape.numberIndices = numberIndices[level];
+
+    glusShapeOptimizeVertexCachef(&levelShape, GLUS_LOD_CACHE_SIZE);
+  }
+
+  return GLUS_TRUE;
+}
@@ -0,0 +1,826 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+// Marks a missing triangle or a vertex, which is in no meshlet.
+#define GLUS_MESHLET_NONE 0xFFFFFFFF
+
+// How much a similar normal counts against a short distance, when a meshlet
+// is grown.
+#define GLUS_MESHLET_CONE_WEIGHT 0.25f
+
+// If the normals of a meshlet spread more than this, it is never back face
+// culled.
+#define GLUS_MESHLET_MIN_CONE 0.1f
+
+/**
+ * The state while splitting the triangles into meshlets.
+ */
+typedef struct _GLUSmeshletbuilder {
+  const GLUSfloat *vertices;
+  GLUSuint numberVertices;
+
+  GLUSuint maxVertices;
+  GLUSuint maxTriangles;
+
+  /**
+   * Normal and center of every triangle.
+   */
+  GLUSfloat *triangleNormals;
+  GLUSfloat *triangleCenters;
+  GLUSubyte *emitted;
+
+  /**
+   * The triangles around every vertex and how many of them are not emitted.
+   */
+  GLUSuint *firstTriangle;
+  GLUSuint *triangles;
+  GLUSuint *liveTriangles;
+
+  /**
+   * The meshlet, which uses the vertex.
+   */
+  GLUSuint *usedBy;
+
+  /**
+   * The meshlet under construction.
+   */
+  GLUSuint *meshletVertices;
+  GLUSuint numberMeshletVertices;
+  GLUSuint *meshletTriangles;
+  GLUSuint numberMeshletTriangles;
+  GLUSuint meshletFirstIndex;
+  GLUSfloat centerSum[3];
+  GLUSfloat normalSum[3];
+
+  /**
+   * Radius of a meshlet with the average triangle area.
+   */
+  GLUSfloat expectedRadius;
+
+  GLUSmeshlet *meshlets;
+  GLUSuint numberMeshlets;
+  GLUSuint capacityMeshlets;
+
+} GLUSmeshletbuilder;
+
+static GLUSvoid glusMeshletDestroyBuilderf(GLUSmeshletbuilder *builder) {
+  glusMemoryFree(builder->triangleNormals);
+  glusMemoryFree(builder->triangleCenters);
+  glusMemoryFree(builder->emitted);
+  glusMemoryFree(builder->firstTriangle);
+  glusMemoryFree(builder->triangles);
+  glusMemoryFree(builder->liveTriangles);
+  glusMemoryFree(builder->usedBy);
+  glusMemoryFree(builder->meshletVertices);
+  glusMemoryFree(builder->meshletTriangles);
+  glusMemoryFree(builder->meshlets);
+
+  memset(builder, 0, sizeof(GLUSmeshletbuilder));
+}
+
+static GLUSboolean glusMeshletInitBuilderf(GLUSmeshletbuilder *builder,
+                                           const GLUSfloat *vertices,
+                                           const GLUSuint numberVertices,
+                                           const GLUSindex *indices,
+                                           const GLUSuint numberIndices,
+                                           const GLUSuint maxVertices,
+                                           const GLUSuint maxTriangles) {
+  GLUSuint numberTriangles = numberIndices / 3;
+
+  GLUSfloat area = 0.0f;
+
+  GLUSuint i, k;
+
+  memset(builder, 0, sizeof(GLUSmeshletbuilder));
+
+  builder->vertices = vertices;
+  builder->numberVertices = numberVertices;
+  builder->maxVertices = maxVertices;
+  builder->maxTriangles = maxTriangles;
+
+  builder->capacityMeshlets = numberTriangles / maxTriangles + 16;
+
+  builder->triangleNormals = (GLUSfloat *)glusMemoryMalloc(
+      3 * numberTriangles * sizeof(GLUSfloat));
+  builder->triangleCenters = (GLUSfloat *)glusMemoryMalloc(
+      3 * numberTriangles * sizeof(GLUSfloat));
+  builder->emitted =
+      (GLUSubyte *)glusMemoryMalloc(numberTriangles * sizeof(GLUSubyte));
+  builder->firstTriangle =
+      (GLUSuint *)glusMemoryMalloc((numberVertices + 1) * sizeof(GLUSuint));
+  builder->triangles =
+      (GLUSuint *)glusMemoryMalloc(numberIndices * sizeof(GLUSuint));
+  builder->liveTriangles =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->usedBy =
+      (GLUSuint *)glusMemoryMalloc(numberVertices * sizeof(GLUSuint));
+  builder->meshletVertices =
+      (GLUSuint *)glusMemoryMalloc(maxVertices * sizeof(GLUSuint));
+  builder->meshletTriangles =
+      (GLUSuint *)glusMemoryMalloc(maxTriangles * sizeof(GLUSuint));
+  builder->meshlets = (GLUSmeshlet *)glusMemoryMalloc(
+      builder->capacityMeshlets * sizeof(GLUSmeshlet));
+
+  if ((numberTriangles > 0 &&
+       (!builder->triangleNormals || !builder->triangleCenters ||
+        !builder->emitted || !builder->triangles)) ||
+      !builder->firstTriangle || !builder->liveTriangles || !builder->usedBy ||
+      !builder->meshletVertices || !builder->meshletTriangles ||
+      !builder->meshlets) {
+    glusMeshletDestroyBuilderf(builder);
+
+    return GLUS_FALSE;
+  }
+
+  memset(builder->emitted, 0, numberTriangles * sizeof(GLUSubyte));
+  memset(builder->liveTriangles, 0, numberVertices * sizeof(GLUSuint));
+  memset(builder->usedBy, 0xFF, numberVertices * sizeof(GLUSuint));
+
+  for (i = 0; i < numberTriangles; i++) {
+    const GLUSfloat *p0 = &vertices[4 * indices[3 * i + 0]];
+    const GLUSfloat *p1 = &vertices[4 * indices[3 * i + 1]];
+    const GLUSfloat *p2 = &vertices[4 * indices[3 * i + 2]];
+
+    GLUSfloat *normal = &builder->triangleNormals[3 * i];
+    GLUSfloat *center = &builder->triangleCenters[3 * i];
+
+    GLUSfloat edge0[3], edge1[3];
+
+    glusVector3SubtractVector3f(edge0, p1, p0);
+    glusVector3SubtractVector3f(edge1, p2, p0);
+    glusVector3Crossf(normal, edge0, edge1);
+
+    area += 0.5f * glusVector3Lengthf(normal);
+
+    // Degenerated triangles keep a zero normal.
+    glusVector3Normalizef(normal);
+
+    for (k = 0; k < 3; k++) {
+      center[k] = (p0[k] + p1[k] + p2[k]) / 3.0f;
+    }
+  }
+
+  builder->expectedRadius = 1.0f;
+
+  if (numberTriangles > 0 && area > 0.0f) {
+    builder->expectedRadius = 0.5f * sqrtf(area / (GLUSfloat)numberTriangles *
+                                           (GLUSfloat)maxTriangles);
+  }
+
+  // Triangles around every vertex.
+
+  for (i = 0; i < numberIndices; i++) {
+    builder->liveTriangles[indices[i]]++;
+  }
+
+  builder->firstTriangle[0] = 0;
+
+  for (i = 0; i < numberVertices; i++) {
+    builder->firstTriangle[i + 1] =
+        builder->firstTriangle[i] + builder->liveTriangles[i];
+  }
+
+  for (i = 0; i < numberIndices; i++) {
+    builder->triangles[builder->firstTriangle[indices[i]]++] = i / 3;
+  }
+
+  for (i = numberVertices; i > 0; i--) {
+    builder->firstTriangle[i] = builder->firstTriangle[i - 1];
+  }
+
+  builder->firstTriangle[0] = 0;
+
+  return GLUS_TRUE;
+}
+
+// Returns the number of vertices of the triangle, which are not yet in the
+// current meshlet.
+static GLUSuint glusMeshletGetExtraVerticesf(const GLUSmeshletbuilder *builder,
+                                             const GLUSindex *triangle) {
+  GLUSuint extra = 0;
+
+  GLUSuint k;
+
+  for (k = 0; k < 3; k++) {
+    if (builder->usedBy[triangle[k]] != builder->numberMeshlets &&
+        (k < 1 || triangle[k] != triangle[0]) &&
+        (k < 2 || triangle[k] != triangle[1])) {
+      extra++;
+    }
+  }
+
+  return extra;
+}
+
+// Searches the best triangle around the vertices of the current meshlet. The
+// fewer vertices it adds, the better. Otherwise, the closer it is and the more
+// its normal is like the others, the better.
+static GLUSuint glusMeshletGetNextTrianglef(const GLUSmeshletbuilder *builder,
+                                            const GLUSindex *indices,
+                                            const GLUSuint firstTriangle,
+                                            const GLUSuint lastTriangle,
+                                            GLUSboolean *blocked) {
+  GLUSuint bestTriangle = GLUS_MESHLET_NONE;
+  GLUSuint bestExtra = 3;
+  GLUSfloat bestScore = 0.0f;
+
+  GLUSfloat center[3];
+  GLUSfloat axis[3];
+
+  GLUSuint i, k;
+
+  glusVector3MultiplyScalarf(
+      center, builder->centerSum,
+      1.0f / (GLUSfloat)builder->numberMeshletTriangles);
+
+  glusVector3Copyf(axis, builder->normalSum);
+  glusVector3Normalizef(axis);
+
+  for (i = 0; i < builder->numberMeshletVertices; i++) {
+    GLUSuint vertex = builder->meshletVertices[i];
+
+    // All triangles around inner vertices are already emitted.
+    if (builder->liveTriangles[vertex] == 0) {
+      continue;
+    }
+
+    for (k = builder->firstTriangle[vertex];
+         k < builder->firstTriangle[vertex + 1]; k++) {
+      GLUSuint triangle = builder->triangles[k];
+
+      GLUSuint extra;
+
+      GLUSfloat direction[3];
+
+      GLUSfloat spread, cone, score;
+
+      if (triangle < firstTriangle || triangle >= lastTriangle ||
+          builder->emitted[triangle]) {
+        continue;
+      }
+
+      extra = glusMeshletGetExtraVerticesf(builder, &indices[3 * triangle]);
+
+      if (builder->numberMeshletVertices + extra > builder->maxVertices) {
+        *blocked = GLUS_TRUE;
+
+        continue;
+      }
+
+      if (extra > bestExtra) {
+        continue;
+      }
+
+      glusVector3SubtractVector3f(direction,
+                                  &builder->triangleCenters[3 * triangle],
+                                  center);
+
+      spread = glusVector3Dotf(&builder->triangleNormals[3 * triangle], axis);
+
+      cone = 1.0f - spread * GLUS_MESHLET_CONE_WEIGHT;
+
+      score = (1.0f + glusVector3Lengthf(direction) / builder->expectedRadius *
+                          (1.0f - GLUS_MESHLET_CONE_WEIGHT)) *
+              (cone < 0.001f ? 0.001f : cone);
+
+      if (extra < bestExtra || score < bestScore) {
+        bestTriangle = triangle;
+        bestExtra = extra;
+        bestScore = score;
+      }
+    }
+  }
+
+  return bestTriangle;
+}
+
+static GLUSboolean glusMeshletAddTrianglef(GLUSmeshletbuilder *builder,
+                                           GLUSindex *sortedIndices,
+                                           const GLUSindex *indices,
+                                           const GLUSuint triangle,
+                                           GLUSuint *numberSorted) {
+  GLUSuint k;
+
+  for (k = 0; k < 3; k++) {
+    GLUSuint vertex = indices[3 * triangle + k];
+
+    if (builder->usedBy[vertex] != builder->numberMeshlets) {
+      builder->usedBy[vertex] = builder->numberMeshlets;
+
+      builder->meshletVertices[builder->numberMeshletVertices++] = vertex;
+    }
+
+    builder->liveTriangles[vertex]--;
+
+    sortedIndices[(*numberSorted)++] = (GLUSindex)vertex;
+  }
+
+  glusVector3AddVector3f(builder->centerSum, builder->centerSum,
+                         &builder->triangleCenters[3 * triangle]);
+  glusVector3AddVector3f(builder->normalSum, builder->normalSum,
+                         &builder->triangleNormals[3 * triangle]);
+
+  builder->meshletTriangles[builder->numberMeshletTriangles++] = triangle;
+
+  builder->emitted[triangle] = 1;
+
+  return builder->numberMeshletTriangles == builder->maxTriangles;
+}
+
+// Bounding sphere after Ritter: The two most distant extreme points along the
+// axes give the start sphere, which is grown to include all points.
+static GLUSvoid glusMeshletGetSpheref(GLUSmeshlet *meshlet,
+                                      const GLUSmeshletbuilder *builder) {
+  const GLUSfloat *minimum[3];
+  const GLUSfloat *maximum[3];
+
+  GLUSfloat bestDistance = -1.0f;
+
+  GLUSfloat radius = 0.0f;
+
+  GLUSuint i, k;
+
+  for (k = 0; k < 3; k++) {
+    minimum[k] = &builder->vertices[4 * builder->meshletVertices[0]];
+    maximum[k] = minimum[k];
+  }
+
+  for (i = 1; i < builder->numberMeshletVertices; i++) {
+    const GLUSfloat *point =
+        &builder->vertices[4 * builder->meshletVertices[i]];
+
+    for (k = 0; k < 3; k++) {
+      if (point[k] < minimum[k][k]) {
+        minimum[k] = point;
+      }
+
+      if (point[k] > maximum[k][k]) {
+        maximum[k] = point;
+      }
+    }
+  }
+
+  for (k = 0; k < 3; k++) {
+    GLUSfloat difference[3];
+
+    GLUSfloat distance;
+
+    glusVector3SubtractVector3f(difference, maximum[k], minimum[k]);
+
+    distance = glusVector3Dotf(difference, difference);
+
+    if (distance > bestDistance) {
+      bestDistance = distance;
+
+      for (i = 0; i < 3; i++) {
+        meshlet->center[i] = 0.5f * (minimum[k][i] + maximum[k][i]);
+      }
+
+      radius = 0.5f * sqrtf(distance);
+    }
+  }
+
+  for (i = 0; i < builder->numberMeshletVertices; i++) {
+    const GLUSfloat *point =
+        &builder->vertices[4 * builder->meshletVertices[i]];
+
+    GLUSfloat difference[3];
+
+    GLUSfloat distance;
+
+    glusVector3SubtractVector3f(difference, point, meshlet->center);
+
+    distance = glusVector3Lengthf(difference);
+
+    if (distance > radius) {
+      GLUSfloat grownRadius = 0.5f * (radius + distance);
+
+      for (k = 0; k < 3; k++) {
+        meshlet->center[k] +=
+            difference[k] * (grownRadius - radius) / distance;
+      }
+
+      radius = grownRadius;
+    }
+  }
+
+  meshlet->center[3] = 1.0f;
+  meshlet->radius = radius;
+}
+
+// The cone contains all normals. Seen from inside the cone, i.e. from behind,
+// all triangles face away.
+static GLUSvoid glusMeshletGetConef(GLUSmeshlet *meshlet,
+                                    const GLUSmeshletbuilder *builder) {
+  GLUSfloat minimumDot = 1.0f;
+
+  GLUSuint i;
+
+  glusVector3Copyf(meshlet->coneAxis, builder->normalSum);
+
+  if (!glusVector3Normalizef(meshlet->coneAxis)) {
+    meshlet->coneCutoff = 1.0f;
+
+    return;
+  }
+
+  for (i = 0; i < builder->numberMeshletTriangles; i++) {
+    const GLUSfloat *normal =
+        &builder->triangleNormals[3 * builder->meshletTriangles[i]];
+
+    GLUSfloat dot;
+
+    // Degenerated triangles are never visible.
+    if (glusVector3Dotf(normal, normal) == 0.0f) {
+      continue;
+    }
+
+    dot = glusVector3Dotf(normal, meshlet->coneAxis);
+
+    if (dot < minimumDot) {
+      minimumDot = dot;
+    }
+  }
+
+  if (minimumDot <= GLUS_MESHLET_MIN_CONE) {
+    meshlet->coneCutoff = 1.0f;
+  } else {
+    meshlet->coneCutoff = sqrtf(1.0f - minimumDot * minimumDot);
+  }
+}
+
+static GLUSboolean glusMeshletFinishf(GLUSmeshletbuilder *builder,
+                                      const GLUSuint numberSorted) {
+  GLUSmeshlet *meshlet;
+
+  if (builder->numberMeshletTriangles == 0) {
+    return GLUS_TRUE;
+  }
+
+  if (builder->numberMeshlets == builder->capacityMeshlets) {
+    GLUSmeshlet *meshlets = (GLUSmeshlet *)glusMemoryRealloc(
+        builder->meshlets, 2 * builder->capacityMeshlets * sizeof(GLUSmeshlet));
+
+    if (!meshlets) {
+      return GLUS_FALSE;
+    }
+
+    builder->meshlets = meshlets;
+    builder->capacityMeshlets *= 2;
+  }
+
+  meshlet = &builder->meshlets[builder->numberMeshlets];
+
+  meshlet->firstIndex = builder->meshletFirstIndex;
+  meshlet->numberIndices = numberSorted - builder->meshletFirstIndex;
+  meshlet->numberVertices = builder->numberMeshletVertices;
+
+  glusMeshletGetSpheref(meshlet, builder);
+  glusMeshletGetConef(meshlet, builder);
+
+  // A new number invalidates the vertex marks of the finished meshlet.
+  builder->numberMeshlets++;
+
+  builder->numberMeshletVertices = 0;
+  builder->numberMeshletTriangles = 0;
+  builder->meshletFirstIndex = numberSorted;
+
+  memset(builder->centerSum, 0, sizeof(builder->centerSum));
+  memset(builder->normalSum, 0, sizeof(builder->normalSum));
+
+  return GLUS_TRUE;
+}
+
+// Splits a range of triangles. The sorted indices are written at the same
+// place as the source indices.
+static GLUSboolean glusMeshletBuildRangef(GLUSmeshletbuilder *builder,
+                                          GLUSindex *sortedIndices,
+                                          const GLUSindex *indices,
+                                          const GLUSuint firstTriangle,
+                                          const GLUSuint lastTriangle) {
+  GLUSuint numberSorted = 3 * firstTriangle;
+
+  GLUSuint scan = firstTriangle;
+
+  builder->meshletFirstIndex = numberSorted;
+
+  while (GLUS_TRUE) {
+    GLUSuint triangle = GLUS_MESHLET_NONE;
+
+    GLUSboolean blocked = GLUS_FALSE;
+
+    if (builder->numberMeshletTriangles > 0) {
+      triangle = glusMeshletGetNextTrianglef(builder, indices, firstTriangle,
+                                             lastTriangle, &blocked);
+    }
+
+    if (triangle == GLUS_MESHLET_NONE) {
+      while (scan < lastTriangle && builder->emitted[scan]) {
+        scan++;
+      }
+
+      if (scan == lastTriangle) {
+        break;
+      }
+
+      triangle = scan;
+
+      // A triangle without a shared vertex is only added, if it is close.
+      if (builder->numberMeshletTriangles > 0) {
+        GLUSfloat direction[3];
+
+        glusVector3MultiplyScalarf(
+            direction, builder->centerSum,
+            -1.0f / (GLUSfloat)builder->numberMeshletTriangles);
+        glusVector3AddVector3f(direction, direction,
+                               &builder->triangleCenters[3 * triangle]);
+
+        if (blocked ||
+            glusVector3Lengthf(direction) > builder->expectedRadius ||
+            builder->numberMeshletVertices +
+                    glusMeshletGetExtraVerticesf(builder,
+                                                 &indices[3 * triangle]) >
+                builder->maxVertices) {
+          if (!glusMeshletFinishf(builder, numberSorted)) {
+            return GLUS_FALSE;
+          }
+        }
+      }
+    }
+
+    if (glusMeshletAddTrianglef(builder, sortedIndices, indices, triangle,
+                                &numberSorted)) {
+      if (!glusMeshletFinishf(builder, numberSorted)) {
+        return GLUS_FALSE;
+      }
+    }
+  }
+
+  return glusMeshletFinishf(builder, numberSorted);
+}
+
+// Moves the meshlets out of the builder, which is destroyed.
+static GLUSvoid glusMeshletTakef(GLUSmeshlet **meshlets,
+                                 GLUSuint *numberMeshlets,
+                                 GLUSmeshletbuilder *builder) {
+  GLUSmeshlet *compacted;
+
+  if (builder->numberMeshlets > 0) {
+    compacted = (GLUSmeshlet *)glusMemoryRealloc(
+        builder->meshlets, builder->numberMeshlets * sizeof(GLUSmeshlet));
+
+    if (compacted) {
+      builder->meshlets = compacted;
+    }
+  }
+
+  *meshlets = builder->meshlets;
+  *numberMeshlets = builder->numberMeshlets;
+
+  builder->meshlets = 0;
+
+  glusMeshletDestroyBuilderf(builder);
+}
+
+static GLUSboolean glusMeshletCheckf(GLUSmeshlet **meshlets,
+                                     GLUSuint *numberMeshlets,
+                                     const GLUSfloat *vertices,
+                                     const GLUSuint numberVertices,
+                                     const GLUSindex *indices,
+                                     const GLUSuint numberIndices,
+                                     const GLUSuint maxVertices,
+                                     const GLUSuint maxTriangles) {
+  GLUSuint i;
+
+  if (!meshlets || !numberMeshlets || !vertices ||
+      (numberIndices > 0 && !indices) || numberIndices % 3 != 0 ||
+      maxVertices < 3 || maxTriangles < 1) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < numberIndices; i++) {
+    if (indices[i] >= numberVertices) {
+      return GLUS_FALSE;
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeCreateMeshletsf(
+    GLUSmeshlet **meshlets, GLUSuint *numberMeshlets, GLUSshape *shape,
+    const GLUSuint maxVertices, const GLUSuint maxTriangles) {
+  GLUSmeshletbuilder builder;
+
+  GLUSindex *sortedIndices;
+
+  if (!shape || shape->mode != GLUS_TRIANGLES ||
+      !glusMeshletCheckf(meshlets, numberMeshlets, shape->vertices,
+                         shape->numberVertices, shape->indices,
+                         shape->numberIndices, maxVertices, maxTriangles)) {
+    return GLUS_FALSE;
+  }
+
+  sortedIndices =
+      (GLUSindex *)glusMemoryMalloc(shape->numberIndices * sizeof(GLUSindex));
+
+  if (!sortedIndices) {
+    return GLUS_FALSE;
+  }
+
+  if (!glusMeshletInitBuilderf(&builder, shape->vertices,
+                               shape->numberVertices, shape->indices,
+                               shape->numberIndices, maxVertices,
+                               maxTriangles)) {
+    glusMemoryFree(sortedIndices);
+
+    return GLUS_FALSE;
+  }
+
+  if (!glusMeshletBuildRangef(&builder, sortedIndices, shape->indices, 0,
+                              shape->numberIndices / 3)) {
+    glusMeshletDestroyBuilderf(&builder);
+
+    glusMemoryFree(sortedIndices);
+
+    return GLUS_FALSE;
+  }
+
+  memcpy(shape->indices, sortedIndices,
+         shape->numberIndices * sizeof(GLUSindex));
+
+  glusMemoryFree(sortedIndices);
+
+  glusMeshletTakef(meshlets, numberMeshlets, &builder);
+
+  glusLogPrint(GLUS_LOG_DEBUG, "Meshlets: %u for %u triangles", *numberMeshlets,
+               shape->numberIndices / 3);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusWavefrontCreateMeshletsf(
+    GLUSmeshlet **meshlets, GLUSuint *numberMeshlets, GLUSwavefront *wavefront,
+    const GLUSuint maxVertices, const GLUSuint maxTriangles) {
+  GLUSmeshletbuilder builder;
+
+  GLUSindex *sortedIndices;
+
+  GLUSgroupList *groupWalker;
+
+  if (!wavefront || !wavefront->indices ||
+      !glusMeshletCheckf(meshlets, numberMeshlets, wavefront->vertices,
+                         wavefront->numberVertices, wavefront->indices,
+                         wavefront->numberIndices, maxVertices,
+                         maxTriangles)) {
+    return GLUS_FALSE;
+  }
+
+  for (groupWalker = wavefront->groups; groupWalker;
+       groupWalker = groupWalker->next) {
+    if (groupWalker->group.numberIndices % 3 != 0) {
+      return GLUS_FALSE;
+    }
+  }
+
+  sortedIndices = (GLUSindex *)glusMemoryMalloc(wavefront->numberIndices *
+                                                sizeof(GLUSindex));
+
+  if (!sortedIndices) {
+    return GLUS_FALSE;
+  }
+
+  // The adjacency is built once for all groups. Triangles of other groups are
+  // skipped by their range.
+  if (!glusMeshletInitBuilderf(&builder, wavefront->vertices,
+                               wavefront->numberVertices, wavefront->indices,
+                               wavefront->numberIndices, maxVertices,
+                               maxTriangles)) {
+    glusMemoryFree(sortedIndices);
+
+    return GLUS_FALSE;
+  }
+
+  for (groupWalker = wavefront->groups; groupWalker;
+       groupWalker = groupWalker->next) {
+    GLUSuint firstTriangle;
+
+    if (groupWalker->group.numberIndices == 0) {
+      continue;
+    }
+
+    firstTriangle =
+        (GLUSuint)(groupWalker->group.indices - wavefront->indices) / 3;
+
+    if (!glusMeshletBuildRangef(
+            &builder, sortedIndices, wavefront->indices, firstTriangle,
+            firstTriangle + groupWalker->group.numberIndices / 3)) {
+      glusMeshletDestroyBuilderf(&builder);
+
+      glusMemoryFree(sortedIndices);
+
+      return GLUS_FALSE;
+    }
+  }
+
+  memcpy(wavefront->indices, sortedIndices,
+         wavefront->numberIndices * sizeof(GLUSindex));
+
+  glusMemoryFree(sortedIndices);
+
+  glusMeshletTakef(meshlets, numberMeshlets, &builder);
+
+  glusLogPrint(GLUS_LOG_DEBUG, "Meshlets: %u for %u triangles", *numberMeshlets,
+               wavefront->numberIndices / 3);
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusMeshletDestroyf(GLUSmeshlet *meshlets) {
+  glusMemoryFree(meshlets);
+}
+
+GLUSuint GLUSAPIENTRY glusMeshletCullf(GLUSuint *visibleMeshlets,
+                                       const GLUSmeshlet *meshlets,
+                                       const GLUSuint numberMeshlets,
+                                       const GLUSfloat viewProjectionMatrix[16],
+                                       const GLUSfloat eye[4]) {
+  GLUSfloat planes[6][4];
+
+  GLUSuint numberVisible = 0;
+
+  GLUSuint i, k;
+
+  if (!visibleMeshlets || !meshlets || !viewProjectionMatrix || !eye) {
+    return 0;
+  }
+
+  // The frustum planes are the sums and differences of the fourth and the
+  // other rows of the matrix.
+  for (i = 0; i < 3; i++) {
+    for (k = 0; k < 4; k++) {
+      planes[2 * i + 0][k] =
+          viewProjectionMatrix[4 * k + 3] + viewProjectionMatrix[4 * k + i];
+      planes[2 * i + 1][k] =
+          viewProjectionMatrix[4 * k + 3] - viewProjectionMatrix[4 * k + i];
+    }
+  }
+
+  for (i = 0; i < 6; i++) {
+    GLUSfloat length = glusVector3Lengthf(planes[i]);
+
+    if (length > 0.0f) {
+      for (k = 0; k < 4; k++) {
+        planes[i][k] /= length;
+      }
+    }
+  }
+
+  for (i = 0; i < numberMeshlets; i++) {
+    const GLUSmeshlet *meshlet = &meshlets[i];
+
+    GLUSboolean visible = GLUS_TRUE;
+
+    for (k = 0; k < 6 && visible; k++) {
+      if (glusVector3Dotf(planes[k], meshlet->center) + planes[k][3] <
+          -meshlet->radius) {
+        visible = GLUS_FALSE;
+      }
+    }
+
+    if (visible && meshlet->coneCutoff < 1.0f) {
+      GLUSfloat direction[3];
+
+      glusVector3SubtractVector3f(direction, meshlet->center, eye);
+
+      if (glusVector3Dotf(direction, meshlet->coneAxis) >=
+          meshlet->coneCutoff * glusVector3Lengthf(direction) +
+              meshlet->radius) {
+        visible = GLUS_FALSE;
+      }
+    }
+
+    if (visible) {
+      visibleMeshlets[numberVisible++] = i;
+    }
+  }
+
+  return numberVisible;
+}
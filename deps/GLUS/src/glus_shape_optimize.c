@@ -0,0 +1,765 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+// Marks a vertex, which is not used by the indices.
+#define GLUS_OPTIMIZE_NO_VERTEX 0xFFFFFFFF
+
+extern GLUSboolean _glusWavefrontCacheContains(const GLUSvoid *cache,
+                                               const GLUSvoid *pointer);
+
+/**
+ * Sort key of a cluster of triangles.
+ */
+typedef struct _GLUSclusterkey {
+  GLUSfloat key;
+
+  GLUSuint cluster;
+
+} GLUSclusterkey;
+
+static GLUSboolean glusShapeCheckTrianglesf(const GLUSshape *shape) {
+  GLUSuint i;
+
+  if (!shape || !shape->vertices || !shape->indices ||
+      shape->mode != GLUS_TRIANGLES || shape->numberIndices % 3 != 0) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberIndices; i++) {
+    if (shape->indices[i] >= shape->numberVertices) {
+      return GLUS_FALSE;
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+// A vertex is in the FIFO cache, if it was one of the last cacheSize misses.
+// So a time stamp per vertex is enough to simulate the cache. Increasing the
+// time stamp by more than the cache size empties the cache.
+static GLUSuint glusShapeUpdateCachef(GLUSuint *cacheTimes, GLUSuint *timestamp,
+                                      const GLUSuint cacheSize,
+                                      const GLUSuint vertex) {
+  if (*timestamp - cacheTimes[vertex] > cacheSize) {
+    cacheTimes[vertex] = (*timestamp)++;
+
+    return 1;
+  }
+
+  return 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeAnalyzeVertexCachef(const GLUSshape *shape,
+                                                      const GLUSuint cacheSize,
+                                                      GLUSfloat *acmr,
+                                                      GLUSfloat *atvr) {
+  GLUSuint *cacheTimes;
+
+  GLUSuint timestamp = cacheSize + 1;
+
+  GLUSuint misses = 0;
+  GLUSuint usedVertices = 0;
+
+  GLUSuint i;
+
+  if (!glusShapeCheckTrianglesf(shape) || cacheSize == 0) {
+    return GLUS_FALSE;
+  }
+
+  cacheTimes =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+
+  if (!cacheTimes) {
+    return GLUS_FALSE;
+  }
+
+  memset(cacheTimes, 0, shape->numberVertices * sizeof(GLUSuint));
+
+  for (i = 0; i < shape->numberIndices; i++) {
+    // A vertex, which was never transformed, has a time stamp of zero.
+    if (cacheTimes[shape->indices[i]] == 0) {
+      usedVertices++;
+    }
+
+    misses += glusShapeUpdateCachef(cacheTimes, &timestamp, cacheSize,
+                                    shape->indices[i]);
+  }
+
+  glusMemoryFree(cacheTimes);
+
+  if (acmr) {
+    *acmr = shape->numberIndices > 0
+                ? (GLUSfloat)misses / (GLUSfloat)(shape->numberIndices / 3)
+                : 0.0f;
+  }
+
+  if (atvr) {
+    *atvr =
+        usedVertices > 0 ? (GLUSfloat)misses / (GLUSfloat)usedVertices : 0.0f;
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSvoid glusShapeLogVertexCachef(const GLUSshape *shape,
+                                         const GLUSuint cacheSize,
+                                         const char *step) {
+  GLUSfloat acmr;
+  GLUSfloat atvr;
+
+  if (glusLogGetLevel() < GLUS_LOG_DEBUG) {
+    return;
+  }
+
+  if (glusShapeAnalyzeVertexCachef(shape, cacheSize, &acmr, &atvr)) {
+    glusLogPrint(GLUS_LOG_DEBUG, "Vertex cache %s: ACMR %.3f ATVR %.3f", step,
+                 acmr, atvr);
+  }
+}
+
+// Returns the vertex with the most recent cache entry, which still stays in
+// the cache while its remaining triangles are emitted. Without one, the last
+// used vertices and then all vertices are searched for remaining triangles.
+static GLUSuint glusShapeGetNextVertexf(
+    const GLUSuint *candidates, const GLUSuint numberCandidates,
+    const GLUSuint *live, const GLUSuint *cacheTimes, const GLUSuint timestamp,
+    const GLUSuint cacheSize, GLUSuint *deadEnds, GLUSuint *numberDeadEnds,
+    GLUSuint *cursor, const GLUSuint numberVertices) {
+  GLUSuint nextVertex = GLUS_OPTIMIZE_NO_VERTEX;
+
+  GLUSint maxPriority = -1;
+
+  GLUSuint i;
+
+  for (i = 0; i < numberCandidates; i++) {
+    GLUSuint vertex = candidates[i];
+
+    GLUSint priority;
+
+    if (live[vertex] == 0) {
+      continue;
+    }
+
+    priority = 0;
+
+    if (timestamp - cacheTimes[vertex] + 2 * live[vertex] <= cacheSize) {
+      priority = (GLUSint)(timestamp - cacheTimes[vertex]);
+    }
+
+    if (priority > maxPriority) {
+      maxPriority = priority;
+
+      nextVertex = vertex;
+    }
+  }
+
+  if (nextVertex != GLUS_OPTIMIZE_NO_VERTEX) {
+    return nextVertex;
+  }
+
+  while (*numberDeadEnds > 0) {
+    GLUSuint vertex = deadEnds[--(*numberDeadEnds)];
+
+    if (live[vertex] > 0) {
+      return vertex;
+    }
+  }
+
+  while (*cursor < numberVertices) {
+    if (live[*cursor] > 0) {
+      return *cursor;
+    }
+
+    (*cursor)++;
+  }
+
+  return GLUS_OPTIMIZE_NO_VERTEX;
+}
+
+// Emits the triangles around a vertex and continues with a vertex, whose
+// triangles are likely in the cache.
+static GLUSboolean glusShapeTipsifyf(const GLUSshape *shape,
+                                     const GLUSuint cacheSize,
+                                     const GLUSuint *firstTriangle,
+                                     const GLUSuint *triangles, GLUSuint *live,
+                                     GLUSuint *cacheTimes, GLUSuint *deadEnds,
+                                     GLUSubyte *emitted, GLUSindex *indices) {
+  GLUSuint *candidates;
+
+  GLUSuint numberDeadEnds = 0;
+  GLUSuint numberCandidates;
+  GLUSuint numberOptimized = 0;
+
+  GLUSuint maxLive = 0;
+
+  GLUSuint timestamp = cacheSize + 1;
+
+  GLUSuint cursor = 0;
+
+  GLUSuint vertex = 0;
+
+  GLUSuint i, k;
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    if (live[i] > maxLive) {
+      maxLive = live[i];
+    }
+  }
+
+  // The vertices of the triangles emitted around one vertex are the
+  // candidates for the next one.
+  candidates =
+      (GLUSuint *)glusMemoryMalloc((3 * maxLive + 1) * sizeof(GLUSuint));
+
+  if (!candidates) {
+    return GLUS_FALSE;
+  }
+
+  memset(cacheTimes, 0, shape->numberVertices * sizeof(GLUSuint));
+  memset(emitted, 0, (shape->numberIndices / 3) * sizeof(GLUSubyte));
+
+  while (vertex != GLUS_OPTIMIZE_NO_VERTEX) {
+    numberCandidates = 0;
+
+    for (i = firstTriangle[vertex]; i < firstTriangle[vertex + 1]; i++) {
+      GLUSuint triangle = triangles[i];
+
+      if (emitted[triangle]) {
+        continue;
+      }
+
+      for (k = 0; k < 3; k++) {
+        GLUSuint current = shape->indices[3 * triangle + k];
+
+        indices[numberOptimized++] = (GLUSindex)current;
+
+        deadEnds[numberDeadEnds++] = current;
+
+        candidates[numberCandidates++] = current;
+
+        live[current]--;
+
+        glusShapeUpdateCachef(cacheTimes, &timestamp, cacheSize, current);
+      }
+
+      emitted[triangle] = GLUS_TRUE;
+    }
+
+    vertex = glusShapeGetNextVertexf(
+        candidates, numberCandidates, live, cacheTimes, timestamp, cacheSize,
+        deadEnds, &numberDeadEnds, &cursor, shape->numberVertices);
+  }
+
+  glusMemoryFree(candidates);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeOptimizeVertexCachef(
+    GLUSshape *shape, const GLUSuint cacheSize) {
+  GLUSuint *firstTriangle;
+  GLUSuint *triangles;
+  GLUSuint *live;
+  GLUSuint *cacheTimes;
+  GLUSuint *deadEnds;
+  GLUSubyte *emitted;
+  GLUSindex *indices;
+
+  GLUSshape optimizedShape;
+
+  GLUSfloat inputAcmr;
+  GLUSfloat optimizedAcmr;
+
+  GLUSboolean result = GLUS_FALSE;
+
+  GLUSuint i;
+
+  if (!glusShapeCheckTrianglesf(shape) || cacheSize == 0) {
+    return GLUS_FALSE;
+  }
+
+  if (shape->numberIndices == 0) {
+    return GLUS_TRUE;
+  }
+
+  glusShapeLogVertexCachef(shape, cacheSize, "before");
+
+  firstTriangle = (GLUSuint *)glusMemoryMalloc((shape->numberVertices + 1) *
+                                               sizeof(GLUSuint));
+  triangles =
+      (GLUSuint *)glusMemoryMalloc(shape->numberIndices * sizeof(GLUSuint));
+  live =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+  cacheTimes =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+  deadEnds =
+      (GLUSuint *)glusMemoryMalloc(shape->numberIndices * sizeof(GLUSuint));
+  emitted = (GLUSubyte *)glusMemoryMalloc((shape->numberIndices / 3) *
+                                          sizeof(GLUSubyte));
+  indices =
+      (GLUSindex *)glusMemoryMalloc(shape->numberIndices * sizeof(GLUSindex));
+
+  if (firstTriangle && triangles && live && cacheTimes && deadEnds &&
+      emitted && indices) {
+    // The triangles of every vertex are stored one after another. The number
+    // of triangles, which are not emitted yet, is counted per vertex.
+
+    memset(live, 0, shape->numberVertices * sizeof(GLUSuint));
+
+    for (i = 0; i < shape->numberIndices; i++) {
+      live[shape->indices[i]]++;
+    }
+
+    firstTriangle[0] = 0;
+
+    for (i = 0; i < shape->numberVertices; i++) {
+      firstTriangle[i + 1] = firstTriangle[i] + live[i];
+    }
+
+    for (i = 0; i < shape->numberIndices; i++) {
+      triangles[firstTriangle[shape->indices[i]]++] = i / 3;
+    }
+
+    for (i = shape->numberVertices; i > 0; i--) {
+      firstTriangle[i] = firstTriangle[i - 1];
+    }
+
+    firstTriangle[0] = 0;
+
+    result = glusShapeTipsifyf(shape, cacheSize, firstTriangle, triangles,
+                               live, cacheTimes, deadEnds, emitted, indices);
+  }
+
+  if (result) {
+    // Tipsify is a heuristic, so an input, which already uses the cache well,
+    // can get worse. In this case, the input order is kept.
+    optimizedShape = *shape;
+    optimizedShape.indices = indices;
+
+    result = glusShapeAnalyzeVertexCachef(shape, cacheSize, &inputAcmr, 0) &&
+             glusShapeAnalyzeVertexCachef(&optimizedShape, cacheSize,
+                                          &optimizedAcmr, 0);
+  }
+
+  if (result) {
+    if (optimizedAcmr < inputAcmr) {
+      memcpy(shape->indices, indices,
+             shape->numberIndices * sizeof(GLUSindex));
+
+      glusShapeLogVertexCachef(shape, cacheSize, "after");
+    } else {
+      glusLogPrint(GLUS_LOG_DEBUG,
+                   "Vertex cache: Input order kept, ACMR %.3f instead of %.3f",
+                   inputAcmr, optimizedAcmr);
+    }
+  }
+
+  glusMemoryFree(firstTriangle);
+  glusMemoryFree(triangles);
+  glusMemoryFree(live);
+  glusMemoryFree(cacheTimes);
+  glusMemoryFree(deadEnds);
+  glusMemoryFree(emitted);
+  glusMemoryFree(indices);
+
+  return result;
+}
+
+// Splits the triangles into clusters. A cluster starts, where the cache does
+// not help, i.e. all vertices of a triangle are misses. These clusters are
+// split again, as soon as the miss ratio so far is good enough.
+static GLUSuint glusShapeGetClustersf(const GLUSshape *shape,
+                                      const GLUSuint cacheSize,
+                                      const GLUSfloat threshold,
+                                      GLUSuint *cacheTimes,
+                                      GLUSuint *hardClusters,
+                                      GLUSuint *clusters) {
+  GLUSuint numberTriangles = shape->numberIndices / 3;
+
+  GLUSuint numberHardClusters = 0;
+  GLUSuint numberClusters = 0;
+
+  GLUSuint timestamp = cacheSize + 1;
+
+  GLUSuint i, k, triangle;
+
+  memset(cacheTimes, 0, shape->numberVertices * sizeof(GLUSuint));
+
+  for (triangle = 0; triangle < numberTriangles; triangle++) {
+    GLUSuint misses = 0;
+
+    for (k = 0; k < 3; k++) {
+      misses += glusShapeUpdateCachef(cacheTimes, &timestamp, cacheSize,
+                                      shape->indices[3 * triangle + k]);
+    }
+
+    if (triangle == 0 || misses == 3) {
+      hardClusters[numberHardClusters++] = triangle;
+    }
+  }
+
+  hardClusters[numberHardClusters] = numberTriangles;
+
+  for (i = 0; i < numberHardClusters; i++) {
+    GLUSuint first = hardClusters[i];
+    GLUSuint last = hardClusters[i + 1];
+
+    GLUSuint misses = 0;
+    GLUSuint runningMisses = 0;
+    GLUSuint runningTriangles = 0;
+
+    GLUSfloat clusterThreshold;
+
+    // Empty the cache.
+    timestamp += cacheSize + 1;
+
+    for (triangle = first; triangle < last; triangle++) {
+      for (k = 0; k < 3; k++) {
+        misses += glusShapeUpdateCachef(cacheTimes, &timestamp, cacheSize,
+                                        shape->indices[3 * triangle + k]);
+      }
+    }
+
+    clusterThreshold =
+        threshold * (GLUSfloat)misses / (GLUSfloat)(last - first);
+
+    clusters[numberClusters++] = first;
+
+    timestamp += cacheSize + 1;
+
+    for (triangle = first; triangle < last; triangle++) {
+      for (k = 0; k < 3; k++) {
+        runningMisses +=
+            glusShapeUpdateCachef(cacheTimes, &timestamp, cacheSize,
+                                  shape->indices[3 * triangle + k]);
+      }
+
+      runningTriangles++;
+
+      if (triangle + 1 < last &&
+          (GLUSfloat)runningMisses / (GLUSfloat)runningTriangles <=
+              clusterThreshold) {
+        clusters[numberClusters++] = triangle + 1;
+
+        timestamp += cacheSize + 1;
+
+        runningMisses = 0;
+        runningTriangles = 0;
+      }
+    }
+  }
+
+  clusters[numberClusters] = numberTriangles;
+
+  return numberClusters;
+}
+
+// Clusters facing away from the center of the shape are sorted first.
+static int glusShapeCompareClustersf(const void *a, const void *b) {
+  const GLUSclusterkey *keyA = (const GLUSclusterkey *)a;
+  const GLUSclusterkey *keyB = (const GLUSclusterkey *)b;
+
+  if (keyA->key != keyB->key) {
+    return keyA->key > keyB->key ? -1 : 1;
+  }
+
+  return keyA->cluster < keyB->cluster ? -1 : 1;
+}
+
+static GLUSvoid glusShapeGetClusterKeyf(GLUSclusterkey *clusterKey,
+                                        const GLUSshape *shape,
+                                        const GLUSuint first,
+                                        const GLUSuint last,
+                                        const GLUSfloat meshCenter[3]) {
+  GLUSfloat normal[3] = {0.0f, 0.0f, 0.0f};
+  GLUSfloat center[3] = {0.0f, 0.0f, 0.0f};
+  GLUSfloat average[3] = {0.0f, 0.0f, 0.0f};
+
+  GLUSfloat area = 0.0f;
+
+  GLUSfloat length;
+
+  GLUSuint triangle, k;
+
+  // The center and normal of the cluster are weighted by the triangle area.
+  for (triangle = first; triangle < last; triangle++) {
+    const GLUSfloat *p0 = &shape->vertices[4 * shape->indices[3 * triangle]];
+    const GLUSfloat *p1 =
+        &shape->vertices[4 * shape->indices[3 * triangle + 1]];
+    const GLUSfloat *p2 =
+        &shape->vertices[4 * shape->indices[3 * triangle + 2]];
+
+    GLUSfloat edge0[3];
+    GLUSfloat edge1[3];
+    GLUSfloat cross[3];
+
+    GLUSfloat triangleArea;
+
+    glusVector3SubtractVector3f(edge0, p1, p0);
+    glusVector3SubtractVector3f(edge1, p2, p0);
+
+    glusVector3Crossf(cross, edge0, edge1);
+
+    triangleArea = glusVector3Lengthf(cross);
+
+    for (k = 0; k < 3; k++) {
+      normal[k] += cross[k];
+
+      center[k] += triangleArea * (p0[k] + p1[k] + p2[k]) / 3.0f;
+
+      average[k] += (p0[k] + p1[k] + p2[k]) / 3.0f;
+    }
+
+    area += triangleArea;
+  }
+
+  for (k = 0; k < 3; k++) {
+    if (area > 0.0f) {
+      center[k] = center[k] / area - meshCenter[k];
+    } else {
+      center[k] = average[k] / (GLUSfloat)(last - first) - meshCenter[k];
+    }
+  }
+
+  length = glusVector3Lengthf(normal);
+
+  clusterKey->key = length > 0.0f ? glusVector3Dotf(center, normal) / length
+                                  : 0.0f;
+}
+
+// Writes the triangles of the clusters in the order of their sort keys.
+static GLUSboolean glusShapeSortClustersf(const GLUSshape *shape,
+                                          const GLUSuint *clusters,
+                                          const GLUSuint numberClusters,
+                                          GLUSindex *indices) {
+  GLUSclusterkey *clusterKeys;
+
+  GLUSuint numberOptimized = 0;
+
+  GLUSfloat meshCenter[3] = {0.0f, 0.0f, 0.0f};
+
+  GLUSuint i, k;
+
+  clusterKeys = (GLUSclusterkey *)glusMemoryMalloc(numberClusters *
+                                                   sizeof(GLUSclusterkey));
+
+  if (!clusterKeys) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    for (k = 0; k < 3; k++) {
+      meshCenter[k] += shape->vertices[4 * i + k];
+    }
+  }
+
+  for (k = 0; k < 3; k++) {
+    meshCenter[k] /= (GLUSfloat)shape->numberVertices;
+  }
+
+  for (i = 0; i < numberClusters; i++) {
+    clusterKeys[i].cluster = i;
+
+    glusShapeGetClusterKeyf(&clusterKeys[i], shape, clusters[i],
+                            clusters[i + 1], meshCenter);
+  }
+
+  qsort(clusterKeys, numberClusters, sizeof(GLUSclusterkey),
+        glusShapeCompareClustersf);
+
+  for (i = 0; i < numberClusters; i++) {
+    GLUSuint cluster = clusterKeys[i].cluster;
+
+    GLUSuint numberIndices = 3 * (clusters[cluster + 1] - clusters[cluster]);
+
+    memcpy(&indices[numberOptimized], &shape->indices[3 * clusters[cluster]],
+           numberIndices * sizeof(GLUSindex));
+
+    numberOptimized += numberIndices;
+  }
+
+  glusMemoryFree(clusterKeys);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeOptimizeOverdrawf(
+    GLUSshape *shape, const GLUSuint cacheSize, const GLUSfloat threshold) {
+  GLUSuint numberTriangles;
+
+  GLUSuint *cacheTimes;
+  GLUSuint *hardClusters;
+  GLUSuint *clusters;
+  GLUSindex *indices;
+
+  GLUSuint numberClusters;
+
+  GLUSboolean result = GLUS_FALSE;
+
+  if (!glusShapeCheckTrianglesf(shape) || cacheSize == 0 ||
+      !(threshold >= 1.0f)) {
+    return GLUS_FALSE;
+  }
+
+  numberTriangles = shape->numberIndices / 3;
+
+  if (numberTriangles == 0) {
+    return GLUS_TRUE;
+  }
+
+  glusShapeLogVertexCachef(shape, cacheSize, "before");
+
+  cacheTimes =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+  hardClusters =
+      (GLUSuint *)glusMemoryMalloc((numberTriangles + 1) * sizeof(GLUSuint));
+  clusters =
+      (GLUSuint *)glusMemoryMalloc((numberTriangles + 1) * sizeof(GLUSuint));
+  indices =
+      (GLUSindex *)glusMemoryMalloc(shape->numberIndices * sizeof(GLUSindex));
+
+  if (cacheTimes && hardClusters && clusters && indices) {
+    numberClusters = glusShapeGetClustersf(shape, cacheSize, threshold,
+                                           cacheTimes, hardClusters, clusters);
+
+    result = glusShapeSortClustersf(shape, clusters, numberClusters, indices);
+  }
+
+  if (result) {
+    memcpy(shape->indices, indices, shape->numberIndices * sizeof(GLUSindex));
+
+    glusShapeLogVertexCachef(shape, cacheSize, "after");
+  }
+
+  glusMemoryFree(cacheTimes);
+  glusMemoryFree(hardClusters);
+  glusMemoryFree(clusters);
+  glusMemoryFree(indices);
+
+  return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeOptimizeVertexFetchf(GLUSshape *shape) {
+  GLUSfloat **attributes[6];
+  GLUSuint components[6];
+  GLUSfloat *reordered[6];
+
+  GLUSuint *remap;
+
+  GLUSuint numberReordered = 0;
+
+  GLUSboolean result = GLUS_TRUE;
+
+  GLUSuint i, k;
+
+  if (!glusShapeCheckTrianglesf(shape)) {
+    return GLUS_FALSE;
+  }
+
+  if (shape->numberVertices == 0) {
+    return GLUS_TRUE;
+  }
+
+  attributes[0] = &shape->vertices;
+  attributes[1] = &shape->normals;
+  attributes[2] = &shape->tangents;
+  attributes[3] = &shape->bitangents;
+  attributes[4] = &shape->texCoords;
+  attributes[5] = &shape->allAttributes;
+
+  components[0] = 4;
+  components[1] = 3;
+  components[2] = 3;
+  components[3] = 3;
+  components[4] = 2;
+  components[5] = 15;
+
+  remap =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+
+  if (!remap) {
+    result = GLUS_FALSE;
+  }
+
+  // All arrays are allocated first, so the shape stays unchanged on failure.
+  for (k = 0; k < 6; k++) {
+    reordered[k] = 0;
+
+    if (*attributes[k] && result) {
+      reordered[k] = (GLUSfloat *)glusMemoryMalloc(
+          components[k] * shape->numberVertices * sizeof(GLUSfloat));
+
+      if (!reordered[k]) {
+        result = GLUS_FALSE;
+      }
+    }
+  }
+
+  if (!result) {
+    for (k = 0; k < 6; k++) {
+      glusMemoryFree(reordered[k]);
+    }
+
+    glusMemoryFree(remap);
+
+    return GLUS_FALSE;
+  }
+
+  memset(remap, 0xFF, shape->numberVertices * sizeof(GLUSuint));
+
+  for (i = 0; i < shape->numberIndices; i++) {
+    if (remap[shape->indices[i]] == GLUS_OPTIMIZE_NO_VERTEX) {
+      remap[shape->indices[i]] = numberReordered++;
+    }
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    if (remap[i] == GLUS_OPTIMIZE_NO_VERTEX) {
+      remap[i] = numberReordered++;
+    }
+  }
+
+  for (k = 0; k < 6; k++) {
+    if (!reordered[k]) {
+      continue;
+    }
+
+    for (i = 0; i < shape->numberVertices; i++) {
+      memcpy(&reordered[k][components[k] * remap[i]],
+             &(*attributes[k])[components[k] * i],
+             components[k] * sizeof(GLUSfloat));
+    }
+
+    // Attributes inside the cache file are released with it.
+    if (!_glusWavefrontCacheContains(shape->cache, *attributes[k])) {
+      glusMemoryFree(*attributes[k]);
+    }
+
+    *attributes[k] = reordered[k];
+  }
+
+  for (i = 0; i < shape->numberIndices; i++) {
+    shape->indices[i] = (GLUSindex)remap[shape->indices[i]];
+  }
+
+  glusMemoryFree(remap);
+
+  return GLUS_TRUE;
+}
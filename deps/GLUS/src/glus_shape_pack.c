@@ -0,0 +1,465 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+// Largest value of a normalized short and unsigned short.
+#define GLUS_PACK_SHORT_MAX 32767
+#define GLUS_PACK_USHORT_MAX 65535
+
+// Half float of 1.0.
+#define GLUS_PACK_HALF_ONE 0x3C00
+
+static GLUSfloat glusPackSignf(const GLUSfloat value) {
+  return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Octahedral encoding, where the second value is a multiple of step. So the
+// lowest bit can store something else.
+static GLUSvoid glusPackOctahedralStepf(GLUSshort packed[2],
+                                        const GLUSfloat vector[3],
+                                        const GLUSint step) {
+  GLUSfloat sum = fabsf(vector[0]) + fabsf(vector[1]) + fabsf(vector[2]);
+
+  GLUSfloat u, v;
+
+  GLUSfloat normalized[3];
+
+  GLUSfloat bestDot = -2.0f;
+
+  GLUSint baseU, baseV;
+
+  GLUSint i, k;
+
+  packed[0] = 0;
+  packed[1] = 0;
+
+  if (sum == 0.0f) {
+    return;
+  }
+
+  u = vector[0] / sum;
+  v = vector[1] / sum;
+
+  // The lower half is folded over the diagonals.
+  if (vector[2] < 0.0f) {
+    GLUSfloat foldedU = (1.0f - fabsf(v)) * glusPackSignf(u);
+    GLUSfloat foldedV = (1.0f - fabsf(u)) * glusPackSignf(v);
+
+    u = foldedU;
+    v = foldedV;
+  }
+
+  glusVector3Copyf(normalized, vector);
+  glusVector3Normalizef(normalized);
+
+  baseU = (GLUSint)floorf(u * (GLUSfloat)GLUS_PACK_SHORT_MAX);
+  baseV = step * (GLUSint)floorf(v * (GLUSfloat)GLUS_PACK_SHORT_MAX /
+                                 (GLUSfloat)step);
+
+  // Rounding to nearest is not the best for the decoded vector, so all four
+  // neighbours are tried.
+  for (i = 0; i < 2; i++) {
+    for (k = 0; k < 2; k++) {
+      GLUSshort candidate[2];
+
+      GLUSfloat decoded[3];
+
+      GLUSfloat dot;
+
+      GLUSint maxV = GLUS_PACK_SHORT_MAX / step * step;
+
+      GLUSint valueU = baseU + i;
+      GLUSint valueV = baseV + k * step;
+
+      valueU = valueU > GLUS_PACK_SHORT_MAX ? GLUS_PACK_SHORT_MAX : valueU;
+      valueU = valueU < -GLUS_PACK_SHORT_MAX ? -GLUS_PACK_SHORT_MAX : valueU;
+      valueV = valueV > maxV ? maxV : valueV;
+      valueV = valueV < -maxV ? -maxV : valueV;
+
+      candidate[0] = (GLUSshort)valueU;
+      candidate[1] = (GLUSshort)valueV;
+
+      glusUnpackOctahedralf(decoded, candidate);
+
+      dot = glusVector3Dotf(decoded, normalized);
+
+      if (dot > bestDot) {
+        bestDot = dot;
+
+        packed[0] = candidate[0];
+        packed[1] = candidate[1];
+      }
+    }
+  }
+}
+
+GLUSvoid GLUSAPIENTRY glusPackOctahedralf(GLUSshort packed[2],
+                                          const GLUSfloat vector[3]) {
+  glusPackOctahedralStepf(packed, vector, 1);
+}
+
+GLUSvoid GLUSAPIENTRY glusUnpackOctahedralf(GLUSfloat vector[3],
+                                            const GLUSshort packed[2]) {
+  GLUSfloat u = (GLUSfloat)packed[0] / (GLUSfloat)GLUS_PACK_SHORT_MAX;
+  GLUSfloat v = (GLUSfloat)packed[1] / (GLUSfloat)GLUS_PACK_SHORT_MAX;
+
+  u = u < -1.0f ? -1.0f : u;
+  v = v < -1.0f ? -1.0f : v;
+
+  vector[2] = 1.0f - fabsf(u) - fabsf(v);
+
+  if (vector[2] < 0.0f) {
+    vector[0] = (1.0f - fabsf(v)) * glusPackSignf(u);
+    vector[1] = (1.0f - fabsf(u)) * glusPackSignf(v);
+  } else {
+    vector[0] = u;
+    vector[1] = v;
+  }
+
+  glusVector3Normalizef(vector);
+}
+
+// Angle in degrees between two vectors, which do not need to be normalized.
+static GLUSfloat glusPackGetAnglef(const GLUSfloat vector0[3],
+                                   const GLUSfloat vector1[3]) {
+  GLUSfloat lengths = glusVector3Lengthf(vector0) * glusVector3Lengthf(vector1);
+
+  if (lengths == 0.0f) {
+    return 0.0f;
+  }
+
+  return glusMathRadToDegf(acosf(glusMathClampf(
+      glusVector3Dotf(vector0, vector1) / lengths, -1.0f, 1.0f)));
+}
+
+static GLUSvoid glusPackPositionf(GLUSpackedshape *packedShape,
+                                  GLUSubyte *attributes,
+                                  const GLUSfloat *position) {
+  GLUSushort values[4];
+
+  GLUSuint k;
+
+  if (packedShape->positionType == GLUS_HALF_FLOAT) {
+    for (k = 0; k < 3; k++) {
+      values[k] = glusMathFloatToHalff(position[k]);
+    }
+
+    values[3] = GLUS_PACK_HALF_ONE;
+  } else {
+    for (k = 0; k < 3; k++) {
+      GLUSfloat value = 0.0f;
+
+      if (packedShape->positionScale[k] > 0.0f) {
+        value = (position[k] - packedShape->positionBias[k]) /
+                packedShape->positionScale[k];
+      }
+
+      values[k] = (GLUSushort)glusMathClampf(
+          floorf(value + 0.5f), 0.0f, (GLUSfloat)GLUS_PACK_USHORT_MAX);
+    }
+
+    values[3] = GLUS_PACK_USHORT_MAX;
+  }
+
+  memcpy(attributes, values, sizeof(values));
+}
+
+// Packs one vertex and updates the errors.
+static GLUSvoid glusPackVertexf(GLUSpackedshape *packedShape,
+                                const GLUSshape *shape, const GLUSuint vertex) {
+  GLUSubyte *attributes =
+      &packedShape->attributes[vertex * packedShape->stride];
+
+  GLUSfloat position[4];
+  GLUSfloat normal[3], tangent[3], bitangent[3];
+  GLUSfloat texCoord[2];
+
+  GLUSfloat difference[3];
+
+  GLUSfloat error;
+
+  GLUSuint k;
+
+  glusPackPositionf(packedShape, attributes, &shape->vertices[4 * vertex]);
+
+  if (packedShape->normalOffset) {
+    GLUSshort packed[2];
+
+    glusPackOctahedralf(packed, &shape->normals[3 * vertex]);
+
+    memcpy(&attributes[packedShape->normalOffset], packed, sizeof(packed));
+  }
+
+  if (packedShape->tangentOffset) {
+    GLUSshort packed[2];
+
+    glusPackOctahedralStepf(packed, &shape->tangents[3 * vertex], 2);
+
+    // The bitangent points to the other side, e.g. for mirrored texture
+    // coordinates.
+    if (shape->normals && shape->bitangents) {
+      glusVector3Crossf(bitangent, &shape->normals[3 * vertex],
+                        &shape->tangents[3 * vertex]);
+
+      if (glusVector3Dotf(bitangent, &shape->bitangents[3 * vertex]) < 0.0f) {
+        packed[1] |= 1;
+      }
+    }
+
+    memcpy(&attributes[packedShape->tangentOffset], packed, sizeof(packed));
+  }
+
+  if (packedShape->texCoordOffset) {
+    GLUSushort packed[2];
+
+    for (k = 0; k < 2; k++) {
+      packed[k] = glusMathFloatToHalff(shape->texCoords[2 * vertex + k]);
+    }
+
+    memcpy(&attributes[packedShape->texCoordOffset], packed, sizeof(packed));
+  }
+
+  // Errors
+
+  glusPackedShapeUnpackf(position, normal, tangent, bitangent, texCoord,
+                         packedShape, vertex);
+
+  glusVector3SubtractVector3f(difference, position,
+                              &shape->vertices[4 * vertex]);
+
+  error = glusVector3Lengthf(difference);
+
+  if (error > packedShape->maxPositionError) {
+    packedShape->maxPositionError = error;
+  }
+
+  if (packedShape->normalOffset) {
+    error = glusPackGetAnglef(normal, &shape->normals[3 * vertex]);
+
+    if (error > packedShape->maxNormalError) {
+      packedShape->maxNormalError = error;
+    }
+  }
+
+  if (packedShape->tangentOffset) {
+    error = glusPackGetAnglef(tangent, &shape->tangents[3 * vertex]);
+
+    if (error > packedShape->maxTangentError) {
+      packedShape->maxTangentError = error;
+    }
+  }
+
+  if (packedShape->normalOffset && packedShape->tangentOffset &&
+      shape->bitangents) {
+    error = glusPackGetAnglef(bitangent, &shape->bitangents[3 * vertex]);
+
+    if (error > packedShape->maxBitangentError) {
+      packedShape->maxBitangentError = error;
+    }
+  }
+
+  if (packedShape->texCoordOffset) {
+    for (k = 0; k < 2; k++) {
+      error = fabsf(texCoord[k] - shape->texCoords[2 * vertex + k]);
+
+      if (error > packedShape->maxTexCoordError) {
+        packedShape->maxTexCoordError = error;
+      }
+    }
+  }
+}
+
+GLUSboolean GLUSAPIENTRY glusShapePackf(GLUSpackedshape *packedShape,
+                                        const GLUSshape *shape,
+                                        const GLUSenum positionType,
+                                        const GLUSbitfield attributes) {
+  GLUSuint i, k;
+
+  if (!packedShape || !shape || !shape->vertices ||
+      (positionType != GLUS_HALF_FLOAT &&
+       positionType != GLUS_UNSIGNED_SHORT)) {
+    return GLUS_FALSE;
+  }
+
+  memset(packedShape, 0, sizeof(GLUSpackedshape));
+
+  packedShape->numberVertices = shape->numberVertices;
+  packedShape->positionType = positionType;
+
+  // Layout
+
+  packedShape->stride = 4 * sizeof(GLUSushort);
+
+  if ((attributes & GLUS_ATTRIBUTE_NORMALS) && shape->normals) {
+    packedShape->normalOffset = packedShape->stride;
+    packedShape->stride += 2 * sizeof(GLUSshort);
+  }
+
+  if ((attributes & GLUS_ATTRIBUTE_TANGENTS) && shape->tangents) {
+    packedShape->tangentOffset = packedShape->stride;
+    packedShape->stride += 2 * sizeof(GLUSshort);
+  }
+
+  if ((attributes & GLUS_ATTRIBUTE_TEXCOORDS) && shape->texCoords) {
+    packedShape->texCoordOffset = packedShape->stride;
+    packedShape->stride += 2 * sizeof(GLUSushort);
+  }
+
+  // Bounds of the normalized positions
+
+  if (positionType == GLUS_HALF_FLOAT) {
+    for (k = 0; k < 3; k++) {
+      packedShape->positionScale[k] = 1.0f;
+      packedShape->positionBias[k] = 0.0f;
+    }
+  } else if (shape->numberVertices > 0) {
+    GLUSfloat minimum[3], maximum[3];
+
+    glusVector3Copyf(minimum, shape->vertices);
+    glusVector3Copyf(maximum, shape->vertices);
+
+    for (i = 1; i < shape->numberVertices; i++) {
+      for (k = 0; k < 3; k++) {
+        minimum[k] = glusMathMinf(minimum[k], shape->vertices[4 * i + k]);
+        maximum[k] = glusMathMaxf(maximum[k], shape->vertices[4 * i + k]);
+      }
+    }
+
+    for (k = 0; k < 3; k++) {
+      packedShape->positionScale[k] =
+          (maximum[k] - minimum[k]) / (GLUSfloat)GLUS_PACK_USHORT_MAX;
+      packedShape->positionBias[k] = minimum[k];
+    }
+  }
+
+  packedShape->attributes = (GLUSubyte *)glusMemoryMalloc(
+      shape->numberVertices * packedShape->stride * sizeof(GLUSubyte));
+
+  if (!packedShape->attributes) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    glusPackVertexf(packedShape, shape, i);
+  }
+
+  glusLogPrint(GLUS_LOG_DEBUG,
+               "Packed %u vertices with %u bytes: position %g normal %g "
+               "tangent %g bitangent %g texture coordinate %g",
+               packedShape->numberVertices, packedShape->stride,
+               packedShape->maxPositionError, packedShape->maxNormalError,
+               packedShape->maxTangentError, packedShape->maxBitangentError,
+               packedShape->maxTexCoordError);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusPackedShapeUnpackf(
+    GLUSfloat position[4], GLUSfloat normal[3], GLUSfloat tangent[3],
+    GLUSfloat bitangent[3], GLUSfloat texCoord[2],
+    const GLUSpackedshape *packedShape, const GLUSuint vertex) {
+  const GLUSubyte *attributes;
+
+  GLUSfloat unpackedNormal[3], unpackedTangent[3];
+
+  GLUSfloat sign = 1.0f;
+
+  GLUSuint k;
+
+  if (!packedShape || !packedShape->attributes ||
+      vertex >= packedShape->numberVertices) {
+    return GLUS_FALSE;
+  }
+
+  attributes = &packedShape->attributes[vertex * packedShape->stride];
+
+  if (position) {
+    GLUSushort values[4];
+
+    memcpy(values, attributes, sizeof(values));
+
+    for (k = 0; k < 3; k++) {
+      GLUSfloat value = packedShape->positionType == GLUS_HALF_FLOAT
+                            ? glusMathHalfToFloatf(values[k])
+                            : (GLUSfloat)values[k];
+
+      position[k] =
+          packedShape->positionBias[k] + packedShape->positionScale[k] * value;
+    }
+
+    position[3] = 1.0f;
+  }
+
+  if (packedShape->normalOffset) {
+    GLUSshort packed[2];
+
+    memcpy(packed, &attributes[packedShape->normalOffset], sizeof(packed));
+
+    glusUnpackOctahedralf(unpackedNormal, packed);
+
+    if (normal) {
+      glusVector3Copyf(normal, unpackedNormal);
+    }
+  }
+
+  if (packedShape->tangentOffset) {
+    GLUSshort packed[2];
+
+    memcpy(packed, &attributes[packedShape->tangentOffset], sizeof(packed));
+
+    if (packed[1] & 1) {
+      sign = -1.0f;
+    }
+
+    packed[1] &= ~1;
+
+    glusUnpackOctahedralf(unpackedTangent, packed);
+
+    if (tangent) {
+      glusVector3Copyf(tangent, unpackedTangent);
+    }
+  }
+
+  if (bitangent && packedShape->normalOffset && packedShape->tangentOffset) {
+    glusVector3Crossf(bitangent, unpackedNormal, unpackedTangent);
+    glusVector3MultiplyScalarf(bitangent, bitangent, sign);
+  }
+
+  if (texCoord && packedShape->texCoordOffset) {
+    GLUSushort packed[2];
+
+    memcpy(packed, &attributes[packedShape->texCoordOffset], sizeof(packed));
+
+    for (k = 0; k < 2; k++) {
+      texCoord[k] = glusMathHalfToFloatf(packed[k]);
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusPackedShapeDestroyf(GLUSpackedshape *packedShape) {
+  if (!packedShape) {
+    return;
+  }
+
+  glusMemoryFree(packedShape->attributes);
+
+  memset(packedShape, 0, sizeof(GLUSpackedshape));
+}
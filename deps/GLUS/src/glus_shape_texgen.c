@@ -18,70 +18,133 @@
 
 #include "GL/glus.h"
 
-GLUSboolean GLUSAPIENTRY glusShapeTexGenByAxesf(
-    GLUSshape *shape, const GLUSfloat sSizeX, const GLUSfloat sSizeZ,
-    const GLUSfloat tSizeY, const GLUSfloat tSizeZ, const GLUSfloat sOffset,
-    const GLUSfloat tOffset) {
-  GLUSuint i;
-
-  if (!shape) {
-    return GLUS_FALSE;
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Number of vertices, from which on the texture coordinates are generated in
+// parallel.
+#define GLUS_TEXGEN_PARALLEL_VERTICES 65536
+
+extern GLUSboolean _glusWavefrontCacheContains(const GLUSvoid *cache,
+                                               const GLUSvoid *pointer);
+
+// Both generations are a scaled plane distance per texture coordinate. The
+// loop has no calls and only local constants, so it can be vectorized by the
+// compiler.
+static GLUSvoid glusShapeTexGenf(GLUSfloat *texCoords,
+                                 const GLUSfloat *vertices,
+                                 const GLUSuint numberVertices,
+                                 const GLUSfloat sPlane[4],
+                                 const GLUSfloat tPlane[4],
+                                 const GLUSfloat sSize, const GLUSfloat tSize,
+                                 const GLUSfloat sOffset,
+                                 const GLUSfloat tOffset) {
+  const GLUSfloat sX = sPlane[0];
+  const GLUSfloat sY = sPlane[1];
+  const GLUSfloat sZ = sPlane[2];
+  const GLUSfloat sD = sPlane[3];
+
+  const GLUSfloat tX = tPlane[0];
+  const GLUSfloat tY = tPlane[1];
+  const GLUSfloat tZ = tPlane[2];
+  const GLUSfloat tD = tPlane[3];
+
+  GLUSint i;
+
+#ifdef _OPENMP
+#pragma omp parallel for if (numberVertices >= GLUS_TEXGEN_PARALLEL_VERTICES)
+#endif
+  for (i = 0; i < (GLUSint)numberVertices; i++) {
+    GLUSfloat x = vertices[4 * i + 0];
+    GLUSfloat y = vertices[4 * i + 1];
+    GLUSfloat z = vertices[4 * i + 2];
+
+    texCoords[2 * i + 0] = (sX * x + sY * y + sZ * z + sD) * sSize + sOffset;
+    texCoords[2 * i + 1] = (tX * x + tY * y + tZ * z + tD) * tSize + tOffset;
   }
+}
 
-  if (shape->texCoords) {
-    glusMemoryFree(shape->texCoords);
-
+// Makes sure, that the shape has own texture coordinates, which can be
+// overwritten. Existing ones are reused.
+static GLUSboolean glusShapeTexGenPreparef(GLUSshape *shape) {
+  // Texture coordinates inside the cache file are released with it.
+  if (shape->texCoords &&
+      _glusWavefrontCacheContains(shape->cache, shape->texCoords)) {
     shape->texCoords = 0;
   }
 
-  shape->texCoords = (GLUSfloat *)glusMemoryMalloc(2 * shape->numberVertices *
-                                                   sizeof(GLUSfloat));
-
   if (!shape->texCoords) {
-    return GLUS_FALSE;
+    shape->texCoords = (GLUSfloat *)glusMemoryMalloc(
+        2 * shape->numberVertices * sizeof(GLUSfloat));
   }
 
-  for (i = 0; i < shape->numberVertices; i++) {
-    shape->texCoords[2 * i + 0] = shape->vertices[4 * i + 0] * sSizeX +
-                                  shape->vertices[4 * i + 2] * sSizeZ + sOffset;
-    shape->texCoords[2 * i + 1] = shape->vertices[4 * i + 1] * tSizeY +
-                                  shape->vertices[4 * i + 2] * tSizeZ + tOffset;
+  return shape->texCoords != 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeTexGenByAxesf(
+    GLUSshape *shape, const GLUSfloat sSizeX, const GLUSfloat sSizeZ,
+    const GLUSfloat tSizeY, const GLUSfloat tSizeZ, const GLUSfloat sOffset,
+    const GLUSfloat tOffset) {
+  if (!shape || !glusShapeTexGenPreparef(shape)) {
+    return GLUS_FALSE;
   }
 
-  return GLUS_TRUE;
+  return glusShapeTexGenByAxesToBufferf(shape->texCoords, shape, sSizeX,
+                                        sSizeZ, tSizeY, tSizeZ, sOffset,
+                                        tOffset);
 }
 
 GLUSboolean GLUSAPIENTRY glusShapeTexGenByPlanesf(
     GLUSshape *shape, const GLUSfloat sPlane[4], const GLUSfloat tPlane[4],
     const float sSize, const float tSize, const float sOffset,
     const float tOffset) {
-  GLUSuint i;
-
-  if (!shape) {
+  if (!shape || !glusShapeTexGenPreparef(shape)) {
     return GLUS_FALSE;
   }
 
-  if (shape->texCoords) {
-    glusMemoryFree(shape->texCoords);
+  return glusShapeTexGenByPlanesToBufferf(shape->texCoords, shape, sPlane,
+                                          tPlane, sSize, tSize, sOffset,
+                                          tOffset);
+}
 
-    shape->texCoords = 0;
+GLUSboolean GLUSAPIENTRY glusShapeTexGenByAxesToBufferf(
+    GLUSfloat *texCoords, const GLUSshape *shape, const GLUSfloat sSizeX,
+    const GLUSfloat sSizeZ, const GLUSfloat tSizeY, const GLUSfloat tSizeZ,
+    const GLUSfloat sOffset, const GLUSfloat tOffset) {
+  GLUSfloat sPlane[4];
+  GLUSfloat tPlane[4];
+
+  if (!texCoords || !shape || !shape->vertices) {
+    return GLUS_FALSE;
   }
 
-  shape->texCoords = (GLUSfloat *)glusMemoryMalloc(2 * shape->numberVertices *
-                                                   sizeof(GLUSfloat));
+  sPlane[0] = sSizeX;
+  sPlane[1] = 0.0f;
+  sPlane[2] = sSizeZ;
+  sPlane[3] = 0.0f;
 
-  if (!shape->texCoords) {
+  tPlane[0] = 0.0f;
+  tPlane[1] = tSizeY;
+  tPlane[2] = tSizeZ;
+  tPlane[3] = 0.0f;
+
+  glusShapeTexGenf(texCoords, shape->vertices, shape->numberVertices, sPlane,
+                   tPlane, 1.0f, 1.0f, sOffset, tOffset);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeTexGenByPlanesToBufferf(
+    GLUSfloat *texCoords, const GLUSshape *shape, const GLUSfloat sPlane[4],
+    const GLUSfloat tPlane[4], const GLUSfloat sSize, const GLUSfloat tSize,
+    const GLUSfloat sOffset, const GLUSfloat tOffset) {
+  if (!texCoords || !shape || !shape->vertices || !sPlane || !tPlane) {
     return GLUS_FALSE;
   }
 
-  for (i = 0; i < shape->numberVertices; i++) {
-    shape->texCoords[2 * i + 0] =
-        glusPlaneDistancePoint4f(sPlane, &shape->vertices[4 * i]) * sSize +
-        sOffset;
-    shape->texCoords[2 * i + 1] =
-        glusPlaneDistancePoint4f(tPlane, &shape->vertices[4 * i]) * tSize +
-        tOffset;
-  }
+  glusShapeTexGenf(texCoords, shape->vertices, shape->numberVertices, sPlane,
+                   tPlane, sSize, tSize, sOffset, tOffset);
 
   return GLUS_TRUE;
 }
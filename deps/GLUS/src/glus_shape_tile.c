@@ -0,0 +1,186 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+// Largest number of vertices of a tile, as the restart index can not be used.
+#define GLUS_TILE_MAX_VERTICES 65535
+
+GLUSboolean GLUSAPIENTRY glusShapeCreateTiledGridPlanef(
+    GLUStiledgrid *tiledGrid, const GLUSfloat horizontalExtend,
+    const GLUSfloat verticalExtend, const GLUSuint rows, const GLUSuint columns,
+    const GLUSuint tileRows, const GLUSuint tileColumns,
+    const GLUSboolean triangleStrip) {
+  GLUSuint i, currentRow, currentColumn;
+
+  GLUSuint numberVertices;
+  GLUSuint numberIndices;
+
+  GLUSuint numberTileRows;
+  GLUSuint numberTileColumns;
+
+  GLUSuint indexIndices;
+
+  if (!tiledGrid) {
+    return GLUS_FALSE;
+  }
+
+  if (rows < 1 || columns < 1 || tileRows < 1 || tileColumns < 1 ||
+      tileRows >= GLUS_TILE_MAX_VERTICES ||
+      tileColumns >= GLUS_TILE_MAX_VERTICES || rows % tileRows != 0 ||
+      columns % tileColumns != 0) {
+    return GLUS_FALSE;
+  }
+
+  if ((tileRows + 1) > GLUS_TILE_MAX_VERTICES / (tileColumns + 1)) {
+    return GLUS_FALSE;
+  }
+
+  numberVertices = (tileRows + 1) * (tileColumns + 1);
+
+  if (triangleStrip) {
+    // Every row is a strip, followed by the restart index except the last one.
+    numberIndices = tileRows * 2 * (tileColumns + 1) + (tileRows - 1);
+  } else {
+    numberIndices = tileRows * 6 * tileColumns;
+  }
+
+  numberTileRows = rows / tileRows;
+  numberTileColumns = columns / tileColumns;
+
+  if (numberTileRows > (GLUSuint)-1 / 4 / numberTileColumns) {
+    return GLUS_FALSE;
+  }
+
+  memset(tiledGrid, 0, sizeof(GLUStiledgrid));
+
+  tiledGrid->mode = triangleStrip ? GLUS_TRIANGLE_STRIP : GLUS_TRIANGLES;
+
+  tiledGrid->numberVertices = numberVertices;
+  tiledGrid->numberIndices = numberIndices;
+
+  tiledGrid->numberTileRows = numberTileRows;
+  tiledGrid->numberTileColumns = numberTileColumns;
+  tiledGrid->numberTiles = numberTileRows * numberTileColumns;
+
+  tiledGrid->vertices =
+      (GLUSfloat *)glusMemoryMalloc(4 * numberVertices * sizeof(GLUSfloat));
+  tiledGrid->texCoords =
+      (GLUSfloat *)glusMemoryMalloc(2 * numberVertices * sizeof(GLUSfloat));
+  tiledGrid->indices =
+      (GLUSushort *)glusMemoryMalloc(numberIndices * sizeof(GLUSushort));
+  tiledGrid->tileOffsets = (GLUSfloat *)glusMemoryMalloc(
+      4 * tiledGrid->numberTiles * sizeof(GLUSfloat));
+
+  if (!tiledGrid->vertices || !tiledGrid->texCoords || !tiledGrid->indices ||
+      !tiledGrid->tileOffsets) {
+    glusTiledGridDestroyf(tiledGrid);
+
+    return GLUS_FALSE;
+  }
+
+  // Same layout as a grid plane, but relative to the lower left corner.
+  for (i = 0; i < numberVertices; i++) {
+    currentColumn = i % (tileColumns + 1);
+    currentRow = i / (tileColumns + 1);
+
+    tiledGrid->vertices[i * 4 + 0] =
+        (GLUSfloat)((GLUSdouble)horizontalExtend * (GLUSdouble)currentColumn /
+                    (GLUSdouble)columns);
+    tiledGrid->vertices[i * 4 + 1] =
+        (GLUSfloat)((GLUSdouble)verticalExtend *
+                    (GLUSdouble)(tileRows - currentRow) / (GLUSdouble)rows);
+    tiledGrid->vertices[i * 4 + 2] = 0.0f;
+    tiledGrid->vertices[i * 4 + 3] = 1.0f;
+
+    tiledGrid->texCoords[i * 2 + 0] =
+        (GLUSfloat)((GLUSdouble)currentColumn / (GLUSdouble)columns);
+    tiledGrid->texCoords[i * 2 + 1] =
+        (GLUSfloat)((GLUSdouble)(tileRows - currentRow) / (GLUSdouble)rows);
+  }
+
+  indexIndices = 0;
+
+  if (triangleStrip) {
+    for (currentRow = 0; currentRow < tileRows; currentRow++) {
+      if (currentRow > 0) {
+        tiledGrid->indices[indexIndices++] = GLUS_TILE_RESTART_INDEX;
+      }
+
+      // Left to right, counter clock wise
+      for (currentColumn = 0; currentColumn <= tileColumns; currentColumn++) {
+        tiledGrid->indices[indexIndices++] =
+            (GLUSushort)(currentColumn + currentRow * (tileColumns + 1));
+        tiledGrid->indices[indexIndices++] =
+            (GLUSushort)(currentColumn + (currentRow + 1) * (tileColumns + 1));
+      }
+    }
+  } else {
+    for (i = 0; i < tileRows * tileColumns; i++) {
+      GLUSushort topLeft;
+      GLUSushort bottomLeft;
+
+      currentColumn = i % tileColumns;
+      currentRow = i / tileColumns;
+
+      topLeft = (GLUSushort)(currentColumn + currentRow * (tileColumns + 1));
+      bottomLeft = (GLUSushort)(topLeft + tileColumns + 1);
+
+      tiledGrid->indices[indexIndices++] = topLeft;
+      tiledGrid->indices[indexIndices++] = bottomLeft;
+      tiledGrid->indices[indexIndices++] = bottomLeft + 1;
+
+      tiledGrid->indices[indexIndices++] = bottomLeft + 1;
+      tiledGrid->indices[indexIndices++] = topLeft + 1;
+      tiledGrid->indices[indexIndices++] = topLeft;
+    }
+  }
+
+  // The lower left corners of the tiles.
+  for (i = 0; i < tiledGrid->numberTiles; i++) {
+    GLUSdouble s, t;
+
+    currentColumn = i % numberTileColumns;
+    currentRow = i / numberTileColumns;
+
+    s = (GLUSdouble)(currentColumn * tileColumns) / (GLUSdouble)columns;
+    t = 1.0 - (GLUSdouble)((currentRow + 1) * tileRows) / (GLUSdouble)rows;
+
+    tiledGrid->tileOffsets[i * 4 + 0] =
+        (GLUSfloat)((GLUSdouble)horizontalExtend * (s - 0.5));
+    tiledGrid->tileOffsets[i * 4 + 1] =
+        (GLUSfloat)((GLUSdouble)verticalExtend * (t - 0.5));
+    tiledGrid->tileOffsets[i * 4 + 2] = (GLUSfloat)s;
+    tiledGrid->tileOffsets[i * 4 + 3] = (GLUSfloat)t;
+  }
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusTiledGridDestroyf(GLUStiledgrid *tiledGrid) {
+  if (!tiledGrid) {
+    return;
+  }
+
+  glusMemoryFree(tiledGrid->vertices);
+  glusMemoryFree(tiledGrid->texCoords);
+  glusMemoryFree(tiledGrid->indices);
+  glusMemoryFree(tiledGrid->tileOffsets);
+
+  memset(tiledGrid, 0, sizeof(GLUStiledgrid));
+}
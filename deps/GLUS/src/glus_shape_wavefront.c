@@ -21,9 +21,45 @@
 extern GLUSboolean _glusWavefrontParse(const GLUSchar *filename,
                                        GLUSshape *shape,
                                        GLUSwavefront *wavefront,
-                                       GLUSscene *scene);
+                                       GLUSscene *scene,
+                                       const GLUSwavefrontoptions *options);
+
+extern GLUSboolean _glusWavefrontCacheLoadShape(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    GLUSshape *shape);
+
+extern GLUSvoid _glusWavefrontCacheSaveShape(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    const GLUSshape *shape);
 
 GLUSboolean GLUSAPIENTRY glusShapeLoadWavefront(const GLUSchar *filename,
                                                 GLUSshape *shape) {
-  return _glusWavefrontParse(filename, shape, 0, 0);
+  return glusShapeLoadWavefrontWithOptions(filename, shape, 0);
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontWithOptions(
+    const GLUSchar *filename, GLUSshape *shape,
+    const GLUSwavefrontoptions *options) {
+  GLUSwavefrontoptions defaultOptions;
+
+  if (!options) {
+    glusWavefrontInitOptions(&defaultOptions);
+
+    options = &defaultOptions;
+  }
+
+  if (options->cache && shape &&
+      _glusWavefrontCacheLoadShape(filename, options, shape)) {
+    return GLUS_TRUE;
+  }
+
+  if (!_glusWavefrontParse(filename, shape, 0, 0, options)) {
+    return GLUS_FALSE;
+  }
+
+  if (options->cache) {
+    _glusWavefrontCacheSaveShape(filename, options, shape);
+  }
+
+  return GLUS_TRUE;
 }
@@ -0,0 +1,590 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Below this number of vertices, starting threads costs more than it saves.
+#define GLUS_WELD_PARALLEL_VERTICES 16384
+
+// Marks an empty slot in the hash table.
+#define GLUS_WELD_NO_CELL 0xFFFFFFFF
+
+#define GLUS_WELD_MAX_COMPARED 4
+
+extern GLUSboolean _glusWavefrontCacheContains(const GLUSvoid *cache,
+                                               const GLUSvoid *pointer);
+
+/**
+ * A cell of the uniform grid. The vertices of a cell are stored one after
+ * another in ascending order.
+ */
+typedef struct _GLUSweldcell {
+  /**
+   * The coordinates of the cell.
+   */
+  GLUSint cell[3];
+
+  /**
+   * Index of the first vertex in the vertex list.
+   */
+  GLUSuint firstVertex;
+
+  /**
+   * Number of vertices in the cell.
+   */
+  GLUSuint numberVertices;
+
+} GLUSweldcell;
+
+/**
+ * Uniform grid over the vertex positions, addressed by a hash table.
+ */
+typedef struct _GLUSweldgrid {
+  const GLUSshape *shape;
+
+  GLUSfloat tolerance;
+
+  /**
+   * The attributes, which have to be equal as well.
+   */
+  const GLUSfloat *compared[GLUS_WELD_MAX_COMPARED];
+  GLUSuint comparedComponents[GLUS_WELD_MAX_COMPARED];
+  GLUSuint numberCompared;
+
+  GLUSfloat attributeTolerance;
+
+  /**
+   * The occupied cells in order of their first vertex.
+   */
+  GLUSweldcell *cells;
+  GLUSuint numberCells;
+  GLUSuint capacityCells;
+
+  /**
+   * Open addressing hash table with the indices of the cells.
+   */
+  GLUSuint *table;
+  GLUSuint tableMask;
+
+  /**
+   * The vertices of all cells.
+   */
+  GLUSuint *cellVertices;
+
+} GLUSweldgrid;
+
+static GLUSuint glusShapeWeldHashf(const GLUSint *cell) {
+  GLUSuint hash = ((GLUSuint)cell[0] * 0x9E3779B1u + (GLUSuint)cell[1]) *
+                      0x9E3779B1u +
+                  (GLUSuint)cell[2];
+
+  // Mix all bits, as the table is addressed by the lower bits.
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+// The cells are twice as large as the tolerance. So all vertices within the
+// tolerance are in the same cell or in the neighbouring one, which is closer.
+// Without a tolerance, the bits of the coordinates are the cell.
+static GLUSvoid glusShapeWeldGetCellf(GLUSint *cell, GLUSint *direction,
+                                      const GLUSfloat *vertex,
+                                      const GLUSfloat tolerance) {
+  GLUSuint i;
+
+  for (i = 0; i < 3; i++) {
+    double position;
+
+    double coordinate;
+
+    if (tolerance == 0.0f) {
+      // Adding zero turns -0.0 into 0.0, which is equal.
+      GLUSfloat value = vertex[i] + 0.0f;
+
+      memcpy(&cell[i], &value, sizeof(GLUSint));
+
+      direction[i] = 0;
+
+      continue;
+    }
+
+    position = (double)vertex[i] / (2.0 * (double)tolerance);
+
+    coordinate = floor(position);
+
+    direction[i] = position - coordinate < 0.5 ? -1 : 1;
+
+    // Clamping keeps neighbouring cells neighbours.
+    if (coordinate != coordinate) {
+      coordinate = 0.0;
+    } else if (coordinate < -1073741824.0) {
+      coordinate = -1073741824.0;
+    } else if (coordinate > 1073741824.0) {
+      coordinate = 1073741824.0;
+    }
+
+    cell[i] = (GLUSint)coordinate;
+  }
+}
+
+// Returns the slot of the cell or the empty slot, where it belongs.
+static GLUSuint glusShapeWeldFindSlotf(const GLUSweldgrid *grid,
+                                       const GLUSint *cell) {
+  GLUSuint slot = glusShapeWeldHashf(cell) & grid->tableMask;
+
+  while (grid->table[slot] != GLUS_WELD_NO_CELL) {
+    const GLUSweldcell *current = &grid->cells[grid->table[slot]];
+
+    if (current->cell[0] == cell[0] && current->cell[1] == cell[1] &&
+        current->cell[2] == cell[2]) {
+      break;
+    }
+
+    slot = (slot + 1) & grid->tableMask;
+  }
+
+  return slot;
+}
+
+static GLUSboolean glusShapeWeldGrowf(GLUSweldgrid *grid) {
+  GLUSuint capacity = (grid->tableMask + 1) * 2;
+
+  GLUSweldcell *cells;
+
+  GLUSuint i;
+
+  cells = (GLUSweldcell *)glusMemoryRealloc(
+      grid->cells, (capacity / 2) * sizeof(GLUSweldcell));
+
+  if (!cells) {
+    return GLUS_FALSE;
+  }
+
+  grid->cells = cells;
+  grid->capacityCells = capacity / 2;
+
+  glusMemoryFree(grid->table);
+
+  grid->table = (GLUSuint *)glusMemoryMalloc(capacity * sizeof(GLUSuint));
+
+  if (!grid->table) {
+    return GLUS_FALSE;
+  }
+
+  grid->tableMask = capacity - 1;
+
+  memset(grid->table, 0xFF, capacity * sizeof(GLUSuint));
+
+  for (i = 0; i < grid->numberCells; i++) {
+    grid->table[glusShapeWeldFindSlotf(grid, grid->cells[i].cell)] = i;
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSvoid glusShapeWeldDestroyGridf(GLUSweldgrid *grid) {
+  if (grid->cells) {
+    glusMemoryFree(grid->cells);
+
+    grid->cells = 0;
+  }
+
+  if (grid->table) {
+    glusMemoryFree(grid->table);
+
+    grid->table = 0;
+  }
+
+  if (grid->cellVertices) {
+    glusMemoryFree(grid->cellVertices);
+
+    grid->cellVertices = 0;
+  }
+}
+
+// Sorts all vertices into the cells. The cell of every vertex is stored in
+// vertexCells.
+static GLUSboolean glusShapeWeldInitGridf(GLUSweldgrid *grid,
+                                          GLUSuint *vertexCells) {
+  const GLUSshape *shape = grid->shape;
+
+  GLUSint cell[3];
+  GLUSint direction[3];
+
+  GLUSuint currentCell = GLUS_WELD_NO_CELL;
+
+  GLUSuint i;
+
+  grid->tableMask = 1023;
+  grid->capacityCells = 512;
+
+  grid->cells = (GLUSweldcell *)glusMemoryMalloc(grid->capacityCells *
+                                                 sizeof(GLUSweldcell));
+  grid->table =
+      (GLUSuint *)glusMemoryMalloc((grid->tableMask + 1) * sizeof(GLUSuint));
+  grid->cellVertices =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+
+  if (!grid->cells || !grid->table || !grid->cellVertices) {
+    return GLUS_FALSE;
+  }
+
+  memset(grid->table, 0xFF, (grid->tableMask + 1) * sizeof(GLUSuint));
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    GLUSuint slot;
+
+    glusShapeWeldGetCellf(cell, direction, &shape->vertices[4 * i],
+                          grid->tolerance);
+
+    // Neighbouring vertices are often in the same cell.
+    if (currentCell == GLUS_WELD_NO_CELL ||
+        grid->cells[currentCell].cell[0] != cell[0] ||
+        grid->cells[currentCell].cell[1] != cell[1] ||
+        grid->cells[currentCell].cell[2] != cell[2]) {
+      slot = glusShapeWeldFindSlotf(grid, cell);
+
+      if (grid->table[slot] == GLUS_WELD_NO_CELL) {
+        // The table is kept at most half full.
+        if (grid->numberCells == grid->capacityCells) {
+          if (!glusShapeWeldGrowf(grid)) {
+            return GLUS_FALSE;
+          }
+
+          slot = glusShapeWeldFindSlotf(grid, cell);
+        }
+
+        grid->cells[grid->numberCells].cell[0] = cell[0];
+        grid->cells[grid->numberCells].cell[1] = cell[1];
+        grid->cells[grid->numberCells].cell[2] = cell[2];
+        grid->cells[grid->numberCells].firstVertex = 0;
+        grid->cells[grid->numberCells].numberVertices = 0;
+
+        grid->table[slot] = grid->numberCells;
+
+        grid->numberCells++;
+      }
+
+      currentCell = grid->table[slot];
+    }
+
+    grid->cells[currentCell].numberVertices++;
+
+    vertexCells[i] = currentCell;
+  }
+
+  // The vertex lists of the cells follow each other.
+
+  currentCell = 0;
+
+  for (i = 0; i < grid->numberCells; i++) {
+    grid->cells[i].firstVertex = currentCell;
+
+    currentCell += grid->cells[i].numberVertices;
+  }
+
+  // The first vertex is used as a cursor and rewound afterwards.
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    grid->cellVertices[grid->cells[vertexCells[i]].firstVertex++] = i;
+  }
+
+  for (i = 0; i < grid->numberCells; i++) {
+    grid->cells[i].firstVertex -= grid->cells[i].numberVertices;
+  }
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusShapeWeldIsEqualf(const GLUSweldgrid *grid,
+                                         const GLUSuint index0,
+                                         const GLUSuint index1) {
+  const GLUSfloat *vertex0 = &grid->shape->vertices[4 * index0];
+  const GLUSfloat *vertex1 = &grid->shape->vertices[4 * index1];
+
+  GLUSuint i, k;
+
+  for (k = 0; k < 3; k++) {
+    if (!(vertex0[k] >= vertex1[k] - grid->tolerance &&
+          vertex0[k] <= vertex1[k] + grid->tolerance)) {
+      return GLUS_FALSE;
+    }
+  }
+
+  for (i = 0; i < grid->numberCompared; i++) {
+    GLUSuint components = grid->comparedComponents[i];
+
+    const GLUSfloat *attribute0 = &grid->compared[i][components * index0];
+    const GLUSfloat *attribute1 = &grid->compared[i][components * index1];
+
+    for (k = 0; k < components; k++) {
+      if (!(attribute0[k] >= attribute1[k] - grid->attributeTolerance &&
+            attribute0[k] <= attribute1[k] + grid->attributeTolerance)) {
+        return GLUS_FALSE;
+      }
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+// Returns the first earlier vertex, which is equal to the given vertex. If
+// representatives are given, only vertices, which have not been merged, are
+// accepted. Without a match, the vertex itself is returned.
+static GLUSuint glusShapeWeldFindVertexf(const GLUSweldgrid *grid,
+                                         const GLUSuint vertex,
+                                         const GLUSuint *representatives) {
+  GLUSint cell[3];
+  GLUSint direction[3];
+
+  GLUSint neighbour[3];
+
+  GLUSuint numberNeighbours = grid->tolerance == 0.0f ? 1 : 8;
+
+  GLUSuint result = vertex;
+
+  GLUSuint i, k;
+
+  glusShapeWeldGetCellf(cell, direction, &grid->shape->vertices[4 * vertex],
+                        grid->tolerance);
+
+  for (i = 0; i < numberNeighbours; i++) {
+    const GLUSweldcell *current;
+
+    GLUSuint slot;
+
+    neighbour[0] = cell[0] + ((i & 1) ? direction[0] : 0);
+    neighbour[1] = cell[1] + ((i & 2) ? direction[1] : 0);
+    neighbour[2] = cell[2] + ((i & 4) ? direction[2] : 0);
+
+    slot = glusShapeWeldFindSlotf(grid, neighbour);
+
+    if (grid->table[slot] == GLUS_WELD_NO_CELL) {
+      continue;
+    }
+
+    current = &grid->cells[grid->table[slot]];
+
+    // The vertices are in ascending order, so the first match is the first
+    // vertex of this cell.
+    for (k = 0; k < current->numberVertices; k++) {
+      GLUSuint candidate = grid->cellVertices[current->firstVertex + k];
+
+      if (candidate >= result) {
+        break;
+      }
+
+      if (representatives && representatives[candidate] != candidate) {
+        continue;
+      }
+
+      if (glusShapeWeldIsEqualf(grid, candidate, vertex)) {
+        result = candidate;
+
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+// Moves the welded vertices to the front. The new index of a vertex is never
+// larger than the old one, so this works in place.
+static GLUSvoid glusShapeWeldCompactf(GLUSshape *shape, GLUSfloat **attribute,
+                                      const GLUSuint components,
+                                      const GLUSuint *representatives,
+                                      const GLUSuint *remap,
+                                      const GLUSuint numberWelded) {
+  GLUSfloat *compacted;
+
+  GLUSuint i;
+
+  if (!*attribute) {
+    return;
+  }
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    if (representatives[i] == i && remap[i] != i) {
+      memcpy(&(*attribute)[components * remap[i]],
+             &(*attribute)[components * i], components * sizeof(GLUSfloat));
+    }
+  }
+
+  // Attributes inside the cache file keep their size.
+  if (_glusWavefrontCacheContains(shape->cache, *attribute)) {
+    return;
+  }
+
+  compacted = (GLUSfloat *)glusMemoryRealloc(
+      *attribute, components * numberWelded * sizeof(GLUSfloat));
+
+  if (compacted) {
+    *attribute = compacted;
+  }
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeWeldf(GLUSshape *shape,
+                                        const GLUSfloat tolerance,
+                                        const GLUSbitfield attributes,
+                                        const GLUSfloat attributeTolerance) {
+  GLUSweldgrid grid;
+
+  GLUSuint *representatives;
+  GLUSuint *remap;
+
+  GLUSuint numberWelded = 0;
+
+  GLUSint i;
+
+  if (!shape || !shape->vertices || !shape->indices || !(tolerance >= 0.0f) ||
+      !(attributeTolerance >= 0.0f)) {
+    return GLUS_FALSE;
+  }
+
+  for (i = 0; i < (GLUSint)shape->numberIndices; i++) {
+    if (shape->indices[i] >= shape->numberVertices) {
+      return GLUS_FALSE;
+    }
+  }
+
+  memset(&grid, 0, sizeof(GLUSweldgrid));
+
+  grid.shape = shape;
+  grid.tolerance = tolerance;
+  grid.attributeTolerance = attributeTolerance;
+
+  if ((attributes & GLUS_ATTRIBUTE_NORMALS) && shape->normals) {
+    grid.compared[grid.numberCompared] = shape->normals;
+    grid.comparedComponents[grid.numberCompared] = 3;
+    grid.numberCompared++;
+  }
+
+  if ((attributes & GLUS_ATTRIBUTE_TEXCOORDS) && shape->texCoords) {
+    grid.compared[grid.numberCompared] = shape->texCoords;
+    grid.comparedComponents[grid.numberCompared] = 2;
+    grid.numberCompared++;
+  }
+
+  if ((attributes & GLUS_ATTRIBUTE_TANGENTS) && shape->tangents) {
+    grid.compared[grid.numberCompared] = shape->tangents;
+    grid.comparedComponents[grid.numberCompared] = 3;
+    grid.numberCompared++;
+  }
+
+  if ((attributes & GLUS_ATTRIBUTE_BITANGENTS) && shape->bitangents) {
+    grid.compared[grid.numberCompared] = shape->bitangents;
+    grid.comparedComponents[grid.numberCompared] = 3;
+    grid.numberCompared++;
+  }
+
+  // The cell of a vertex is only needed to build the grid, so the array is
+  // reused for the representatives afterwards.
+  representatives =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+  remap =
+      (GLUSuint *)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+
+  if (!representatives || !remap ||
+      !glusShapeWeldInitGridf(&grid, representatives)) {
+    glusShapeWeldDestroyGridf(&grid);
+
+    glusMemoryFree(representatives);
+    glusMemoryFree(remap);
+
+    return GLUS_FALSE;
+  }
+
+  // The search is independent for every vertex, so the cells are processed in
+  // parallel. The result is the first equal vertex, which may have been merged
+  // itself.
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (shape->numberVertices >= GLUS_WELD_PARALLEL_VERTICES)
+#endif
+  for (i = 0; i < (GLUSint)grid.numberCells; i++) {
+    const GLUSweldcell *current = &grid.cells[i];
+
+    GLUSuint k;
+
+    for (k = 0; k < current->numberVertices; k++) {
+      GLUSuint vertex = grid.cellVertices[current->firstVertex + k];
+
+      representatives[vertex] = glusShapeWeldFindVertexf(&grid, vertex, 0);
+    }
+  }
+
+  // In vertex order, the earlier vertices are final. Only if the first equal
+  // vertex has been merged, the search is repeated for the vertices, which
+  // have been kept.
+
+  for (i = 0; i < (GLUSint)shape->numberVertices; i++) {
+    GLUSuint representative = representatives[i];
+
+    if (representatives[representative] != representative) {
+      representative = glusShapeWeldFindVertexf(&grid, i, representatives);
+
+      representatives[i] = representative;
+    }
+
+    if (representative == (GLUSuint)i) {
+      remap[i] = numberWelded++;
+    } else {
+      remap[i] = remap[representative];
+    }
+  }
+
+  glusShapeWeldDestroyGridf(&grid);
+
+  if (numberWelded < shape->numberVertices) {
+#ifdef _OPENMP
+#pragma omp parallel for if (shape->numberIndices >= GLUS_WELD_PARALLEL_VERTICES)
+#endif
+    for (i = 0; i < (GLUSint)shape->numberIndices; i++) {
+      shape->indices[i] = (GLUSindex)remap[shape->indices[i]];
+    }
+
+    glusShapeWeldCompactf(shape, &shape->vertices, 4, representatives, remap,
+                          numberWelded);
+    glusShapeWeldCompactf(shape, &shape->normals, 3, representatives, remap,
+                          numberWelded);
+    glusShapeWeldCompactf(shape, &shape->tangents, 3, representatives, remap,
+                          numberWelded);
+    glusShapeWeldCompactf(shape, &shape->bitangents, 3, representatives, remap,
+                          numberWelded);
+    glusShapeWeldCompactf(shape, &shape->texCoords, 2, representatives, remap,
+                          numberWelded);
+    glusShapeWeldCompactf(shape, &shape->allAttributes, 15, representatives,
+                          remap, numberWelded);
+
+    shape->numberVertices = numberWelded;
+  }
+
+  glusMemoryFree(representatives);
+  glusMemoryFree(remap);
+
+  return GLUS_TRUE;
+}
@@ -20,32 +20,60 @@
 
 #include "string.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define GLUS_MAX_OBJECTS 1
-#define GLUS_MAX_ATTRIBUTES (GLUS_MAX_VERTICES / GLUS_VERTICES_DIVISOR)
-#define GLUS_MAX_TRIANGLE_ATTRIBUTES GLUS_MAX_VERTICES
-#define GLUS_MAX_LINE_ATTRIBUTES GLUS_MAX_VERTICES
+#define GLUS_START_CAPACITY 1024
 #define GLUS_BUFFERSIZE 1024
 
-static GLUSboolean glusWavefrontMallocTempMemoryLine(GLUSfloat **vertices,
-                                                     GLUSindex **indices) {
-  if (!vertices || !indices) {
-    return GLUS_FALSE;
-  }
+// Largest number of vertices, which can still be addressed by GLUSindex. The
+// largest index is left out, as it is the primitive restart index.
+#define GLUS_MAX_INDEXED_VERTICES ((GLUSuint)(GLUSindex)~0)
 
-  *vertices = (GLUSfloat *)glusMemoryMalloc(4 * GLUS_MAX_ATTRIBUTES *
-                                            sizeof(GLUSfloat));
-  if (!*vertices) {
-    return GLUS_FALSE;
-  }
+// Structural keywords, which are recorded while parsing the chunks and handled
+// afterwards in file order.
+#define GLUS_EVENT_OBJECT 0
+#define GLUS_EVENT_GROUP 1
+#define GLUS_EVENT_MATERIAL_LIBRARY 2
+#define GLUS_EVENT_USE_MATERIAL 3
 
-  *indices = (GLUSindex *)glusMemoryMalloc(GLUS_MAX_LINE_ATTRIBUTES *
-                                           sizeof(GLUSindex));
-  if (!*indices) {
-    return GLUS_FALSE;
-  }
+// Smaller parts of a file are not worth to be parsed by another thread.
+#define GLUS_MIN_CHUNK_SIZE 65536
 
-  return GLUS_TRUE;
-}
+// More chunks than threads, so threads finishing early can take over work.
+#define GLUS_CHUNKS_PER_THREAD 4
+
+// Size of the parts read at once, if a wavefront file is streamed.
+#define GLUS_STREAM_BLOCK_SIZE 65536
+
+// Default number of triangles passed at once to the stream function.
+#define GLUS_STREAM_TRIANGLES 4096
+
+extern GLUSboolean _glusWavefrontCacheLoadWavefront(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    GLUSwavefront *wavefront);
+
+extern GLUSvoid _glusWavefrontCacheSaveWavefront(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    const GLUSwavefront *wavefront);
+
+extern GLUSboolean _glusWavefrontCacheLoadScene(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    GLUSscene *scene);
+
+extern GLUSvoid _glusWavefrontCacheSaveScene(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    const GLUSscene *scene);
+
+extern GLUSvoid _glusWavefrontCacheDestroy(GLUSvoid *cache);
+
+extern GLUSboolean _glusLineBatchAddIndexed(GLUSlinebatch *lineBatch,
+                                            const GLUSfloat *vertices,
+                                            const GLUSuint numberVertices,
+                                            const GLUSindex *indices,
+                                            const GLUSuint numberIndices);
 
 static GLUSvoid glusWavefrontFreeTempMemoryLine(GLUSfloat **vertices,
                                                 GLUSindex **indices) {
@@ -62,60 +90,35 @@ static GLUSvoid glusWavefrontFreeTempMemoryLine(GLUSfloat **vertices,
   }
 }
 
-static GLUSboolean glusWavefrontMallocTempMemory(
-    GLUSfloat **vertices, GLUSfloat **normals, GLUSfloat **texCoords,
-    GLUSfloat **triangleVertices, GLUSfloat **triangleNormals,
-    GLUSfloat **triangleTexCoords) {
-  if (!vertices || !normals || !texCoords || !triangleVertices ||
-      !triangleNormals || !triangleTexCoords) {
-    return GLUS_FALSE;
-  }
+// Grows the memory geometrically, so it can hold at least one more element.
+// If growing fails, the old memory is freed.
+static GLUSvoid *glusWavefrontGrowMemory(GLUSvoid *memory, GLUSuint *capacity,
+                                         size_t elementSize) {
+  GLUSvoid *newMemory = 0;
 
-  *vertices = (GLUSfloat *)glusMemoryMalloc(4 * GLUS_MAX_ATTRIBUTES *
-                                            sizeof(GLUSfloat));
-  if (!*vertices) {
-    return GLUS_FALSE;
-  }
+  GLUSuint newCapacity = *capacity > 0 ? 2 * *capacity : GLUS_START_CAPACITY;
 
-  *normals = (GLUSfloat *)glusMemoryMalloc(3 * GLUS_MAX_ATTRIBUTES *
-                                           sizeof(GLUSfloat));
-  if (!*normals) {
-    return GLUS_FALSE;
+  if (*capacity < 0x80000000) {
+    newMemory = glusMemoryRealloc(memory, (size_t)newCapacity * elementSize);
   }
 
-  *texCoords = (GLUSfloat *)glusMemoryMalloc(2 * GLUS_MAX_ATTRIBUTES *
-                                             sizeof(GLUSfloat));
-  if (!*texCoords) {
-    return GLUS_FALSE;
-  }
+  if (!newMemory) {
+    glusMemoryFree(memory);
 
-  *triangleVertices = (GLUSfloat *)glusMemoryMalloc(
-      4 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
-  if (!*triangleVertices) {
-    return GLUS_FALSE;
-  }
+    *capacity = 0;
 
-  *triangleNormals = (GLUSfloat *)glusMemoryMalloc(
-      3 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
-  if (!*triangleNormals) {
-    return GLUS_FALSE;
+    return 0;
   }
 
-  *triangleTexCoords = (GLUSfloat *)glusMemoryMalloc(
-      2 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
-  if (!*triangleTexCoords) {
-    return GLUS_FALSE;
-  }
+  *capacity = newCapacity;
 
-  return GLUS_TRUE;
+  return newMemory;
 }
 
 static GLUSvoid glusWavefrontFreeTempMemory(GLUSfloat **vertices,
                                             GLUSfloat **normals,
                                             GLUSfloat **texCoords,
-                                            GLUSfloat **triangleVertices,
-                                            GLUSfloat **triangleNormals,
-                                            GLUSfloat **triangleTexCoords) {
+                                            GLUSint **triangleIndices) {
   if (vertices && *vertices) {
     glusMemoryFree(*vertices);
 
@@ -134,23 +137,262 @@ static GLUSvoid glusWavefrontFreeTempMemory(GLUSfloat **vertices,
     *texCoords = 0;
   }
 
-  if (triangleVertices && *triangleVertices) {
-    glusMemoryFree(*triangleVertices);
+  if (triangleIndices && *triangleIndices) {
+    glusMemoryFree(*triangleIndices);
+
+    *triangleIndices = 0;
+  }
+}
+
+static const GLUSdouble glusWavefrontPowersOfTen[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static const GLUSchar *glusWavefrontSkipSpaces(const GLUSchar *c) {
+  while (*c == ' ' || *c == '\t' || *c == '\r') {
+    c++;
+  }
+
+  return c;
+}
+
+static const GLUSchar *glusWavefrontSkipLine(const GLUSchar *c) {
+  const GLUSchar *lineEnd = strchr(c, '\n');
+
+  if (!lineEnd) {
+    return c + strlen(c);
+  }
+
+  return lineEnd + 1;
+}
+
+static const GLUSchar *glusWavefrontSkipToken(const GLUSchar *c) {
+  while (*c && *c != ' ' && *c != '\t' && *c != '\r' && *c != '\n') {
+    c++;
+  }
+
+  return c;
+}
+
+static GLUSboolean glusWavefrontIsKeyword(const GLUSchar *token,
+                                          const GLUSchar *tokenEnd,
+                                          const GLUSchar *keyword) {
+  size_t length = strlen(keyword);
+
+  return (size_t)(tokenEnd - token) == length &&
+         strncmp(token, keyword, length) == 0;
+}
+
+// Parses a float in place. If mantissa and power of ten are exact doubles, one
+// multiplication or division is enough. All other cases are passed to strtof(),
+// so the result is always the same as with strtof().
+static const GLUSchar *glusWavefrontParseFloat(const GLUSchar *c,
+                                               GLUSfloat *value) {
+  const GLUSchar *start;
+
+  GLUSuint64 mantissa = 0;
+  GLUSuint64 bits;
+  GLUSint numberDigits = 0;
+  GLUSint exponent = 0;
+  GLUSint explicitExponent = 0;
+
+  GLUSboolean negative = GLUS_FALSE;
+  GLUSboolean negativeExponent = GLUS_FALSE;
+  GLUSboolean hasDigits = GLUS_FALSE;
+  GLUSboolean exact = GLUS_TRUE;
+
+  GLUSdouble result;
+
+  GLUSchar *end;
+
+  c = glusWavefrontSkipSpaces(c);
+
+  start = c;
+
+  if (*c == '-') {
+    negative = GLUS_TRUE;
+
+    c++;
+  } else if (*c == '+') {
+    c++;
+  }
+
+  // Leading zeros are not significant.
+  while (*c == '0') {
+    hasDigits = GLUS_TRUE;
+
+    c++;
+  }
+
+  while (*c >= '0' && *c <= '9') {
+    if (numberDigits < 19) {
+      mantissa = mantissa * 10 + (GLUSuint64)(*c - '0');
+
+      numberDigits++;
+    } else {
+      exact = GLUS_FALSE;
+    }
+
+    hasDigits = GLUS_TRUE;
+
+    c++;
+  }
+
+  if (*c == '.') {
+    c++;
+
+    if (numberDigits == 0) {
+      while (*c == '0') {
+        exponent--;
+
+        hasDigits = GLUS_TRUE;
+
+        c++;
+      }
+    }
+
+    while (*c >= '0' && *c <= '9') {
+      if (numberDigits < 19) {
+        mantissa = mantissa * 10 + (GLUSuint64)(*c - '0');
+
+        numberDigits++;
+
+        exponent--;
+      } else {
+        exact = GLUS_FALSE;
+      }
+
+      hasDigits = GLUS_TRUE;
+
+      c++;
+    }
+  }
+
+  if (!hasDigits || *c == 'x' || *c == 'X') {
+    exact = GLUS_FALSE;
+  } else if (*c == 'e' || *c == 'E') {
+    c++;
+
+    if (*c == '-') {
+      negativeExponent = GLUS_TRUE;
+
+      c++;
+    } else if (*c == '+') {
+      c++;
+    }
+
+    if (*c < '0' || *c > '9') {
+      exact = GLUS_FALSE;
+    }
+
+    while (*c >= '0' && *c <= '9') {
+      if (explicitExponent < 10000) {
+        explicitExponent = explicitExponent * 10 + (*c - '0');
+      }
+
+      c++;
+    }
+
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+
+  if (exact && mantissa == 0) {
+    *value = negative ? -0.0f : 0.0f;
+
+    return c;
+  }
+
+  if (exact && mantissa <= ((GLUSuint64)1 << 53) && exponent >= -22 &&
+      exponent <= 22) {
+    result = (GLUSdouble)mantissa;
+
+    if (exponent < 0) {
+      result /= glusWavefrontPowersOfTen[-exponent];
+    } else {
+      result *= glusWavefrontPowersOfTen[exponent];
+    }
+
+    memcpy(&bits, &result, sizeof(GLUSdouble));
+
+    // Rounding the double to float is only the same as rounding the exact
+    // value to float, if the double is not exactly between two floats.
+    // Denormalized floats and overflows are left to strtof().
+    if ((bits & 0x1FFFFFFF) != 0x10000000 && result >= 1.17549435e-38 &&
+        result <= 3.40282347e+38) {
+      *value = (GLUSfloat)(negative ? -result : result);
+
+      return c;
+    }
+  }
+
+  // strtof() would skip a new line and parse the next line.
+  if (*start == '\n' || *start == '\0') {
+    return start;
+  }
+
+  *value = strtof(start, &end);
 
-    *triangleVertices = 0;
+  return end;
+}
+
+// Parses a wavefront index in place. Positive indices start with 1, negative
+// indices are relative to the given number of elements. The returned index
+// starts with 0 and is -1, if no or an invalid index is given.
+static const GLUSchar *glusWavefrontParseIndex(const GLUSchar *c,
+                                               GLUSint numberElements,
+                                               GLUSint *index) {
+  GLUSint value = 0;
+
+  GLUSboolean negative = GLUS_FALSE;
+
+  if (*c == '-') {
+    negative = GLUS_TRUE;
+
+    c++;
+  } else if (*c == '+') {
+    c++;
   }
 
-  if (triangleNormals && *triangleNormals) {
-    glusMemoryFree(*triangleNormals);
+  while (*c >= '0' && *c <= '9') {
+    if (value < 100000000) {
+      value = value * 10 + (*c - '0');
+    }
+
+    c++;
+  }
 
-    *triangleNormals = 0;
+  if (value == 0 || (negative && value > numberElements)) {
+    *index = -1;
+  } else if (negative) {
+    *index = numberElements - value;
+  } else {
+    *index = value - 1;
   }
 
-  if (triangleTexCoords && *triangleTexCoords) {
-    glusMemoryFree(*triangleTexCoords);
+  return c;
+}
+
+static const GLUSchar *glusWavefrontParseName(const GLUSchar *c,
+                                              GLUSchar *name) {
+  const GLUSchar *nameEnd;
+
+  c = glusWavefrontSkipSpaces(c);
+
+  nameEnd = glusWavefrontSkipToken(c);
 
-    *triangleTexCoords = 0;
+  // Like sscanf(), the name stays untouched, if there is none.
+  if (nameEnd > c) {
+    size_t length = (size_t)(nameEnd - c);
+
+    if (length >= GLUS_MAX_STRING) {
+      length = GLUS_MAX_STRING - 1;
+    }
+
+    memcpy(name, c, length);
+    name[length] = '\0';
   }
+
+  return nameEnd;
 }
 
 static GLUSvoid glusWavefrontInitMaterial(GLUSmaterial *material) {
@@ -513,9 +755,9 @@ static GLUSboolean glusWavefrontLoadMaterial(const GLUSchar *filename,
   return GLUS_TRUE;
 }
 
+// The groups are stored in one array, so only the first one is freed.
 static GLUSvoid glusWavefrontDestroyGroup(GLUSgroupList **groupList) {
   GLUSgroupList *currentGroupList = 0;
-  GLUSgroupList *nextGroupList = 0;
 
   if (!groupList || !*groupList) {
     return;
@@ -523,18 +765,16 @@ static GLUSvoid glusWavefrontDestroyGroup(GLUSgroupList **groupList) {
 
   currentGroupList = *groupList;
   while (currentGroupList != 0) {
-    nextGroupList = currentGroupList->next;
-
     if (currentGroupList->group.indices) {
       glusMemoryFree(currentGroupList->group.indices);
     }
     memset(&currentGroupList->group, 0, sizeof(GLUSgroup));
 
-    glusMemoryFree(currentGroupList);
-
-    currentGroupList = nextGroupList;
+    currentGroupList = currentGroupList->next;
   }
 
+  glusMemoryFree(*groupList);
+
   *groupList = 0;
 }
 
@@ -543,7 +783,8 @@ static GLUSboolean glusWavefrontCopyDataLine(GLUSline *line,
                                              GLUSfloat *lineVertices,
                                              GLUSuint totalNumberIndices,
                                              GLUSindex *lineIndices) {
-  if (!line || !lineVertices || !lineIndices) {
+  if (!line || (totalNumberVertices > 0 && !lineVertices) ||
+      (totalNumberIndices > 0 && !lineIndices)) {
     return GLUS_FALSE;
   }
 
@@ -583,59 +824,118 @@ static GLUSboolean glusWavefrontCopyDataLine(GLUSline *line,
   return GLUS_TRUE;
 }
 
-static GLUSboolean
-glusWavefrontCopyData(GLUSshape *shape, GLUSuint totalNumberVertices,
-                      GLUSfloat *triangleVertices, GLUSuint totalNumberNormals,
-                      GLUSfloat *triangleNormals, GLUSuint totalNumberTexCoords,
-                      GLUSfloat *triangleTexCoords) {
+// Returns GLUS_TRUE, if the normals are needed for the given attributes.
+static GLUSboolean glusWavefrontUseNormals(GLUSbitfield attributes) {
+  return (attributes &
+          (GLUS_ATTRIBUTE_NORMALS | GLUS_ATTRIBUTE_ALL_ATTRIBUTES)) != 0;
+}
+
+// Returns GLUS_TRUE, if the texture coordinates are needed for the given
+// attributes.
+static GLUSboolean glusWavefrontUseTexCoords(GLUSbitfield attributes) {
+  return (attributes &
+          (GLUS_ATTRIBUTE_TEXCOORDS | GLUS_ATTRIBUTE_TANGENTS |
+           GLUS_ATTRIBUTE_BITANGENTS | GLUS_ATTRIBUTE_ALL_ATTRIBUTES)) != 0;
+}
+
+static GLUSboolean glusWavefrontCopyData(GLUSshape *shape,
+                                         GLUSuint totalNumberVertices,
+                                         const GLUSint *triangleIndices,
+                                         const GLUSfloat *vertices,
+                                         const GLUSfloat *normals,
+                                         const GLUSfloat *texCoords,
+                                         GLUSbitfield attributes) {
+  GLUSboolean hasNormals = GLUS_FALSE;
+  GLUSboolean hasTexCoords = GLUS_FALSE;
+
+  GLUSboolean useNormals = glusWavefrontUseNormals(attributes);
+  GLUSboolean useTexCoords = glusWavefrontUseTexCoords(attributes);
+
   GLUSuint indicesCounter = 0;
 
-  if (!shape || !triangleVertices || !triangleNormals || !triangleTexCoords) {
+  if (!shape || (totalNumberVertices > 0 && !triangleIndices)) {
     return GLUS_FALSE;
   }
 
   memset(shape, 0, sizeof(GLUSshape));
 
+  if (totalNumberVertices > GLUS_MAX_INDEXED_VERTICES) {
+    return GLUS_FALSE;
+  }
+
+  for (indicesCounter = 0; indicesCounter < totalNumberVertices;
+       indicesCounter++) {
+    if (useTexCoords && triangleIndices[3 * indicesCounter + 1] >= 0) {
+      hasTexCoords = GLUS_TRUE;
+    }
+    if (useNormals && triangleIndices[3 * indicesCounter + 2] >= 0) {
+      hasNormals = GLUS_TRUE;
+    }
+  }
+
   shape->numberVertices = totalNumberVertices;
 
   if (totalNumberVertices > 0) {
-    shape->vertices = (GLUSfloat *)glusMemoryMalloc(totalNumberVertices * 4 *
-                                                    sizeof(GLUSfloat));
+    shape->vertices = (GLUSfloat *)glusMemoryMalloc(
+        (size_t)totalNumberVertices * 4 * sizeof(GLUSfloat));
 
     if (shape->vertices == 0) {
       glusShapeDestroyf(shape);
 
       return GLUS_FALSE;
     }
-
-    memcpy(shape->vertices, triangleVertices,
-           totalNumberVertices * 4 * sizeof(GLUSfloat));
   }
-  if (totalNumberNormals > 0) {
-    shape->normals = (GLUSfloat *)glusMemoryMalloc(totalNumberNormals * 3 *
-                                                   sizeof(GLUSfloat));
+  if (hasNormals) {
+    shape->normals = (GLUSfloat *)glusMemoryMalloc(
+        (size_t)totalNumberVertices * 3 * sizeof(GLUSfloat));
 
     if (shape->normals == 0) {
       glusShapeDestroyf(shape);
 
       return GLUS_FALSE;
     }
-
-    memcpy(shape->normals, triangleNormals,
-           totalNumberNormals * 3 * sizeof(GLUSfloat));
   }
-  if (totalNumberTexCoords > 0) {
-    shape->texCoords = (GLUSfloat *)glusMemoryMalloc(totalNumberTexCoords * 2 *
-                                                     sizeof(GLUSfloat));
+  if (hasTexCoords) {
+    shape->texCoords = (GLUSfloat *)glusMemoryMalloc(
+        (size_t)totalNumberVertices * 2 * sizeof(GLUSfloat));
 
     if (shape->texCoords == 0) {
       glusShapeDestroyf(shape);
 
       return GLUS_FALSE;
     }
+  }
+
+  // Every triangle corner gets its own vertex, normal and texture coordinate.
+  // Corners without a normal or texture coordinate get zero values.
+
+  for (indicesCounter = 0; indicesCounter < totalNumberVertices;
+       indicesCounter++) {
+    const GLUSint *current = &triangleIndices[3 * indicesCounter];
+
+    memcpy(&shape->vertices[4 * indicesCounter], &vertices[4 * current[0]],
+           4 * sizeof(GLUSfloat));
+
+    if (hasTexCoords) {
+      if (current[1] >= 0) {
+        memcpy(&shape->texCoords[2 * indicesCounter],
+               &texCoords[2 * current[1]], 2 * sizeof(GLUSfloat));
+      } else {
+        shape->texCoords[2 * indicesCounter + 0] = 0.0f;
+        shape->texCoords[2 * indicesCounter + 1] = 0.0f;
+      }
+    }
 
-    memcpy(shape->texCoords, triangleTexCoords,
-           totalNumberTexCoords * 2 * sizeof(GLUSfloat));
+    if (hasNormals) {
+      if (current[2] >= 0) {
+        memcpy(&shape->normals[3 * indicesCounter], &normals[3 * current[2]],
+               3 * sizeof(GLUSfloat));
+      } else {
+        shape->normals[3 * indicesCounter + 0] = 0.0f;
+        shape->normals[3 * indicesCounter + 1] = 0.0f;
+        shape->normals[3 * indicesCounter + 2] = 0.0f;
+      }
+    }
   }
 
   // Just create the indices from the list of vertices.
@@ -643,8 +943,8 @@ glusWavefrontCopyData(GLUSshape *shape, GLUSuint totalNumberVertices,
   shape->numberIndices = totalNumberVertices;
 
   if (totalNumberVertices > 0) {
-    shape->indices =
-        (GLUSindex *)glusMemoryMalloc(totalNumberVertices * sizeof(GLUSindex));
+    shape->indices = (GLUSindex *)glusMemoryMalloc((size_t)totalNumberVertices *
+                                                   sizeof(GLUSindex));
 
     if (shape->indices == 0) {
       glusShapeDestroyf(shape);
@@ -662,710 +962,1935 @@ glusWavefrontCopyData(GLUSshape *shape, GLUSuint totalNumberVertices,
 
   return GLUS_TRUE;
 }
+static GLUSuint glusWavefrontHashIndices(const GLUSint *triangleIndices) {
+  GLUSuint hash = 2166136261u;
 
-GLUSboolean _glusWavefrontMove(GLUSwavefront *wavefront, GLUSshape *shape) {
-  GLUSmaterialList *materialWalker;
-  GLUSgroupList *groupWalker;
+  hash = (hash ^ (GLUSuint)triangleIndices[0]) * 16777619u;
+  hash = (hash ^ (GLUSuint)triangleIndices[1]) * 16777619u;
+  hash = (hash ^ (GLUSuint)triangleIndices[2]) * 16777619u;
 
-  GLUSuint i;
-  GLUSuint counter = 0;
+  return hash ^ (hash >> 15);
+}
 
-  if (!wavefront || !shape) {
-    return GLUS_FALSE;
-  }
+// Gets the vertex, texture coordinate and normal index of a triangle corner.
+// Indices of attributes, which are not needed, are ignored, so more corners
+// can share one vertex.
+static GLUSvoid glusWavefrontGetCorner(GLUSint *corner,
+                                       const GLUSint *triangleIndices,
+                                       GLUSboolean useTexCoords,
+                                       GLUSboolean useNormals) {
+  corner[0] = triangleIndices[0];
+  corner[1] = useTexCoords ? triangleIndices[1] : -1;
+  corner[2] = useNormals ? triangleIndices[2] : -1;
+}
 
-  // No clear of wavefront by purpose.
+static GLUSboolean glusWavefrontCopyDataIndexed(
+    GLUSshape *shape, GLUSuint totalNumberVertices,
+    const GLUSint *triangleIndices, const GLUSfloat *vertices,
+    const GLUSfloat *normals, const GLUSfloat *texCoords,
+    GLUSbitfield attributes) {
+  GLUSuint *hashTable = 0;
+  GLUSuint hashTableSize = 1;
+  GLUSuint hashTableMask;
+  GLUSuint hash;
 
-  wavefront->vertices = shape->vertices;
-  wavefront->normals = shape->normals;
-  wavefront->texCoords = shape->texCoords;
-  wavefront->tangents = shape->tangents;
-  wavefront->bitangents = shape->bitangents;
-  wavefront->numberVertices = shape->numberVertices;
+  GLUSuint *uniqueCorners = 0;
+  GLUSuint numberUniqueVertices = 0;
 
-  groupWalker = wavefront->groups;
-  while (groupWalker) {
-    groupWalker->group.indices = (GLUSindex *)glusMemoryMalloc(
-        groupWalker->group.numberIndices * sizeof(GLUSindex));
+  GLUSboolean hasNormals = GLUS_FALSE;
+  GLUSboolean hasTexCoords = GLUS_FALSE;
 
-    if (!groupWalker->group.indices) {
-      memset(wavefront, 0, sizeof(GLUSwavefront));
+  GLUSboolean useNormals = glusWavefrontUseNormals(attributes);
+  GLUSboolean useTexCoords = glusWavefrontUseTexCoords(attributes);
 
-      return GLUS_FALSE;
-    }
+  GLUSuint i;
 
-    for (i = 0; i < groupWalker->group.numberIndices; i++) {
-      groupWalker->group.indices[i] = counter++;
-    }
+  if (!shape || (totalNumberVertices > 0 && !triangleIndices)) {
+    return GLUS_FALSE;
+  }
 
-    materialWalker = wavefront->materials;
+  memset(shape, 0, sizeof(GLUSshape));
 
-    while (materialWalker) {
-      if (strcmp(materialWalker->material.name,
-                 groupWalker->group.materialName) == 0) {
-        groupWalker->group.material = &materialWalker->material;
+  shape->mode = GLUS_TRIANGLES;
 
-        break;
-      }
+  if (totalNumberVertices == 0) {
+    return GLUS_TRUE;
+  }
 
-      materialWalker = materialWalker->next;
-    }
+  // Open addressing with at least half of the table empty, which has to be
+  // addressable with 32 bit.
+  if (totalNumberVertices > 0x7FFFFFFF) {
+    return GLUS_FALSE;
+  }
 
-    groupWalker = groupWalker->next;
+  while (hashTableSize < 2 * totalNumberVertices) {
+    hashTableSize *= 2;
   }
+  hashTableMask = hashTableSize - 1;
 
-  glusMemoryFree(shape->indices);
-  shape->indices = 0;
+  hashTable =
+      (GLUSuint *)glusMemoryMalloc((size_t)hashTableSize * sizeof(GLUSuint));
+  uniqueCorners = (GLUSuint *)glusMemoryMalloc((size_t)totalNumberVertices *
+                                              sizeof(GLUSuint));
+  shape->indices = (GLUSindex *)glusMemoryMalloc((size_t)totalNumberVertices *
+                                                 sizeof(GLUSindex));
 
-  memset(shape, 0, sizeof(GLUSshape));
+  if (!hashTable || !uniqueCorners || !shape->indices) {
+    if (hashTable) {
+      glusMemoryFree(hashTable);
+    }
+    if (uniqueCorners) {
+      glusMemoryFree(uniqueCorners);
+    }
+    glusShapeDestroyf(shape);
 
-  return GLUS_TRUE;
-}
+    return GLUS_FALSE;
+  }
 
-GLUSboolean _glusWavefrontParse(const GLUSchar *filename, GLUSshape *shape,
-                                GLUSwavefront *wavefront, GLUSscene *scene) {
-  GLUSboolean result;
+  memset(hashTable, 0xFF, (size_t)hashTableSize * sizeof(GLUSuint));
 
-  FILE *f;
+  // Find the unique vertex, texture coordinate and normal index triples.
 
-  GLUSchar buffer[GLUS_BUFFERSIZE];
-  GLUSchar identifier[7];
+  for (i = 0; i < totalNumberVertices; i++) {
+    GLUSint current[3];
 
-  GLUSfloat x, y, z;
-  GLUSfloat s, t;
+    glusWavefrontGetCorner(current, &triangleIndices[3 * i], useTexCoords,
+                           useNormals);
 
-  GLUSfloat *vertices = 0;
-  GLUSfloat *normals = 0;
-  GLUSfloat *texCoords = 0;
+    hash = glusWavefrontHashIndices(current) & hashTableMask;
 
-  GLUSuint numberVertices = 0;
-  GLUSuint numberNormals = 0;
-  GLUSuint numberTexCoords = 0;
+    while (hashTable[hash] != 0xFFFFFFFF) {
+      GLUSint other[3];
 
-  GLUSfloat *triangleVertices = 0;
-  GLUSfloat *triangleNormals = 0;
-  GLUSfloat *triangleTexCoords = 0;
+      glusWavefrontGetCorner(
+          other, &triangleIndices[3 * uniqueCorners[hashTable[hash]]],
+          useTexCoords, useNormals);
 
-  GLUSuint offsetNumberVertices = 0;
-  GLUSuint offsetNumberNormals = 0;
-  GLUSuint offsetNumberTexCoords = 0;
+      if (other[0] == current[0] && other[1] == current[1] &&
+          other[2] == current[2]) {
+        break;
+      }
 
-  GLUSuint totalNumberVertices = 0;
-  GLUSuint totalNumberNormals = 0;
-  GLUSuint totalNumberTexCoords = 0;
+      hash = (hash + 1) & hashTableMask;
+    }
 
-  GLUSuint facesEncoding = 0;
+    if (hashTable[hash] == 0xFFFFFFFF) {
+      if (numberUniqueVertices >= GLUS_MAX_INDEXED_VERTICES) {
+        glusMemoryFree(hashTable);
+        glusMemoryFree(uniqueCorners);
 
-  // Material and groups
+        glusShapeDestroyf(shape);
 
-  GLUSchar name[GLUS_MAX_STRING];
+        return GLUS_FALSE;
+      }
 
-  GLUSuint numberIndicesGroup = 0;
-  GLUSuint numberMaterials = 0;
-  GLUSuint numberGroups = 0;
+      hashTable[hash] = numberUniqueVertices;
 
-  GLUSgroupList *currentGroupList = 0;
-  GLUSobjectList *currentObjectList = 0;
+      uniqueCorners[numberUniqueVertices] = i;
 
-  // get path of wavefront file
-  int len = strlen(filename);
-  char *dir = malloc(len + 1);
-  {
-    strcpy(dir, filename);
-    while (len > 0) {
-      len--;
-      if (dir[len] == '\\' || dir[len] == '/') {
-        dir[len] = '\0';
-        break;
+      numberUniqueVertices++;
+
+      if (current[1] >= 0) {
+        hasTexCoords = GLUS_TRUE;
+      }
+      if (current[2] >= 0) {
+        hasNormals = GLUS_TRUE;
       }
     }
+
+    shape->indices[i] = (GLUSindex)hashTable[hash];
   }
 
-  // Objects
+  glusMemoryFree(hashTable);
 
-  GLUSuint numberObjects = 0;
+  shape->numberIndices = totalNumberVertices;
+  shape->numberVertices = numberUniqueVertices;
 
-  if (scene) {
-    memset(scene, 0, sizeof(GLUSscene));
+  shape->vertices = (GLUSfloat *)glusMemoryMalloc(
+      (size_t)numberUniqueVertices * 4 * sizeof(GLUSfloat));
+  if (hasNormals) {
+    shape->normals = (GLUSfloat *)glusMemoryMalloc(
+        (size_t)numberUniqueVertices * 3 * sizeof(GLUSfloat));
   }
-
-  if (wavefront) {
-    memset(wavefront, 0, sizeof(GLUSwavefront));
+  if (hasTexCoords) {
+    shape->texCoords = (GLUSfloat *)glusMemoryMalloc(
+        (size_t)numberUniqueVertices * 2 * sizeof(GLUSfloat));
   }
 
-  if (shape) {
-    memset(shape, 0, sizeof(GLUSshape));
-  }
+  if (!shape->vertices || (hasNormals && !shape->normals) ||
+      (hasTexCoords && !shape->texCoords)) {
+    glusMemoryFree(uniqueCorners);
+
+    glusShapeDestroyf(shape);
 
-  if (!filename || !shape) {
     return GLUS_FALSE;
   }
 
-  f = glusFileOpen(filename, "r");
+  // Corners without a normal or texture coordinate get zero values.
 
-  if (!f) {
-    return GLUS_FALSE;
+  for (i = 0; i < numberUniqueVertices; i++) {
+    const GLUSint *current = &triangleIndices[3 * uniqueCorners[i]];
+
+    memcpy(&shape->vertices[4 * i], &vertices[4 * current[0]],
+           4 * sizeof(GLUSfloat));
+
+    if (hasTexCoords) {
+      if (current[1] >= 0) {
+        memcpy(&shape->texCoords[2 * i], &texCoords[2 * current[1]],
+               2 * sizeof(GLUSfloat));
+      } else {
+        shape->texCoords[2 * i + 0] = 0.0f;
+        shape->texCoords[2 * i + 1] = 0.0f;
+      }
+    }
+
+    if (hasNormals) {
+      if (current[2] >= 0) {
+        memcpy(&shape->normals[3 * i], &normals[3 * current[2]],
+               3 * sizeof(GLUSfloat));
+      } else {
+        shape->normals[3 * i + 0] = 0.0f;
+        shape->normals[3 * i + 1] = 0.0f;
+        shape->normals[3 * i + 2] = 0.0f;
+      }
+    }
+  }
+
+  glusMemoryFree(uniqueCorners);
+
+  return GLUS_TRUE;
+}
+
+static GLUSuint glusWavefrontHashName(const GLUSchar *name) {
+  GLUSuint hash = 2166136261u;
+
+  while (*name) {
+    hash = (hash ^ (GLUSubyte)*name) * 16777619u;
+
+    name++;
+  }
+
+  return hash;
+}
+
+// Index of the materials. The hash table with open addressing stores the
+// number of a material plus one, zero marks a free entry.
+typedef struct _GLUSwavefrontmaterialindex {
+  GLUSmaterial **materials;
+  GLUSuint numberMaterials;
+
+  GLUSuint *table;
+  GLUSuint capacity;
+
+} GLUSwavefrontmaterialindex;
+
+static GLUSvoid
+glusWavefrontDestroyMaterialIndex(GLUSwavefrontmaterialindex *index) {
+  glusMemoryFree(index->materials);
+  glusMemoryFree(index->table);
+
+  memset(index, 0, sizeof(GLUSwavefrontmaterialindex));
+}
+
+// If names are used several times, the first material is found like by
+// walking the list.
+static GLUSboolean
+glusWavefrontIndexMaterials(GLUSwavefrontmaterialindex *index,
+                            GLUSmaterialList *materials) {
+  GLUSmaterialList *materialWalker;
+
+  GLUSuint numberMaterials = 0;
+
+  memset(index, 0, sizeof(GLUSwavefrontmaterialindex));
+
+  for (materialWalker = materials; materialWalker;
+       materialWalker = materialWalker->next) {
+    numberMaterials++;
+  }
+
+  index->capacity = 16;
+
+  while (index->capacity < 2 * numberMaterials) {
+    index->capacity *= 2;
+  }
+
+  index->table =
+      (GLUSuint *)glusMemoryMalloc(index->capacity * sizeof(GLUSuint));
+  index->materials = (GLUSmaterial **)glusMemoryMalloc(
+      (numberMaterials + 1) * sizeof(GLUSmaterial *));
+
+  if (!index->table || !index->materials) {
+    glusWavefrontDestroyMaterialIndex(index);
+
+    return GLUS_FALSE;
+  }
+
+  memset(index->table, 0, index->capacity * sizeof(GLUSuint));
+
+  for (materialWalker = materials; materialWalker;
+       materialWalker = materialWalker->next) {
+    GLUSuint i = glusWavefrontHashName(materialWalker->material.name) &
+                 (index->capacity - 1);
+
+    while (index->table[i] &&
+           strcmp(index->materials[index->table[i] - 1]->name,
+                  materialWalker->material.name) != 0) {
+      i = (i + 1) & (index->capacity - 1);
+    }
+
+    index->materials[index->numberMaterials] = &materialWalker->material;
+
+    index->numberMaterials++;
+
+    if (!index->table[i]) {
+      index->table[i] = index->numberMaterials;
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+// Returns the number of the material or the number of materials, if not found.
+static GLUSuint
+glusWavefrontFindMaterial(const GLUSwavefrontmaterialindex *index,
+                          const GLUSchar *name) {
+  GLUSuint i = glusWavefrontHashName(name) & (index->capacity - 1);
+
+  while (index->table[i]) {
+    if (strcmp(index->materials[index->table[i] - 1]->name, name) == 0) {
+      return index->table[i] - 1;
+    }
+
+    i = (i + 1) & (index->capacity - 1);
+  }
+
+  return index->numberMaterials;
+}
+
+// Sorts the groups by material with a counting sort, which keeps the order of
+// groups having the same material. The indices of all groups are stored into
+// one array and every material gets one range.
+static GLUSboolean glusWavefrontMergeGroups(
+    GLUSwavefront *wavefront, const GLUSshape *shape,
+    const GLUSwavefrontmaterialindex *index, const GLUSuint *materialNumbers,
+    GLUSuint numberGroups) {
+  GLUSuint numberBuckets = index->numberMaterials + 1;
+
+  GLUSuint *firstGroups;
+  GLUSuint *firstIndices;
+
+  GLUSgroupList *groups = 0;
+
+  GLUSuint numberIndices = 0;
+  GLUSuint i;
+
+  firstGroups =
+      (GLUSuint *)glusMemoryMalloc(2 * numberBuckets * sizeof(GLUSuint));
+
+  if (!firstGroups) {
+    return GLUS_FALSE;
+  }
+
+  firstIndices = &firstGroups[numberBuckets];
+
+  memset(firstGroups, 0, 2 * numberBuckets * sizeof(GLUSuint));
+
+  for (i = 0; i < numberGroups; i++) {
+    firstGroups[materialNumbers[i]]++;
+    firstIndices[materialNumbers[i]] +=
+        wavefront->groups[i].group.numberIndices;
+
+    numberIndices += wavefront->groups[i].group.numberIndices;
+  }
+
+  if (numberIndices > shape->numberIndices) {
+    glusMemoryFree(firstGroups);
+
+    return GLUS_FALSE;
+  }
+
+  wavefront->ranges = (GLUSmaterialrange *)glusMemoryMalloc(
+      numberBuckets * sizeof(GLUSmaterialrange));
+  wavefront->indices =
+      (GLUSindex *)glusMemoryMalloc(numberIndices * sizeof(GLUSindex));
+  groups = (GLUSgroupList *)glusMemoryMalloc(numberGroups *
+                                             sizeof(GLUSgroupList));
+
+  if (!wavefront->ranges || (numberIndices > 0 && !wavefront->indices) ||
+      (numberGroups > 0 && !groups)) {
+    glusMemoryFree(wavefront->ranges);
+    glusMemoryFree(wavefront->indices);
+    glusMemoryFree(groups);
+    glusMemoryFree(firstGroups);
+
+    wavefront->ranges = 0;
+    wavefront->indices = 0;
+
+    return GLUS_FALSE;
+  }
+
+  // Ranges of the materials, converting the counts into first elements.
+
+  {
+    GLUSuint group = 0;
+    GLUSuint first = 0;
+
+    for (i = 0; i < numberBuckets; i++) {
+      GLUSuint count = firstIndices[i];
+
+      if (count > 0) {
+        GLUSmaterialrange *range = &wavefront->ranges[wavefront->numberRanges];
+
+        range->material = i < index->numberMaterials ? index->materials[i] : 0;
+        range->firstIndex = first;
+        range->numberIndices = count;
+
+        wavefront->numberRanges++;
+      }
+
+      firstIndices[i] = first;
+      first += count;
+
+      count = firstGroups[i];
+      firstGroups[i] = group;
+      group += count;
+    }
+  }
+
+  {
+    GLUSuint counter = 0;
+
+    for (i = 0; i < numberGroups; i++) {
+      GLUSgroupList *groupList = &groups[firstGroups[materialNumbers[i]]++];
+
+      GLUSuint first = firstIndices[materialNumbers[i]];
+
+      memcpy(groupList, &wavefront->groups[i], sizeof(GLUSgroupList));
+
+      groupList->group.indices = 0;
+
+      if (groupList->group.numberIndices > 0) {
+        groupList->group.indices = &wavefront->indices[first];
+
+        memcpy(groupList->group.indices, &shape->indices[counter],
+               groupList->group.numberIndices * sizeof(GLUSindex));
+      }
+
+      counter += groupList->group.numberIndices;
+
+      firstIndices[materialNumbers[i]] += groupList->group.numberIndices;
+    }
+  }
+
+  for (i = 0; i + 1 < numberGroups; i++) {
+    groups[i].next = &groups[i + 1];
+  }
+
+  if (numberGroups > 0) {
+    groups[numberGroups - 1].next = 0;
+  }
+
+  glusMemoryFree(wavefront->groups);
+
+  wavefront->groups = groups;
+
+  wavefront->numberIndices = numberIndices;
+
+  glusMemoryFree(firstGroups);
+
+  return GLUS_TRUE;
+}
+
+GLUSboolean _glusWavefrontMove(GLUSwavefront *wavefront, GLUSshape *shape,
+                               GLUSboolean mergeGroups) {
+  GLUSgroupList *groupWalker;
+
+  GLUSwavefrontmaterialindex index;
+
+  GLUSuint *materialNumbers = 0;
+  GLUSuint numberGroups = 0;
+
+  GLUSuint counter = 0;
+
+  if (!wavefront || !shape) {
+    return GLUS_FALSE;
+  }
+
+  // No clear of wavefront by purpose.
+
+  wavefront->vertices = shape->vertices;
+  wavefront->normals = shape->normals;
+  wavefront->texCoords = shape->texCoords;
+  wavefront->tangents = shape->tangents;
+  wavefront->bitangents = shape->bitangents;
+  wavefront->allAttributes = shape->allAttributes;
+  wavefront->numberVertices = shape->numberVertices;
+
+  for (groupWalker = wavefront->groups; groupWalker;
+       groupWalker = groupWalker->next) {
+    numberGroups++;
+  }
+
+  if (!glusWavefrontIndexMaterials(&index, wavefront->materials)) {
+    memset(wavefront, 0, sizeof(GLUSwavefront));
+
+    return GLUS_FALSE;
+  }
+
+  if (mergeGroups && numberGroups > 0) {
+    materialNumbers =
+        (GLUSuint *)glusMemoryMalloc(numberGroups * sizeof(GLUSuint));
+
+    if (!materialNumbers) {
+      glusWavefrontDestroyMaterialIndex(&index);
+
+      memset(wavefront, 0, sizeof(GLUSwavefront));
+
+      return GLUS_FALSE;
+    }
+  }
+
+  numberGroups = 0;
+
+  groupWalker = wavefront->groups;
+  while (groupWalker) {
+    GLUSuint materialNumber =
+        glusWavefrontFindMaterial(&index, groupWalker->group.materialName);
+
+    if (materialNumber < index.numberMaterials) {
+      groupWalker->group.material = index.materials[materialNumber];
+    }
+
+    if (materialNumbers) {
+      materialNumbers[numberGroups] = materialNumber;
+    } else {
+      groupWalker->group.indices = (GLUSindex *)glusMemoryMalloc(
+          groupWalker->group.numberIndices * sizeof(GLUSindex));
+
+      // The groups are stored one after another in the shape indices.
+      if (!groupWalker->group.indices ||
+          counter + groupWalker->group.numberIndices > shape->numberIndices) {
+        glusWavefrontDestroyMaterialIndex(&index);
+
+        memset(wavefront, 0, sizeof(GLUSwavefront));
+
+        return GLUS_FALSE;
+      }
+
+      memcpy(groupWalker->group.indices, &shape->indices[counter],
+             groupWalker->group.numberIndices * sizeof(GLUSindex));
+
+      counter += groupWalker->group.numberIndices;
+    }
+
+    numberGroups++;
+
+    groupWalker = groupWalker->next;
+  }
+
+  if (materialNumbers) {
+    GLUSboolean result = glusWavefrontMergeGroups(
+        wavefront, shape, &index, materialNumbers, numberGroups);
+
+    glusMemoryFree(materialNumbers);
+
+    if (!result) {
+      glusWavefrontDestroyMaterialIndex(&index);
+
+      memset(wavefront, 0, sizeof(GLUSwavefront));
+
+      return GLUS_FALSE;
+    }
+  }
+
+  glusWavefrontDestroyMaterialIndex(&index);
+
+  glusMemoryFree(shape->indices);
+  shape->indices = 0;
+
+  memset(shape, 0, sizeof(GLUSshape));
+
+  return GLUS_TRUE;
+}
+
+// Appends a group to the array of groups. As the array may move, all groups
+// are linked again in this case.
+static GLUSgroupList *glusWavefrontCreateGroup(GLUSwavefront *wavefront,
+                                              GLUSgroupList *currentGroupList,
+                                              GLUSuint *numberGroups,
+                                              GLUSuint *capacityGroups,
+                                              GLUSuint *numberIndicesGroup,
+                                              const GLUSchar *name) {
+  GLUSgroupList *newGroupList;
+
+  GLUSuint i;
+
+  if (*numberGroups > 0) {
+    if (!currentGroupList) {
+      return 0;
+    }
+
+    currentGroupList->group.numberIndices = *numberIndicesGroup;
+    *numberIndicesGroup = 0;
+  }
+
+  if (*numberGroups == *capacityGroups) {
+    GLUSgroupList *newGroups;
+
+    GLUSuint newCapacity = *capacityGroups > 0 ? 2 * *capacityGroups : 16;
+
+    if (*capacityGroups >= 0x80000000 ||
+        (GLUSuint64)newCapacity * sizeof(GLUSgroupList) > (size_t)-1) {
+      return 0;
+    }
+
+    newGroups = (GLUSgroupList *)glusMemoryRealloc(
+        wavefront->groups, newCapacity * sizeof(GLUSgroupList));
+
+    if (!newGroups) {
+      return 0;
+    }
+
+    wavefront->groups = newGroups;
+    *capacityGroups = newCapacity;
+
+    for (i = 0; i + 1 < *numberGroups; i++) {
+      newGroups[i].next = &newGroups[i + 1];
+    }
+  }
+
+  newGroupList = &wavefront->groups[*numberGroups];
+
+  memset(newGroupList, 0, sizeof(GLUSgroupList));
+
+  strcpy(newGroupList->group.name, name);
+
+  if (*numberGroups > 0) {
+    wavefront->groups[*numberGroups - 1].next = newGroupList;
+  }
+
+  (*numberGroups)++;
+
+  return newGroupList;
+}
+
+// Interleaves all attributes with the same layout as the created shapes.
+// Missing attributes are zero.
+static GLUSboolean glusWavefrontInterleave(GLUSshape *shape) {
+  GLUSuint i;
+
+  // vertex, normal, tangent, bitangent, texCoords
+  GLUSuint stride = 4 + 3 + 3 + 3 + 2;
+
+  if (shape->numberVertices == 0) {
+    return GLUS_TRUE;
+  }
+
+  shape->allAttributes = (GLUSfloat *)glusMemoryMalloc(
+      (size_t)stride * shape->numberVertices * sizeof(GLUSfloat));
+
+  if (!shape->allAttributes) {
+    return GLUS_FALSE;
+  }
+
+  memset(shape->allAttributes, 0,
+         (size_t)stride * shape->numberVertices * sizeof(GLUSfloat));
+
+  for (i = 0; i < shape->numberVertices; i++) {
+    GLUSfloat *current = &shape->allAttributes[(size_t)i * stride];
+
+    memcpy(&current[0], &shape->vertices[i * 4], 4 * sizeof(GLUSfloat));
+
+    if (shape->normals) {
+      memcpy(&current[4], &shape->normals[i * 3], 3 * sizeof(GLUSfloat));
+    }
+
+    if (shape->tangents) {
+      memcpy(&current[7], &shape->tangents[i * 3], 3 * sizeof(GLUSfloat));
+    }
+
+    if (shape->bitangents) {
+      memcpy(&current[10], &shape->bitangents[i * 3], 3 * sizeof(GLUSfloat));
+    }
+
+    if (shape->texCoords) {
+      memcpy(&current[13], &shape->texCoords[i * 2], 2 * sizeof(GLUSfloat));
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+// Frees an attribute, which was only needed to create other attributes.
+static GLUSvoid glusWavefrontFreeAttribute(GLUSfloat **attribute) {
+  if (*attribute) {
+    glusMemoryFree(*attribute);
+
+    *attribute = 0;
+  }
+}
+
+static GLUSboolean glusWavefrontCreateShape(
+    GLUSshape *shape, GLUSuint totalNumberVertices,
+    const GLUSint *triangleIndices, const GLUSfloat *vertices,
+    const GLUSfloat *normals, const GLUSfloat *texCoords,
+    const GLUSwavefrontoptions *options) {
+  GLUSbitfield attributes = options->attributes;
+
+  GLUSboolean result;
+
+  if (options->indexed) {
+    result = glusWavefrontCopyDataIndexed(shape, totalNumberVertices,
+                                          triangleIndices, vertices, normals,
+                                          texCoords, attributes);
+  } else {
+    result = glusWavefrontCopyData(shape, totalNumberVertices,
+                                   triangleIndices, vertices, normals,
+                                   texCoords, attributes);
+  }
+
+  if (!result) {
+    return GLUS_FALSE;
+  }
+
+  if (attributes &
+      (GLUS_ATTRIBUTE_TANGENTS | GLUS_ATTRIBUTE_BITANGENTS |
+       GLUS_ATTRIBUTE_ALL_ATTRIBUTES)) {
+    glusShapeCalculateTangentBitangentf(shape);
+  }
+
+  if (attributes & GLUS_ATTRIBUTE_ALL_ATTRIBUTES) {
+    if (!glusWavefrontInterleave(shape)) {
+      glusShapeDestroyf(shape);
+
+      return GLUS_FALSE;
+    }
+  }
+
+  if (!(attributes & GLUS_ATTRIBUTE_NORMALS)) {
+    glusWavefrontFreeAttribute(&shape->normals);
+  }
+
+  if (!(attributes & GLUS_ATTRIBUTE_TEXCOORDS)) {
+    glusWavefrontFreeAttribute(&shape->texCoords);
+  }
+
+  if (!(attributes & GLUS_ATTRIBUTE_TANGENTS)) {
+    glusWavefrontFreeAttribute(&shape->tangents);
+  }
+
+  if (!(attributes & GLUS_ATTRIBUTE_BITANGENTS)) {
+    glusWavefrontFreeAttribute(&shape->bitangents);
+  }
+
+  return GLUS_TRUE;
+}
+
+/**
+ * Structure for a structural keyword found in a chunk.
+ */
+typedef struct _GLUSwavefrontevent {
+  /**
+   * The type of the keyword.
+   */
+  GLUSuint type;
+
+  /**
+   * The text following the keyword.
+   */
+  const GLUSchar *text;
+
+  /**
+   * Number of triangle vertices in the chunk before the keyword.
+   */
+  GLUSuint numberTriangleVertices;
+
+} GLUSwavefrontevent;
+
+/**
+ * Structure for a part of the wavefront file, which is parsed by one thread.
+ */
+typedef struct _GLUSwavefrontchunk {
+  /**
+   * First character of the chunk.
+   */
+  const GLUSchar *begin;
+
+  /**
+   * First character after the chunk. Always after a new line or at the end.
+   */
+  const GLUSchar *end;
+
+  /**
+   * Number of vertices, normals and texture coordinates in the chunk.
+   */
+  GLUSuint numberVertices;
+  GLUSuint numberNormals;
+  GLUSuint numberTexCoords;
+
+  /**
+   * Number of vertices, normals and texture coordinates in previous chunks.
+   */
+  GLUSuint offsetVertices;
+  GLUSuint offsetNormals;
+  GLUSuint offsetTexCoords;
+
+  /**
+   * The triangle vertices of the chunk.
+   */
+  GLUSint *triangleIndices;
+  GLUSuint numberTriangleVertices;
+  GLUSuint capacityTriangleVertices;
+
+  /**
+   * Number of triangle vertices in previous chunks.
+   */
+  GLUSuint offsetTriangleVertices;
+
+  /**
+   * The structural keywords of the chunk.
+   */
+  GLUSwavefrontevent *events;
+  GLUSuint numberEvents;
+  GLUSuint capacityEvents;
+
+  /**
+   * GLUS_TRUE, if the chunk was parsed without an error.
+   */
+  GLUSboolean result;
+
+} GLUSwavefrontchunk;
+
+static GLUSuint
+glusWavefrontGetNumberThreads(const GLUSwavefrontoptions *options) {
+#ifdef _OPENMP
+  if (options->numberThreads == 0) {
+    return (GLUSuint)omp_get_num_procs();
+  }
+
+  return options->numberThreads;
+#else
+  return 1;
+#endif
+}
+
+static GLUSvoid glusWavefrontDestroyChunks(GLUSwavefrontchunk **chunks,
+                                           GLUSuint numberChunks) {
+  GLUSuint i;
+
+  if (!chunks || !*chunks) {
+    return;
+  }
+
+  for (i = 0; i < numberChunks; i++) {
+    if ((*chunks)[i].triangleIndices) {
+      glusMemoryFree((*chunks)[i].triangleIndices);
+    }
+
+    if ((*chunks)[i].events) {
+      glusMemoryFree((*chunks)[i].events);
+    }
+  }
+
+  glusMemoryFree(*chunks);
+
+  *chunks = 0;
+}
+
+// Splits the text at new lines, so no line is shared by two chunks.
+static GLUSwavefrontchunk *glusWavefrontCreateChunks(const GLUSchar *text,
+                                                     GLUSuint numberThreads,
+                                                     GLUSuint *numberChunks) {
+  GLUSwavefrontchunk *chunks;
+
+  size_t length = strlen(text);
+  size_t maxChunks = length / GLUS_MIN_CHUNK_SIZE;
+
+  const GLUSchar *begin = text;
+
+  GLUSuint i;
+
+  *numberChunks = 1;
+
+  if (numberThreads > 1 && maxChunks > 1) {
+    *numberChunks = numberThreads * GLUS_CHUNKS_PER_THREAD;
+
+    if (*numberChunks > maxChunks) {
+      *numberChunks = (GLUSuint)maxChunks;
+    }
+  }
+
+  chunks = (GLUSwavefrontchunk *)glusMemoryMalloc(*numberChunks *
+                                                 sizeof(GLUSwavefrontchunk));
+
+  if (!chunks) {
+    return 0;
+  }
+
+  memset(chunks, 0, *numberChunks * sizeof(GLUSwavefrontchunk));
+
+  for (i = 0; i < *numberChunks; i++) {
+    const GLUSchar *end = text + length;
+
+    if (i + 1 < *numberChunks) {
+      end = text + length / *numberChunks * (i + 1);
+
+      if (end < begin) {
+        end = begin;
+      }
+
+      end = glusWavefrontSkipLine(end);
+    }
+
+    chunks[i].begin = begin;
+    chunks[i].end = end;
+
+    begin = end;
+  }
+
+  return chunks;
+}
+
+// Counts the vertices, normals and texture coordinates, so the parsed values of
+// all chunks can be stored into one array.
+static GLUSvoid glusWavefrontCountChunk(GLUSwavefrontchunk *chunk) {
+  const GLUSchar *c = chunk->begin;
+  const GLUSchar *token;
+  const GLUSchar *tokenEnd;
+
+  while (c < chunk->end) {
+    token = glusWavefrontSkipSpaces(c);
+    tokenEnd = glusWavefrontSkipToken(token);
+
+    if (*token == 'v') {
+      if (tokenEnd - token == 1) {
+        chunk->numberVertices++;
+      } else if (tokenEnd - token == 2 && token[1] == 'n') {
+        chunk->numberNormals++;
+      } else if (tokenEnd - token == 2 && token[1] == 't') {
+        chunk->numberTexCoords++;
+      }
+    }
+
+    c = glusWavefrontSkipLine(tokenEnd);
+  }
+}
+
+static GLUSboolean glusWavefrontAddEvent(GLUSwavefrontchunk *chunk,
+                                         GLUSuint type, const GLUSchar *text) {
+  GLUSwavefrontevent *event;
+
+  if (chunk->numberEvents == chunk->capacityEvents) {
+    chunk->events = (GLUSwavefrontevent *)glusWavefrontGrowMemory(
+        chunk->events, &chunk->capacityEvents, sizeof(GLUSwavefrontevent));
+
+    if (!chunk->events) {
+      return GLUS_FALSE;
+    }
+  }
+
+  event = &chunk->events[chunk->numberEvents];
+
+  event->type = type;
+  event->text = text;
+  event->numberTriangleVertices = chunk->numberTriangleVertices;
+
+  chunk->numberEvents++;
+
+  return GLUS_TRUE;
+}
+
+// Parses the vertices, normals, texture coordinates and faces of a chunk. The
+// attributes are stored after the ones of the previous chunks, so indices do
+// resolve in the same way as if the whole file is parsed at once. The attribute
+// arrays are only grown, if the file is parsed as one chunk. Otherwise, the
+// capacities are the counted numbers and are never exceeded.
+static GLUSvoid glusWavefrontParseChunk(
+    GLUSwavefrontchunk *chunk, GLUSfloat **vertices, GLUSuint *capacityVertices,
+    GLUSfloat **normals, GLUSuint *capacityNormals, GLUSfloat **texCoords,
+    GLUSuint *capacityTexCoords) {
+  const GLUSchar *c = chunk->begin;
+  const GLUSchar *token;
+  const GLUSchar *tokenEnd;
+
+  GLUSuint numberVertices = chunk->offsetVertices;
+  GLUSuint numberNormals = chunk->offsetNormals;
+  GLUSuint numberTexCoords = chunk->offsetTexCoords;
+
+  chunk->result = GLUS_FALSE;
+
+  while (c < chunk->end) {
+    c = glusWavefrontSkipSpaces(c);
+
+    token = c;
+    tokenEnd = glusWavefrontSkipToken(c);
+
+    c = tokenEnd;
+
+    if (tokenEnd - token == 1 && *token == 'v') {
+      GLUSfloat *vertex;
+
+      if (numberVertices == *capacityVertices) {
+        *vertices = (GLUSfloat *)glusWavefrontGrowMemory(
+            *vertices, capacityVertices, 4 * sizeof(GLUSfloat));
+
+        if (!*vertices) {
+          return;
+        }
+      }
+
+      vertex = &(*vertices)[4 * numberVertices];
+
+      vertex[0] = 0.0f;
+      vertex[1] = 0.0f;
+      vertex[2] = 0.0f;
+      vertex[3] = 1.0f;
+
+      c = glusWavefrontParseFloat(c, &vertex[0]);
+      c = glusWavefrontParseFloat(c, &vertex[1]);
+      c = glusWavefrontParseFloat(c, &vertex[2]);
+
+      numberVertices++;
+    } else if (tokenEnd - token == 1 && *token == 'f') {
+      GLUSint corner[3];
+      GLUSint firstCorner[3];
+      GLUSint previousCorner[3];
+
+      GLUSuint edgeCount = 0;
+
+      c = glusWavefrontSkipSpaces(c);
+
+      while (*c && *c != '\n' && *c != '#') {
+        c = glusWavefrontParseIndex(c, (GLUSint)numberVertices, &corner[0]);
+
+        corner[1] = -1;
+        corner[2] = -1;
+
+        if (*c == '/') {
+          c++;
+
+          if (*c != '/') {
+            c = glusWavefrontParseIndex(c, (GLUSint)numberTexCoords,
+                                        &corner[1]);
+          }
+
+          if (*c == '/') {
+            c++;
+
+            c = glusWavefrontParseIndex(c, (GLUSint)numberNormals, &corner[2]);
+          }
+        }
+
+        c = glusWavefrontSkipToken(c);
+        c = glusWavefrontSkipSpaces(c);
+
+        if (corner[0] < 0) {
+          continue;
+        }
+
+        if (corner[0] >= (GLUSint)numberVertices ||
+            corner[1] >= (GLUSint)numberTexCoords ||
+            corner[2] >= (GLUSint)numberNormals) {
+          return;
+        }
+
+        // Polygons are triangulated as a fan around the first corner.
+
+        if (edgeCount == 0) {
+          memcpy(firstCorner, corner, 3 * sizeof(GLUSint));
+        } else if (edgeCount >= 2) {
+          GLUSint *triangle;
+
+          if (chunk->numberTriangleVertices + 3 >
+              chunk->capacityTriangleVertices) {
+            chunk->triangleIndices = (GLUSint *)glusWavefrontGrowMemory(
+                chunk->triangleIndices, &chunk->capacityTriangleVertices,
+                3 * sizeof(GLUSint));
+
+            if (!chunk->triangleIndices) {
+              return;
+            }
+          }
+
+          triangle = &chunk->triangleIndices[3 * chunk->numberTriangleVertices];
+
+          memcpy(&triangle[0], firstCorner, 3 * sizeof(GLUSint));
+          memcpy(&triangle[3], previousCorner, 3 * sizeof(GLUSint));
+          memcpy(&triangle[6], corner, 3 * sizeof(GLUSint));
+
+          chunk->numberTriangleVertices += 3;
+        }
+
+        memcpy(previousCorner, corner, 3 * sizeof(GLUSint));
+
+        edgeCount++;
+      }
+    } else if (glusWavefrontIsKeyword(token, tokenEnd, "vn")) {
+      GLUSfloat *normal;
+
+      if (numberNormals == *capacityNormals) {
+        *normals = (GLUSfloat *)glusWavefrontGrowMemory(
+            *normals, capacityNormals, 3 * sizeof(GLUSfloat));
+
+        if (!*normals) {
+          return;
+        }
+      }
+
+      normal = &(*normals)[3 * numberNormals];
+
+      normal[0] = 0.0f;
+      normal[1] = 0.0f;
+      normal[2] = 0.0f;
+
+      c = glusWavefrontParseFloat(c, &normal[0]);
+      c = glusWavefrontParseFloat(c, &normal[1]);
+      c = glusWavefrontParseFloat(c, &normal[2]);
+
+      numberNormals++;
+    } else if (glusWavefrontIsKeyword(token, tokenEnd, "vt")) {
+      GLUSfloat *texCoord;
+
+      if (numberTexCoords == *capacityTexCoords) {
+        *texCoords = (GLUSfloat *)glusWavefrontGrowMemory(
+            *texCoords, capacityTexCoords, 2 * sizeof(GLUSfloat));
+
+        if (!*texCoords) {
+          return;
+        }
+      }
+
+      texCoord = &(*texCoords)[2 * numberTexCoords];
+
+      texCoord[0] = 0.0f;
+      texCoord[1] = 0.0f;
+
+      c = glusWavefrontParseFloat(c, &texCoord[0]);
+      c = glusWavefrontParseFloat(c, &texCoord[1]);
+
+      numberTexCoords++;
+    } else if (glusWavefrontIsKeyword(token, tokenEnd, "o")) {
+      if (!glusWavefrontAddEvent(chunk, GLUS_EVENT_OBJECT, c)) {
+        return;
+      }
+    } else if (glusWavefrontIsKeyword(token, tokenEnd, "g")) {
+      if (!glusWavefrontAddEvent(chunk, GLUS_EVENT_GROUP, c)) {
+        return;
+      }
+    } else if (glusWavefrontIsKeyword(token, tokenEnd, "mtllib")) {
+      if (!glusWavefrontAddEvent(chunk, GLUS_EVENT_MATERIAL_LIBRARY, c)) {
+        return;
+      }
+    } else if (glusWavefrontIsKeyword(token, tokenEnd, "usemtl")) {
+      if (!glusWavefrontAddEvent(chunk, GLUS_EVENT_USE_MATERIAL, c)) {
+        return;
+      }
+    }
+
+    c = glusWavefrontSkipLine(c);
+  }
+
+  chunk->numberVertices = numberVertices - chunk->offsetVertices;
+  chunk->numberNormals = numberNormals - chunk->offsetNormals;
+  chunk->numberTexCoords = numberTexCoords - chunk->offsetTexCoords;
+
+  chunk->result = GLUS_TRUE;
+}
+
+// Parses all chunks, so that vertices, normals, texture coordinates and
+// triangle vertices are stored one after another in file order.
+static GLUSboolean glusWavefrontParseChunks(
+    GLUSwavefrontchunk *chunks, GLUSuint numberChunks, GLUSuint numberThreads,
+    GLUSfloat **vertices, GLUSfloat **normals, GLUSfloat **texCoords,
+    GLUSint **triangleIndices, GLUSuint *numberTriangleVertices) {
+  GLUSuint64 numberVertices = 0;
+  GLUSuint64 numberNormals = 0;
+  GLUSuint64 numberTexCoords = 0;
+  GLUSuint64 numberAllTriangleVertices = 0;
+
+  GLUSuint capacityVertices = 0;
+  GLUSuint capacityNormals = 0;
+  GLUSuint capacityTexCoords = 0;
+
+  GLUSint i;
+
+  // A single chunk is parsed like a stream, so counting would only cost time.
+  if (numberChunks > 1) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(numberThreads)
+#endif
+    for (i = 0; i < (GLUSint)numberChunks; i++) {
+      glusWavefrontCountChunk(&chunks[i]);
+    }
+
+    // The offsets of a chunk are the sums of all previous chunks.
+
+    for (i = 0; i < (GLUSint)numberChunks; i++) {
+      chunks[i].offsetVertices = (GLUSuint)numberVertices;
+      chunks[i].offsetNormals = (GLUSuint)numberNormals;
+      chunks[i].offsetTexCoords = (GLUSuint)numberTexCoords;
+
+      numberVertices += chunks[i].numberVertices;
+      numberNormals += chunks[i].numberNormals;
+      numberTexCoords += chunks[i].numberTexCoords;
+    }
+
+    // Indices are parsed as signed integers.
+    if (numberVertices > 0x7FFFFFFF || numberNormals > 0x7FFFFFFF ||
+        numberTexCoords > 0x7FFFFFFF) {
+      return GLUS_FALSE;
+    }
+
+    if (numberVertices > 0) {
+      *vertices = (GLUSfloat *)glusMemoryMalloc((size_t)numberVertices * 4 *
+                                                sizeof(GLUSfloat));
+    }
+    if (numberNormals > 0) {
+      *normals = (GLUSfloat *)glusMemoryMalloc((size_t)numberNormals * 3 *
+                                               sizeof(GLUSfloat));
+    }
+    if (numberTexCoords > 0) {
+      *texCoords = (GLUSfloat *)glusMemoryMalloc((size_t)numberTexCoords * 2 *
+                                                 sizeof(GLUSfloat));
+    }
+
+    if ((numberVertices > 0 && !*vertices) ||
+        (numberNormals > 0 && !*normals) ||
+        (numberTexCoords > 0 && !*texCoords)) {
+      return GLUS_FALSE;
+    }
+
+    capacityVertices = (GLUSuint)numberVertices;
+    capacityNormals = (GLUSuint)numberNormals;
+    capacityTexCoords = (GLUSuint)numberTexCoords;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(numberThreads)
+#endif
+  for (i = 0; i < (GLUSint)numberChunks; i++) {
+    glusWavefrontParseChunk(&chunks[i], vertices, &capacityVertices, normals,
+                            &capacityNormals, texCoords, &capacityTexCoords);
+  }
+
+  for (i = 0; i < (GLUSint)numberChunks; i++) {
+    if (!chunks[i].result) {
+      return GLUS_FALSE;
+    }
+
+    chunks[i].offsetTriangleVertices = (GLUSuint)numberAllTriangleVertices;
+
+    numberAllTriangleVertices += chunks[i].numberTriangleVertices;
+  }
+
+  if (numberAllTriangleVertices > 0xFFFFFFFF) {
+    return GLUS_FALSE;
+  }
+
+  *numberTriangleVertices = (GLUSuint)numberAllTriangleVertices;
+
+  // A single chunk already has all triangle vertices in one array.
+  if (numberChunks == 1) {
+    *triangleIndices = chunks[0].triangleIndices;
+
+    chunks[0].triangleIndices = 0;
+
+    return GLUS_TRUE;
+  }
+
+  if (numberAllTriangleVertices > 0) {
+    *triangleIndices = (GLUSint *)glusMemoryMalloc(
+        (size_t)numberAllTriangleVertices * 3 * sizeof(GLUSint));
+
+    if (!*triangleIndices) {
+      return GLUS_FALSE;
+    }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numberThreads)
+#endif
+  for (i = 0; i < (GLUSint)numberChunks; i++) {
+    if (chunks[i].numberTriangleVertices > 0) {
+      memcpy(&(*triangleIndices)[3 * (size_t)chunks[i].offsetTriangleVertices],
+             chunks[i].triangleIndices,
+             (size_t)chunks[i].numberTriangleVertices * 3 * sizeof(GLUSint));
+    }
+  }
+
+  return GLUS_TRUE;
+}
+
+/**
+ * Structure for the state of a wavefront stream.
+ */
+typedef struct _GLUSwavefrontstream {
+  /**
+   * All vertices, normals and texture coordinates parsed so far.
+   */
+  GLUSfloat *vertices;
+  GLUSuint capacityVertices;
+  GLUSuint numberVertices;
+
+  GLUSfloat *normals;
+  GLUSuint capacityNormals;
+  GLUSuint numberNormals;
+
+  GLUSfloat *texCoords;
+  GLUSuint capacityTexCoords;
+  GLUSuint numberTexCoords;
+
+  /**
+   * The batch passed to the stream function and its capacity in vertices.
+   */
+  GLUSwavefrontbatch batch;
+  GLUSuint capacityBatch;
+
+  GLUSfloat *batchVertices;
+  GLUSfloat *batchNormals;
+  GLUSfloat *batchTexCoords;
+
+  GLUSchar objectName[GLUS_MAX_STRING];
+  GLUSchar groupName[GLUS_MAX_STRING];
+  GLUSchar materialName[GLUS_MAX_STRING];
+
+  /**
+   * The material names in the order of appearance.
+   */
+  GLUSchar (*materialNames)[GLUS_MAX_STRING];
+  GLUSuint capacityMaterialNames;
+  GLUSuint numberMaterialNames;
+
+  /**
+   * Hash table of the material names with open addressing. It stores the index
+   * of a name plus one, zero marks a free entry.
+   */
+  GLUSuint *materialTable;
+  GLUSuint capacityMaterialTable;
+
+  GLUSboolean (*glusStreamFunc)(const GLUSwavefrontbatch *batch,
+                                GLUSvoid *userData);
+  GLUSvoid *userData;
+
+} GLUSwavefrontstream;
+
+static GLUSvoid glusWavefrontDestroyStream(GLUSwavefrontstream *stream) {
+  glusWavefrontFreeTempMemory(&stream->vertices, &stream->normals,
+                              &stream->texCoords, 0);
+  glusWavefrontFreeTempMemory(&stream->batchVertices, &stream->batchNormals,
+                              &stream->batchTexCoords, 0);
+
+  if (stream->materialNames) {
+    glusMemoryFree(stream->materialNames);
+
+    stream->materialNames = 0;
   }
 
-  if (!glusWavefrontMallocTempMemory(&vertices, &normals, &texCoords,
-                                     &triangleVertices, &triangleNormals,
-                                     &triangleTexCoords)) {
-    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                &triangleVertices, &triangleNormals,
-                                &triangleTexCoords);
+  if (stream->materialTable) {
+    glusMemoryFree(stream->materialTable);
+
+    stream->materialTable = 0;
+  }
+}
 
-    glusFileClose(f);
+static GLUSboolean glusWavefrontFlushStream(GLUSwavefrontstream *stream) {
+  GLUSboolean result;
 
-    return GLUS_FALSE;
+  if (stream->batch.numberVertices == 0) {
+    return GLUS_TRUE;
   }
 
-  while (!feof(f)) {
-    buffer[0] = 0;
+  result = stream->glusStreamFunc(&stream->batch, stream->userData);
 
-    if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0) {
-      if (ferror(f)) {
-        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                    &triangleVertices, &triangleNormals,
-                                    &triangleTexCoords);
+  stream->batch.numberVertices = 0;
 
-        glusFileClose(f);
+  return result;
+}
 
-        return GLUS_FALSE;
-      }
-    }
+// Stores the index of the material name in the first free entry of the hash
+// table.
+static GLUSvoid glusWavefrontInsertMaterialName(GLUSwavefrontstream *stream,
+                                                GLUSuint index) {
+  GLUSuint mask = stream->capacityMaterialTable - 1;
 
-    if (wavefront) {
-      if (strncmp(buffer, "mtllib", 6) == 0) {
-        sscanf(buffer, "%s %s", identifier, name);
+  GLUSuint i = glusWavefrontHashName(stream->materialNames[index]) & mask;
 
-        if (numberMaterials == 0) {
-          wavefront->materials = 0;
-        }
+  while (stream->materialTable[i]) {
+    i = (i + 1) & mask;
+  }
 
-        {
+  stream->materialTable[i] = index + 1;
+}
 
-          int dirlen = strlen(dir);
-          int namelen = strlen(name);
-          char *fullpath = malloc(dirlen + namelen + 2);
-          {
-            strncpy(fullpath, dir, dirlen);
-            fullpath[dirlen] = '/';
-            strncpy(&fullpath[dirlen + 1], name, namelen);
-            fullpath[dirlen + namelen + 1] = 0;
-          }
-          if (!glusWavefrontLoadMaterial(fullpath, &wavefront->materials)) {
-            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                        &triangleVertices, &triangleNormals,
-                                        &triangleTexCoords);
-            glusFileClose(f);
-            free(fullpath);
-            return GLUS_FALSE;
-          }
-          free(fullpath);
-        }
-        numberMaterials++;
-      } else if (strncmp(buffer, "usemtl", 6) == 0) {
-        if (!currentGroupList ||
-            currentGroupList->group.materialName[0] != '\0') {
-          GLUSgroupList *newGroupList;
+// Doubles the hash table of the material names and inserts all names again.
+static GLUSboolean glusWavefrontGrowMaterialTable(GLUSwavefrontstream *stream) {
+  GLUSuint newCapacity = stream->capacityMaterialTable > 0
+                             ? 2 * stream->capacityMaterialTable
+                             : 16;
 
-          newGroupList =
-              (GLUSgroupList *)glusMemoryMalloc(sizeof(GLUSgroupList));
+  GLUSuint *newTable;
 
-          if (!newGroupList) {
-            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                        &triangleVertices, &triangleNormals,
-                                        &triangleTexCoords);
+  GLUSuint i;
 
-            glusFileClose(f);
+  if (stream->capacityMaterialTable >= 0x80000000) {
+    return GLUS_FALSE;
+  }
 
-            return GLUS_FALSE;
-          }
+  newTable =
+      (GLUSuint *)glusMemoryMalloc((size_t)newCapacity * sizeof(GLUSuint));
 
-          memset(newGroupList, 0, sizeof(GLUSgroupList));
+  if (!newTable) {
+    return GLUS_FALSE;
+  }
 
-          strcpy(newGroupList->group.name, name);
+  memset(newTable, 0, (size_t)newCapacity * sizeof(GLUSuint));
 
-          if (numberGroups == 0) {
-            wavefront->groups = newGroupList;
-          } else {
-            if (!currentGroupList) {
-              glusMemoryFree(newGroupList);
+  if (stream->materialTable) {
+    glusMemoryFree(stream->materialTable);
+  }
 
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+  stream->materialTable = newTable;
+  stream->capacityMaterialTable = newCapacity;
 
-              glusFileClose(f);
+  for (i = 0; i < stream->numberMaterialNames; i++) {
+    glusWavefrontInsertMaterialName(stream, i);
+  }
 
-              return GLUS_FALSE;
-            }
+  return GLUS_TRUE;
+}
 
-            currentGroupList->next = newGroupList;
+// Returns the index of the material name. A new name is appended. Names are
+// looked up with the same hash as the material index of the loaders, so many
+// material switches stay linear.
+static GLUSint glusWavefrontGetMaterialIndex(GLUSwavefrontstream *stream,
+                                             const GLUSchar *name) {
+  GLUSuint i;
 
-            currentGroupList->group.numberIndices = numberIndicesGroup;
-            numberIndicesGroup = 0;
-          }
+  if (stream->capacityMaterialTable > 0) {
+    GLUSuint mask = stream->capacityMaterialTable - 1;
 
-          currentGroupList = newGroupList;
+    i = glusWavefrontHashName(name) & mask;
 
-          numberGroups++;
-        }
+    while (stream->materialTable[i]) {
+      if (strcmp(stream->materialNames[stream->materialTable[i] - 1], name) ==
+          0) {
+        return (GLUSint)(stream->materialTable[i] - 1);
+      }
 
-        //
+      i = (i + 1) & mask;
+    }
+  }
 
-        sscanf(buffer, "%s %s", identifier, name);
+  // The table is kept at most half full.
+  if (2 * (stream->numberMaterialNames + 1) > stream->capacityMaterialTable &&
+      !glusWavefrontGrowMaterialTable(stream)) {
+    return -1;
+  }
 
-        strcpy(currentGroupList->group.materialName, name);
-      } else if (strncmp(buffer, "g", 1) == 0) {
-        GLUSgroupList *newGroupList;
+  if (stream->numberMaterialNames == stream->capacityMaterialNames) {
+    stream->materialNames = (GLUSchar(*)[GLUS_MAX_STRING])
+        glusWavefrontGrowMemory(stream->materialNames,
+                                &stream->capacityMaterialNames,
+                                GLUS_MAX_STRING * sizeof(GLUSchar));
 
-        sscanf(buffer, "%s %s", identifier, name);
+    if (!stream->materialNames) {
+      return -1;
+    }
+  }
 
-        newGroupList = (GLUSgroupList *)glusMemoryMalloc(sizeof(GLUSgroupList));
+  strcpy(stream->materialNames[stream->numberMaterialNames], name);
 
-        if (!newGroupList) {
-          glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                      &triangleVertices, &triangleNormals,
-                                      &triangleTexCoords);
+  glusWavefrontInsertMaterialName(stream, stream->numberMaterialNames);
 
-          glusFileClose(f);
+  stream->numberMaterialNames++;
 
-          return GLUS_FALSE;
-        }
+  return (GLUSint)(stream->numberMaterialNames - 1);
+}
 
-        memset(newGroupList, 0, sizeof(GLUSgroupList));
+// Handles a structural keyword. The current batch is passed before, as all
+// triangles of a batch belong to the same object, group and material.
+static GLUSboolean glusWavefrontStreamEvent(GLUSwavefrontstream *stream,
+                                           const GLUSwavefrontevent *event) {
+  if (event->type == GLUS_EVENT_MATERIAL_LIBRARY) {
+    return GLUS_TRUE;
+  }
 
-        strcpy(newGroupList->group.name, name);
+  if (!glusWavefrontFlushStream(stream)) {
+    return GLUS_FALSE;
+  }
 
-        if (numberGroups == 0) {
-          wavefront->groups = newGroupList;
-        } else {
-          if (!currentGroupList) {
-            glusMemoryFree(newGroupList);
+  if (event->type == GLUS_EVENT_OBJECT) {
+    glusWavefrontParseName(event->text, stream->objectName);
 
-            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                        &triangleVertices, &triangleNormals,
-                                        &triangleTexCoords);
+    stream->batch.objectIndex++;
+  } else if (event->type == GLUS_EVENT_GROUP) {
+    glusWavefrontParseName(event->text, stream->groupName);
 
-            glusFileClose(f);
+    stream->batch.groupIndex++;
+  } else if (event->type == GLUS_EVENT_USE_MATERIAL) {
+    glusWavefrontParseName(event->text, stream->materialName);
 
-            return GLUS_FALSE;
-          }
+    stream->batch.materialIndex =
+        glusWavefrontGetMaterialIndex(stream, stream->materialName);
 
-          currentGroupList->next = newGroupList;
+    if (stream->batch.materialIndex < 0) {
+      return GLUS_FALSE;
+    }
+  }
 
-          currentGroupList->group.numberIndices = numberIndicesGroup;
-          numberIndicesGroup = 0;
-        }
+  return GLUS_TRUE;
+}
+
+// Expands the triangle vertices into the batch. Missing normals and texture
+// coordinates are zero.
+static GLUSboolean glusWavefrontStreamTriangles(GLUSwavefrontstream *stream,
+                                               const GLUSint *triangleIndices,
+                                               GLUSuint numberVertices) {
+  GLUSuint i;
 
-        currentGroupList = newGroupList;
+  for (i = 0; i < numberVertices; i++) {
+    const GLUSint *corner = &triangleIndices[3 * i];
 
-        numberGroups++;
+    GLUSuint k = stream->batch.numberVertices;
+
+    if (i % 3 == 0 && k + 3 > stream->capacityBatch) {
+      if (!glusWavefrontFlushStream(stream)) {
+        return GLUS_FALSE;
       }
+
+      k = 0;
     }
 
-    if (strncmp(buffer, "o", 1) == 0) {
-      if (scene) {
-        GLUSobjectList *newObjectList;
+    memcpy(&stream->batchVertices[4 * k], &stream->vertices[4 * corner[0]],
+           4 * sizeof(GLUSfloat));
 
-        if (currentObjectList) {
-          if (wavefront && currentGroupList) {
-            currentGroupList->group.numberIndices = numberIndicesGroup;
-            numberIndicesGroup = 0;
-          }
+    if (corner[1] >= 0) {
+      memcpy(&stream->batchTexCoords[2 * k],
+             &stream->texCoords[2 * corner[1]], 2 * sizeof(GLUSfloat));
+    } else {
+      memset(&stream->batchTexCoords[2 * k], 0, 2 * sizeof(GLUSfloat));
+    }
 
-          result = glusWavefrontCopyData(
-              shape, totalNumberVertices - offsetNumberVertices,
-              &triangleVertices[4 * offsetNumberVertices],
-              totalNumberNormals - offsetNumberNormals,
-              &triangleNormals[3 * offsetNumberNormals],
-              totalNumberTexCoords - offsetNumberTexCoords,
-              &triangleTexCoords[2 * offsetNumberTexCoords]);
+    if (corner[2] >= 0) {
+      memcpy(&stream->batchNormals[3 * k], &stream->normals[3 * corner[2]],
+             3 * sizeof(GLUSfloat));
+    } else {
+      memset(&stream->batchNormals[3 * k], 0, 3 * sizeof(GLUSfloat));
+    }
 
-          if (result) {
-            glusShapeCalculateTangentBitangentf(shape);
-          }
+    stream->batch.numberVertices++;
+  }
 
-          if (!_glusWavefrontMove(wavefront, shape)) {
-            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                        &triangleVertices, &triangleNormals,
-                                        &triangleTexCoords);
+  return GLUS_TRUE;
+}
 
-            glusFileClose(f);
+// Parses complete lines with the chunk parser and passes the triangles and
+// keywords in file order.
+static GLUSboolean glusWavefrontStreamText(GLUSwavefrontstream *stream,
+                                          GLUSwavefrontchunk *chunk,
+                                          const GLUSchar *text,
+                                          size_t length) {
+  GLUSuint begin = 0;
+  GLUSuint i;
 
-            return GLUS_FALSE;
-          }
+  chunk->begin = text;
+  chunk->end = text + length;
 
-          memcpy(&currentObjectList->object, wavefront, sizeof(GLUSwavefront));
-        }
+  chunk->offsetVertices = stream->numberVertices;
+  chunk->offsetNormals = stream->numberNormals;
+  chunk->offsetTexCoords = stream->numberTexCoords;
 
-        sscanf(buffer, "%s %s", identifier, name);
+  chunk->numberTriangleVertices = 0;
+  chunk->numberEvents = 0;
 
-        strcpy(wavefront->name, name);
+  glusWavefrontParseChunk(chunk, &stream->vertices, &stream->capacityVertices,
+                          &stream->normals, &stream->capacityNormals,
+                          &stream->texCoords, &stream->capacityTexCoords);
 
-        // Always create a new object.
+  if (!chunk->result) {
+    return GLUS_FALSE;
+  }
 
-        newObjectList =
-            (GLUSobjectList *)glusMemoryMalloc(sizeof(GLUSobjectList));
-        if (!newObjectList) {
-          glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                      &triangleVertices, &triangleNormals,
-                                      &triangleTexCoords);
+  stream->numberVertices += chunk->numberVertices;
+  stream->numberNormals += chunk->numberNormals;
+  stream->numberTexCoords += chunk->numberTexCoords;
 
-          glusFileClose(f);
+  for (i = 0; i <= chunk->numberEvents; i++) {
+    GLUSuint end = i < chunk->numberEvents
+                       ? chunk->events[i].numberTriangleVertices
+                       : chunk->numberTriangleVertices;
 
-          return GLUS_FALSE;
-        }
-        newObjectList->next = 0;
+    if (!glusWavefrontStreamTriangles(
+            stream, &chunk->triangleIndices[3 * begin], end - begin)) {
+      return GLUS_FALSE;
+    }
 
-        // Link together.
-        if (currentObjectList) {
-          currentObjectList->next = newObjectList;
-        }
-        currentObjectList = newObjectList;
+    if (i < chunk->numberEvents &&
+        !glusWavefrontStreamEvent(stream, &chunk->events[i])) {
+      return GLUS_FALSE;
+    }
 
-        // Set as root, if needed.
-        if (scene->objectList == 0) {
-          scene->objectList = currentObjectList;
-        }
+    begin = end;
+  }
+
+  return GLUS_TRUE;
+}
 
-        // Remember offset and reset values.
+GLUSboolean _glusWavefrontParse(const GLUSchar *filename, GLUSshape *shape,
+                                GLUSwavefront *wavefront, GLUSscene *scene,
+                                const GLUSwavefrontoptions *options) {
+  GLUSboolean result;
 
-        offsetNumberVertices = totalNumberVertices;
-        offsetNumberNormals = totalNumberNormals;
-        offsetNumberTexCoords = totalNumberTexCoords;
+  GLUSwavefrontoptions defaultOptions;
 
-        numberGroups = 0;
+  GLUStextfile textfile;
 
-        currentGroupList = 0;
-      } else if (wavefront) {
-        GLUSgroupList *newGroupList;
+  const GLUSchar *c;
 
-        sscanf(buffer, "%s %s", identifier, name);
+  GLUSfloat *vertices = 0;
+  GLUSfloat *normals = 0;
+  GLUSfloat *texCoords = 0;
 
-        newGroupList = (GLUSgroupList *)glusMemoryMalloc(sizeof(GLUSgroupList));
+  GLUSint *triangleIndices = 0;
 
-        if (!newGroupList) {
-          glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                      &triangleVertices, &triangleNormals,
-                                      &triangleTexCoords);
+  GLUSuint offsetNumberVertices = 0;
 
-          glusFileClose(f);
+  GLUSuint totalNumberVertices = 0;
 
-          return GLUS_FALSE;
-        }
+  GLUSuint numberTriangleVertices = 0;
 
-        memset(newGroupList, 0, sizeof(GLUSgroupList));
+  // Chunks
 
-        strcpy(newGroupList->group.name, name);
+  GLUSwavefrontchunk *chunks = 0;
+  GLUSuint numberChunks = 0;
+  GLUSuint numberThreads;
 
-        if (numberGroups == 0) {
-          wavefront->groups = newGroupList;
-        } else {
-          if (!currentGroupList) {
-            glusMemoryFree(newGroupList);
+  GLUSuint i, k;
 
-            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                        &triangleVertices, &triangleNormals,
-                                        &triangleTexCoords);
+  // Material and groups
 
-            glusFileClose(f);
+  GLUSchar name[GLUS_MAX_STRING];
 
-            return GLUS_FALSE;
-          }
+  GLUSuint numberIndicesGroup = 0;
+  GLUSuint numberMaterials = 0;
+  GLUSuint numberGroups = 0;
+  GLUSuint capacityGroups = 0;
 
-          currentGroupList->next = newGroupList;
+  GLUSgroupList *currentGroupList = 0;
+  GLUSobjectList *currentObjectList = 0;
 
-          currentGroupList->group.numberIndices = numberIndicesGroup;
-          numberIndicesGroup = 0;
-        }
+  // Objects
 
-        currentGroupList = newGroupList;
+  GLUSuint numberObjects = 0;
 
-        numberGroups++;
-      } else {
-        if (numberObjects == GLUS_MAX_OBJECTS) {
-          glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                      &triangleVertices, &triangleNormals,
-                                      &triangleTexCoords);
+  if (scene) {
+    memset(scene, 0, sizeof(GLUSscene));
+  }
 
-          glusFileClose(f);
+  if (wavefront) {
+    memset(wavefront, 0, sizeof(GLUSwavefront));
+  }
 
-          return GLUS_FALSE;
-        }
-      }
+  if (shape) {
+    memset(shape, 0, sizeof(GLUSshape));
+  }
 
-      numberObjects++;
-    } else if (strncmp(buffer, "vt", 2) == 0) {
-      if (numberTexCoords == GLUS_MAX_ATTRIBUTES) {
-        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                    &triangleVertices, &triangleNormals,
-                                    &triangleTexCoords);
+  if (!filename || !shape) {
+    return GLUS_FALSE;
+  }
 
-        glusFileClose(f);
+  if (!options) {
+    glusWavefrontInitOptions(&defaultOptions);
 
-        return GLUS_FALSE;
+    options = &defaultOptions;
+  }
+
+  // get path of wavefront file
+  int len = strlen(filename);
+  char *dir = malloc(len + 1);
+  {
+    strcpy(dir, filename);
+    while (len > 0) {
+      len--;
+      if (dir[len] == '\\' || dir[len] == '/') {
+        dir[len] = '\0';
+        break;
       }
+    }
+  }
 
-      sscanf(buffer, "%s %f %f", identifier, &s, &t);
+  name[0] = '\0';
 
-      texCoords[2 * numberTexCoords + 0] = s;
-      texCoords[2 * numberTexCoords + 1] = t;
+  // The complete file is parsed in place.
+  if (!glusFileLoadText(filename, &textfile)) {
+    free(dir);
 
-      numberTexCoords++;
-    } else if (strncmp(buffer, "vn", 2) == 0) {
-      if (numberNormals == GLUS_MAX_ATTRIBUTES) {
-        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                    &triangleVertices, &triangleNormals,
-                                    &triangleTexCoords);
+    return GLUS_FALSE;
+  }
 
-        glusFileClose(f);
+  numberThreads = glusWavefrontGetNumberThreads(options);
 
-        return GLUS_FALSE;
-      }
+  chunks = glusWavefrontCreateChunks(textfile.text, numberThreads,
+                                     &numberChunks);
 
-      sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+  if (!chunks ||
+      !glusWavefrontParseChunks(chunks, numberChunks, numberThreads, &vertices,
+                                &normals, &texCoords, &triangleIndices,
+                                &numberTriangleVertices)) {
+    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                &triangleIndices);
 
-      normals[3 * numberNormals + 0] = x;
-      normals[3 * numberNormals + 1] = y;
-      normals[3 * numberNormals + 2] = z;
+    glusWavefrontDestroyChunks(&chunks, numberChunks);
 
-      numberNormals++;
-    } else if (strncmp(buffer, "v", 1) == 0) {
-      if (numberVertices == GLUS_MAX_ATTRIBUTES) {
-        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                    &triangleVertices, &triangleNormals,
-                                    &triangleTexCoords);
+    glusFileDestroyText(&textfile);
 
-        glusFileClose(f);
+    free(dir);
 
-        return GLUS_FALSE;
-      }
+    return GLUS_FALSE;
+  }
 
-      sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+  // Objects, groups and materials are processed in file order.
 
-      vertices[4 * numberVertices + 0] = x;
-      vertices[4 * numberVertices + 1] = y;
-      vertices[4 * numberVertices + 2] = z;
-      vertices[4 * numberVertices + 3] = 1.0f;
+  for (i = 0; i < numberChunks; i++) {
+    for (k = 0; k < chunks[i].numberEvents; k++) {
+      const GLUSwavefrontevent *event = &chunks[i].events[k];
 
-      numberVertices++;
-    } else if (strncmp(buffer, "f", 1) == 0) {
-      GLUSchar *token;
+      GLUSuint currentNumberVertices =
+          chunks[i].offsetTriangleVertices + event->numberTriangleVertices;
 
-      GLUSint vIndex, vtIndex, vnIndex;
+      c = event->text;
 
-      GLUSuint edgeCount = 0;
+      // The triangles since the previous keyword belong to the current group.
+      numberIndicesGroup += currentNumberVertices - totalNumberVertices;
 
-      token = strtok(buffer, " \t");
-      token = strtok(0, " \n");
+      totalNumberVertices = currentNumberVertices;
 
-      if (!token) {
-        continue;
-      }
+      if (wavefront && event->type == GLUS_EVENT_MATERIAL_LIBRARY) {
+        c = glusWavefrontParseName(c, name);
 
-      // Check faces
-      if (strstr(token, "//") != 0) {
-        facesEncoding = 2;
-      } else if (strstr(token, "/") == 0) {
-        facesEncoding = 0;
-      } else if (strstr(token, "/") != 0) {
-        GLUSchar *c = strstr(token, "/");
+        if (numberMaterials == 0) {
+          wavefront->materials = 0;
+        }
 
-        c++;
+        {
+          int dirlen = strlen(dir);
+          int namelen = strlen(name);
+          char *fullpath = malloc(dirlen + namelen + 2);
+          {
+            strncpy(fullpath, dir, dirlen);
+            fullpath[dirlen] = '/';
+            strncpy(&fullpath[dirlen + 1], name, namelen);
+            fullpath[dirlen + namelen + 1] = 0;
+          }
+          if (!glusWavefrontLoadMaterial(fullpath, &wavefront->materials)) {
+            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                        &triangleIndices);
+            glusWavefrontDestroyChunks(&chunks, numberChunks);
+            glusFileDestroyText(&textfile);
+            free(fullpath);
+            free(dir);
+            return GLUS_FALSE;
+          }
+          free(fullpath);
+        }
+        numberMaterials++;
+      } else if (wavefront && event->type == GLUS_EVENT_USE_MATERIAL) {
+        if (!currentGroupList ||
+            currentGroupList->group.materialName[0] != '\0') {
+          // The new group gets the most recently parsed name.
+          currentGroupList = glusWavefrontCreateGroup(
+              wavefront, currentGroupList, &numberGroups, &capacityGroups,
+              &numberIndicesGroup, name);
 
-        if (!c) {
-          continue;
+          if (!currentGroupList) {
+            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                        &triangleIndices);
+
+            glusWavefrontDestroyChunks(&chunks, numberChunks);
+
+            glusFileDestroyText(&textfile);
+
+            free(dir);
+
+            return GLUS_FALSE;
+          }
+        }
+
+        c = glusWavefrontParseName(c, name);
+
+        strcpy(currentGroupList->group.materialName, name);
+      } else if (wavefront && event->type == GLUS_EVENT_GROUP) {
+        c = glusWavefrontParseName(c, name);
+
+        currentGroupList =
+            glusWavefrontCreateGroup(wavefront, currentGroupList, &numberGroups,
+                                     &capacityGroups, &numberIndicesGroup,
+                                     name);
+
+        if (!currentGroupList) {
+          glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                      &triangleIndices);
+
+          glusWavefrontDestroyChunks(&chunks, numberChunks);
+
+          glusFileDestroyText(&textfile);
+
+          free(dir);
+
+          return GLUS_FALSE;
         }
+      } else if (event->type == GLUS_EVENT_OBJECT) {
+        if (scene) {
+          GLUSobjectList *newObjectList;
+
+          if (currentObjectList) {
+            if (currentGroupList) {
+              currentGroupList->group.numberIndices = numberIndicesGroup;
+            }
+
+            result = glusWavefrontCreateShape(
+                shape, totalNumberVertices - offsetNumberVertices,
+                &triangleIndices[3 * offsetNumberVertices], vertices, normals,
+                texCoords, options);
+
+            if (!result || !_glusWavefrontMove(wavefront, shape,
+                                               options->mergeGroups)) {
+              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                          &triangleIndices);
+
+              glusWavefrontDestroyChunks(&chunks, numberChunks);
+
+              glusFileDestroyText(&textfile);
+
+              free(dir);
+
+              return GLUS_FALSE;
+            }
+
+            memcpy(&currentObjectList->object, wavefront,
+                   sizeof(GLUSwavefront));
 
-        if (strstr(c, "/") == 0) {
-          facesEncoding = 1;
-        } else {
-          facesEncoding = 3;
-        }
-      }
+            // The groups belong to the previous object now.
+            wavefront->groups = 0;
 
-      while (token != 0) {
-        vIndex = -1;
-        vtIndex = -1;
-        vnIndex = -1;
-
-        switch (facesEncoding) {
-        case 0:
-          sscanf(token, "%d", &vIndex);
-          break;
-        case 1:
-          sscanf(token, "%d/%d", &vIndex, &vtIndex);
-          break;
-        case 2:
-          sscanf(token, "%d//%d", &vIndex, &vnIndex);
-          break;
-        case 3:
-          sscanf(token, "%d/%d/%d", &vIndex, &vtIndex, &vnIndex);
-          break;
-        }
+            wavefront->indices = 0;
+            wavefront->numberIndices = 0;
+            wavefront->ranges = 0;
+            wavefront->numberRanges = 0;
+          }
 
-        vIndex--;
-        vtIndex--;
-        vnIndex--;
+          c = glusWavefrontParseName(c, name);
 
-        if (vIndex >= 0) {
-          if (edgeCount < 3) {
-            if (totalNumberVertices >= GLUS_MAX_TRIANGLE_ATTRIBUTES) {
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+          strcpy(wavefront->name, name);
 
-              glusFileClose(f);
+          // Always create a new object.
 
-              return GLUS_FALSE;
-            }
+          newObjectList =
+              (GLUSobjectList *)glusMemoryMalloc(sizeof(GLUSobjectList));
+          if (!newObjectList) {
+            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                        &triangleIndices);
 
-            memcpy(&triangleVertices[4 * totalNumberVertices],
-                   &vertices[4 * vIndex], 4 * sizeof(GLUSfloat));
+            glusWavefrontDestroyChunks(&chunks, numberChunks);
 
-            totalNumberVertices++;
-            numberIndicesGroup++;
-          } else {
-            if (totalNumberVertices >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2) {
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+            glusFileDestroyText(&textfile);
 
-              glusFileClose(f);
+            free(dir);
 
-              return GLUS_FALSE;
-            }
+            return GLUS_FALSE;
+          }
+          memset(newObjectList, 0, sizeof(GLUSobjectList));
 
-            memcpy(&triangleVertices[4 * (totalNumberVertices)],
-                   &triangleVertices[4 * (totalNumberVertices - edgeCount)],
-                   4 * sizeof(GLUSfloat));
-            memcpy(&triangleVertices[4 * (totalNumberVertices + 1)],
-                   &triangleVertices[4 * (totalNumberVertices - 1)],
-                   4 * sizeof(GLUSfloat));
-            memcpy(&triangleVertices[4 * (totalNumberVertices + 2)],
-                   &vertices[4 * vIndex], 4 * sizeof(GLUSfloat));
-
-            totalNumberVertices += 3;
-            numberIndicesGroup += 3;
+          // Link together.
+          if (currentObjectList) {
+            currentObjectList->next = newObjectList;
           }
-        }
-        if (vnIndex >= 0) {
-          if (edgeCount < 3) {
-            if (totalNumberNormals >= GLUS_MAX_TRIANGLE_ATTRIBUTES) {
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+          currentObjectList = newObjectList;
 
-              glusFileClose(f);
+          // Set as root, if needed.
+          if (scene->objectList == 0) {
+            scene->objectList = currentObjectList;
+          }
 
-              return GLUS_FALSE;
-            }
+          // Remember offset and reset values.
 
-            memcpy(&triangleNormals[3 * totalNumberNormals],
-                   &normals[3 * vnIndex], 3 * sizeof(GLUSfloat));
+          offsetNumberVertices = totalNumberVertices;
 
-            totalNumberNormals++;
-          } else {
-            if (totalNumberNormals >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2) {
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+          numberIndicesGroup = 0;
 
-              glusFileClose(f);
+          numberGroups = 0;
+          capacityGroups = 0;
 
-              return GLUS_FALSE;
-            }
+          currentGroupList = 0;
+        } else if (wavefront) {
+          c = glusWavefrontParseName(c, name);
 
-            memcpy(&triangleNormals[3 * (totalNumberNormals)],
-                   &triangleNormals[3 * (totalNumberNormals - edgeCount)],
-                   3 * sizeof(GLUSfloat));
-            memcpy(&triangleNormals[3 * (totalNumberNormals + 1)],
-                   &triangleNormals[3 * (totalNumberNormals - 1)],
-                   3 * sizeof(GLUSfloat));
-            memcpy(&triangleNormals[3 * (totalNumberNormals + 2)],
-                   &normals[3 * vnIndex], 3 * sizeof(GLUSfloat));
+          currentGroupList = glusWavefrontCreateGroup(
+              wavefront, currentGroupList, &numberGroups, &capacityGroups,
+              &numberIndicesGroup, name);
 
-            totalNumberNormals += 3;
-          }
-        }
-        if (vtIndex >= 0) {
-          if (edgeCount < 3) {
-            if (totalNumberTexCoords >= GLUS_MAX_TRIANGLE_ATTRIBUTES) {
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+          if (!currentGroupList) {
+            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                        &triangleIndices);
 
-              glusFileClose(f);
+            glusWavefrontDestroyChunks(&chunks, numberChunks);
 
-              return GLUS_FALSE;
-            }
+            glusFileDestroyText(&textfile);
 
-            memcpy(&triangleTexCoords[2 * totalNumberTexCoords],
-                   &texCoords[2 * vtIndex], 2 * sizeof(GLUSfloat));
+            free(dir);
 
-            totalNumberTexCoords++;
-          } else {
-            if (totalNumberTexCoords >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2) {
-              glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                                          &triangleVertices, &triangleNormals,
-                                          &triangleTexCoords);
+            return GLUS_FALSE;
+          }
+        } else {
+          if (numberObjects == GLUS_MAX_OBJECTS) {
+            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
+                                        &triangleIndices);
 
-              glusFileClose(f);
+            glusWavefrontDestroyChunks(&chunks, numberChunks);
 
-              return GLUS_FALSE;
-            }
+            glusFileDestroyText(&textfile);
 
-            memcpy(&triangleTexCoords[2 * (totalNumberTexCoords)],
-                   &triangleTexCoords[2 * (totalNumberTexCoords - edgeCount)],
-                   2 * sizeof(GLUSfloat));
-            memcpy(&triangleTexCoords[2 * (totalNumberTexCoords + 1)],
-                   &triangleTexCoords[2 * (totalNumberTexCoords - 1)],
-                   2 * sizeof(GLUSfloat));
-            memcpy(&triangleTexCoords[2 * (totalNumberTexCoords + 2)],
-                   &texCoords[2 * vtIndex], 2 * sizeof(GLUSfloat));
+            free(dir);
 
-            totalNumberTexCoords += 3;
+            return GLUS_FALSE;
           }
         }
 
-        edgeCount++;
-
-        token = strtok(0, " \n");
+        numberObjects++;
       }
     }
   }
 
-  glusFileClose(f);
+  glusWavefrontDestroyChunks(&chunks, numberChunks);
+
+  glusFileDestroyText(&textfile);
+
+  numberIndicesGroup += numberTriangleVertices - totalNumberVertices;
+
+  totalNumberVertices = numberTriangleVertices;
 
   if (wavefront && currentGroupList) {
     currentGroupList->group.numberIndices = numberIndicesGroup;
     numberIndicesGroup = 0;
   }
 
-  result =
-      glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices,
-                            &triangleVertices[4 * offsetNumberVertices],
-                            totalNumberNormals - offsetNumberNormals,
-                            &triangleNormals[3 * offsetNumberNormals],
-                            totalNumberTexCoords - offsetNumberTexCoords,
-                            &triangleTexCoords[2 * offsetNumberTexCoords]);
+  result = glusWavefrontCreateShape(
+      shape, totalNumberVertices - offsetNumberVertices,
+      &triangleIndices[3 * offsetNumberVertices], vertices, normals, texCoords,
+      options);
 
   glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords,
-                              &triangleVertices, &triangleNormals,
-                              &triangleTexCoords);
-
-  if (result) {
-    glusShapeCalculateTangentBitangentf(shape);
-  }
+                              &triangleIndices);
 
   if (scene) {
-    if (!_glusWavefrontMove(wavefront, shape)) {
+    if (!result ||
+        !_glusWavefrontMove(wavefront, shape, options->mergeGroups)) {
       if (result) {
         glusShapeDestroyf(shape);
       }
 
+      free(dir);
+
       return GLUS_FALSE;
     }
 
@@ -1375,6 +2900,8 @@ GLUSboolean _glusWavefrontParse(const GLUSchar *filename, GLUSshape *shape,
       if (!scene->objectList) {
         glusWavefrontDestroy(wavefront);
 
+        free(dir);
+
         return GLUS_FALSE;
       }
       scene->objectList->next = 0;
@@ -1388,18 +2915,18 @@ GLUSboolean _glusWavefrontParse(const GLUSchar *filename, GLUSshape *shape,
   free(dir);
   return result;
 }
-
-GLUSboolean _glusWavefrontParseLine(const GLUSchar *filename, GLUSline *line) {
+// Parses the vertices and lines of a file. Either line gets the line segments
+// or every polyline is appended to the line batch as a line strip.
+static GLUSboolean glusWavefrontParseLines(const GLUSchar *filename,
+                                           GLUSline *line,
+                                           GLUSlinebatch *lineBatch) {
   GLUSboolean result;
 
-  FILE *f;
-
-  GLUSchar buffer[GLUS_BUFFERSIZE];
-  GLUSchar identifier[7];
-
-  GLUSfloat x, y, z;
+  GLUStextfile textfile;
 
-  GLUSint start, end;
+  const GLUSchar *c;
+  const GLUSchar *token;
+  const GLUSchar *tokenEnd;
 
   GLUSfloat *vertices = 0;
 
@@ -1409,6 +2936,10 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar *filename, GLUSline *line) {
 
   GLUSuint numberIndices = 0;
 
+  GLUSuint capacityVertices = 0;
+
+  GLUSuint capacityIndices = 0;
+
   // Objects
 
   GLUSuint numberObjects = 0;
@@ -1417,135 +2948,214 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar *filename, GLUSline *line) {
     memset(line, 0, sizeof(GLUSline));
   }
 
-  if (!filename || !line) {
-    return GLUS_FALSE;
-  }
-
-  f = glusFileOpen(filename, "r");
-
-  if (!f) {
+  if (!filename || (!line && !lineBatch)) {
     return GLUS_FALSE;
   }
 
-  if (!glusWavefrontMallocTempMemoryLine(&vertices, &indices)) {
-    glusWavefrontFreeTempMemoryLine(&vertices, &indices);
-
-    glusFileClose(f);
-
+  if (!glusFileLoadText(filename, &textfile)) {
     return GLUS_FALSE;
   }
 
-  while (!feof(f)) {
-    buffer[0] = 0;
+  c = textfile.text;
 
-    if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0) {
-      if (ferror(f)) {
-        glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+  while (*c) {
+    c = glusWavefrontSkipSpaces(c);
 
-        glusFileClose(f);
+    token = c;
+    tokenEnd = glusWavefrontSkipToken(c);
 
-        return GLUS_FALSE;
-      }
-    }
+    c = tokenEnd;
 
-    if (strncmp(buffer, "o", 1) == 0) {
+    if (glusWavefrontIsKeyword(token, tokenEnd, "o")) {
       if (numberObjects == GLUS_MAX_OBJECTS) {
         glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-        glusFileClose(f);
+        glusFileDestroyText(&textfile);
 
         return GLUS_FALSE;
       }
 
       numberObjects++;
-    } else if (strncmp(buffer, "v", 1) == 0) {
-      if (numberVertices == GLUS_MAX_ATTRIBUTES) {
-        glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+    } else if (tokenEnd - token == 1 && *token == 'v') {
+      GLUSfloat *vertex;
 
-        glusFileClose(f);
+      if (numberVertices == capacityVertices) {
+        vertices = (GLUSfloat *)glusWavefrontGrowMemory(
+            vertices, &capacityVertices, 4 * sizeof(GLUSfloat));
 
-        return GLUS_FALSE;
+        if (!vertices) {
+          glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+
+          glusFileDestroyText(&textfile);
+
+          return GLUS_FALSE;
+        }
       }
 
-      sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+      vertex = &vertices[4 * numberVertices];
 
-      vertices[4 * numberVertices + 0] = x;
-      vertices[4 * numberVertices + 1] = y;
-      vertices[4 * numberVertices + 2] = z;
-      vertices[4 * numberVertices + 3] = 1.0f;
+      vertex[0] = 0.0f;
+      vertex[1] = 0.0f;
+      vertex[2] = 0.0f;
+      vertex[3] = 1.0f;
+
+      c = glusWavefrontParseFloat(c, &vertex[0]);
+      c = glusWavefrontParseFloat(c, &vertex[1]);
+      c = glusWavefrontParseFloat(c, &vertex[2]);
 
       numberVertices++;
-    } else if (strncmp(buffer, "l", 1) == 0) {
-      if (numberIndices == GLUS_MAX_LINE_ATTRIBUTES) {
-        glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+    } else if (tokenEnd - token == 1 && *token == 'l') {
+      GLUSint index;
+      GLUSint previousIndex = -1;
 
-        glusFileClose(f);
+      GLUSuint polylineStart = numberIndices;
+      GLUSuint numberPoints = 0;
 
-        return GLUS_FALSE;
-      }
+      c = glusWavefrontSkipSpaces(c);
 
-      sscanf(buffer, "%s %d %d", identifier, &start, &end);
+      // A polyline is split into line segments or kept as one line strip.
+      while (*c && *c != '\n' && *c != '#') {
+        c = glusWavefrontParseIndex(c, (GLUSint)numberVertices, &index);
 
-      if (start > 0) {
-        start--;
-      } else if (start < 0) {
-        start += numberVertices;
-      } else {
-        glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+        c = glusWavefrontSkipToken(c);
+        c = glusWavefrontSkipSpaces(c);
 
-        glusFileClose(f);
+        if (index < 0 || index >= (GLUSint)numberVertices ||
+            (GLUSuint)index >= GLUS_MAX_INDEXED_VERTICES ||
+            (lineBatch && (GLUSuint64)index >= GLUS_PRIMITIVE_RESTART_INDEX)) {
+          glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-        return GLUS_FALSE;
-      }
+          glusFileDestroyText(&textfile);
 
-      if (end > 0) {
-        end--;
-      } else if (end < 0) {
-        end += numberVertices;
-      } else {
-        glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+          return GLUS_FALSE;
+        }
 
-        glusFileClose(f);
+        if (numberIndices + 2 > capacityIndices) {
+          indices = (GLUSindex *)glusWavefrontGrowMemory(
+              indices, &capacityIndices, sizeof(GLUSindex));
 
-        return GLUS_FALSE;
-      }
+          if (!indices) {
+            glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+
+            glusFileDestroyText(&textfile);
+
+            return GLUS_FALSE;
+          }
+        }
+
+        if (lineBatch) {
+          // Line strips are separated by the restart index.
+          if (numberPoints == 0 && numberIndices > 0) {
+            indices[numberIndices++] = GLUS_PRIMITIVE_RESTART_INDEX;
+          }
+
+          indices[numberIndices++] = (GLUSindex)index;
+        } else if (previousIndex >= 0) {
+          indices[numberIndices + 0] = (GLUSindex)previousIndex;
+          indices[numberIndices + 1] = (GLUSindex)index;
+
+          numberIndices += 2;
+        }
 
-      indices[numberIndices + 0] = (GLUSindex)start;
-      indices[numberIndices + 1] = (GLUSindex)end;
+        previousIndex = index;
 
-      numberIndices += 2;
-      ;
+        numberPoints++;
+      }
+
+      // A single point is no line strip.
+      if (lineBatch && numberPoints < 2) {
+        numberIndices = polylineStart;
+      }
     }
+
+    c = glusWavefrontSkipLine(c);
   }
 
-  glusFileClose(f);
+  glusFileDestroyText(&textfile);
 
-  result = glusWavefrontCopyDataLine(line, numberVertices, vertices,
-                                     numberIndices, indices);
+  if (lineBatch) {
+    result = _glusLineBatchAddIndexed(lineBatch, vertices, numberVertices,
+                                      indices, numberIndices);
+  } else {
+    result = glusWavefrontCopyDataLine(line, numberVertices, vertices,
+                                       numberIndices, indices);
+  }
 
   glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
   return result;
 }
 
+GLUSboolean _glusWavefrontParseLine(const GLUSchar *filename, GLUSline *line) {
+  return glusWavefrontParseLines(filename, line, 0);
+}
+
+GLUSboolean _glusWavefrontParseLineBatch(const GLUSchar *filename,
+                                         GLUSlinebatch *lineBatch) {
+  if (!lineBatch) {
+    return GLUS_FALSE;
+  }
+
+  return glusWavefrontParseLines(filename, 0, lineBatch);
+}
+
 //
 
+GLUSvoid GLUSAPIENTRY glusWavefrontInitOptions(GLUSwavefrontoptions *options) {
+  if (!options) {
+    return;
+  }
+
+  memset(options, 0, sizeof(GLUSwavefrontoptions));
+
+  options->indexed = GLUS_FALSE;
+
+  options->numberThreads = 1;
+
+  options->cache = GLUS_FALSE;
+
+  options->attributes = GLUS_ATTRIBUTE_DEFAULT;
+}
+
 GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar *filename,
                                            GLUSwavefront *wavefront) {
+  return glusWavefrontLoadWithOptions(filename, wavefront, 0);
+}
+
+GLUSboolean GLUSAPIENTRY
+glusWavefrontLoadWithOptions(const GLUSchar *filename, GLUSwavefront *wavefront,
+                             const GLUSwavefrontoptions *options) {
   GLUSshape dummyShape;
 
-  if (!_glusWavefrontParse(filename, &dummyShape, wavefront, 0)) {
+  GLUSwavefrontoptions defaultOptions;
+
+  if (!options) {
+    glusWavefrontInitOptions(&defaultOptions);
+
+    options = &defaultOptions;
+  }
+
+  if (options->cache && wavefront &&
+      _glusWavefrontCacheLoadWavefront(filename, options, wavefront)) {
+    return GLUS_TRUE;
+  }
+
+  if (!_glusWavefrontParse(filename, &dummyShape, wavefront, 0, options)) {
     glusWavefrontDestroy(wavefront);
 
     return GLUS_FALSE;
   }
 
-  if (!_glusWavefrontMove(wavefront, &dummyShape)) {
+  if (!_glusWavefrontMove(wavefront, &dummyShape, options->mergeGroups)) {
     glusWavefrontDestroy(wavefront);
 
     return GLUS_FALSE;
   }
 
+  if (options->cache) {
+    _glusWavefrontCacheSaveWavefront(filename, options, wavefront);
+  }
+
   return GLUS_TRUE;
 }
 
@@ -1554,6 +3164,35 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront *wavefront) {
     return;
   }
 
+  // All data is inside the cache file.
+  if (wavefront->cache) {
+    _glusWavefrontCacheDestroy(wavefront->cache);
+
+    memset(wavefront, 0, sizeof(GLUSwavefront));
+
+    return;
+  }
+
+  // Merged groups point into the indices of the wavefront.
+  if (wavefront->indices) {
+    GLUSgroupList *groupWalker;
+
+    for (groupWalker = wavefront->groups; groupWalker;
+         groupWalker = groupWalker->next) {
+      groupWalker->group.indices = 0;
+    }
+
+    glusMemoryFree(wavefront->indices);
+
+    wavefront->indices = 0;
+  }
+
+  if (wavefront->ranges) {
+    glusMemoryFree(wavefront->ranges);
+
+    wavefront->ranges = 0;
+  }
+
   glusWavefrontDestroyMaterial(&wavefront->materials);
   glusWavefrontDestroyGroup(&wavefront->groups);
 
@@ -1587,29 +3226,59 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront *wavefront) {
     wavefront->bitangents = 0;
   }
 
+  if (wavefront->allAttributes) {
+    glusMemoryFree(wavefront->allAttributes);
+
+    wavefront->allAttributes = 0;
+  }
+
   memset(wavefront, 0, sizeof(GLUSwavefront));
 }
 
 GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar *filename,
                                                 GLUSscene *scene) {
+  return glusWavefrontLoadSceneWithOptions(filename, scene, 0);
+}
+
+GLUSboolean GLUSAPIENTRY
+glusWavefrontLoadSceneWithOptions(const GLUSchar *filename, GLUSscene *scene,
+                                  const GLUSwavefrontoptions *options) {
   GLUSshape dummyShape;
   GLUSwavefront dummyWavefront;
 
+  GLUSwavefrontoptions defaultOptions;
+
   if (!scene) {
     return GLUS_FALSE;
   }
 
+  if (!options) {
+    glusWavefrontInitOptions(&defaultOptions);
+
+    options = &defaultOptions;
+  }
+
   memset(&dummyShape, 0, sizeof(GLUSshape));
   memset(&dummyWavefront, 0, sizeof(GLUSwavefront));
 
   memset(scene, 0, sizeof(GLUSscene));
 
-  if (!_glusWavefrontParse(filename, &dummyShape, &dummyWavefront, scene)) {
+  if (options->cache &&
+      _glusWavefrontCacheLoadScene(filename, options, scene)) {
+    return GLUS_TRUE;
+  }
+
+  if (!_glusWavefrontParse(filename, &dummyShape, &dummyWavefront, scene,
+                           options)) {
     glusWavefrontDestroyScene(scene);
 
     return GLUS_FALSE;
   }
 
+  if (options->cache) {
+    _glusWavefrontCacheSaveScene(filename, options, scene);
+  }
+
   return GLUS_TRUE;
 }
 
@@ -1621,6 +3290,15 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene *scene) {
     return;
   }
 
+  // All objects are inside the cache file.
+  if (scene->cache) {
+    _glusWavefrontCacheDestroy(scene->cache);
+
+    memset(scene, 0, sizeof(GLUSscene));
+
+    return;
+  }
+
   walker = scene->objectList;
 
   while (walker) {
@@ -1640,3 +3318,160 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene *scene) {
 
   memset(scene, 0, sizeof(GLUSscene));
 }
+
+GLUSboolean GLUSAPIENTRY glusWavefrontStream(
+    const GLUSchar *filename, GLUSuint numberTriangles,
+    GLUSboolean (*glusStreamFunc)(const GLUSwavefrontbatch *batch,
+                                  GLUSvoid *userData),
+    GLUSvoid *userData) {
+  GLUSboolean result = GLUS_TRUE;
+  GLUSboolean finished = GLUS_FALSE;
+
+  GLUSwavefrontstream stream;
+  GLUSwavefrontchunk chunk;
+
+  FILE *f;
+
+  GLUSchar *buffer;
+  size_t capacity = GLUS_STREAM_BLOCK_SIZE;
+  size_t length = 0;
+
+  if (!filename || !glusStreamFunc) {
+    return GLUS_FALSE;
+  }
+
+  if (numberTriangles == 0) {
+    numberTriangles = GLUS_STREAM_TRIANGLES;
+  }
+
+  if (numberTriangles > 0x7FFFFFFF / 4 / 3) {
+    return GLUS_FALSE;
+  }
+
+  memset(&stream, 0, sizeof(GLUSwavefrontstream));
+  memset(&chunk, 0, sizeof(GLUSwavefrontchunk));
+
+  stream.capacityBatch = 3 * numberTriangles;
+
+  stream.batchVertices = (GLUSfloat *)glusMemoryMalloc(
+      (size_t)stream.capacityBatch * 4 * sizeof(GLUSfloat));
+  stream.batchNormals = (GLUSfloat *)glusMemoryMalloc(
+      (size_t)stream.capacityBatch * 3 * sizeof(GLUSfloat));
+  stream.batchTexCoords = (GLUSfloat *)glusMemoryMalloc(
+      (size_t)stream.capacityBatch * 2 * sizeof(GLUSfloat));
+
+  buffer = (GLUSchar *)glusMemoryMalloc(capacity);
+
+  if (!stream.batchVertices || !stream.batchNormals ||
+      !stream.batchTexCoords || !buffer) {
+    glusWavefrontDestroyStream(&stream);
+
+    glusMemoryFree(buffer);
+
+    return GLUS_FALSE;
+  }
+
+  stream.batch.vertices = stream.batchVertices;
+  stream.batch.normals = stream.batchNormals;
+  stream.batch.texCoords = stream.batchTexCoords;
+
+  stream.batch.objectIndex = -1;
+  stream.batch.groupIndex = -1;
+  stream.batch.materialIndex = -1;
+
+  stream.batch.objectName = stream.objectName;
+  stream.batch.groupName = stream.groupName;
+  stream.batch.materialName = stream.materialName;
+
+  stream.glusStreamFunc = glusStreamFunc;
+  stream.userData = userData;
+
+  f = glusFileOpen(filename, "rb");
+
+  if (!f) {
+    glusWavefrontDestroyStream(&stream);
+
+    glusMemoryFree(buffer);
+
+    return GLUS_FALSE;
+  }
+
+  // Only complete lines are parsed. The rest is kept for the next block.
+
+  while (result && !finished) {
+    size_t numberRead;
+    size_t end;
+
+    GLUSchar save;
+
+    // A line does not fit into the buffer.
+    if (length + 1 == capacity) {
+      GLUSchar *newBuffer = (GLUSchar *)glusMemoryRealloc(buffer, 2 * capacity);
+
+      if (!newBuffer) {
+        result = GLUS_FALSE;
+
+        break;
+      }
+
+      buffer = newBuffer;
+      capacity *= 2;
+    }
+
+    numberRead = fread(&buffer[length], 1, capacity - 1 - length, f);
+
+    if (ferror(f)) {
+      result = GLUS_FALSE;
+
+      break;
+    }
+
+    length += numberRead;
+
+    end = length;
+
+    if (numberRead == 0) {
+      finished = GLUS_TRUE;
+    } else {
+      while (end > 0 && buffer[end - 1] != '\n') {
+        end--;
+      }
+
+      if (end == 0) {
+        continue;
+      }
+    }
+
+    save = buffer[end];
+
+    buffer[end] = '\0';
+
+    result = glusWavefrontStreamText(&stream, &chunk, buffer, end);
+
+    buffer[end] = save;
+
+    memmove(buffer, &buffer[end], length - end);
+
+    length -= end;
+  }
+
+  if (result) {
+    result = glusWavefrontFlushStream(&stream);
+  }
+
+  glusFileClose(f);
+
+  if (chunk.triangleIndices) {
+    glusMemoryFree(chunk.triangleIndices);
+  }
+
+  if (chunk.events) {
+    glusMemoryFree(chunk.events);
+  }
+
+  glusWavefrontDestroyStream(&stream);
+
+  glusMemoryFree(buffer);
+
+  return result;
+}
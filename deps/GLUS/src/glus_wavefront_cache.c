@@ -0,0 +1,1311 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since
+ * 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#define GLUS_CACHE_VERSION 2
+
+// Every structure and array in the cache file starts at this alignment.
+#define GLUS_CACHE_ALIGNMENT 16
+
+#define GLUS_CACHE_START_CAPACITY 4096
+
+// Types of the cached data.
+#define GLUS_CACHE_SHAPE 1
+#define GLUS_CACHE_WAVEFRONT 2
+#define GLUS_CACHE_SCENE 3
+
+// Loading options, which change the cached data.
+#define GLUS_CACHE_FLAG_INDEXED 1
+#define GLUS_CACHE_FLAG_MERGE_GROUPS 2
+
+// The requested attributes are stored above the other flags.
+#define GLUS_CACHE_FLAG_ATTRIBUTES_SHIFT 8
+
+extern GLUSubyte *_glusFileMap(const GLUSchar *filename, size_t *size,
+                               GLUSboolean copyOnWrite);
+
+extern GLUSvoid _glusFileUnmap(GLUSubyte *data, size_t size);
+
+/**
+ * Structure for the header at the beginning of the cache file.
+ */
+typedef struct _GLUScacheheader {
+  /**
+   * Always "GLUSMESH".
+   */
+  GLUSchar magic[8];
+
+  /**
+   * The version of the file layout.
+   */
+  GLUSuint version;
+
+  /**
+   * The cached data type: Shape, wavefront or scene.
+   */
+  GLUSuint type;
+
+  /**
+   * The loading options, the data was created with.
+   */
+  GLUSuint flags;
+
+  /**
+   * Byte order and sizes of the stored structures. The cache file can only be
+   * used by a build with the same layout.
+   */
+  GLUSuint layout[8];
+
+  /**
+   * Number of the files, the data was loaded from.
+   */
+  GLUSuint numberSources;
+
+  /**
+   * Number of the pointers, which have to be fixed up.
+   */
+  GLUSuint numberRelocations;
+
+  /**
+   * The size of the complete cache file.
+   */
+  GLUSuint64 size;
+
+  /**
+   * Offsets of the source files, relocations and the root structure.
+   */
+  GLUSuint64 sourcesOffset;
+  GLUSuint64 relocationsOffset;
+  GLUSuint64 rootOffset;
+
+} GLUScacheheader;
+
+/**
+ * Structure for a file, the cached data was loaded from.
+ */
+typedef struct _GLUScachesource {
+  /**
+   * The size of the file.
+   */
+  GLUSuint64 size;
+
+  /**
+   * The modification time of the file.
+   */
+  GLUSint64 modificationTime;
+
+  /**
+   * Hash of the file content. Used, if only the modification time changed.
+   */
+  GLUSuint64 hash;
+
+  /**
+   * The name of the file. The first source is the wavefront file itself.
+   */
+  GLUSchar filename[GLUS_MAX_FILENAME];
+
+} GLUScachesource;
+
+/**
+ * Structure used for creating the cache file in memory.
+ */
+typedef struct _GLUScachewriter {
+  /**
+   * The content of the cache file.
+   */
+  GLUSubyte *data;
+  size_t size;
+  size_t capacity;
+
+  /**
+   * Offsets of all pointers in the cache file.
+   */
+  GLUSuint64 *relocations;
+  GLUSuint numberRelocations;
+  GLUSuint capacityRelocations;
+
+  /**
+   * GLUS_FALSE, if writing into memory failed.
+   */
+  GLUSboolean result;
+
+} GLUScachewriter;
+
+static GLUSvoid glusCacheInitLayout(GLUSuint *layout) {
+  layout[0] = 0x01020304;
+  layout[1] = (GLUSuint)sizeof(GLUSvoid *);
+  layout[2] = (GLUSuint)sizeof(GLUSindex);
+  layout[3] = (GLUSuint)sizeof(GLUSshape);
+  layout[4] = (GLUSuint)sizeof(GLUSwavefront);
+  layout[5] = (GLUSuint)sizeof(GLUSgroupList);
+  layout[6] = (GLUSuint)sizeof(GLUSmaterialList);
+  layout[7] = (GLUSuint)sizeof(GLUSobjectList);
+}
+
+static GLUSuint glusCacheGetFlags(const GLUSwavefrontoptions *options) {
+  GLUSuint flags = 0;
+
+  if (options->indexed) {
+    flags |= GLUS_CACHE_FLAG_INDEXED;
+  }
+
+  if (options->mergeGroups) {
+    flags |= GLUS_CACHE_FLAG_MERGE_GROUPS;
+  }
+
+  flags |= options->attributes << GLUS_CACHE_FLAG_ATTRIBUTES_SHIFT;
+
+  return flags;
+}
+
+// Every type has its own cache file, so the same wavefront file can be loaded
+// in different ways.
+static const GLUSchar *glusCacheGetExtension(GLUSuint type) {
+  if (type == GLUS_CACHE_SHAPE) {
+    return ".shape.glusmesh";
+  } else if (type == GLUS_CACHE_WAVEFRONT) {
+    return ".wavefront.glusmesh";
+  }
+
+  return ".scene.glusmesh";
+}
+
+// Prepends the base directory like glusFileOpen() and appends the extension.
+static GLUSboolean glusCacheGetFilename(GLUSchar *buffer,
+                                        const GLUSchar *filename,
+                                        const GLUSchar *extension) {
+  if (strlen(GLUS_BASE_DIRECTORY) + strlen(filename) + strlen(extension) >=
+      GLUS_MAX_FILENAME) {
+    return GLUS_FALSE;
+  }
+
+  strcpy(buffer, GLUS_BASE_DIRECTORY);
+  strcat(buffer, filename);
+  strcat(buffer, extension);
+
+  return GLUS_TRUE;
+}
+
+// Hashes eight bytes at once. The hash is only needed, if a cache file is
+// written or the modification time of a source file has changed.
+static GLUSuint64 glusCacheHash(const GLUSubyte *data, size_t length) {
+  GLUSuint64 hash = 14695981039346656037ULL;
+  GLUSuint64 word;
+
+  size_t i;
+
+  for (i = 0; i + 8 <= length; i += 8) {
+    memcpy(&word, &data[i], 8);
+
+    hash = (hash ^ word) * 1099511628211ULL;
+    hash ^= hash >> 29;
+  }
+
+  for (; i < length; i++) {
+    hash = (hash ^ data[i]) * 1099511628211ULL;
+  }
+
+  return hash ^ (GLUSuint64)length;
+}
+
+static GLUSboolean glusCacheStatSource(const GLUSchar *filename,
+                                       GLUScachesource *source) {
+  GLUSchar buffer[GLUS_MAX_FILENAME];
+
+  struct stat fileStatus;
+
+  if (!glusCacheGetFilename(buffer, filename, "") ||
+      stat(buffer, &fileStatus) != 0) {
+    return GLUS_FALSE;
+  }
+
+  source->size = (GLUSuint64)fileStatus.st_size;
+  source->modificationTime = (GLUSint64)fileStatus.st_mtime;
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusCacheHashSource(const GLUSchar *filename,
+                                       GLUScachesource *source) {
+  GLUSbinaryfile binaryfile;
+
+  if (!glusFileLoadBinary(filename, &binaryfile)) {
+    return GLUS_FALSE;
+  }
+
+  source->hash =
+      glusCacheHash(binaryfile.binary, (size_t)binaryfile.length);
+
+  glusFileDestroyBinary(&binaryfile);
+
+  return GLUS_TRUE;
+}
+
+static GLUSboolean glusCacheCheckSource(const GLUSchar *filename,
+                                        const GLUScachesource *source) {
+  GLUScachesource current;
+
+  if (!glusCacheStatSource(filename, &current) ||
+      current.size != source->size) {
+    return GLUS_FALSE;
+  }
+
+  if (current.modificationTime == source->modificationTime) {
+    return GLUS_TRUE;
+  }
+
+  // Touched, but maybe not changed, so the content decides.
+  return glusCacheHashSource(filename, &current) &&
+         current.hash == source->hash;
+}
+
+// Checks, if the range is inside the cache file.
+static GLUSboolean glusCacheCheckRange(GLUSuint64 offset, GLUSuint64 number,
+                                       size_t elementSize, size_t size) {
+  if (offset > size) {
+    return GLUS_FALSE;
+  }
+
+  return number <= (size - offset) / elementSize;
+}
+
+// Checks, if the array behind a fixed up pointer is inside the mapped cache
+// file. A null pointer is a missing array.
+static GLUSboolean glusCacheCheckArray(const GLUSubyte *data, size_t size,
+                                       const GLUSvoid *pointer,
+                                       GLUSuint64 number, size_t elementSize) {
+  if (!pointer) {
+    return GLUS_TRUE;
+  }
+
+  // A pointer before the data gives a huge offset.
+  return glusCacheCheckRange(
+      (GLUSuint64)((uintptr_t)pointer - (uintptr_t)data), number, elementSize,
+      size);
+}
+
+// Checks the next node of a list. The nodes are written one after another,
+// so a node has to follow the previous one. This also rules out cycles.
+static GLUSboolean glusCacheCheckNode(const GLUSubyte *data, size_t size,
+                                      const GLUSvoid *node,
+                                      const GLUSvoid *previousNode,
+                                      size_t nodeSize) {
+  if (previousNode && (uintptr_t)node <= (uintptr_t)previousNode) {
+    return GLUS_FALSE;
+  }
+
+  return glusCacheCheckArray(data, size, node, 1, nodeSize);
+}
+
+static GLUSboolean glusCacheCheckShape(const GLUSubyte *data, size_t size,
+                                       const GLUSshape *shape) {
+  GLUSuint64 numberVertices = shape->numberVertices;
+
+  return glusCacheCheckArray(data, size, shape->vertices, numberVertices,
+                             4 * sizeof(GLUSfloat)) &&
+         glusCacheCheckArray(data, size, shape->normals, numberVertices,
+                             3 * sizeof(GLUSfloat)) &&
+         glusCacheCheckArray(data, size, shape->tangents, numberVertices,
+                             3 * sizeof(GLUSfloat)) &&
+         glusCacheCheckArray(data, size, shape->bitangents, numberVertices,
+                             3 * sizeof(GLUSfloat)) &&
+         glusCacheCheckArray(data, size, shape->texCoords, numberVertices,
+                             2 * sizeof(GLUSfloat)) &&
+         glusCacheCheckArray(data, size, shape->allAttributes, numberVertices,
+                             15 * sizeof(GLUSfloat)) &&
+         glusCacheCheckArray(data, size, shape->indices, shape->numberIndices,
+                             sizeof(GLUSindex));
+}
+
+static GLUSboolean glusCacheCheckWavefront(const GLUSubyte *data, size_t size,
+                                           const GLUSwavefront *wavefront) {
+  const GLUSmaterialList *materialWalker;
+  const GLUSmaterialList *previousMaterial = 0;
+
+  const GLUSgroupList *groupWalker;
+  const GLUSgroupList *previousGroup = 0;
+
+  GLUSuint64 numberVertices = wavefront->numberVertices;
+
+  GLUSuint i;
+
+  if (!glusCacheCheckArray(data, size, wavefront->vertices, numberVertices,
+                           4 * sizeof(GLUSfloat)) ||
+      !glusCacheCheckArray(data, size, wavefront->normals, numberVertices,
+                           3 * sizeof(GLUSfloat)) ||
+      !glusCacheCheckArray(data, size, wavefront->tangents, numberVertices,
+                           3 * sizeof(GLUSfloat)) ||
+      !glusCacheCheckArray(data, size, wavefront->bitangents, numberVertices,
+                           3 * sizeof(GLUSfloat)) ||
+      !glusCacheCheckArray(data, size, wavefront->texCoords, numberVertices,
+                           2 * sizeof(GLUSfloat)) ||
+      !glusCacheCheckArray(data, size, wavefront->allAttributes,
+                           numberVertices, 15 * sizeof(GLUSfloat)) ||
+      !glusCacheCheckArray(data, size, wavefront->indices,
+                           wavefront->numberIndices, sizeof(GLUSindex)) ||
+      !glusCacheCheckArray(data, size, wavefront->ranges,
+                           wavefront->numberRanges,
+                           sizeof(GLUSmaterialrange))) {
+    return GLUS_FALSE;
+  }
+
+  // The ranges are parts of the indices.
+  for (i = 0; wavefront->ranges && i < wavefront->numberRanges; i++) {
+    const GLUSmaterialrange *range = &wavefront->ranges[i];
+
+    if (!wavefront->indices ||
+        (GLUSuint64)range->firstIndex + range->numberIndices >
+            wavefront->numberIndices ||
+        !glusCacheCheckArray(data, size, range->material, 1,
+                             sizeof(GLUSmaterial))) {
+      return GLUS_FALSE;
+    }
+  }
+
+  for (materialWalker = wavefront->materials; materialWalker;
+       materialWalker = materialWalker->next) {
+    if (!glusCacheCheckNode(data, size, materialWalker, previousMaterial,
+                            sizeof(GLUSmaterialList))) {
+      return GLUS_FALSE;
+    }
+
+    previousMaterial = materialWalker;
+  }
+
+  for (groupWalker = wavefront->groups; groupWalker;
+       groupWalker = groupWalker->next) {
+    if (!glusCacheCheckNode(data, size, groupWalker, previousGroup,
+                            sizeof(GLUSgroupList)) ||
+        !glusCacheCheckArray(data, size, groupWalker->group.indices,
+                             groupWalker->group.numberIndices,
+                             sizeof(GLUSindex)) ||
+        !glusCacheCheckArray(data, size, groupWalker->group.material, 1,
+                             sizeof(GLUSmaterial))) {
+      return GLUS_FALSE;
+    }
+
+    previousGroup = groupWalker;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Checks the counts behind all fixed up pointers, so a corrupted cache file
+// is not read past its end.
+static GLUSboolean glusCacheCheckRoot(const GLUSubyte *data, size_t size,
+                                      GLUSuint type, GLUSuint64 rootOffset) {
+  const GLUSobjectList *objectWalker;
+  const GLUSobjectList *previousObject = 0;
+
+  GLUSshape shape;
+  GLUSwavefront wavefront;
+
+  if (type == GLUS_CACHE_SHAPE) {
+    memcpy(&shape, &data[rootOffset], sizeof(GLUSshape));
+
+    return glusCacheCheckShape(data, size, &shape);
+  } else if (type == GLUS_CACHE_WAVEFRONT) {
+    memcpy(&wavefront, &data[rootOffset], sizeof(GLUSwavefront));
+
+    return glusCacheCheckWavefront(data, size, &wavefront);
+  }
+
+  for (objectWalker = (const GLUSobjectList *)&data[rootOffset]; objectWalker;
+       objectWalker = objectWalker->next) {
+    // Only the scene owns the mapped file.
+    if (!glusCacheCheckNode(data, size, objectWalker, previousObject,
+                            sizeof(GLUSobjectList)) ||
+        objectWalker->object.cache ||
+        !glusCacheCheckWavefront(data, size, &objectWalker->object)) {
+      return GLUS_FALSE;
+    }
+
+    previousObject = objectWalker;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Maps a valid cache file and fixes up all pointers. Returns 0, if there is no
+// valid cache file.
+static GLUSubyte *glusCacheLoad(const GLUSchar *filename, GLUSuint type,
+                                GLUSuint flags, size_t rootSize) {
+  GLUSchar buffer[GLUS_MAX_FILENAME];
+
+  GLUSubyte *data;
+  size_t size;
+
+  GLUScacheheader header;
+  GLUSuint layout[8];
+
+  const GLUScachesource *sources;
+
+  GLUSuint i;
+
+  if (!filename ||
+      !glusCacheGetFilename(buffer, filename, glusCacheGetExtension(type))) {
+    return 0;
+  }
+
+  // Mapped copy on write, so pointers can be fixed up in place without
+  // changing the file.
+  data = _glusFileMap(buffer, &size, GLUS_TRUE);
+
+  if (!data) {
+    return 0;
+  }
+
+  if (size < sizeof(GLUScacheheader)) {
+    _glusFileUnmap(data, size);
+
+    return 0;
+  }
+
+  memcpy(&header, data, sizeof(GLUScacheheader));
+
+  glusCacheInitLayout(layout);
+
+  if (memcmp(header.magic, "GLUSMESH", 8) != 0 ||
+      header.version != GLUS_CACHE_VERSION || header.type != type ||
+      header.flags != flags || memcmp(header.layout, layout, sizeof(layout)) ||
+      header.size != size || header.numberSources == 0 ||
+      !glusCacheCheckRange(header.sourcesOffset, header.numberSources,
+                           sizeof(GLUScachesource), size) ||
+      !glusCacheCheckRange(header.relocationsOffset, header.numberRelocations,
+                           sizeof(GLUSuint64), size) ||
+      !glusCacheCheckRange(header.rootOffset, 1, rootSize, size)) {
+    _glusFileUnmap(data, size);
+
+    return 0;
+  }
+
+  // The wavefront file is checked by the given name, as the cache file is
+  // found by it. Material files are checked by the stored names.
+
+  sources = (const GLUScachesource *)&data[header.sourcesOffset];
+
+  for (i = 0; i < header.numberSources; i++) {
+    const GLUSchar *sourceFilename = i == 0 ? filename : sources[i].filename;
+
+    if (!memchr(sources[i].filename, '\0', GLUS_MAX_FILENAME) ||
+        !glusCacheCheckSource(sourceFilename, &sources[i])) {
+      _glusFileUnmap(data, size);
+
+      return 0;
+    }
+  }
+
+  // Pointers are stored as offsets from the beginning of the file.
+
+  for (i = 0; i < header.numberRelocations; i++) {
+    GLUSuint64 relocation;
+
+    uintptr_t offset;
+
+    GLUSvoid *pointer;
+
+    memcpy(&relocation,
+           &data[header.relocationsOffset + i * sizeof(GLUSuint64)],
+           sizeof(GLUSuint64));
+
+    if (!glusCacheCheckRange(relocation, 1, sizeof(GLUSvoid *), size)) {
+      _glusFileUnmap(data, size);
+
+      return 0;
+    }
+
+    memcpy(&offset, &data[relocation], sizeof(uintptr_t));
+
+    if (offset >= size) {
+      _glusFileUnmap(data, size);
+
+      return 0;
+    }
+
+    pointer = &data[offset];
+
+    memcpy(&data[relocation], &pointer, sizeof(GLUSvoid *));
+  }
+
+  if (!glusCacheCheckRoot(data, size, type, header.rootOffset)) {
+    _glusFileUnmap(data, size);
+
+    return 0;
+  }
+
+  return data;
+}
+
+// Appends aligned data to the cache file. If data is 0, the memory is cleared.
+static size_t glusCacheAppend(GLUScachewriter *writer, const GLUSvoid *data,
+                              size_t size) {
+  size_t offset;
+
+  if (!writer->result) {
+    return 0;
+  }
+
+  offset = (writer->size + GLUS_CACHE_ALIGNMENT - 1) &
+           ~(size_t)(GLUS_CACHE_ALIGNMENT - 1);
+
+  if (offset + size > writer->capacity) {
+    GLUSubyte *newData;
+
+    size_t newCapacity =
+        writer->capacity > 0 ? writer->capacity : GLUS_CACHE_START_CAPACITY;
+
+    while (newCapacity < offset + size) {
+      newCapacity *= 2;
+    }
+
+    newData = (GLUSubyte *)glusMemoryRealloc(writer->data, newCapacity);
+
+    if (!newData) {
+      writer->result = GLUS_FALSE;
+
+      return 0;
+    }
+
+    writer->data = newData;
+    writer->capacity = newCapacity;
+  }
+
+  memset(&writer->data[writer->size], 0, offset - writer->size);
+
+  if (data) {
+    memcpy(&writer->data[offset], data, size);
+  } else {
+    memset(&writer->data[offset], 0, size);
+  }
+
+  writer->size = offset + size;
+
+  return offset;
+}
+
+// Stores the offset of the target into the pointer at the given offset. A
+// target offset of 0 is a null pointer.
+static GLUSvoid glusCacheSetPointer(GLUScachewriter *writer, size_t offset,
+                                    size_t target) {
+  uintptr_t value = (uintptr_t)target;
+
+  if (!writer->result) {
+    return;
+  }
+
+  memcpy(&writer->data[offset], &value, sizeof(uintptr_t));
+
+  if (target == 0) {
+    return;
+  }
+
+  if (writer->numberRelocations == writer->capacityRelocations) {
+    GLUSuint64 *newRelocations;
+
+    GLUSuint newCapacity = writer->capacityRelocations > 0
+                               ? 2 * writer->capacityRelocations
+                               : GLUS_CACHE_START_CAPACITY;
+
+    newRelocations = (GLUSuint64 *)glusMemoryRealloc(
+        writer->relocations, newCapacity * sizeof(GLUSuint64));
+
+    if (!newRelocations) {
+      writer->result = GLUS_FALSE;
+
+      return;
+    }
+
+    writer->relocations = newRelocations;
+    writer->capacityRelocations = newCapacity;
+  }
+
+  writer->relocations[writer->numberRelocations] = (GLUSuint64)offset;
+
+  writer->numberRelocations++;
+}
+
+static GLUSvoid glusCacheSetArray(GLUScachewriter *writer, size_t offset,
+                                  const GLUSvoid *data, size_t size) {
+  size_t target = 0;
+
+  if (data && size > 0) {
+    target = glusCacheAppend(writer, data, size);
+  }
+
+  glusCacheSetPointer(writer, offset, target);
+}
+
+// Adds a source file. The hash is calculated from the already loaded content.
+static GLUSboolean glusCacheAddSource(GLUScachesource **sources,
+                                      GLUSuint *numberSources,
+                                      const GLUSchar *filename,
+                                      const GLUSubyte *content, size_t length) {
+  GLUScachesource *source;
+
+  GLUScachesource *newSources;
+
+  if (strlen(filename) >= GLUS_MAX_FILENAME) {
+    return GLUS_FALSE;
+  }
+
+  newSources = (GLUScachesource *)glusMemoryRealloc(
+      *sources, (*numberSources + 1) * sizeof(GLUScachesource));
+
+  if (!newSources) {
+    return GLUS_FALSE;
+  }
+
+  *sources = newSources;
+
+  source = &newSources[*numberSources];
+
+  memset(source, 0, sizeof(GLUScachesource));
+
+  if (!glusCacheStatSource(filename, source)) {
+    return GLUS_FALSE;
+  }
+
+  if (content) {
+    source->hash = glusCacheHash(content, length);
+  } else if (!glusCacheHashSource(filename, source)) {
+    return GLUS_FALSE;
+  }
+
+  strcpy(source->filename, filename);
+
+  (*numberSources)++;
+
+  return GLUS_TRUE;
+}
+
+// Finds the material files in the same way as the wavefront parser.
+static GLUSboolean glusCacheAddMaterialSources(GLUScachesource **sources,
+                                               GLUSuint *numberSources,
+                                               const GLUSchar *filename,
+                                               const GLUSchar *text) {
+  GLUSchar dir[GLUS_MAX_FILENAME];
+  GLUSchar materialFilename[GLUS_MAX_FILENAME];
+
+  const GLUSchar *c = text;
+
+  size_t length = strlen(filename);
+
+  strcpy(dir, filename);
+  while (length > 0) {
+    length--;
+    if (dir[length] == '\\' || dir[length] == '/') {
+      dir[length] = '\0';
+      break;
+    }
+  }
+
+  while (*c) {
+    while (*c == ' ' || *c == '\t') {
+      c++;
+    }
+
+    if (strncmp(c, "mtllib", 6) == 0 && (c[6] == ' ' || c[6] == '\t')) {
+      size_t nameLength = 0;
+
+      c += 6;
+
+      while (*c == ' ' || *c == '\t') {
+        c++;
+      }
+
+      while (c[nameLength] && c[nameLength] != ' ' && c[nameLength] != '\t' &&
+             c[nameLength] != '\r' && c[nameLength] != '\n') {
+        nameLength++;
+      }
+
+      if (nameLength >= GLUS_MAX_STRING) {
+        nameLength = GLUS_MAX_STRING - 1;
+      }
+
+      if (nameLength > 0) {
+        if (strlen(dir) + nameLength + 2 > GLUS_MAX_FILENAME) {
+          return GLUS_FALSE;
+        }
+
+        strcpy(materialFilename, dir);
+        strcat(materialFilename, "/");
+        strncat(materialFilename, c, nameLength);
+
+        if (!glusCacheAddSource(sources, numberSources, materialFilename, 0,
+                                0)) {
+          return GLUS_FALSE;
+        }
+      }
+    }
+
+    c = strchr(c, '\n');
+
+    if (!c) {
+      break;
+    }
+
+    c++;
+  }
+
+  return GLUS_TRUE;
+}
+
+// Writes the wavefront file and, if needed, the material files as sources.
+static GLUSboolean glusCacheWriteSources(GLUScachewriter *writer,
+                                         const GLUSchar *filename,
+                                         GLUSboolean materials,
+                                         GLUScacheheader *header) {
+  GLUStextfile textfile;
+
+  GLUScachesource *sources = 0;
+  GLUSuint numberSources = 0;
+
+  GLUSboolean result;
+
+  if (strlen(filename) >= GLUS_MAX_FILENAME ||
+      !glusFileLoadText(filename, &textfile)) {
+    return GLUS_FALSE;
+  }
+
+  result = glusCacheAddSource(&sources, &numberSources, filename,
+                              (const GLUSubyte *)textfile.text,
+                              (size_t)textfile.length);
+
+  if (result && materials) {
+    result = glusCacheAddMaterialSources(&sources, &numberSources, filename,
+                                         textfile.text);
+  }
+
+  glusFileDestroyText(&textfile);
+
+  if (result) {
+    header->sourcesOffset = (GLUSuint64)glusCacheAppend(
+        writer, sources, numberSources * sizeof(GLUScachesource));
+    header->numberSources = numberSources;
+  }
+
+  if (sources) {
+    glusMemoryFree(sources);
+  }
+
+  return result && writer->result;
+}
+
+static GLUSvoid glusCacheWriteShape(GLUScachewriter *writer, size_t offset,
+                                    const GLUSshape *shape) {
+  size_t numberVertices = (size_t)shape->numberVertices;
+
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, vertices),
+                    shape->vertices, numberVertices * 4 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, normals),
+                    shape->normals, numberVertices * 3 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, tangents),
+                    shape->tangents, numberVertices * 3 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, bitangents),
+                    shape->bitangents, numberVertices * 3 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, texCoords),
+                    shape->texCoords, numberVertices * 2 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, allAttributes),
+                    shape->allAttributes,
+                    numberVertices * 15 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSshape, indices),
+                    shape->indices,
+                    (size_t)shape->numberIndices * sizeof(GLUSindex));
+
+  glusCacheSetPointer(writer, offset + offsetof(GLUSshape, cache), 0);
+}
+
+// Writes the materials as one array and returns its offset.
+static size_t glusCacheWriteMaterials(GLUScachewriter *writer,
+                                      const GLUSmaterialList *materials) {
+  const GLUSmaterialList *materialWalker;
+
+  size_t offset;
+  size_t numberMaterials = 0;
+  size_t i = 0;
+
+  for (materialWalker = materials; materialWalker;
+       materialWalker = materialWalker->next) {
+    numberMaterials++;
+  }
+
+  if (numberMaterials == 0) {
+    return 0;
+  }
+
+  offset =
+      glusCacheAppend(writer, 0, numberMaterials * sizeof(GLUSmaterialList));
+
+  for (materialWalker = materials; materialWalker && writer->result;
+       materialWalker = materialWalker->next) {
+    size_t materialOffset = offset + i * sizeof(GLUSmaterialList);
+
+    memcpy(&writer->data[materialOffset], materialWalker,
+           sizeof(GLUSmaterialList));
+
+    glusCacheSetPointer(writer,
+                        materialOffset + offsetof(GLUSmaterialList, next),
+                        materialWalker->next
+                            ? materialOffset + sizeof(GLUSmaterialList)
+                            : 0);
+
+    i++;
+  }
+
+  return offset;
+}
+
+// Returns the offset of the material in the material array or 0, if there is
+// no material.
+static size_t glusCacheGetMaterialOffset(const GLUSmaterialList *materials,
+                                         size_t materialsOffset,
+                                         const GLUSmaterial *material) {
+  const GLUSmaterialList *materialWalker;
+
+  size_t k = 0;
+
+  if (!material) {
+    return 0;
+  }
+
+  for (materialWalker = materials; materialWalker;
+       materialWalker = materialWalker->next) {
+    if (&materialWalker->material == material) {
+      return materialsOffset + k * sizeof(GLUSmaterialList) +
+             offsetof(GLUSmaterialList, material);
+    }
+
+    k++;
+  }
+
+  return 0;
+}
+
+// Writes the data of the wavefront structure at the given offset. The groups
+// are written as one array.
+static GLUSvoid glusCacheWriteWavefront(GLUScachewriter *writer, size_t offset,
+                                        const GLUSwavefront *wavefront,
+                                        const GLUSmaterialList *materials,
+                                        size_t materialsOffset) {
+  const GLUSgroupList *groupWalker;
+
+  size_t numberVertices = (size_t)wavefront->numberVertices;
+
+  size_t groupsOffset = 0;
+  size_t indicesOffset = 0;
+  size_t rangesOffset = 0;
+  size_t numberGroups = 0;
+  size_t i;
+
+  glusCacheSetArray(writer, offset + offsetof(GLUSwavefront, vertices),
+                    wavefront->vertices,
+                    numberVertices * 4 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSwavefront, normals),
+                    wavefront->normals,
+                    numberVertices * 3 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSwavefront, tangents),
+                    wavefront->tangents,
+                    numberVertices * 3 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSwavefront, bitangents),
+                    wavefront->bitangents,
+                    numberVertices * 3 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSwavefront, texCoords),
+                    wavefront->texCoords,
+                    numberVertices * 2 * sizeof(GLUSfloat));
+  glusCacheSetArray(writer, offset + offsetof(GLUSwavefront, allAttributes),
+                    wavefront->allAttributes,
+                    numberVertices * 15 * sizeof(GLUSfloat));
+
+  // Merged groups point into these indices.
+
+  if (wavefront->indices && wavefront->numberIndices > 0) {
+    indicesOffset = glusCacheAppend(
+        writer, wavefront->indices,
+        (size_t)wavefront->numberIndices * sizeof(GLUSindex));
+  }
+
+  glusCacheSetPointer(writer, offset + offsetof(GLUSwavefront, indices),
+                      indicesOffset);
+
+  if (wavefront->ranges && wavefront->numberRanges > 0) {
+    rangesOffset = glusCacheAppend(
+        writer, wavefront->ranges,
+        (size_t)wavefront->numberRanges * sizeof(GLUSmaterialrange));
+  }
+
+  for (i = 0; rangesOffset && i < wavefront->numberRanges; i++) {
+    size_t rangeOffset = rangesOffset + i * sizeof(GLUSmaterialrange);
+
+    glusCacheSetPointer(
+        writer, rangeOffset + offsetof(GLUSmaterialrange, material),
+        glusCacheGetMaterialOffset(materials, materialsOffset,
+                                   wavefront->ranges[i].material));
+  }
+
+  glusCacheSetPointer(writer, offset + offsetof(GLUSwavefront, ranges),
+                      rangesOffset);
+
+  for (groupWalker = wavefront->groups; groupWalker;
+       groupWalker = groupWalker->next) {
+    numberGroups++;
+  }
+
+  if (numberGroups > 0) {
+    groupsOffset =
+        glusCacheAppend(writer, 0, numberGroups * sizeof(GLUSgroupList));
+  }
+
+  i = 0;
+
+  for (groupWalker = wavefront->groups; groupWalker && writer->result;
+       groupWalker = groupWalker->next) {
+    size_t groupOffset = groupsOffset + i * sizeof(GLUSgroupList);
+
+    size_t indicesPointerOffset =
+        groupOffset + offsetof(GLUSgroupList, group.indices);
+
+    memcpy(&writer->data[groupOffset], groupWalker, sizeof(GLUSgroupList));
+
+    if (indicesOffset && groupWalker->group.indices) {
+      glusCacheSetPointer(
+          writer, indicesPointerOffset,
+          indicesOffset +
+              (size_t)(groupWalker->group.indices - wavefront->indices) *
+                  sizeof(GLUSindex));
+    } else {
+      glusCacheSetArray(
+          writer, indicesPointerOffset, groupWalker->group.indices,
+          (size_t)groupWalker->group.numberIndices * sizeof(GLUSindex));
+    }
+
+    glusCacheSetPointer(
+        writer, groupOffset + offsetof(GLUSgroupList, group.material),
+        glusCacheGetMaterialOffset(materials, materialsOffset,
+                                   groupWalker->group.material));
+
+    glusCacheSetPointer(writer, groupOffset + offsetof(GLUSgroupList, next),
+                        groupWalker->next ? groupOffset + sizeof(GLUSgroupList)
+                                          : 0);
+
+    i++;
+  }
+
+  glusCacheSetPointer(writer, offset + offsetof(GLUSwavefront, groups),
+                      groupsOffset);
+  glusCacheSetPointer(writer, offset + offsetof(GLUSwavefront, materials),
+                      wavefront->materials ? materialsOffset : 0);
+
+  glusCacheSetPointer(writer, offset + offsetof(GLUSwavefront, cache), 0);
+}
+
+static GLUSboolean glusCacheBegin(GLUScachewriter *writer,
+                                  const GLUSchar *filename, GLUSuint type,
+                                  const GLUSwavefrontoptions *options,
+                                  GLUScacheheader *header) {
+  memset(writer, 0, sizeof(GLUScachewriter));
+
+  writer->result = GLUS_TRUE;
+
+  memset(header, 0, sizeof(GLUScacheheader));
+
+  memcpy(header->magic, "GLUSMESH", 8);
+  header->version = GLUS_CACHE_VERSION;
+  header->type = type;
+  header->flags = glusCacheGetFlags(options);
+  glusCacheInitLayout(header->layout);
+
+  // Space for the header, which is written at the end.
+  glusCacheAppend(writer, 0, sizeof(GLUScacheheader));
+
+  return glusCacheWriteSources(writer, filename, type != GLUS_CACHE_SHAPE,
+                               header);
+}
+
+static GLUSvoid glusCacheEnd(GLUScachewriter *writer, const GLUSchar *filename,
+                             GLUScacheheader *header, size_t rootOffset) {
+  GLUSchar buffer[GLUS_MAX_FILENAME];
+  GLUSchar temporaryExtension[GLUS_MAX_STRING];
+  GLUSchar cacheFilename[GLUS_MAX_FILENAME];
+  GLUSchar temporaryFilename[GLUS_MAX_FILENAME];
+
+  const GLUSchar *extension = glusCacheGetExtension(header->type);
+
+  FILE *f;
+
+  size_t elementsWritten;
+
+  header->rootOffset = (GLUSuint64)rootOffset;
+  header->numberRelocations = writer->numberRelocations;
+
+  if (writer->numberRelocations > 0) {
+    header->relocationsOffset = (GLUSuint64)glusCacheAppend(
+        writer, writer->relocations,
+        (size_t)writer->numberRelocations * sizeof(GLUSuint64));
+  }
+
+  header->size = (GLUSuint64)writer->size;
+
+  strcpy(temporaryExtension, extension);
+  strcat(temporaryExtension, ".tmp");
+
+  if (writer->result &&
+      strlen(filename) + strlen(temporaryExtension) < GLUS_MAX_FILENAME &&
+      glusCacheGetFilename(cacheFilename, filename, extension) &&
+      glusCacheGetFilename(temporaryFilename, filename, temporaryExtension)) {
+    memcpy(writer->data, header, sizeof(GLUScacheheader));
+
+    strcpy(buffer, filename);
+    strcat(buffer, temporaryExtension);
+
+    // The old cache file may still be mapped by loaded data, so it must not
+    // be truncated. A new file is written and replaces the old one.
+    f = glusFileOpen(buffer, "wb");
+
+    if (f) {
+      elementsWritten = fwrite(writer->data, 1, writer->size, f);
+
+      glusFileClose(f);
+
+#if defined(_WIN32)
+      // Fails, if the old file is mapped. Then, the old file is kept.
+      remove(cacheFilename);
+#endif
+
+      if (elementsWritten != writer->size ||
+          rename(temporaryFilename, cacheFilename) != 0) {
+        remove(temporaryFilename);
+      }
+    }
+  }
+
+  if (writer->data) {
+    glusMemoryFree(writer->data);
+
+    writer->data = 0;
+  }
+
+  if (writer->relocations) {
+    glusMemoryFree(writer->relocations);
+
+    writer->relocations = 0;
+  }
+}
+
+//
+
+GLUSboolean _glusWavefrontCacheLoadShape(const GLUSchar *filename,
+                                         const GLUSwavefrontoptions *options,
+                                         GLUSshape *shape) {
+  GLUSubyte *data =
+      glusCacheLoad(filename, GLUS_CACHE_SHAPE, glusCacheGetFlags(options),
+                    sizeof(GLUSshape));
+
+  GLUScacheheader header;
+
+  if (!data) {
+    return GLUS_FALSE;
+  }
+
+  memcpy(&header, data, sizeof(GLUScacheheader));
+
+  memcpy(shape, &data[header.rootOffset], sizeof(GLUSshape));
+
+  shape->cache = data;
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid _glusWavefrontCacheSaveShape(const GLUSchar *filename,
+                                      const GLUSwavefrontoptions *options,
+                                      const GLUSshape *shape) {
+  GLUScachewriter writer;
+  GLUScacheheader header;
+
+  size_t rootOffset = 0;
+
+  if (glusCacheBegin(&writer, filename, GLUS_CACHE_SHAPE, options, &header)) {
+    rootOffset = glusCacheAppend(&writer, shape, sizeof(GLUSshape));
+
+    glusCacheWriteShape(&writer, rootOffset, shape);
+  } else {
+    writer.result = GLUS_FALSE;
+  }
+
+  glusCacheEnd(&writer, filename, &header, rootOffset);
+}
+
+GLUSboolean _glusWavefrontCacheLoadWavefront(
+    const GLUSchar *filename, const GLUSwavefrontoptions *options,
+    GLUSwavefront *wavefront) {
+  GLUSubyte *data =
+      glusCacheLoad(filename, GLUS_CACHE_WAVEFRONT, glusCacheGetFlags(options),
+                    sizeof(GLUSwavefront));
+
+  GLUScacheheader header;
+
+  if (!data) {
+    return GLUS_FALSE;
+  }
+
+  memcpy(&header, data, sizeof(GLUScacheheader));
+
+  memcpy(wavefront, &data[header.rootOffset], sizeof(GLUSwavefront));
+
+  wavefront->cache = data;
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid _glusWavefrontCacheSaveWavefront(const GLUSchar *filename,
+                                          const GLUSwavefrontoptions *options,
+                                          const GLUSwavefront *wavefront) {
+  GLUScachewriter writer;
+  GLUScacheheader header;
+
+  size_t rootOffset = 0;
+
+  if (glusCacheBegin(&writer, filename, GLUS_CACHE_WAVEFRONT, options,
+                     &header)) {
+    size_t materialsOffset =
+        glusCacheWriteMaterials(&writer, wavefront->materials);
+
+    rootOffset = glusCacheAppend(&writer, wavefront, sizeof(GLUSwavefront));
+
+    glusCacheWriteWavefront(&writer, rootOffset, wavefront,
+                            wavefront->materials, materialsOffset);
+  } else {
+    writer.result = GLUS_FALSE;
+  }
+
+  glusCacheEnd(&writer, filename, &header, rootOffset);
+}
+
+GLUSboolean _glusWavefrontCacheLoadScene(const GLUSchar *filename,
+                                         const GLUSwavefrontoptions *options,
+                                         GLUSscene *scene) {
+  GLUSubyte *data =
+      glusCacheLoad(filename, GLUS_CACHE_SCENE, glusCacheGetFlags(options),
+                    sizeof(GLUSobjectList));
+
+  GLUScacheheader header;
+
+  if (!data) {
+    return GLUS_FALSE;
+  }
+
+  memcpy(&header, data, sizeof(GLUScacheheader));
+
+  scene->objectList = (GLUSobjectList *)&data[header.rootOffset];
+
+  scene->cache = data;
+
+  return GLUS_TRUE;
+}
+
+GLUSvoid _glusWavefrontCacheSaveScene(const GLUSchar *filename,
+                                      const GLUSwavefrontoptions *options,
+                                      const GLUSscene *scene) {
+  GLUScachewriter writer;
+  GLUScacheheader header;
+
+  const GLUSobjectList *objectWalker;
+
+  size_t rootOffset = 0;
+
+  if (!scene->objectList) {
+    return;
+  }
+
+  if (glusCacheBegin(&writer, filename, GLUS_CACHE_SCENE, options, &header)) {
+    const GLUSmaterialList *materials = 0;
+
+    size_t materialsOffset;
+    size_t numberObjects = 0;
+    size_t i = 0;
+
+    // All objects share one material list.
+    for (objectWalker = scene->objectList; objectWalker;
+         objectWalker = objectWalker->next) {
+      if (!materials) {
+        materials = objectWalker->object.materials;
+      }
+
+      numberObjects++;
+    }
+
+    materialsOffset = glusCacheWriteMaterials(&writer, materials);
+
+    rootOffset =
+        glusCacheAppend(&writer, 0, numberObjects * sizeof(GLUSobjectList));
+
+    for (objectWalker = scene->objectList; objectWalker && writer.result;
+         objectWalker = objectWalker->next) {
+      size_t objectOffset = rootOffset + i * sizeof(GLUSobjectList);
+
+      memcpy(&writer.data[objectOffset], objectWalker, sizeof(GLUSobjectList));
+
+      glusCacheWriteWavefront(&writer,
+                              objectOffset + offsetof(GLUSobjectList, object),
+                              &objectWalker->object, materials,
+                              materialsOffset);
+
+      glusCacheSetPointer(
+          &writer, objectOffset + offsetof(GLUSobjectList, next),
+          objectWalker->next ? objectOffset + sizeof(GLUSobjectList) : 0);
+
+      i++;
+    }
+  } else {
+    writer.result = GLUS_FALSE;
+  }
+
+  glusCacheEnd(&writer, filename, &header, rootOffset);
+}
+
+GLUSvoid _glusWavefrontCacheDestroy(GLUSvoid *cache) {
+  GLUScacheheader header;
+
+  if (!cache) {
+    return;
+  }
+
+  memcpy(&header, cache, sizeof(GLUScacheheader));
+
+  _glusFileUnmap((GLUSubyte *)cache, (size_t)header.size);
+}
+
+GLUSboolean _glusWavefrontCacheContains(const GLUSvoid *cache,
+                                        const GLUSvoid *pointer) {
+  GLUScacheheader header;
+
+  uintptr_t begin = (uintptr_t)cache;
+  uintptr_t address = (uintptr_t)pointer;
+
+  if (!cache || !pointer) {
+    return GLUS_FALSE;
+  }
+
+  memcpy(&header, cache, sizeof(GLUScacheheader));
+
+  return address >= begin && address - begin < (uintptr_t)header.size;
+}